@@ -3,7 +3,7 @@
  
  * File:   Main/testMain.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <memory>
 #include <array>
+#include <tuple>
 #include <boost/format.hpp>
 #include <boost/multi_array.hpp>
 
@@ -105,6 +106,7 @@
 
 #include "testAlgebra.h"
 #include "testAttachSupport.h"
+#include "testBench.h"
 #include "testBinData.h"
 #include "testBnId.h"
 #include "testBoost.h"
@@ -128,11 +130,13 @@
 #include "testHeadRule.h"
 #include "testInputParam.h"
 #include "testInsertComp.h"
+#include "testLayerDivide3D.h"
 #include "testLine.h"
 #include "testLineTrack.h"
 #include "testLog.h"
 #include "testMapRange.h"
 #include "testMapSupport.h"
+#include "testMarkovProcess.h"
 #include "testMasterRotate.h"
 #include "testMaterial.h"
 #include "testMathSupport.h"
@@ -194,9 +198,10 @@ namespace ELog
   ELog::OutputLog<StreamReport> CellM;
 }
 
-int startTest(const int,const int,const int);
+int startTest(const int,const int,const int,const std::string&);
 
 int attachCompTest(const int,const int);
+int benchTest(const int,const int,const std::string&);
 int funcbaseTest(const int,const int);
 int geometryTest(const int,const int);
 int globalTest(const int,const int);
@@ -227,16 +232,19 @@ main(int argc,char* argv[])
       int section(0);
       int type(0);
       int extra(0);
+      std::string outName;      // benchmark results file
       StrFunc::convert(argv[1],section);
       if (argc>2)
 	StrFunc::convert(argv[2],type);
       if (argc>3)
 	StrFunc::convert(argv[3],extra);
+      if (argc>4)
+	outName=argv[4];
 
       if (section<0 && type<0 && extra<0)
 	retVal=fullTest();
       else
-	retVal=startTest(section,type,extra);
+	retVal=startTest(section,type,extra,outName);
 
       if (section*type*extra)
 	{
@@ -254,7 +262,7 @@ main(int argc,char* argv[])
 	}
     }
   else
-    startTest(0,0,0);
+    startTest(0,0,0,"");
 
   ModelSupport::objectRegister::Instance().reset();
   ModelSupport::surfIndex::Instance().reset();
@@ -262,12 +270,14 @@ main(int argc,char* argv[])
 }
 
 int
-startTest(const int section,const int type,const int extra)
+startTest(const int section,const int type,const int extra,
+	  const std::string& outName)
   /*!
     Processes all the tests:
     \param section :: Section to test
     \param type :: type to test
     \param extra :: extra number
+    \param outName :: Benchmark results file [empty for none]
     \return 0 on success / -ve on failure
   */
 {
@@ -290,6 +300,7 @@ startTest(const int section,const int type,const int extra)
 	  std::cout<<"Namespace :: Work        (12)"<<std::endl;
 	  std::cout<<"Namespace :: XML         (13)"<<std::endl;
 	  std::cout<<"Namespace :: Global      (14)"<<std::endl;
+	  std::cout<<"Namespace :: Benchmark   (15)"<<std::endl;
 
 	  return 0;
 	}
@@ -389,6 +400,13 @@ startTest(const int section,const int type,const int extra)
 	  TestFunc::regGroup("Global");
 	  return globalTest(type,extra);
 	}
+
+      // BENCHMARK [timing only : not in fullTest]
+      if (section==15)
+	{
+	  TestFunc::regGroup("Benchmark");
+	  return benchTest(type,extra,outName);
+	}
       
     }
   catch (ColErr::ExBase& EObj)
@@ -933,23 +951,25 @@ processTest(const int type,const int extra)
       TestFunc::Instance().reportTest(std::cout);
       std::cout<<"testBoxLine          (1)"<<std::endl;
       std::cout<<"testInputParam       (2)"<<std::endl;
-      std::cout<<"testLineTrack        (3)"<<std::endl;
-      std::cout<<"testObjectRegister   (4)"<<std::endl;
-      std::cout<<"testObjectTrackAct   (5)"<<std::endl;
-      std::cout<<"testObjSurfMap       (6)"<<std::endl;
-      std::cout<<"testObjTrackItem     (7)"<<std::endl;
-      std::cout<<"testPairFactory      (8)"<<std::endl;
-      std::cout<<"testPairItem         (9)"<<std::endl;
-      std::cout<<"testPipeLine        (10)"<<std::endl;
-      std::cout<<"testPipeUnit        (11)"<<std::endl;
-      std::cout<<"testSimpleObj       (12)"<<std::endl;
-      std::cout<<"testSurfDIter       (13)"<<std::endl;
-      std::cout<<"testSurfDivide      (14)"<<std::endl;
-      std::cout<<"testSurfEqual       (15)"<<std::endl;
-      std::cout<<"testSurfExpand      (16)"<<std::endl;
-      std::cout<<"testSurfRegister    (17)"<<std::endl;
-      std::cout<<"testVolumes         (18)"<<std::endl;
-      std::cout<<"testWrapper         (19)"<<std::endl;
+      std::cout<<"testLayerDivide3D    (3)"<<std::endl;
+      std::cout<<"testLineTrack        (4)"<<std::endl;
+      std::cout<<"testMarkovProcess    (5)"<<std::endl;
+      std::cout<<"testObjectRegister   (6)"<<std::endl;
+      std::cout<<"testObjectTrackAct   (7)"<<std::endl;
+      std::cout<<"testObjSurfMap       (8)"<<std::endl;
+      std::cout<<"testObjTrackItem     (9)"<<std::endl;
+      std::cout<<"testPairFactory     (10)"<<std::endl;
+      std::cout<<"testPairItem        (11)"<<std::endl;
+      std::cout<<"testPipeLine        (12)"<<std::endl;
+      std::cout<<"testPipeUnit        (13)"<<std::endl;
+      std::cout<<"testSimpleObj       (14)"<<std::endl;
+      std::cout<<"testSurfDIter       (15)"<<std::endl;
+      std::cout<<"testSurfDivide      (16)"<<std::endl;
+      std::cout<<"testSurfEqual       (17)"<<std::endl;
+      std::cout<<"testSurfExpand      (18)"<<std::endl;
+      std::cout<<"testSurfRegister    (19)"<<std::endl;
+      std::cout<<"testVolumes         (20)"<<std::endl;
+      std::cout<<"testWrapper         (21)"<<std::endl;
     }
   int index(1);
   if(type==index || type<0)
@@ -968,6 +988,14 @@ processTest(const int type,const int extra)
     }
   index++;
   
+  if(type==index || type<0)
+    {
+      testLayerDivide3D A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+  index++;
+  
   if(type==index || type<0)
     {
       testLineTrack A;
@@ -976,6 +1004,14 @@ processTest(const int type,const int extra)
     }
   index++;
   
+  if(type==index || type<0)
+    {
+      testMarkovProcess A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+  index++;
+  
   if(type==index || type<0)
     {
       testObjectRegister A;
@@ -1276,6 +1312,32 @@ xmlTest(const int type,const int extra)
   return 0;
 }
 
+int
+benchTest(const int type,const int extra,const std::string& outName)
+  /*!
+    Time the geometry kernels
+    \param type :: type of test
+    \param extra :: extra value
+    \param outName :: Results [csv] file / empty for none
+    \return 0 on success / -ve on failure
+  */
+{
+  if (type==0)
+    {
+      TestFunc::Instance().reportTest(std::cout);
+      std::cout<<"testBench       (1)"<<std::endl;
+    }
+
+  if(type==1 || type<0)
+    {
+      testBench A(outName);
+      int X=A.applyTest(extra);
+      if (X) return X;
+    }
+
+  return 0;
+}
+
 int
 fullTest()
   /*!
@@ -1291,7 +1353,7 @@ fullTest()
       cx<<"TEST SECTION : "<<i+1;
       TestFunc::bracketTest(cx.str(),ELog::EM.Estream());
       ELog::EM<<ELog::endCrit;
-      const int outFlag=startTest(i+1,-1,-1);
+      const int outFlag=startTest(i+1,-1,-1,"");
       if (outFlag)
 	return outFlag;
     }
@@ -3,7 +3,7 @@
  
  * File:   chip/ScatterPlate.cxx
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -272,7 +272,7 @@ ScatterPlate::createObjects(Simulation& System)
   
 
   // Master box: 
-  Out=ModelSupport::getComposite(SMap,spIndex,cx.str());
+  Out=ModelSupport::getDynamicComposite(SMap,spIndex,cx.str());
   addOuterSurf(Out);
   Out+=getContainer();
   System.addCell(MonteCarlo::Qhull(cellIndex++,defMat,0.0,Out));
@@ -93,7 +93,8 @@ BunkerRoof::BunkerRoof(const std::string& bunkerName) :
   attachSystem::FixedComp(bunkerName+"Roof",6),
   attachSystem::CellMap(),attachSystem::SurfMap(),baseName(bunkerName),
   roofIndex(ModelSupport::objectRegister::Instance().cell(keyName,20000)),
-  cellIndex(roofIndex+1),baseSurf(0),topSurf(0),innerSurf(0),outerSurf(0)
+  cellIndex(roofIndex+1),latticeFlag(0),baseSurf(0),topSurf(0),
+  innerSurf(0),outerSurf(0)
   /*!
     Constructor BUT ALL variable are left unpopulated.
     \param bunkerName :: Name of the bunker object that is building this roof
@@ -106,7 +107,8 @@ BunkerRoof::BunkerRoof(const BunkerRoof& A) :
   attachSystem::SurfMap(A),
   baseName(A.baseName),roofIndex(A.roofIndex),cellIndex(A.cellIndex),
   roofThick(A.roofThick),roofMat(A.roofMat),activeRoof(A.activeRoof),
-  nVert(A.nVert),nRadial(A.nRadial),nMedial(A.nMedial),
+  latticeFlag(A.latticeFlag),nVert(A.nVert),nRadial(A.nRadial),
+  nMedial(A.nMedial),
   vert(A.vert),radial(A.radial),medial(A.medial),
   nBasicVert(A.nBasicVert),basicVert(A.basicVert),
   basicMatVec(A.basicMatVec),loadFile(A.loadFile),
@@ -136,6 +138,7 @@ BunkerRoof::operator=(const BunkerRoof& A)
       roofThick=A.roofThick;
       roofMat=A.roofMat;
       activeRoof=A.activeRoof;
+      latticeFlag=A.latticeFlag;
       nVert=A.nVert;
       nRadial=A.nRadial;
       nMedial=A.nMedial;
@@ -181,6 +184,7 @@ BunkerRoof::populate(const FuncDataBase& Control)
   activeRoof=Control.EvalDefVar<size_t>(keyName+"Active",0);
   if (activeRoof)
     {
+      latticeFlag=Control.EvalDefVar<int>(keyName+"Lattice",0);
       nVert=Control.EvalVar<size_t>(keyName+"NVert");
       nRadial=Control.EvalDefVar<size_t>(keyName+"NRadial",0);
       nMedial=Control.EvalDefVar<size_t>(keyName+"NMedial",0);
@@ -291,6 +295,7 @@ BunkerRoof::createSector(Simulation& System,
       LD3.setFractions(1,medial);	    
       LD3.setFractions(2,vert);
       LD3.setIndexNames("Radial","Medial","Vert");
+      LD3.setLattice(latticeFlag);
       LD3.setMaterialXML(keyName+"Def.xml","RoofMat",keyName+".xml",
 			 ModelSupport::EvalMatString(roofMat));	  
     }
@@ -93,8 +93,8 @@ BunkerWall::BunkerWall(const std::string& bunkerName) :
   attachSystem::FixedComp(bunkerName+"Wall",6),
   attachSystem::CellMap(),attachSystem::SurfMap(),baseName(bunkerName),
   wallIndex(ModelSupport::objectRegister::Instance().cell(keyName,20000)),
-  cellIndex(wallIndex+1),activeWall(0),frontSurf(0),backSurf(0),
-  topSurf(0),baseSurf(0)
+  cellIndex(wallIndex+1),activeWall(0),latticeFlag(0),frontSurf(0),
+  backSurf(0),topSurf(0),baseSurf(0)
   /*!
     Constructor BUT ALL variable are left unpopulated.
     \param bunkerName :: Name of the bunker object that is building this wall
@@ -106,7 +106,8 @@ BunkerWall::BunkerWall(const BunkerWall& A) :
   attachSystem::CellMap(A),attachSystem::SurfMap(A),
   baseName(A.baseName),wallIndex(A.wallIndex),
   cellIndex(A.cellIndex),wallThick(A.wallThick),
-  wallMat(A.wallMat),activeWall(A.activeWall),nVert(A.nVert),
+  wallMat(A.wallMat),activeWall(A.activeWall),
+  latticeFlag(A.latticeFlag),nVert(A.nVert),
   nRadial(A.nRadial),nMedial(A.nMedial),vert(A.vert),
   radial(A.radial),medial(A.medial),nBasic(A.nBasic),
   basic(A.basic),basicMatVec(A.basicMatVec),
@@ -137,6 +138,7 @@ BunkerWall::operator=(const BunkerWall& A)
       wallThick=A.wallThick;
       wallMat=A.wallMat;
       activeWall=A.activeWall;
+      latticeFlag=A.latticeFlag;
       nVert=A.nVert;
       nRadial=A.nRadial;
       nMedial=A.nMedial;
@@ -192,6 +194,7 @@ BunkerWall::populate(const FuncDataBase& Control)
   
   if (activeWall)
     {
+      latticeFlag=Control.EvalDefVar<int>(keyName+"Lattice",0);
       nVert=Control.EvalVar<size_t>(keyName+"NVert");
       nRadial=Control.EvalDefVar<size_t>(keyName+"NRadial",0);
       nMedial=Control.EvalDefVar<size_t>(keyName+"NMedial",0);
@@ -297,6 +300,7 @@ BunkerWall::createSector(Simulation& System,
       LD3.setFractions(1,medial);	    
       LD3.setFractions(2,vert);
       LD3.setIndexNames("Radial","Medial","Vert");
+      LD3.setLattice(latticeFlag);
       if (!LD3.setMaterialXML(keyName+"Def.xml","WallMat",keyName+".xml",
 			      ModelSupport::EvalMatString(wallMat)))
 	{
@@ -87,6 +87,9 @@ setBunkerVar(FuncDataBase& Control,const std::string& AKey,
   for(const std::string& KItem : {AKey,BKey})
     {
       Control.addVariable(KItem+"BunkerWallActive",0);
+      // lat=1 output of active wall/roof segments [if regular]
+      Control.addVariable(KItem+"BunkerWallLattice",0);
+      Control.addVariable(KItem+"BunkerRoofLattice",0);
 
       Control.addVariable(KItem+"BunkerWallNVert",8);
       Control.addVariable(KItem+"BunkerWallNMedial",8);
@@ -55,6 +55,7 @@ class BunkerRoof : public attachSystem::ContainedComp,
   
   // ACTIVE COMPONENTS:
   size_t activeRoof;              ///< active flag for roof segments
+  int latticeFlag;                ///< Active segments as a lattice
   size_t nVert;                   ///< number of layers
   size_t nRadial;                 ///< number of radial layers
   size_t nMedial;                 ///< number of horrizontal layers
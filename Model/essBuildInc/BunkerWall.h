@@ -3,7 +3,7 @@
  
  * File:   essBuildInc/BunkerWall.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -55,6 +55,7 @@ class BunkerWall : public attachSystem::ContainedComp,
   
   // ACTIVE COMPONENTS:
   size_t activeWall;              ///< active flag for wall segments
+  int latticeFlag;                ///< Active segments as a lattice
   size_t nVert;                   ///< number of vert layers
   size_t nRadial;                 ///< number of radial layers
   size_t nMedial;                 ///< number of horrizontal layers
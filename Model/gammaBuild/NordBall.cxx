@@ -3,7 +3,7 @@
  
  * File:   gammaBuild/NordBall.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -229,20 +229,21 @@ NordBall::createObjects(Simulation& System)
     cx<<-(31+i)<<" ";
   CompUnit.procString(cx.str());
   CompUnit.makeComplement();
-  Out=ModelSupport::getComposite(SMap,detIndex,cx.str());
+  Out=ModelSupport::getDynamicComposite(SMap,detIndex,cx.str());
   System.addCell(MonteCarlo::Qhull(cellIndex++,mat,0.0,Out+divide));
 
-  Out=ModelSupport::getComposite(SMap,detIndex+50,cx.str());
-  Out+=ModelSupport::getComposite(SMap,detIndex,CompUnit.display());
+  Out=ModelSupport::getDynamicComposite(SMap,detIndex+50,cx.str());
+  Out+=ModelSupport::getDynamicComposite(SMap,detIndex,CompUnit.display());
   System.addCell(MonteCarlo::Qhull(cellIndex++,wallMat,0.0,Out+divide));
 
-  Out=ModelSupport::getComposite(SMap,detIndex+50,cx.str());
+  Out=ModelSupport::getDynamicComposite(SMap,detIndex+50,cx.str());
   Out+=ModelSupport::getComposite(SMap,detIndex," -101 1 ");
   System.addCell(MonteCarlo::Qhull(cellIndex++,wallMat,0.0,Out));
 
   // Edge [void]
   Out=ModelSupport::getComposite(SMap,detIndex,"1 -2 -1107 ");
-  Out+=ModelSupport::getComposite(SMap,detIndex+50,CompUnit.display());
+  Out+=ModelSupport::getDynamicComposite
+    (SMap,detIndex+50,CompUnit.display());
   System.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));
 
 
@@ -256,18 +257,19 @@ NordBall::createObjects(Simulation& System)
   CompUnit.makeComplement();
 
   // Inner
-  Out=ModelSupport::getComposite(SMap,detIndex,cx.str());
+  Out=ModelSupport::getDynamicComposite(SMap,detIndex,cx.str());
   System.addCell(MonteCarlo::Qhull(cellIndex++,mat,0.0,Out+midDivide));
 
   // Wall
-  Out=ModelSupport::getComposite(SMap,detIndex+50,cx.str());
-  Out+=ModelSupport::getComposite(SMap,detIndex,CompUnit.display());
+  Out=ModelSupport::getDynamicComposite(SMap,detIndex+50,cx.str());
+  Out+=ModelSupport::getDynamicComposite(SMap,detIndex,CompUnit.display());
   System.addCell(MonteCarlo::Qhull(cellIndex++,wallMat,0.0,Out+midDivide));
 
 
   // Edge [void]
   Out=ModelSupport::getComposite(SMap,detIndex,"2 -3 -1107 ");
-  Out+=ModelSupport::getComposite(SMap,detIndex+50,CompUnit.display());
+  Out+=ModelSupport::getDynamicComposite
+    (SMap,detIndex+50,CompUnit.display());
   System.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));
 
 
@@ -3,7 +3,7 @@
  
  * File:   lensModel/siModerator.cxx
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -219,7 +219,7 @@ siModerator::createObjects(Simulation& System)
 
   std::string Out;
   // Virtual box:
-  Out=ModelSupport::getComposite(surIndex,"11 -12 3 -4 15 -16");
+  Out=ModelSupport::getComposite(SMap,surIndex,"11 -12 3 -4 15 -16");
   addOuterSurf(Out);
 
   //  System.makeVirtual(cellIndex-1);         
@@ -236,7 +236,8 @@ siModerator::createObjects(Simulation& System)
     {
       cx.str("");
       cx<<prevIndex<<" "<<(-planeIndex);
-      Out=ModelSupport::getComposite(surIndex,XYsides+cx.str());
+      Out=ModelSupport::getDynamicComposite(SMap,surIndex,
+					    XYsides+cx.str());
       System.addCell(MonteCarlo::Qhull(cellIndex++,mat[nextType],temp,Out));
       prevIndex=planeIndex;
       planeIndex++;
@@ -246,11 +247,12 @@ siModerator::createObjects(Simulation& System)
   // Last cell that hits the outside limit:
   cx.str("");
   cx<<prevIndex<<" -6";
-  Out=ModelSupport::getComposite(surIndex,XYsides+cx.str());
+  Out=ModelSupport::getDynamicComposite(SMap,surIndex,
+					  XYsides+cx.str());
   System.addCell(MonteCarlo::Qhull(cellIndex++,mat[nextType],temp,Out));
 
   // Add AL surrounds:
-  Out=ModelSupport::getComposite(surIndex,
+  Out=ModelSupport::getComposite(SMap,surIndex,
 				 "11 -12 3 -4 15 -16 ( -1 : 2 : -5 : 6 )");
   System.addCell(MonteCarlo::Qhull(cellIndex++,surroundMat,temp,Out));
   return; 
@@ -3,7 +3,7 @@
  
  * File:   moderator/Reflector.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -640,6 +640,21 @@ Reflector::getExclude() const
   return Out;
 }
 
+HeadRule
+Reflector::getExcludeRule() const 
+  /*!
+    Virtual function to add the cooling pads
+    \return Full Exclude rule
+  */
+{
+  ELog::RegMethod RegA("Reflector","getExcludeRule");
+
+  HeadRule Out=ContainedComp::getExcludeRule();
+  for(const CoolPad& PD : Pads)
+    Out.addIntersection(PD.getExcludeRule());
+  return Out;
+}
+
 void
 Reflector::createAll(Simulation& System,
 		     const mainSystem::inputParam& IParam)
@@ -3,7 +3,7 @@
  
  * File:   moderatorInc/Reflector.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -108,6 +108,7 @@ class Reflector : public attachSystem::ContainedComp,
   void insertPipeObjects(Simulation&,const mainSystem::inputParam&);
 
   virtual std::string getExclude() const;
+  virtual HeadRule getExcludeRule() const;
 
   void createAll(Simulation&,const mainSystem::inputParam&);
 
@@ -33,6 +33,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -45,7 +46,9 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "Triple.h"
 #include "support.h"
+#include "BoundBox.h"
 #include "Surface.h"
 #include "Quadratic.h"
 #include "Plane.h"
@@ -72,6 +75,8 @@
 #include "Line.h"
 #include "LineIntersectVisit.h"
 #include "AttachSupport.h"
+#include "TripleCache.h"
+#include "InsertCheck.h"
 
 #include "Debug.h"
 #include "debugMethod.h"
@@ -339,7 +344,7 @@ addToInsertControl(Simulation& System,
                        "addToInsertControl(CM,string,FC,CC)");
 
   const size_t NPoint=FC.NConnect();
-  const std::string excludeStr=CC.getExclude();
+  const HeadRule excludeRule(CC.getExcludeRule());
 
   for(const int cN : BaseObj.getCells(cellName))
     {
@@ -353,7 +358,7 @@ addToInsertControl(Simulation& System,
 	      const Geometry::Vec3D& Pt=FC.getLinkPt(j);
 	      if (CRPtr->isValid(Pt))
 		{
-		  CRPtr->addSurfString(excludeStr);
+		  CRPtr->addIntersection(excludeRule);
 		  break;
 		}
 	    }
@@ -383,7 +388,7 @@ addToInsertControl(Simulation& System,
   ELog::RegMethod RegA("AttachSupport","addToInsertControl");
 
   const size_t NPoint=FC.NConnect();
-  const std::string excludeStr=CC.getExclude();
+  const HeadRule excludeRule(CC.getExcludeRule());
   for(int i=cellA+1;i<=cellB;i++)
     {
       MonteCarlo::Qhull* CRPtr=System.findQhull(i);
@@ -395,7 +400,7 @@ addToInsertControl(Simulation& System,
 	      const Geometry::Vec3D& Pt=FC.getLinkPt(j);
 	      if (CRPtr->isValid(Pt))
 		{
-		  CRPtr->addSurfString(excludeStr);
+		  CRPtr->addIntersection(excludeRule);
 		  break;
 		}
 	    }
@@ -500,8 +505,6 @@ addToInsertSurfCtrl(Simulation& System,
 {
   ELog::RegMethod RegA("AttachSupport","addToInsertSurfCtrl(int,int,CC)");
 
-  const std::vector<Geometry::Surface*> SVec=CC.getSurfaces();
-
   MonteCarlo::Qhull* CRPtr=System.findQhull(cellA);
   if (!CRPtr) return;
   
@@ -534,21 +537,20 @@ addToInsertSurfCtrl(Simulation& System,
 {
   ELog::RegMethod RegA("AttachSupport","addToInsertSurfCtrl(int,int,CC)");
 
-  const std::vector<Geometry::Surface*> SVec=CC.getSurfaces();
-
-  for(int i=cellA+1;i<=cellB;i++)
+  InsertCheck ICheck(CC);
+  // only the cells that exist in the range
+  Simulation::OTYPE& Cells=System.getCells();
+  Simulation::OTYPE::iterator mc=Cells.upper_bound(cellA);
+  for(;mc!=Cells.end() && mc->first<=cellB;mc++)
     {
-      MonteCarlo::Qhull* CRPtr=System.findQhull(i);
-      if (CRPtr)
-	{
-	  CRPtr->populate();
-	  CRPtr->createSurfaceList();
-	  const std::vector<const Geometry::Surface*>&
-	    CellSVec=CRPtr->getSurList();
+      MonteCarlo::Qhull* CRPtr=mc->second;
+      CRPtr->populate();
+      CRPtr->createSurfaceList();
+      const std::vector<const Geometry::Surface*>&
+	CellSVec=CRPtr->getSurList();
 	  
-	  if (checkIntersect(CC,*CRPtr,CellSVec))
-	    CC.addInsertCell(i);
-	}
+      if (ICheck.check(*CRPtr,CellSVec))
+	CC.addInsertCell(mc->first);
     }
   CC.insertObjects(System);
   return;
@@ -573,18 +575,18 @@ addToInsertOuterSurfCtrl(Simulation& System,
 {
   ELog::RegMethod RegA("AttachSupport","addToInsertSurfCtrl(int,int,CC)");
 
-  const std::vector<Geometry::Surface*> SVec=CC.getSurfaces();
-
-
   // Populate and createSurface list MUST have been called      
   const std::vector<const Geometry::Surface*>
     CellSVec=BaseCC.getConstSurfaces();
 
-  for(int i=cellA+1;i<=cellB;i++)
+  InsertCheck ICheck(CC);
+  const Simulation::OTYPE& Cells=
+    static_cast<const Simulation&>(System).getCells();
+  Simulation::OTYPE::const_iterator mc=Cells.upper_bound(cellA);
+  for(;mc!=Cells.end() && mc->first<=cellB;mc++)
     {
-      MonteCarlo::Qhull* CRPtr=System.findQhull(i);
-      if (CRPtr && checkIntersect(CC,*CRPtr,CellSVec))
-	CC.addInsertCell(i);
+      if (ICheck.check(*mc->second,CellSVec))
+	CC.addInsertCell(mc->first);
     }
 
   CC.insertObjects(System);
@@ -603,57 +605,9 @@ checkIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
    */
 {
   ELog::RegMethod RegA("AttachSupport","checkInsert");
-  //  ELog::debugMethod DegA;
-  const std::vector<Geometry::Surface*>& SVec=CC.getSurfaces(); 
-  std::vector<Geometry::Vec3D> Out;
-  std::vector<Geometry::Vec3D>::const_iterator vc;
 
-  for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=0;iB<CellSVec.size();iB++)
-      for(size_t iC=iB+1;iC<CellSVec.size();iC++)
-	{	      
-	  Out=SurInter::processPoint(SVec[iA],CellSVec[iB],CellSVec[iC]);
-	  for(vc=Out.begin();vc!=Out.end();vc++)
-	    {
-	      std::set<int> boundarySet;
-	      boundarySet.insert(CellSVec[iB]->getName());
-	      boundarySet.insert(CellSVec[iC]->getName());		  
-	      // Outer valid returns true if out of object
-	      if (CellObj.isValid(*vc,boundarySet) &&
-		  !CC.isOuterValid(*vc,SVec[iA]->getName()))
-		return 1;
-	    }
-	}
-  for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=iA+1;iB<SVec.size();iB++)
-      for(size_t iC=iB+1;iC<SVec.size();iC++)
-	{
-	  Out=SurInter::processPoint(SVec[iA],SVec[iB],SVec[iC]);
-	  for(vc=Out.begin();vc!=Out.end();vc++)
-	    {
-	      if (CellObj.isValid(*vc))
-		return 1;
-	    }
-	}
-  for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=iA+1;iB<SVec.size();iB++)
-      for(size_t iC=0;iC<CellSVec.size();iC++)
-	{
-	  Out=SurInter::processPoint(SVec[iA],SVec[iB],CellSVec[iC]);
-	  for(vc=Out.begin();vc!=Out.end();vc++)
-	    {
-	      std::set<int> boundarySet;
-	      boundarySet.insert(SVec[iA]->getName());
-	      boundarySet.insert(SVec[iB]->getName());
-	      if (CellObj.isValid(*vc,CellSVec[iC]->getName()) &&
-		  !CC.isOuterValid(*vc,boundarySet))
-		{
-		  return 1;
-		}
-	    }
-	}
-  // All failed:
-  return 0;
+  InsertCheck ICheck(CC);
+  return ICheck.check(CellObj,CellSVec);
 }
 
 bool
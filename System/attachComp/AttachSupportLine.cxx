@@ -272,10 +272,7 @@ addToInsertLineCtrl(Simulation& System,
 
 
   if (CRPtr && checkLineIntersect(InsertFC,*CRPtr))
-    {
-      const std::string excludeStr=CC.getExclude();
-      CRPtr->addSurfString(excludeStr);
-    }
+    CRPtr->addIntersection(CC.getExcludeRule());
   return;
 }
 
@@ -3,7 +3,7 @@
  
  * File:   attachComp/CellMap.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -114,7 +114,7 @@ CellMap::insertComponent(Simulation& System,
   ELog::RegMethod RegA("CellMap","insertComponent(CC)");
   
   if (CC.hasOuterSurf())
-    insertComponent(System,Key,CC.getExclude());
+    insertComponent(System,Key,CC.getExcludeRule());
 
   return;
 }
@@ -135,7 +135,7 @@ CellMap::insertComponent(Simulation& System,
   ELog::RegMethod RegA("CellMap","insertComponent(index,CC)");
   
   if (CC.hasOuterSurf())
-    insertComponent(System,Key,index,CC.getExclude());
+    insertComponent(System,Key,index,CC.getExcludeRule());
 
   return;
 }
@@ -152,24 +152,8 @@ CellMap::insertComponent(Simulation& System,
    */
 {
   ELog::RegMethod RegA("CellMap","insertComponent(HR)");
-  if (HR.hasRule())
-    insertComponent(System,Key,HR.display());
-  return;
-}
-
-void
-CellMap::insertComponent(Simulation& System,
-			 const std::string& Key,
-			 const std::string& exclude) const
-  /*!
-    Insert a component into a cell
-    \param System :: Simulation to obtain cell from
-    \param Key :: KeyName for cell
-    \param exclude :: Excluded key
-   */
-{
-  ELog::RegMethod RegA("CellMap","insertComponent(string)");
 
+  if (!HR.hasRule()) return;
   const std::vector<int> CVec=getCells(Key);
   if (CVec.empty())
     throw ColErr::InContainerError<std::string>
@@ -181,7 +165,7 @@ CellMap::insertComponent(Simulation& System,
       if (!outerObj)
 	throw ColErr::InContainerError<int>(cellNum,
 					    "Cell["+Key+"] not in simlutation");
-      outerObj->addSurfString(exclude);
+      outerObj->addIntersection(HR);
     }
   return;
 }
@@ -190,16 +174,16 @@ void
 CellMap::insertComponent(Simulation& System,
 			 const std::string& Key,
 			 const size_t index,
-			 const std::string& exclude) const
+			 const HeadRule& HR) const
   /*!
     Insert a component into a cell
     \param System :: Simulation to obtain cell from
     \param Key :: KeyName for cell
     \param index :: Index to use
-    \param exclude :: Excluded key
+    \param HR :: Excluded rule
    */
 {
-  ELog::RegMethod RegA("CellMap","insertComponent(index,string)");
+  ELog::RegMethod RegA("CellMap","insertComponent(index,HR)");
 
   const int cellNum=getCell(Key,index);
 
@@ -207,7 +191,43 @@ CellMap::insertComponent(Simulation& System,
   if (!outerObj)
     throw ColErr::InContainerError<int>(cellNum,
 					"Cell["+Key+"] not present");
-  outerObj->addSurfString(exclude);
+  outerObj->addIntersection(HR);
+  return;
+}
+
+void
+CellMap::insertComponent(Simulation& System,
+			 const std::string& Key,
+			 const std::string& exclude) const
+  /*!
+    Insert a component into a cell
+    \param System :: Simulation to obtain cell from
+    \param Key :: KeyName for cell
+    \param exclude :: Excluded key
+   */
+{
+  ELog::RegMethod RegA("CellMap","insertComponent(string)");
+
+  insertComponent(System,Key,HeadRule(exclude));
+  return;
+}
+
+void
+CellMap::insertComponent(Simulation& System,
+			 const std::string& Key,
+			 const size_t index,
+			 const std::string& exclude) const
+  /*!
+    Insert a component into a cell
+    \param System :: Simulation to obtain cell from
+    \param Key :: KeyName for cell
+    \param index :: Index to use
+    \param exclude :: Excluded key
+   */
+{
+  ELog::RegMethod RegA("CellMap","insertComponent(index,string)");
+
+  insertComponent(System,Key,index,HeadRule(exclude));
   return;
 }
 
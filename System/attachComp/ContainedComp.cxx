@@ -48,6 +48,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Surface.h"
 #include "SurInter.h"
 #include "Rules.h"
@@ -307,6 +308,19 @@ ContainedComp::getCompExclude() const
   return outerSurf.display();
 }
 
+HeadRule
+ContainedComp::getExcludeRule() const
+  /*!
+    Calculate the excluded rule [complement of the outer
+    surface] to insert into a cell without a string
+    \return Exclude rule [empty if no outer surface]
+  */
+{
+  ELog::RegMethod RegA("ContainedComp","getExcludeRule");
+  
+  return outerSurf.complement();
+}
+
 std::string
 ContainedComp::getExclude() const
   /*!
@@ -514,7 +528,7 @@ ContainedComp::isOuterValid(const Geometry::Vec3D& V,
     \return true/false
    */
 {
-  ELog::RegMethod RegA("ContainedComp","isOuterValid(set))"); 
+  ELog::RegHot RegA("ContainedComp","isOuterValid(set))"); 
   
   return (outerSurf.isValid(V,SN)) ? 0 : 1;
 }
@@ -528,7 +542,7 @@ ContainedComp::isOuterValid(const Geometry::Vec3D& V,const int SN) const
     \return true/false
    */
 {
-  ELog::RegMethod RegA("ContainedComp","isOuterValid(int))"); 
+  ELog::RegHot RegA("ContainedComp","isOuterValid(int))"); 
   
   return (outerSurf.isValid(V,SN)) ? 0 : 1;
 }
@@ -541,10 +555,21 @@ ContainedComp::isOuterValid(const Geometry::Vec3D& V) const
     \return true/false
    */
 {
-  ELog::RegMethod RegA("ContainedComp","isOuterValid())"); 
+  ELog::RegHot RegA("ContainedComp","isOuterValid())"); 
   return (outerSurf.isValid(V)) ? 0 : 1;
 }
 
+Geometry::BoundBox
+ContainedComp::calcOuterBox() const
+  /*!
+    Calculate a conservative box of the outer surface rule
+    \return bounding box [unbounded if no outer rule]
+   */
+{
+  return (outerSurf.hasRule()) ?
+    outerSurf.calcBoundBox() : Geometry::BoundBox();
+}
+
 void 
 ContainedComp::addInsertCell(const std::vector<int>& CVec)
   /*!
@@ -623,11 +648,13 @@ ContainedComp::insertObjects(Simulation& System)
   ELog::RegMethod RegA("ContainedComp","insertObjects");
   if (!hasOuterSurf()) return;
 
+  // exclude rule built once and inserted into each cell
+  const HeadRule excludeRule(getExcludeRule());
   for(const int CN : insertCells)
     {
       MonteCarlo::Qhull* outerObj=System.findQhull(CN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	outerObj->addIntersection(excludeRule);
       else
 	ELog::EM<<"Failed to find outerObject: "<<CN<<ELog::endErr;
     }
@@ -0,0 +1,180 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   attachComp/InsertCheck.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "support.h"
+#include "BoundBox.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "SurInter.h"
+#include "TripleCache.h"
+#include "ContainedComp.h"
+#include "InsertCheck.h"
+
+namespace attachSystem
+{
+
+InsertCheck::InsertCheck(const ContainedComp& A) :
+  CC(A),SVec(A.getSurfaces()),CCBox(A.calcOuterBox())
+  /*!
+    Constructor
+    \param A :: ContainedComp to insert
+  */
+{}
+
+InsertCheck::InsertCheck(const InsertCheck& A) :
+  CC(A.CC),SVec(A.SVec),CCBox(A.CCBox),PtCache(A.PtCache)
+  /*!
+    Copy constructor
+    \param A :: InsertCheck to copy
+  */
+{}
+
+size_t
+InsertCheck::cacheSize() const
+  /*!
+    Number of triples held
+    \return cache size
+  */
+{
+  return PtCache.size();
+}
+
+bool
+InsertCheck::check(const MonteCarlo::Object& CellObj,
+		   const std::vector<const Geometry::Surface*>& CellSVec)
+  /*!
+    Determine if the outer surfaces of the ContainedComp
+    intersect the cell. Unlike the unpruned triple search, a
+    triple point of the object surfaces is only counted if it is
+    in the common box : points outside the object box [e.g. of a
+    redundant plane] found a cell that the object cannot reach.
+    \param CellObj :: Cell Object [populated]
+    \param CellSVec :: Cell surfaces
+    \return true if the object needs to be inserted
+  */
+{
+  ELog::RegMethod RegA("InsertCheck","check");
+
+  if (SVec.empty())
+    return 0;
+
+  Geometry::BoundBox Box(CCBox);
+  Box.intersect(CellObj.calcBoundBox());
+  if (Box.isEmpty())
+    return 0;
+  // points on a shared face are on the box side [small guard]
+  Box.grow(1e-5);
+
+  // only surfaces that can hold a point in the box
+  std::vector<const Geometry::Surface*> AVec;
+  std::vector<const Geometry::Surface*> BVec;
+  for(const Geometry::Surface* SPtr : SVec)
+    if (Geometry::TripleCache::cutsBox(SPtr,Box))
+      AVec.push_back(SPtr);
+  for(const Geometry::Surface* SPtr : CellSVec)
+    if (Geometry::TripleCache::cutsBox(SPtr,Box))
+      BVec.push_back(SPtr);
+
+  for(size_t iB=0;iB<BVec.size();iB++)
+    for(size_t iC=iB+1;iC<BVec.size();iC++)
+      {
+	if (Geometry::TripleCache::isParallel(BVec[iB],BVec[iC])) continue;
+	std::set<int> boundarySet;
+	boundarySet.insert(BVec[iB]->getName());
+	boundarySet.insert(BVec[iC]->getName());
+	for(const Geometry::Surface* APtr : AVec)
+	  for(const Geometry::Vec3D& Pt :
+		PtCache.getPoints(APtr,BVec[iB],BVec[iC]))
+	    {
+	      // Outer valid returns true if out of object
+	      if (Box.isInside(Pt) &&
+		  CellObj.isValid(Pt,boundarySet) &&
+		  !CC.isOuterValid(Pt,APtr->getName()))
+		return 1;
+	    }
+      }
+
+  for(size_t iA=0;iA<AVec.size();iA++)
+    for(size_t iB=iA+1;iB<AVec.size();iB++)
+      {
+	if (Geometry::TripleCache::isParallel(AVec[iA],AVec[iB])) continue;
+	for(size_t iC=iB+1;iC<AVec.size();iC++)
+	  for(const Geometry::Vec3D& Pt :
+		PtCache.getPoints(AVec[iA],AVec[iB],AVec[iC]))
+	    {
+	      if (Box.isInside(Pt) && CellObj.isValid(Pt))
+		return 1;
+	    }
+      }
+
+  for(size_t iA=0;iA<AVec.size();iA++)
+    for(size_t iB=iA+1;iB<AVec.size();iB++)
+      {
+	if (Geometry::TripleCache::isParallel(AVec[iA],AVec[iB])) continue;
+	std::set<int> boundarySet;
+	boundarySet.insert(AVec[iA]->getName());
+	boundarySet.insert(AVec[iB]->getName());
+	for(const Geometry::Surface* CPtr : BVec)
+	  for(const Geometry::Vec3D& Pt :
+		PtCache.getPoints(AVec[iA],AVec[iB],CPtr))
+	    {
+	      if (Box.isInside(Pt) &&
+		  CellObj.isValid(Pt,CPtr->getName()) &&
+		  !CC.isOuterValid(Pt,boundarySet))
+		return 1;
+	    }
+      }
+  // All failed:
+  return 0;
+}
+
+} // NAMESPACE attachSystem
@@ -3,7 +3,7 @@
  
  * File:   attachCompInc/ContainedComp.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -27,6 +27,7 @@ class Simulation;
 namespace Geometry
 {
   class Line;
+  class BoundBox;
 }
 
 namespace attachSystem
@@ -64,6 +65,7 @@ class ContainedComp
   virtual ~ContainedComp();
   
   virtual std::string getExclude() const;
+  virtual HeadRule getExcludeRule() const;
   virtual std::string getCompExclude() const;
   virtual std::string getContainer() const;
   virtual std::string getCompContainer() const;
@@ -86,6 +88,7 @@ class ContainedComp
   int isOuterValid(const Geometry::Vec3D&) const;
   int isOuterValid(const Geometry::Vec3D&,const std::set<int>&) const;
   int isOuterValid(const Geometry::Vec3D&,const int) const;
+  Geometry::BoundBox calcOuterBox() const;
 
   // line in
   bool isOuterLine(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
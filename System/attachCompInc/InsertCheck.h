@@ -0,0 +1,82 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   attachCompInc/InsertCheck.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef attachSystem_InsertCheck_h
+#define attachSystem_InsertCheck_h
+
+namespace Geometry
+{
+  class Surface;
+  class BoundBox;
+  class TripleCache;
+}
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace attachSystem
+{
+
+class ContainedComp;
+
+/*!
+  \class InsertCheck
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Surface intersection test of a ContainedComp against cells
+
+  Holds the outer box of the ContainedComp and the intersection
+  points of each surface triple [keyed by surface number] so that
+  a run of cells is tested without repeating work. Cells whose
+  box misses the outer box are rejected without intersection.
+  Planes that do not cut the common box and parallel plane
+  pairs are dropped before the triples are formed.
+*/
+
+class InsertCheck
+{
+ private:
+
+  const ContainedComp& CC;                     ///< Object to insert
+  const std::vector<Geometry::Surface*> SVec;  ///< Outer surfaces of CC
+  const Geometry::BoundBox CCBox;              ///< Outer box of CC
+
+  Geometry::TripleCache PtCache;               ///< Triple points
+
+ public:
+
+  explicit InsertCheck(const ContainedComp&);
+  InsertCheck(const InsertCheck&);
+  ~InsertCheck() {}       ///< Destructor
+
+  /// Number of triples held
+  size_t cacheSize() const;
+
+  bool check(const MonteCarlo::Object&,
+	     const std::vector<const Geometry::Surface*>&);
+};
+
+}
+
+#endif
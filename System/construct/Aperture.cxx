@@ -223,12 +223,13 @@ Aperture::createObjects(Simulation& System)
   ELog::RegMethod RegA("Aperture","createObjects");
   std::string Out;
 
-  Out=ModelSupport::getComposite(SMap,appIndex,"1 -2 13 -14 15 -16 ");
-  System.addCell(MonteCarlo::Qhull(cellIndex++,voidMat,0.0,Out));
+  System.addCell(MonteCarlo::Qhull
+		 (cellIndex++,voidMat,0.0,ModelSupport::getCompositeRule
+		  (SMap,appIndex,"1 -2 13 -14 15 -16 ")));
 
-  Out=ModelSupport::getComposite(SMap,appIndex,
-                                 "1 -2 3 -4 5 -6 (-13:14:-15:16) ");
-  System.addCell(MonteCarlo::Qhull(cellIndex++,defMat,0.0,Out));
+  System.addCell(MonteCarlo::Qhull
+		 (cellIndex++,defMat,0.0,ModelSupport::getCompositeRule
+		  (SMap,appIndex,"1 -2 3 -4 5 -6 (-13:14:-15:16) ")));
 
 
   Out=ModelSupport::getComposite(SMap,appIndex,"1 -2 3 -4 5 -6 ");
@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <iterator>
+#include <algorithm>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -184,25 +185,55 @@ Code::subStackPtr(const size_t AS)
 
 
 
-template<typename T>
-T
-Code::Eval(varList* Vars)
+template<>
+double
+Code::zeroType()
+/*!
+  Output a zero variable + warning
+  \return nullObject
+ */
+{
+  ELog::EM<<"Error with zero conversion [double]"<<ELog::endErr;
+  return 0.0;
+}
+
+template<>
+Geometry::Vec3D
+Code::zeroType()
+/*!
+  Output a zero variable + warning
+  \return nullObject
+*/
+{
+  ELog::EM<<"Error with zero conversion [vec] "<<ELog::endErr;
+  return Geometry::Vec3D(0,0,0);
+}
+
+int
+Code::runCode(varList* Vars,size_t& SP)
   /*!
-    The function that evaluates everything
+    The function that evaluates everything. The
+    stacks are members and are only grown.
     \param Vars :: Vector of variable pointers
-    \returns value of Function expression
+    \param SP :: Stack pointer of the result [output]
+    \retval 0 :: double result [Stack]
+    \retval 1 :: Vec3D result [StackVec]
+    \retval -1 :: failure
   */
 {
   const size_t ByteCodeSize = ByteCode.size();
   size_t IP(0);       // Bytecode Pointer
   size_t DP(0);       // Immediated points (data)
   size_t DPV(0);      // Immediated Vec3D (data vec)
-  size_t SP(0);       // Stack pointer  
+  SP=0;
   SP--;
 
-  std::vector<int> stackType(StackSize);
-  std::vector<double> Stack(StackSize);
-  std::vector<Geometry::Vec3D> StackVec(StackSize);
+  if (stackType.size()<StackSize)
+    {
+      stackType.resize(StackSize);
+      Stack.resize(StackSize);
+      StackVec.resize(StackSize);
+    }
   while (IP<ByteCodeSize)
     {
       switch(ByteCode[IP])
@@ -217,13 +248,13 @@ Code::Eval(varList* Vars)
 	  else if (stackType[SP]==0)  // double
 	    Stack[SP] = fabs(Stack[SP]); 
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	  
 	case  Opcodes::cAcos: 
 	  if(stackType[SP]==1 || 
 	     (Stack[SP] < -1 || Stack[SP] > 1))
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = acos(Stack[SP]); 
 	  break;
 
@@ -231,13 +262,13 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = acosh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cAsin: 
 	  if(stackType[SP]==1 || 
 	     Stack[SP] < -1 || Stack[SP] > 1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = asin(Stack[SP]); 
 	  break;
 	  
@@ -245,19 +276,19 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = asinh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cAtan: 
 	  if(stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = atan(Stack[SP]); 
 	  break;
 
 
 	case Opcodes::cAtan2: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 
 	  Stack[SP-1] = atan2(Stack[SP-1], Stack[SP]);
 	  SP--; 
@@ -267,79 +298,79 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = atanh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cCeil: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = ceil(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cCos: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cos(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	
 	case Opcodes::cCosd: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cos(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCosh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cosh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCot:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = tan(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCotd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = tan(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCsc:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = sin(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCscd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = sin(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cDot: 
@@ -350,54 +381,54 @@ Code::Eval(varList* Vars)
 	      SP--;
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cExp: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = exp(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cFloor: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = floor(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	      
 	case Opcodes::cInt: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = int(Stack[SP]+0.5); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cLog: 
 	  if(stackType[SP]==0 && Stack[SP] <= 0.0)
 	    Stack[SP] = log(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cLog10: 
 	  if(stackType[SP]==0 && Stack[SP] <= 0.0)
 	    Stack[SP] = log10(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cMax: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP-1] = (Stack[SP-1]>Stack[SP]) ? Stack[SP-1] : Stack[SP];
 	  SP--; 
 	  break;
 
 	case Opcodes::cMin: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP-1] = (Stack[SP-1]<Stack[SP]) ? Stack[SP-1] : Stack[SP];
 	  SP--; 
 	  break;
@@ -406,22 +437,22 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    {
 	      const double t = cos(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cSecd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = cos(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 
@@ -429,49 +460,49 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = sin(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSind: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sin(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSinh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sinh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSqrt: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sqrt(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTan: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tan(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTand: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tan(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTanh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tanh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cVec3D: 
@@ -484,7 +515,7 @@ Code::Eval(varList* Vars)
 	      SP-=2;
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cImmed: 
@@ -508,7 +539,7 @@ Code::Eval(varList* Vars)
 	  else if  (stackType[SP]==0)
 	    Stack[SP] = -Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cAdd: 
@@ -517,7 +548,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] += Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -527,7 +558,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] -= Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 
@@ -544,7 +575,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==1)
 	    StackVec[SP-1] *= Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -556,7 +587,7 @@ Code::Eval(varList* Vars)
 		   Stack[SP]!=0.0)
 	    StackVec[SP-1] /= Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -565,7 +596,7 @@ Code::Eval(varList* Vars)
 	      stackType[SP-1]==0 && Stack[SP]!=0)
 	    Stack[SP-1] = fmod(Stack[SP-1], Stack[SP]);
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  SP--; 
 	  break;
 
@@ -573,7 +604,7 @@ Code::Eval(varList* Vars)
 	  if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] = pow(Stack[SP-1], Stack[SP]);
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  SP--; 
 	  break;
 	      
@@ -582,21 +613,21 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = 180.0*Stack[SP]/M_PI; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	  
 	case  Opcodes::cRad: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = M_PI*Stack[SP]/180.0; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cInv:
 	  if(stackType[SP]==0 && Stack[SP]!=0)
 	    Stack[SP] = 1.0/Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cEqual: 
@@ -623,35 +654,80 @@ Code::Eval(varList* Vars)
       IP++;
     }
   
-  return (stackType[SP]) ? 
+  return stackType[SP];
+}
+
+template<typename T>
+T
+Code::Eval(varList* Vars)
+  /*!
+    Evaluate the code
+    \param Vars :: Vector of variable pointers
+    \returns value of Function expression
+  */
+{
+  size_t SP;
+  const int flag=runCode(Vars,SP);
+  if (flag<0)
+    return zeroType<T>();
+  return (flag) ? 
     typeConvert<T>(StackVec[SP]) : 
     typeConvert<T>(Stack[SP]);
 }
 
-template<>
-double
-Code::zeroType()
-/*!
-  Output a zero variable + warning
-  \return nullObject
- */
+int
+Code::evalValue(varList* Vars,Geometry::Vec3D& oVec,double& oDbl)
+  /*!
+    Evaluate the code without a type conversion
+    \param Vars :: Vector of variable pointers
+    \param oVec :: Vector result [if type 1]
+    \param oDbl :: Double result [if type 0]
+    \retval 0 :: double 
+    \retval 1 :: Vec3D
+    \retval -1 :: failure 
+  */
 {
-  ELog::EM<<"Error with zero conversion [double]"<<ELog::endErr;
-  return 0.0;
+  size_t SP;
+  const int flag=runCode(Vars,SP);
+  if (flag==1)
+    oVec=StackVec[SP];
+  else if (!flag)
+    oDbl=Stack[SP];
+  return flag;
 }
 
-template<>
-Geometry::Vec3D
-Code::zeroType()
-/*!
-  Output a zero variable + warning
-  \return nullObject
-*/
+std::vector<int>
+Code::getVarIndex() const
+  /*!
+    Get the variables that the code reads
+    \return unique variable indexes
+  */
 {
-  ELog::EM<<"Error with zero conversion [vec] "<<ELog::endErr;
-  return Geometry::Vec3D(0,0,0);
+  std::vector<int> Out;
+  for(size_t IP=0;IP<ByteCode.size();IP++)
+    {
+      if (ByteCode[IP]==Opcodes::cEqual)
+	IP++;              // assigned not read
+      else if (ByteCode[IP]>=Opcodes::varBegin)
+	Out.push_back(ByteCode[IP]-Opcodes::varBegin);
+    }
+  std::sort(Out.begin(),Out.end());
+  Out.erase(std::unique(Out.begin(),Out.end()),Out.end());
+  return Out;
 }
 
+bool
+Code::hasAssign() const
+  /*!
+    Determine if the code sets a variable [cEqual]
+    \return true if a variable is assigned
+  */
+{
+  return (std::find(ByteCode.begin(),ByteCode.end(),
+		    Opcodes::cEqual)!=ByteCode.end());
+}
+
+
 template<typename T,typename U>
 T
 Code::typeConvert(const U& A)
@@ -46,7 +46,8 @@
 //-----------------------------------------
 
 FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
-  FItem(VA,I),BaseUnit(CObj)
+  FItem(VA,I),BaseUnit(CObj),depIndex(CObj.getVarIndex()),
+  cacheFlag(!CObj.hasAssign()),cacheType(-1),cacheValue(0.0)
   /*!
     Standard constructor
     \param VA :: VarList pointer
@@ -56,7 +57,9 @@ FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
 {}
 
 FFunc::FFunc(const FFunc& A) :
-  FItem(A),BaseUnit(A.BaseUnit)
+  FItem(A),BaseUnit(A.BaseUnit),depIndex(A.depIndex),
+  cacheFlag(A.cacheFlag),cacheType(A.cacheType),
+  cacheValue(A.cacheValue),cacheVec(A.cacheVec)
   /*!
     Standard copy constructor
     \param A :: FFunc object to copy
@@ -75,6 +78,11 @@ FFunc::operator=(const FFunc& A)
     {
       FItem::operator=(A);
       BaseUnit=A.BaseUnit;
+      depIndex=A.depIndex;
+      cacheFlag=A.cacheFlag;
+      cacheType=A.cacheType;
+      cacheValue=A.cacheValue;
+      cacheVec=A.cacheVec;
     }
   return *this;
 }
@@ -104,22 +112,94 @@ FFunc::setValue(const Code& AC)
   */
 {
   BaseUnit=AC;
+  depIndex=AC.getVarIndex();
+  cacheFlag=!AC.hasAssign();
+  cacheType=-1;
   return;
 }
 
+int
+FFunc::evaluate() const
+  /*!
+    Evaluate the code [if not cached]. A cached value
+    read for the first time after a resetActive, marks the 
+    variables it uses as active.
+    \retval 0 :: double [cacheValue]
+    \retval 1 :: Vec3D [cacheVec]
+    \retval -1 :: failure [zero values]
+  */
+{
+  if (cacheType>=0)
+    {
+      if (!active)
+	VListPtr->markActive(depIndex);
+      return cacheType;
+    }
+  
+  const int flag=BaseUnit.evalValue(VListPtr,cacheVec,cacheValue);
+  if (flag<0)
+    {
+      ELog::EM<<"Error with zero conversion [code]"<<ELog::endErr;
+      cacheValue=0.0;
+      cacheVec=Geometry::Vec3D(0,0,0);
+    }
+  else if (cacheFlag)
+    cacheType=flag;
+  return flag;
+}
+
+double
+FFunc::getDouble() const
+  /*!
+    Get the double value 
+    \throw TypeConvError if the code is a Vec3D
+    \return value 
+  */
+{
+  if (evaluate()==1)
+    throw ColErr::TypeConvError<Geometry::Vec3D,double>
+      (cacheVec,"FFunc::getDouble");
+  const_cast<int&>(active)++;
+  return cacheValue;
+}
+
+int
+FFunc::selectValue(Geometry::Vec3D& oVec,double& oDbl) const
+  /*!
+    Get the value as the natural type of the code
+    \param oVec :: output vector
+    \param oDbl :: output value 
+    \retval 1 :: Vector 
+    \retval 0 :: double [also failure]
+  */
+{
+  if (evaluate()==1)
+    {
+      oVec=cacheVec;
+      const_cast<int&>(active)++;
+      return 1;
+    }
+  oDbl=cacheValue;
+  const_cast<int&>(active)++;
+  return 0;
+}
+
 int
 FFunc::getValue(Geometry::Vec3D& V) const
   /*!
     Get the values. Note that this
     uses varlist
-    \param V :: Outsyste m
-    \return 1 if appropiate eval / 0 otherwise
+    \param V :: Output vector
+    \throw TypeConvError if the code is a double
+    \return 1 
   */
 {
   ELog::RegMethod RegA("FFunc","getValue(Vec3D)");
 
-  Code BC(BaseUnit);
-  V=BC.Eval<Geometry::Vec3D>(FItem::VListPtr);
+  if (!evaluate())
+    throw ColErr::TypeConvError<double,Geometry::Vec3D>
+      (cacheValue,"Code convert");
+  V=cacheVec;
   const_cast<int&>(active)++;
   return 1;
 }
@@ -129,12 +209,11 @@ FFunc::getValue(double& V) const
   /*!
     Get the values. Note that this
     uses varlist
-    \return 1 if appropiate eval / 0 otherwise
+    \param V :: Output value
+    \return 1 
   */
 {
-  Code BC(BaseUnit);
-  V=BC.Eval<double>(FItem::VListPtr);
-  const_cast<int&>(active)++;
+  V=getDouble();
   return 1;
 }
 
@@ -143,12 +222,11 @@ FFunc::getValue(int& V) const
   /*!
     Get the values. Note that this
     uses varlist
-    \return Code expression 
+    \param V :: Output value
+    \return 1
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<int>(BC.Eval<double>(VListPtr));
-  const_cast<int&>(active)++;
+  V=static_cast<int>(getDouble());
   return 1;
 }
 
@@ -157,12 +235,11 @@ FFunc::getValue(long int& V) const
   /*!
     Get the values. Note that this
     uses varlist
-    \return Code expression 
+    \param V :: Output value
+    \return 1
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<long int>(BC.Eval<double>(VListPtr));
-  const_cast<int&>(active)++;
+  V=static_cast<long int>(getDouble());
   return 1;
 }
 
@@ -172,12 +249,11 @@ FFunc::getValue(size_t& V) const
   /*!
     Get the values. Note that this
     uses varlist
-    \return Code expression 
+    \param V :: Output value
+    \return 1
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<size_t>(BC.Eval<double>(VListPtr));
-  const_cast<int&>(active)++;
+  V=static_cast<size_t>(getDouble());
   return 1;
 }
 
@@ -186,15 +262,13 @@ FFunc::getValue(std::string& V) const
   /*!
     Get the values. Note that this
     uses varlist
-    \return Code expression 
+    \param V :: Output value
+    \return 1
   */
 {
-  Code BC(BaseUnit);
-  double Val=BC.Eval<double>(VListPtr);
   std::stringstream cx;
-  cx<<Val;
+  cx<<getDouble();
   V=cx.str();
-  const_cast<int&>(active)++;
   return 1;
 }
 
@@ -82,6 +82,22 @@ FItem::~FItem()
  */
 {}
 
+int
+FItem::selectValue(Geometry::Vec3D& oVec,double& oDbl) const
+  /*!
+    Get the value as the natural type [used by Code::Eval]
+    \param oVec :: output vector
+    \param oDbl :: output value 
+    \retval 1 :: Vector 
+    \retval 0 :: double
+  */
+{
+  if (getValue(oVec))
+    return 1;
+  getValue(oDbl);
+  return 0;
+}
+
 void 
 FItem::setValue(const size_t&)
   /*!
@@ -49,11 +49,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "XMLwriteVisitor.h"
-#include "XMLload.h"
-#include "XMLattribute.h"
-#include "XMLobject.h"
-#include "XMLgroup.h"
-#include "XMLcollect.h"
+#include "XMLpull.h"
 #include "Code.h"
 #include "FItem.h"
 #include "funcList.h"
@@ -993,36 +989,36 @@ FuncDataBase::variableHash() const
 void
 FuncDataBase::processXML(const std::string& FName) 
   /*!
-    Process an XML file to set/add variables
+    Process an XML file to set/add variables. The file
+    is read as a stream of elements, each <variable> is 
+    processed as it is found.
     \param FName :: filename 
   */
 {
   ELog::RegMethod RegA("FuncDataBase","processXML");
-  XML::XMLcollect CO;
-  if (FName.empty() || CO.loadXML(FName))
-    throw ColErr::FileError(0,FName,"XMLcollect file");
-  // Parse for variables:
-  XML::XMLobject* AR=CO.findObj("variable");
-  XML::XMLgroup* AG;
+  XML::XMLpull XP;
+  if (FName.empty() || XP.openFile(FName))
+    throw ColErr::FileError(0,FName,"XMLpull file");
+
   double V;
   Geometry::Vec3D VUnit;
-  std::string VStr;
   int VInt;
-  while(AR)
+  XML::XMLpull::EventType ET;
+  while( (ET=XP.next())!=XML::XMLpull::endFile )
     {
-      const std::string Name=AR->getItem<std::string>("name");
-      const std::string Type=AR->getDefItem<std::string>("type","double");
+      if ((ET!=XML::XMLpull::startElm && ET!=XML::XMLpull::emptyElm) ||
+	  XP.getKey()!="variable")
+	continue;
+      
+      const std::string Name=XP.getAttribute("name");
+      const std::string Type=XP.getAttribute("type","double");
+      const std::string VStr=XP.getValue("value");
 
       if (!hasVariable(Name))
 	ELog::EM<<"Adding variable "<<Name<<ELog::endWarn;
       
-      // Only vector type 
       if (Type=="function")
 	{
-	  if ( (AG=dynamic_cast<XML::XMLgroup*>(AR)) )
-	    VStr=AG->getItem<std::string>("value");
-	  else
-	    VStr=AR->getItem<std::string>();
 	  if (Parse(VStr))
 	    ELog::EM<<"Failed to parse  == "<<VStr<<ELog::endErr;
 	  else
@@ -1030,38 +1026,24 @@ FuncDataBase::processXML(const std::string& FName)
 	}
       else if (Type=="Geometry::Vec3D") 
 	{
-	  if ( (AG=dynamic_cast<XML::XMLgroup*>(AR)) )
-	    VUnit=AG->getItem<Geometry::Vec3D>("value");
-	  else
-	    VUnit=AR->getItem<Geometry::Vec3D>();
+	  if (!StrFunc::convert(VStr,VUnit))
+	    throw ColErr::InvalidLine("Vec3D variable "+Name,VStr,0);
 	  addVariable(Name,VUnit);
 	}
       else if (Type=="std::string") 
-	{
-	  if ( (AG=dynamic_cast<XML::XMLgroup*>(AR)) )
-	    VStr=AG->getItem<std::string>("value");
-	  else
-	    VStr=AR->getItem<std::string>();
-	  addVariable(Name,VStr);
-	}
+	addVariable(Name,VStr);
       else if (Type=="int") 
 	{
-	  if ( (AG=dynamic_cast<XML::XMLgroup*>(AR)) )
-	    VInt=AG->getItem<int>("value");
-	  else
-	    VInt=AR->getItem<int>();
+	  if (!StrFunc::convert(VStr,VInt))
+	    throw ColErr::InvalidLine("int variable "+Name,VStr,0);
 	  addVariable(Name,VInt);
 	}
       else
         {
-	  if ( (AG=dynamic_cast<XML::XMLgroup*>(AR)) )
-	    V=AG->getItem<double>("value");
-	  else
-	    V=AR->getItem<double>();
+	  if (!StrFunc::convert(VStr,V))
+	    throw ColErr::InvalidLine("double variable "+Name,VStr,0);
 	  addVariable(Name,V);
 	}
-      CO.deleteObj(AR);      
-      AR=CO.findObj("variable");
     }
   return;
 }
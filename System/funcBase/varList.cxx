@@ -28,6 +28,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <set>
 #include <algorithm>
 #include <functional>
 
@@ -52,7 +53,7 @@ varList::varList() :
 {}
 
 varList::varList(const varList& A) :
-  varNum(A.varNum)
+  varNum(A.varNum),dependMap(A.dependMap)
   /*!
     Standard Copy constructor.
     Makes a memory copy of the FItem*
@@ -63,6 +64,7 @@ varList::varList(const varList& A) :
   for(vc=A.varName.begin();vc!=A.varName.end();vc++)
     {
       FItem* Ptr=vc->second->clone();
+      Ptr->setVList(this);
       varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
       varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
     }
@@ -82,10 +84,12 @@ varList::operator=(const varList& A)
     {
       varNum=A.varNum;
       deleteMem();
+      dependMap=A.dependMap;
       std::map<std::string,FItem*>::const_iterator vc;
       for(vc=A.varName.begin();vc!=A.varName.end();vc++)
         {
 	  FItem* Ptr=vc->second->clone();
+	  Ptr->setVList(this);
 	  varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
 	  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
 	}
@@ -125,6 +129,61 @@ varList::deleteMem()
     delete vc->second;
   varItem.erase(varItem.begin(),varItem.end());
   varName.erase(varName.begin(),varName.end());
+  dependMap.clear();
+  return;
+}
+
+void
+varList::addDepend(const FItem* FPtr)
+  /*!
+    Register the variables that a function reads
+    \param FPtr :: Item [only FFunc are registered]
+  */
+{
+  const FFunc* FFPtr=dynamic_cast<const FFunc*>(FPtr);
+  if (FFPtr)
+    {
+      const int I=FFPtr->getIndex();
+      for(const int DI : FFPtr->getDepend())
+	{
+	  std::vector<int>& DVec=dependMap[DI];
+	  if (std::find(DVec.begin(),DVec.end(),I)==DVec.end())
+	    DVec.push_back(I);
+	}
+    }
+  return;
+}
+
+void
+varList::invalidate(const int Key)
+  /*!
+    Clear the cached values of all the functions that
+    depend [directly or via other functions] on a variable
+    \param Key :: Variable number that has changed
+  */
+{
+  if (dependMap.empty()) return;
+
+  std::set<int> doneSet;
+  std::vector<int> Stack({Key});
+  while(!Stack.empty())
+    {
+      const int I=Stack.back();
+      Stack.pop_back();
+      std::map<int,std::vector<int>>::const_iterator mc=
+	dependMap.find(I);
+      if (mc!=dependMap.end())
+	{
+	  for(const int DI : mc->second)
+	    if (doneSet.insert(DI).second)
+	      {
+		FItem* FPtr=findVar(DI);
+		if (FPtr)
+		  FPtr->clearCache();
+		Stack.push_back(DI);
+	      }
+	}
+    }
   return;
 }
 
@@ -226,6 +285,7 @@ varList::copyVar(const std::string& newKey,const std::string& oldKey)
       ic=varItem.find(I);
       varName.erase(ac);
       varItem.erase(ic);
+      invalidate(I);
     }
   FItem* Ptr=bc->second->clone();
   Ptr->setIndex(varNum);
@@ -233,6 +293,7 @@ varList::copyVar(const std::string& newKey,const std::string& oldKey)
     // Now insert into master lists
   varName.insert(std::pair<std::string,FItem*>(newKey,Ptr));
   varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+  addDepend(Ptr);
 
   return;
 }
@@ -300,10 +361,21 @@ varList::selectValue(const int Key,Geometry::Vec3D& oVec,
   const FItem* FPtr=findVar(Key);
   if (!FPtr) return -1;
   
-  if (FPtr->getValue(oVec))
-    return 1;
-  FPtr->getValue(oDbl);
-  return 0;
+  return FPtr->selectValue(oVec,oDbl);
+}
+
+void
+varList::markActive(const std::vector<int>& Keys) const
+  /*!
+    Mark variables as read [used by a cached function]
+    \param Keys :: Variable numbers
+  */
+{
+  Geometry::Vec3D oVec;
+  double oDbl;
+  for(const int I : Keys)
+    selectValue(I,oVec,oDbl);
+  return;
 }
 
 template<typename T>
@@ -351,7 +423,11 @@ varList::setValue(const int Key,const T& Value)
 {
   FItem* FPtr=findVar(Key);
   if (FPtr)
-    FPtr->setValue(Value);
+    {
+      FPtr->setValue(Value);
+      addDepend(FPtr);
+      invalidate(Key);
+    }
   return;
 }
 
@@ -374,9 +450,11 @@ varList::removeVar(const std::string& Name)
     throw ColErr::InContainerError<int>(mc->second->getIndex(),
                                         "NAME [INT] "+Name);
 
+  const int I=ic->first;
   delete mc->second;
   varItem.erase(ic);
   varName.erase(mc);
+  invalidate(I);
   return;
 }
 
@@ -396,6 +474,7 @@ varList::addVar(const std::string& Name,const T& Value)
 
   vc=varName.find(Name);
   FItem* Ptr(0);
+  int resetIndex(-1);
   if (vc!=varName.end())
     {
       // Note that the variable number is re-used 
@@ -408,6 +487,7 @@ varList::addVar(const std::string& Name,const T& Value)
       varName.erase(vc);
       varItem.erase(ac);
       Ptr=createFType<T>(I,Value);
+      resetIndex=I;
     }
   else
   // Need to make a completely new item
@@ -418,6 +498,9 @@ varList::addVar(const std::string& Name,const T& Value)
   // Now insert into master lists
   varName.insert(std::pair<std::string,FItem*>(Name,Ptr));
   varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+  addDepend(Ptr);
+  if (resetIndex>=0)
+    invalidate(resetIndex);
   return;
 }
 
@@ -438,6 +521,8 @@ varList::setVar(const std::string& Name,const T& Value)
   try
     {
       vc->second->setValue(Value);
+      addDepend(vc->second);
+      invalidate(vc->second->getIndex());
     }
   catch (ColErr::ExBase&)
     {
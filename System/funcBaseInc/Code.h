@@ -75,6 +75,12 @@ class Code
   std::vector<double> Immed;                ///< Immediate numbers 
   std::vector<Geometry::Vec3D> ImmedVec;    ///< Immediate Vector
 
+  std::vector<int> stackType;               ///< Eval stack type [work]
+  std::vector<double> Stack;                ///< Eval double stack [work]
+  std::vector<Geometry::Vec3D> StackVec;    ///< Eval vector stack [work]
+
+  int runCode(varList*,size_t&);
+  
   template<typename T,typename U>
     static T typeConvert(const U&);
   template<typename T>
@@ -89,6 +95,10 @@ class Code
 
   template<typename T>
   T Eval(varList*);
+  int evalValue(varList*,Geometry::Vec3D&,double&);
+
+  std::vector<int> getVarIndex() const;
+  bool hasAssign() const;
 
   void clear();
   int popByte();
@@ -68,6 +68,10 @@ class FItem
   int isActive() const { return active; }
   /// reset active
   void resetActive() { active=0; }
+  /// Remove any cached value
+  virtual void clearCache() {}
+
+  virtual int selectValue(Geometry::Vec3D&,double&) const;
   ///\cond ABSTRACT
 
   virtual int getValue(Geometry::Vec3D&) const= 0;
@@ -132,14 +136,24 @@ class FValue : public FItem
   \date April 2006
   \version 1.0
   Holds just the code item of the parser (the only bit that
-  is really needed)
+  is really needed). The result is cached until varList 
+  clears it [when a variable that it reads is changed].
 */
 
 class FFunc : public FItem
 {
  private:
 
-  Code BaseUnit;    ///< Code unit of a compile Function
+  mutable Code BaseUnit;       ///< Code unit of a compile Function [work stack]
+  std::vector<int> depIndex;   ///< Variables read by the code
+  bool cacheFlag;              ///< Result can be cached [no assignment]
+
+  mutable int cacheType;       ///< Cache : -1 none / 0 double / 1 Vec3D
+  mutable double cacheValue;       ///< Cached double value
+  mutable Geometry::Vec3D cacheVec;  ///< Cached Vec3D value
+
+  int evaluate() const;
+  double getDouble() const;
 
  public:
 
@@ -150,7 +164,11 @@ class FFunc : public FItem
   virtual ~FFunc();
 
   void setValue(const Code&);
+  virtual void clearCache() { cacheType=-1; }
+  /// Variables read by the code
+  const std::vector<int>& getDepend() const { return depIndex; }
 
+  virtual int selectValue(Geometry::Vec3D&,double&) const;
   virtual int getValue(Geometry::Vec3D&) const;  
   virtual int getValue(int&) const;     
   virtual int getValue(long int&) const;     
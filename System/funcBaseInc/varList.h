@@ -31,6 +31,9 @@
 
   This class holds the variable name + number 
   relative to the actual variable type object. 
+  The functions that read a variable are held by 
+  variable number, so that a change only clears the
+  cached values of its [transitive] dependents.
 */
 
 class FItem;
@@ -47,8 +50,12 @@ class varList
 
   varStore varName;    ///< Var by name
   std::map<int,FItem*> varItem;            ///< Var by number
+  /// Var number : functions [var number] that read it
+  std::map<int,std::vector<int>> dependMap;
 
   void deleteMem();
+  void addDepend(const FItem*);
+  void invalidate(const int);
 
  public:
 
@@ -66,6 +73,7 @@ class varList
   void copyVarSet(const std::string&,const std::string&);
   
   int selectValue(const int,Geometry::Vec3D&,double&) const;
+  void markActive(const std::vector<int>&) const;
 
   template<typename T>
   T getValue(const int) const;
@@ -0,0 +1,86 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/BoundBox.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef Geometry_BoundBox_h
+#define Geometry_BoundBox_h
+
+namespace Geometry
+{
+
+/*!
+  \class BoundBox
+  \brief Axis aligned bounding box
+  \author S. Ansell
+  \date November 2017
+  \version 1.0
+
+  Conservative axis-aligned box. An unbounded side
+  is held as +/-BoundBox::infLimit. A box with
+  a low value greater than the high value is empty.
+*/
+
+class BoundBox
+{
+ private:
+
+  Geometry::Vec3D LowPt;     ///< Low corner
+  Geometry::Vec3D HighPt;    ///< High corner
+
+ public:
+
+  static const double infLimit;    ///< Value used for unbounded
+
+  BoundBox();
+  BoundBox(const Geometry::Vec3D&,const Geometry::Vec3D&);
+  BoundBox(const BoundBox&);
+  BoundBox& operator=(const BoundBox&);
+  ~BoundBox() {}            ///< Destructor
+
+  static BoundBox emptyBox();
+
+  /// Access low corner
+  const Geometry::Vec3D& getLow() const { return LowPt; }
+  /// Access high corner
+  const Geometry::Vec3D& getHigh() const { return HighPt; }
+
+  void setLow(const size_t,const double);
+  void setHigh(const size_t,const double);
+
+  bool isEmpty() const;
+  bool isFinite() const;
+  bool isBounded(const size_t) const;
+  bool isInside(const Geometry::Vec3D&) const;
+  bool overlap(const BoundBox&) const;
+  Geometry::Vec3D getCentre() const;
+
+  BoundBox& intersect(const BoundBox&);
+  BoundBox& unite(const BoundBox&);
+  BoundBox& addPoint(const Geometry::Vec3D&);
+  void grow(const double);
+
+  void write(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&,const BoundBox&);
+
+}  // NAMESPACE Geometry
+
+#endif
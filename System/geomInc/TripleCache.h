@@ -0,0 +1,74 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/TripleCache.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef Geometry_TripleCache_h
+#define Geometry_TripleCache_h
+
+namespace Geometry
+{
+
+class Surface;
+class BoundBox;
+
+/*!
+  \class TripleCache
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Intersection points of surface triples
+
+  Holds the points of SurInter::processPoint keyed by the
+  sorted surface numbers. Lookups may come from several
+  threads. Entries are never removed, so a returned
+  reference stays valid for the life of the cache. The
+  surfaces must not move while the cache is in use.
+*/
+
+class TripleCache
+{
+ private:
+
+  /// Storage of intersection points [sorted surface numbers]
+  typedef std::map<Triple<int>,std::vector<Geometry::Vec3D>> PTYPE;
+
+  mutable std::mutex cacheLock;      ///< Lock for PtCache
+  PTYPE PtCache;                     ///< Triple points
+
+ public:
+
+  TripleCache();
+  TripleCache(const TripleCache&);
+  TripleCache& operator=(const TripleCache&);
+  ~TripleCache() {}         ///< Destructor
+
+  static bool cutsBox(const Surface*,const BoundBox&);
+  static bool isParallel(const Surface*,const Surface*);
+
+  const std::vector<Geometry::Vec3D>&
+    getPoints(const Surface*,const Surface*,const Surface*);
+
+  size_t size() const;
+  void clear();
+};
+
+}
+
+#endif
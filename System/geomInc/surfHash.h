@@ -0,0 +1,100 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/surfHash.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_surfHash_h
+#define ModelSupport_surfHash_h
+
+namespace Geometry
+{
+  class Surface;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class surfHash
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Tolerance aware hash of surfaces
+
+  Each surface is reduced to a class id and a single
+  invariant value [plane distance, radius etc] which
+  is the same [within Geometry::zeroTol] for any two
+  equal or opposite surfaces. The value is binned into
+  buckets much wider than the tolerance and a search
+  looks at the surface bucket and its two neighbours.
+  The result is a candidate list that must still be
+  tested with the real comparison.
+
+  Two key types are supported:
+   - TypeEqual : same type only [ operator== of the type ]
+   - QuadEqual : planes / quadratics [ cmpSurfaces ]
+*/
+
+class surfHash
+{
+ public:
+
+  /// Type of equality to key on
+  enum class KeyType { TypeEqual, QuadEqual };
+  typedef std::map<int,Geometry::Surface*> SMAP;   ///< Surface map
+
+ private:
+
+  /// bucket index : surface
+  typedef std::unordered_multimap<long int,Geometry::Surface*> HTYPE;
+  /// surface number : bucket index / surface
+  typedef std::map<int,std::pair<long int,const Geometry::Surface*>> KTYPE;
+
+  static const double binWidth;    ///< Width of the value bucket
+
+  const KeyType keyType;           ///< Type of key
+  bool validFlag;                  ///< Index matches the surface map
+  HTYPE HMap;                      ///< Hash of bucket index : surface
+  KTYPE keyMap;                    ///< surface number : key
+  std::set<int> pending;           ///< Surfaces to [re]key before use
+
+  bool calcKey(const Geometry::Surface*,long int&,long int&) const;
+  void eraseKey(const int);
+  void flush(const SMAP&);
+
+ public:
+
+  explicit surfHash(const KeyType);
+  ~surfHash() {}     ///< Destructor
+
+  /// Force a rebuild on the next search
+  void setInvalid() { validFlag=0; }
+  void clear();
+
+  void addSurface(Geometry::Surface*);
+  void removeSurface(const int);
+  void updateSurface(const int);
+
+  void build(const SMAP&);
+  bool candidates(const SMAP&,const Geometry::Surface*,SMAP&);
+};
+
+}
+
+#endif
@@ -29,6 +29,7 @@ namespace Geometry
 
 namespace ModelSupport
 {
+  class surfHash;
 
 /*!
   \class surfIndex 
@@ -49,6 +50,7 @@ class surfIndex
   int uniqNum;                      ///< uniq number
   STYPE SMap;                       ///< Index of kept surfaces
   std::map<int,int> holdMap;        ///< Hold/Write map :: surfaceN : write/no-write flag
+  surfHash* HIndex;                 ///< Hash of SMap for equal/opposite
   
   surfIndex();
 
@@ -95,6 +97,8 @@ class surfIndex
 
   /// access to map
   const STYPE& surMap() const { return SMap; }
+  void invalidateHash();
+  bool equalCandidates(const Geometry::Surface*,STYPE&) const;
   void setKeep(const int,const int);
 
   bool mapValid() const;
@@ -0,0 +1,300 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/BoundBox.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+
+namespace Geometry
+{
+
+const double BoundBox::infLimit(1e38);
+
+std::ostream&
+operator<<(std::ostream& OX,const BoundBox& A)
+  /*!
+    Write the box to a stream
+    \param OX :: Output stream
+    \param A :: Box to write
+    \return ostream
+  */
+{
+  A.write(OX);
+  return OX;
+}
+
+BoundBox::BoundBox() :
+  LowPt(-infLimit,-infLimit,-infLimit),
+  HighPt(infLimit,infLimit,infLimit)
+  /*!
+    Constructor : Unbounded box
+  */
+{}
+
+BoundBox::BoundBox(const Geometry::Vec3D& LP,
+		   const Geometry::Vec3D& HP) :
+  LowPt(LP),HighPt(HP)
+  /*!
+    Constructor
+    \param LP :: Low corner
+    \param HP :: High corner
+  */
+{}
+
+BoundBox::BoundBox(const BoundBox& A) :
+  LowPt(A.LowPt),HighPt(A.HighPt)
+  /*!
+    Copy constructor
+    \param A :: BoundBox to copy
+  */
+{}
+
+BoundBox&
+BoundBox::operator=(const BoundBox& A)
+  /*!
+    Assignment operator
+    \param A :: BoundBox to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      LowPt=A.LowPt;
+      HighPt=A.HighPt;
+    }
+  return *this;
+}
+
+BoundBox
+BoundBox::emptyBox()
+  /*!
+    Create a box that contains nothing [identity for unite]
+    \return empty box
+  */
+{
+  return BoundBox(Geometry::Vec3D(infLimit,infLimit,infLimit),
+		  Geometry::Vec3D(-infLimit,-infLimit,-infLimit));
+}
+
+void
+BoundBox::setLow(const size_t index,const double V)
+  /*!
+    Set the low value of an axis
+    \param index :: axis index [0-2]
+    \param V :: Value
+  */
+{
+  if (index>2)
+    throw ColErr::IndexError<size_t>(index,3,"BoundBox::setLow");
+  LowPt[index]=V;
+  return;
+}
+
+void
+BoundBox::setHigh(const size_t index,const double V)
+  /*!
+    Set the high value of an axis
+    \param index :: axis index [0-2]
+    \param V :: Value
+  */
+{
+  if (index>2)
+    throw ColErr::IndexError<size_t>(index,3,"BoundBox::setHigh");
+  HighPt[index]=V;
+  return;
+}
+
+bool
+BoundBox::isEmpty() const
+  /*!
+    Determine if the box contains no volume
+    \return true if empty
+  */
+{
+  return (LowPt[0]>HighPt[0] ||
+	  LowPt[1]>HighPt[1] ||
+	  LowPt[2]>HighPt[2]);
+}
+
+bool
+BoundBox::isBounded(const size_t index) const
+  /*!
+    Determine if an axis is bounded on both sides
+    \param index :: axis index [0-2]
+    \return true if finite
+  */
+{
+  return (LowPt[index]> -infLimit && HighPt[index]<infLimit);
+}
+
+bool
+BoundBox::isFinite() const
+  /*!
+    Determine if all the sides are bounded
+    \return true if finite
+  */
+{
+  return (isBounded(0) && isBounded(1) && isBounded(2));
+}
+
+bool
+BoundBox::isInside(const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if a point is within the box [inclusive]
+    \param Pt :: Point to test
+    \return true if inside/on the box
+  */
+{
+  return (Pt[0]>=LowPt[0] && Pt[0]<=HighPt[0] &&
+	  Pt[1]>=LowPt[1] && Pt[1]<=HighPt[1] &&
+	  Pt[2]>=LowPt[2] && Pt[2]<=HighPt[2]);
+}
+
+bool
+BoundBox::overlap(const BoundBox& A) const
+  /*!
+    Determine if two boxes overlap [touching counts]
+    \param A :: Box to test
+    \return true if the boxes share a point
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      if (A.HighPt[i]<LowPt[i] || A.LowPt[i]>HighPt[i])
+	return 0;
+    }
+  return 1;
+}
+
+Geometry::Vec3D
+BoundBox::getCentre() const
+  /*!
+    Calculate the centre of the box. Unbounded
+    directions are set to zero
+    \return centre point
+  */
+{
+  Geometry::Vec3D Out;
+  for(size_t i=0;i<3;i++)
+    Out[i]= (isBounded(i)) ? (LowPt[i]+HighPt[i])/2.0 : 0.0;
+  return Out;
+}
+
+BoundBox&
+BoundBox::intersect(const BoundBox& A)
+  /*!
+    Reduce this box to the common part of two boxes
+    \param A :: Box to intersect with
+    \return *this
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      LowPt[i]=std::max(LowPt[i],A.LowPt[i]);
+      HighPt[i]=std::min(HighPt[i],A.HighPt[i]);
+    }
+  return *this;
+}
+
+BoundBox&
+BoundBox::unite(const BoundBox& A)
+  /*!
+    Expand this box to include box A
+    \param A :: Box to include
+    \return *this
+  */
+{
+  if (A.isEmpty())
+    return *this;
+  if (isEmpty())
+    return (*this=A);
+
+  for(size_t i=0;i<3;i++)
+    {
+      LowPt[i]=std::min(LowPt[i],A.LowPt[i]);
+      HighPt[i]=std::max(HighPt[i],A.HighPt[i]);
+    }
+  return *this;
+}
+
+BoundBox&
+BoundBox::addPoint(const Geometry::Vec3D& Pt)
+  /*!
+    Expand this box to include a point
+    \param Pt :: Point to include
+    \return *this
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      LowPt[i]=std::min(LowPt[i],Pt[i]);
+      HighPt[i]=std::max(HighPt[i],Pt[i]);
+    }
+  return *this;
+}
+
+void
+BoundBox::grow(const double D)
+  /*!
+    Expand the bounded sides of the box by D
+    \param D :: Distance to expand
+  */
+{
+  if (isEmpty()) return;
+  for(size_t i=0;i<3;i++)
+    {
+      if (LowPt[i]> -infLimit)
+	LowPt[i]-=D;
+      if (HighPt[i]<infLimit)
+	HighPt[i]+=D;
+    }
+  return;
+}
+
+void
+BoundBox::write(std::ostream& OX) const
+  /*!
+    Write out the box
+    \param OX :: Output stream
+  */
+{
+  OX<<"["<<LowPt<<"] : ["<<HighPt<<"]";
+  return;
+}
+
+}  // NAMESPACE Geometry
@@ -0,0 +1,193 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/TripleCache.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "support.h"
+#include "BoundBox.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "SurInter.h"
+#include "TripleCache.h"
+
+namespace Geometry
+{
+
+TripleCache::TripleCache()
+  /*!
+    Constructor
+  */
+{}
+
+TripleCache::TripleCache(const TripleCache& A)
+  /*!
+    Copy constructor
+    \param A :: TripleCache to copy
+  */
+{
+  std::lock_guard<std::mutex> Guard(A.cacheLock);
+  PtCache=A.PtCache;
+}
+
+TripleCache&
+TripleCache::operator=(const TripleCache& A)
+  /*!
+    Assignment operator
+    \param A :: TripleCache to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      std::lock(cacheLock,A.cacheLock);
+      std::lock_guard<std::mutex> GuardA(cacheLock,std::adopt_lock);
+      std::lock_guard<std::mutex> GuardB(A.cacheLock,std::adopt_lock);
+      PtCache=A.PtCache;
+    }
+  return *this;
+}
+
+bool
+TripleCache::cutsBox(const Surface* SPtr,const BoundBox& Box)
+  /*!
+    Determine if a surface can pass through a box.
+    Only a plane with all the box corners on one side
+    is found to miss.
+    \param SPtr :: Surface
+    \param Box :: Finite box
+    \return false if the surface misses the box
+  */
+{
+  const Plane* PPtr=dynamic_cast<const Plane*>(SPtr);
+  if (!PPtr || !Box.isFinite())
+    return 1;
+
+  const Vec3D& LPt=Box.getLow();
+  const Vec3D& HPt=Box.getHigh();
+  int sideFlag(0);
+  for(size_t i=0;i<8;i++)
+    {
+      const Vec3D Corner((i & 1) ? HPt[0] : LPt[0],
+			 (i & 2) ? HPt[1] : LPt[1],
+			 (i & 4) ? HPt[2] : LPt[2]);
+      const int SN=PPtr->side(Corner);
+      if (!SN || (sideFlag && SN!=sideFlag))
+	return 1;
+      sideFlag=SN;
+    }
+  return 0;
+}
+
+bool
+TripleCache::isParallel(const Surface* APtr,const Surface* BPtr)
+  /*!
+    Determine if two surfaces are parallel planes
+    [and hence have no common point in a triple]
+    \param APtr :: First surface
+    \param BPtr :: Second surface
+    \return true if parallel planes
+  */
+{
+  const Plane* PA=dynamic_cast<const Plane*>(APtr);
+  const Plane* PB=dynamic_cast<const Plane*>(BPtr);
+  return (PA && PB &&
+	  std::abs(PA->getNormal().dotProd(PB->getNormal()))>
+	  1.0-zeroTol);
+}
+
+const std::vector<Geometry::Vec3D>&
+TripleCache::getPoints(const Surface* APtr,const Surface* BPtr,
+		       const Surface* CPtr)
+  /*!
+    Get the intersection points of three surfaces
+    [calculated on first use]
+    \param APtr :: First surface
+    \param BPtr :: Second surface
+    \param CPtr :: Third surface
+    \return intersection points
+  */
+{
+  int SN[3]={APtr->getName(),BPtr->getName(),CPtr->getName()};
+  std::sort(SN,SN+3);
+  const Triple<int> key(SN[0],SN[1],SN[2]);
+
+  {
+    std::lock_guard<std::mutex> Guard(cacheLock);
+    PTYPE::const_iterator mc=PtCache.find(key);
+    if (mc!=PtCache.end())
+      return mc->second;
+  }
+
+  // calculated outside the lock : first insert is kept
+  std::vector<Geometry::Vec3D> Pts=SurInter::processPoint(APtr,BPtr,CPtr);
+  std::lock_guard<std::mutex> Guard(cacheLock);
+  return PtCache.emplace(key,std::move(Pts)).first->second;
+}
+
+size_t
+TripleCache::size() const
+  /*!
+    Number of triples held
+    \return cache size
+  */
+{
+  std::lock_guard<std::mutex> Guard(cacheLock);
+  return PtCache.size();
+}
+
+void
+TripleCache::clear()
+  /*!
+    Remove all the points [not while in use]
+  */
+{
+  std::lock_guard<std::mutex> Guard(cacheLock);
+  PtCache.clear();
+  return;
+}
+
+} // NAMESPACE Geometry
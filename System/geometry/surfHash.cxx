@@ -0,0 +1,302 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/surfHash.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Quaternion.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Cone.h"
+#include "CylCan.h"
+#include "Cylinder.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Torus.h"
+#include "surfHash.h"
+
+namespace ModelSupport
+{
+
+const double surfHash::binWidth(1e-4);
+
+surfHash::surfHash(const KeyType KT) :
+  keyType(KT),validFlag(0)
+  /*!
+    Constructor
+    \param KT :: Type of equality to key on
+  */
+{}
+
+void
+surfHash::clear()
+  /*!
+    Remove everything [the index is then valid and empty]
+  */
+{
+  HMap.clear();
+  keyMap.clear();
+  pending.clear();
+  validFlag=1;
+  return;
+}
+
+bool
+surfHash::calcKey(const Geometry::Surface* SPtr,
+		  long int& classID,long int& bucket) const
+  /*!
+    Calculate the class id and the value bucket of a surface
+    \param SPtr :: Surface to key
+    \param classID :: Class id [output]
+    \param bucket :: Bucket of the invariant value [output]
+    \return true if the surface type is hashed
+  */
+{
+  double value(0.0);
+  classID=0;
+
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      // opposite planes have D -> -D
+      classID=1;
+      value=std::abs(PPtr->getDistance());
+    }
+  else if (keyType==KeyType::QuadEqual)
+    {
+      // BaseEqn equal or all terms negated
+      const Geometry::Quadratic* QPtr=
+	dynamic_cast<const Geometry::Quadratic*>(SPtr);
+      if (QPtr && !QPtr->copyBaseEqn().empty())
+	{
+	  classID=2;
+	  value=std::abs(QPtr->copyBaseEqn().back());
+	}
+    }
+  else
+    {
+      const Geometry::Cylinder* CPtr;
+      const Geometry::Sphere* SXPtr;
+      const Geometry::Cone* KPtr;
+      const Geometry::Torus* TPtr;
+      const Geometry::CylCan* CCPtr;
+      if ( (CPtr=dynamic_cast<const Geometry::Cylinder*>(SPtr)) )
+	{
+	  classID=2;
+	  value=CPtr->getRadius();
+	}
+      else if ( (SXPtr=dynamic_cast<const Geometry::Sphere*>(SPtr)) )
+	{
+	  classID=3;
+	  value=SXPtr->getRadius();
+	}
+      else if ( (KPtr=dynamic_cast<const Geometry::Cone*>(SPtr)) )
+	{
+	  classID=4;
+	  value=KPtr->getCosAngle();
+	}
+      else if ( (TPtr=dynamic_cast<const Geometry::Torus*>(SPtr)) )
+	{
+	  classID=5;
+	  value=TPtr->getIRad();
+	}
+      else if ( (CCPtr=dynamic_cast<const Geometry::CylCan*>(SPtr)) )
+	{
+	  classID=6;
+	  value=CCPtr->getRadius();
+	}
+    }
+  if (!classID || std::isnan(value)) return 0;
+
+  // very large values share a bucket
+  value=std::min(value,1e10);
+  bucket=static_cast<long int>(std::floor(value/binWidth));
+  return 1;
+}
+
+void
+surfHash::eraseKey(const int SN)
+  /*!
+    Remove a surface from the hash [no surface access]
+    \param SN :: Surface number
+  */
+{
+  KTYPE::iterator kc=keyMap.find(SN);
+  if (kc!=keyMap.end())
+    {
+      std::pair<HTYPE::iterator,HTYPE::iterator> RX=
+	HMap.equal_range(kc->second.first);
+      for(HTYPE::iterator hc=RX.first;hc!=RX.second;hc++)
+	if (hc->second==kc->second.second)
+	  {
+	    HMap.erase(hc);
+	    break;
+	  }
+      keyMap.erase(kc);
+    }
+  return;
+}
+
+void
+surfHash::addSurface(Geometry::Surface* SPtr)
+  /*!
+    Add a surface to the hash. Unhashed types are ignored
+    \param SPtr :: Surface to add
+  */
+{
+  if (!validFlag || !SPtr) return;
+
+  const int SN=SPtr->getName();
+  eraseKey(SN);
+  pending.erase(SN);
+
+  long int classID,bucket;
+  if (calcKey(SPtr,classID,bucket))
+    {
+      const long int index=bucket*8+classID;
+      HMap.insert(HTYPE::value_type(index,SPtr));
+      keyMap.emplace(SN,std::make_pair(index,SPtr));
+    }
+  return;
+}
+
+void
+surfHash::removeSurface(const int SN)
+  /*!
+    Remove a surface. Must be called before the surface is
+    deleted or renamed.
+    \param SN :: Surface number
+  */
+{
+  eraseKey(SN);
+  pending.erase(SN);
+  return;
+}
+
+void
+surfHash::updateSurface(const int SN)
+  /*!
+    Mark a surface to be rekeyed before the next search
+    [used when the surface parameters are set after insertion]
+    \param SN :: Surface number
+  */
+{
+  if (validFlag)
+    pending.insert(SN);
+  return;
+}
+
+void
+surfHash::flush(const SMAP& SMap)
+  /*!
+    Rekey the pending surfaces
+    \param SMap :: Surface map
+  */
+{
+  for(const int SN : pending)
+    {
+      eraseKey(SN);
+      SMAP::const_iterator mc=SMap.find(SN);
+      if (mc!=SMap.end())
+	{
+	  long int classID,bucket;
+	  if (calcKey(mc->second,classID,bucket))
+	    {
+	      const long int index=bucket*8+classID;
+	      HMap.insert(HTYPE::value_type(index,mc->second));
+	      keyMap.emplace(SN,std::make_pair(index,mc->second));
+	    }
+	}
+    }
+  pending.clear();
+  return;
+}
+
+void
+surfHash::build(const SMAP& SMap)
+  /*!
+    Build the hash from a surface map
+    \param SMap :: Surface map
+  */
+{
+  ELog::RegMethod RegA("surfHash","build");
+
+  clear();
+  HMap.reserve(SMap.size());
+  for(const SMAP::value_type& SItem : SMap)
+    addSurface(SItem.second);
+  return;
+}
+
+bool
+surfHash::candidates(const SMAP& SMap,
+		     const Geometry::Surface* SPtr,SMAP& Out)
+  /*!
+    Get the surfaces that may be equal/opposite to SPtr.
+    The surface bucket and its two neighbours are searched
+    since the value may be on a bucket edge.
+    \param SMap :: Surface map [to rebuild/rekey from]
+    \param SPtr :: Surface to find
+    \param Out :: Candidate surfaces [by number]
+    \return true if the surface is hashed [else Out is not set]
+  */
+{
+  long int classID,bucket;
+  if (!calcKey(SPtr,classID,bucket))
+    return 0;
+
+  if (!validFlag)
+    build(SMap);
+  else if (!pending.empty())
+    flush(SMap);
+
+  for(long int i=bucket-1;i<=bucket+1;i++)
+    {
+      std::pair<HTYPE::const_iterator,HTYPE::const_iterator> RX=
+	HMap.equal_range(i*8+classID);
+      for(HTYPE::const_iterator hc=RX.first;hc!=RX.second;hc++)
+	Out.emplace(hc->second->getName(),hc->second);
+    }
+  return 1;
+}
+
+} // NAMESPACE ModelSupport
@@ -26,6 +26,8 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <list>
 #include <stack>
 #include <string>
@@ -65,6 +67,7 @@
 #include "surfEqual.h"
 #include "surfaceFactory.h"
 #include "surfRegister.h"
+#include "surfHash.h"
 #include "surfIndex.h"
 
 #include "Debug.h"
@@ -72,7 +75,8 @@
 namespace ModelSupport
 {
 
-surfIndex::surfIndex() : uniqNum(1)
+surfIndex::surfIndex() :
+  uniqNum(1),HIndex(new surfHash(surfHash::KeyType::TypeEqual))
   /*!
     Constructor
   */
@@ -97,6 +101,7 @@ surfIndex::~surfIndex()
   STYPE::iterator mc;
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
+  delete HIndex;
 }
 
 void
@@ -109,9 +114,34 @@ surfIndex::reset()
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
   SMap.erase(SMap.begin(),SMap.end());
+  HIndex->clear();
   return;
 }
 
+void
+surfIndex::invalidateHash()
+  /*!
+    Force the equal/opposite hash to be rebuilt on next use.
+    Required if the surfaces are changed in place [transforms]
+  */
+{
+  HIndex->setInvalid();
+  return;
+}
+
+bool
+surfIndex::equalCandidates(const Geometry::Surface* SPtr,
+			   STYPE& Out) const
+  /*!
+    Get the surfaces that may be equal/opposite to SPtr
+    \param SPtr :: Surface to find
+    \param Out :: Candidate surfaces [to test with the type operator==]
+    \return true if SPtr is hashed [otherwise all of SMap needs testing]
+  */
+{
+  return HIndex->candidates(SMap,SPtr,Out);
+}
+
 int
 surfIndex::getUniq() 
   /*!
@@ -147,7 +177,10 @@ surfIndex::addSurface(Geometry::Surface* SPtr)
   Geometry::Surface* NewPtr=ModelSupport::equalSurface(SPtr);
   // Now find if we have copy
   if (NewPtr==SPtr)
-    SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+    {
+      SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+      HIndex->addSurface(SPtr);
+    }
   else
     delete SPtr;
 
@@ -188,6 +221,7 @@ surfIndex::insertSurface(Geometry::Surface* SPtr)
     }
 
   SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+  HIndex->addSurface(SPtr);
 
   return;
 }
@@ -205,8 +239,10 @@ surfIndex::findOpposite(const Geometry::Surface* SPtr)  const
     dynamic_cast<const Geometry::Plane*>(SPtr);
   if (PPtr)
     {
+      STYPE Cand;
+      const STYPE& TMap=(equalCandidates(PPtr,Cand)) ? Cand : SMap;
       STYPE::const_iterator mc;
-      for(mc=SMap.begin();mc!=SMap.end();mc++)
+      for(mc=TMap.begin();mc!=TMap.end();mc++)
 	if (ModelSupport::oppositeSurfaces(PPtr,mc->second)) 
 	  return mc->first;
     }
@@ -225,6 +261,7 @@ surfIndex::removeOpposite(const int SN)
   STYPE::iterator sc=SMap.find(SN);
   if (sc!=SMap.end())
     {
+      HIndex->removeSurface(SN);
       delete sc->second;
       SMap.erase(sc);
     }
@@ -251,6 +288,7 @@ surfIndex::removeEqualSurface(const int SNum)
   
   if (NewPtr!=vc->second)
     {
+      HIndex->removeSurface(SNum);
       delete vc->second;
       SMap.erase(vc);
     }
@@ -291,14 +329,18 @@ surfIndex::createSurf(const int surfN)
       outPtr=dynamic_cast<T*>(mp->second);
       if (outPtr)
 	return outPtr;
+      HIndex->removeSurface(surfN);
       delete mp->second;
       outPtr=new T(surfN,0);
       mp->second=outPtr;
+      HIndex->updateSurface(surfN);
       ELog::EM<<"Reasigned exiting surface"<<surfN<<ELog::endWarn;
       return outPtr;
     }
   outPtr=new T(surfN,0);
   SMap.insert(STYPE::value_type(surfN,outPtr));
+  // surface is set by the caller after insertion
+  HIndex->updateSurface(surfN);
   return outPtr;
 }
 
@@ -374,6 +416,7 @@ surfIndex::createSurface(const int SN,const int TN,const std::string& SLine)
       STYPE::iterator mc=SMap.find(SN);
       if (mc!=SMap.end())
         {
+	  HIndex->removeSurface(SN);
 	  delete mc->second;
 	  mc->second=SPtr;
 	}
@@ -381,6 +424,7 @@ surfIndex::createSurface(const int SN,const int TN,const std::string& SLine)
         {
 	  SMap.insert(STYPE::value_type(SN,SPtr));
 	}
+      HIndex->addSurface(SPtr);
     }
   catch (const ColErr::ExBase& A)
     {
@@ -403,6 +447,7 @@ surfIndex::deleteSurface(const int surfN)
   if (mf==SMap.end())
     throw ColErr::InContainerError<int>(surfN,"surfN");
 
+  HIndex->removeSurface(surfN);
   delete mf->second;
   SMap.erase(mf);
 
@@ -454,6 +499,7 @@ surfIndex::renumber(const int origNum,const int newNum)
       return;
     }
   Geometry::Surface* SPtr=mc->second;
+  HIndex->removeSurface(origNum);
   SMap.erase(mc);
   SPtr->setName(newNum);
   insertSurface(SPtr);
@@ -800,21 +846,31 @@ int
 surfIndex::findEqualSurf(const int sBegin,const int sEnd,
 			 std::map<int,Geometry::Surface*>& EQMap) const
   /*!
-    Loop [long] though and find equal surfaces
+    Find equal surfaces. The surfaces tested against each
+    surface are restricted by a hash of the surface map
     \param sBegin :: begining number
     \param sBegin :: end number
     \param EQMap :: Map of equal surfaces
     \return number found
    */
 {
+  ELog::RegMethod RegA("surfIndex","findEqualSurf");
   typedef std::map<int,Geometry::Surface*> EQTYPE;
+
+  surfHash QIndex(surfHash::KeyType::QuadEqual);
+  QIndex.build(SMap);
+
   STYPE::const_iterator mc;
   STYPE::const_iterator nc;
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     {
       if (mc->first>=sBegin && mc->first<sEnd)
 	{
-	  for(nc=SMap.begin();nc!=SMap.end();nc++)
+	  // only planes/quadratics can compare equal
+	  STYPE Cand;
+	  if (!QIndex.candidates(SMap,mc->second,Cand))
+	    continue;
+	  for(nc=Cand.begin();nc!=Cand.end();nc++)
 	    {
 	      if ((nc->first<sBegin || nc->first>mc->first) &&
 		  ModelSupport::cmpSurfaces(mc->second,nc->second))
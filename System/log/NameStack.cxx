@@ -23,28 +23,33 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <algorithm>
 
 #include "NameStack.h"
 
 namespace ELog
 {
 
+const size_t NameStack::maxDepth;
+
 NameStack::NameStack() :
-  extraLevel(0),indentLevel(0)
+  depth(0),extraLevel(0),indentLevel(0)
   /*!
     Constructor
   */
 {}
 
 NameStack::NameStack(const NameStack& A) :
-  key(A.key),Class(A.Class),Method(A.Method),
+  depth(A.depth),Held(A.Held),
   Extra(A.Extra),extraLevel(A.extraLevel),
   indentLevel(A.indentLevel)
   /*!
     Copy Constructor
     \param A :: NameStack to copy
   */
-{}
+{
+  std::copy(A.Items,A.Items+std::min(depth,maxDepth),Items);
+}
 
 NameStack&
 NameStack::operator=(const NameStack& A) 
@@ -56,9 +61,9 @@ NameStack::operator=(const NameStack& A)
 {
   if (this!=&A)
     {
-      key=A.key;
-      Class=A.Class;
-      Method=A.Method;
+      depth=A.depth;
+      std::copy(A.Items,A.Items+std::min(depth,maxDepth),Items);
+      Held=A.Held;
       Extra=A.Extra;
       extraLevel=A.extraLevel;
       indentLevel=A.indentLevel;
@@ -72,26 +77,50 @@ NameStack::clear()
    Clear the stack
  */
 {
-  key.erase(key.begin(),key.end());
-  Class.clear();
-  Method.clear();
+  depth=0;
+  Held.clear();
   Extra.clear();
   extraLevel=0;
   indentLevel=0;
   return;
 }
 
+void
+NameStack::addComp(const char* CN,const char* MN)
+  /*!
+    Adds a component to the class names series.
+    The strings are not copied.
+    \param CN :: Class name [must outlive the item]
+    \param MN :: Method name [must outlive the item]
+  */
+{
+  if (depth<maxDepth)
+    {
+      Items[depth].className=CN;
+      Items[depth].methodName=MN;
+    }
+  depth++;
+  return;
+}
+
 void
 NameStack::addComp(const std::string& CN,
 		   const std::string& MN)
   /*!
     Adds a component to the class names series
+    The strings are copied.
     \param CN :: Class name
     \param MN :: Method name
   */
 {
-  Class.push_back(CN);
-  Method.push_back(MN);
+  if (depth<maxDepth)
+    {
+      Items[depth].className=0;
+      Items[depth].methodName=0;
+      Items[depth].heldIndex=Held.size();
+      Held.push_back(std::pair<std::string,std::string>(CN,MN));
+    }
+  depth++;
   return;
 }
   
@@ -101,15 +130,16 @@ NameStack::popBack()
     Pop back a item
   */
 {
-  if (!Class.empty())
+  if (depth)
     {
-      if (extraLevel==Class.size())
+      if (extraLevel==depth)
 	{
 	  Extra.clear();
 	  extraLevel=0;
 	}
-      Class.pop_back();
-      Method.pop_back();
+      depth--;
+      if (depth<maxDepth && !Items[depth].className)
+	Held.pop_back();
     }
   return;
 }
@@ -122,7 +152,7 @@ NameStack::setExtra(const std::string& A)
    */
 {
   Extra=A;
-  extraLevel=Class.size();
+  extraLevel=depth;
   return;
 }
 
@@ -135,6 +165,22 @@ NameStack::getExtra() const
 {
   return Extra;
 }
+
+std::string
+NameStack::itemName(const size_t Index) const
+  /*!
+    Build the name of an item
+    \param Index :: Item index [< depth]
+    \return Class::Method
+  */
+{
+  if (Index>=maxDepth)
+    return "...";
+  const StackItem& SI(Items[Index]);
+  if (!SI.className)
+    return Held[SI.heldIndex].first+"::"+Held[SI.heldIndex].second;
+  return std::string(SI.className)+"::"+SI.methodName;
+}
   
 std::string
 NameStack::getBase() const 
@@ -143,8 +189,7 @@ NameStack::getBase() const
     \return BaseItem
   */
 {
-  return (Class.empty()) ?  
-    "" : Class.back()+"::"+Method.back();
+  return (!depth) ? "" : itemName(depth-1);
 }
 
 std::string
@@ -156,17 +201,15 @@ NameStack::getItem(const long int Index) const
     \return BaseItem
   */
 {
-  if (Class.empty()) return "";
+  if (!depth) return "";
   if (!Index) 
-    return Class.back()+"::"+Method.back();
+    return itemName(depth-1);
   
-  const size_t CSize=Class.size();
- 
   const size_t itx( (Index<0) 
-		    ? (CSize-static_cast<size_t>(1-Index)) 
+		    ? (depth-static_cast<size_t>(1-Index)) 
 		    : static_cast<size_t>(Index));
 
-  return (itx<CSize) ? Class[itx]+"::"+Method[itx] : "";
+  return (itx<depth) ? itemName(itx) : "";
 } 
 
 std::string
@@ -176,13 +219,12 @@ NameStack::getFull() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
-  std::string Out=*vc+"::"+*ac;
-  for(ac++,vc++;vc!=Class.end();vc++,ac++)
+  if (!depth) return "";
+  std::string Out=itemName(0);
+  for(size_t i=1;i<depth;i++)
     {
       Out+="#";
-      Out+=*vc+"::"+*ac;
+      Out+=itemName(i);
     }
   if (!Extra.empty())
     {
@@ -199,15 +241,14 @@ NameStack::getFullTree() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
+  if (!depth) return "";
   size_t indent(2);
-  std::string Out=*vc+"::"+*ac;
-  for(ac++,vc++;vc!=Class.end();vc++,ac++,indent+=2)
+  std::string Out=itemName(0);
+  for(size_t i=1;i<depth;i++,indent+=2)
     {
       Out+='\n';
       Out+=std::string(indent,' ');
-      Out+=*vc+"::"+*ac;
+      Out+=itemName(i);
     }
   if (!Extra.empty())
     {
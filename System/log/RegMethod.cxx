@@ -33,7 +33,18 @@
 namespace ELog
 {
 
-NameStack RegMethod::Base;
+thread_local NameStack RegMethod::Base;
+
+RegMethod::RegMethod(const char* CN,const char* MN) :
+  indentLevel(0)
+  /*!
+    Constructor add name to stack [no copy/allocation]
+    \param CN :: Class name [literal]
+    \param MN :: Method name [literal]
+  */
+{
+  Base.addComp(CN,MN);
+}
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN) :
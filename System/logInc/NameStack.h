@@ -30,18 +30,38 @@ namespace ELog
     \author S. Ansell
     \version 1.0
     \date June 2009
+
+    Items are held as const char* [string literals] in
+    a fixed size stack so adding/removing an item does not
+    allocate. Names that are not literals are copied to a
+    separate held list. The full names are only built when
+    requested [exception / log output]. Items deeper than
+    maxDepth are counted but not recorded.
   */
 class NameStack
 {
  private:
 
-  std::map<std::string,int> key;        ///< Key names
-  std::vector<std::string> Class;       ///< Class Name
-  std::vector<std::string> Method;      ///< Method Name
+  static const size_t maxDepth=512;     ///< Recorded depth
+
+  /// Single stack item
+  struct StackItem
+  {
+    const char* className;              ///< Class name [0 if held]
+    const char* methodName;             ///< Method name [0 if held]
+    size_t heldIndex;                   ///< Index in Held
+  };
+
+  size_t depth;                         ///< Number of items 
+  StackItem Items[maxDepth];            ///< Stack items
+  /// Copy of names that are not literals [in stack order]
+  std::vector<std::pair<std::string,std::string>> Held;
   std::string Extra;                    ///< Extra tag if neeed
   size_t extraLevel;                    ///< Extra tag if neeed
   long int indentLevel;                 ///< Indent level
 
+  std::string itemName(const size_t) const;
+  
  public:
 
   NameStack();
@@ -55,6 +75,7 @@ class NameStack
   void setExtra(const std::string&);
   /// Remove extra output for exception [early]
   void clearExtra() { Extra.clear(); }
+  void addComp(const char*,const char*);
   void addComp(const std::string&,const std::string&);
   void popBack();
 
@@ -66,7 +87,7 @@ class NameStack
   const std::string& getExtra() const;
 
   /// Access depth of function:
-  size_t getDepth() const { return Class.size(); }
+  size_t getDepth() const { return depth; }
 
   void addIndent(const long int);
   /// Output of the indent level
@@ -33,13 +33,15 @@ namespace ELog
 
     This class is called as a registration class.
     It keeps location etc possible for 
+    exception/log output. The const char* form
+    holds the pointers only and must be given literals.
   */
 
 class RegMethod
 {
  private:
 
-  static NameStack Base;           ///< Singleton of base to register
+  static thread_local NameStack Base;   ///< Call stack [one per thread]
 
   int indentLevel;                 ///< Additional indent
   /// \cond NOWRITTEN
@@ -51,6 +53,7 @@ class RegMethod
 
   /// Access NameStack pointer
   NameStack* getBasePtr() { return &Base; }
+  RegMethod(const char*,const char*);
   RegMethod(const std::string&,const std::string&);
   RegMethod(const std::string&,const std::string&,const int);
   ~RegMethod();
@@ -70,6 +73,25 @@ class RegMethod
 
 };
 
+#ifdef NO_HOTREG
+  /*!
+    \class RegHot
+    \brief Registration of a hot [tracking] path : compiled out
+    \author S. Ansell
+    \date November 2017
+    \version 1.0
+  */
+class RegHot
+{
+ public:
+  /// Constructor [no action]
+  RegHot(const char*,const char*) {}
+};
+#else
+/// Registration of a hot [tracking] path
+typedef RegMethod RegHot;
+#endif
+
 }
 
 #endif
@@ -0,0 +1,234 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/CompExpand.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "CompExpand.h"
+
+namespace MonteCarlo
+{
+
+CompExpand::CompExpand(const std::map<int,Qhull*>& MObj) :
+  MList(MObj)
+  /*!
+    Constructor
+    \param MObj :: Cells to use for the #N references
+  */
+{}
+
+CompExpand::CompExpand(const CompExpand& A) :
+  MList(A.MList),posRule(A.posRule),negRule(A.negRule),
+  activeCells(A.activeCells)
+  /*!
+    Copy constructor
+    \param A :: CompExpand to copy
+  */
+{}
+
+Rule*
+CompExpand::makeBranch(const bool interFlag,Rule* APtr,Rule* BPtr)
+  /*!
+    Join two rules [keeping the leaf order]
+    \param interFlag :: Intersection [true] / Union [false]
+    \param APtr :: First leaf [managed]
+    \param BPtr :: Second leaf [managed]
+    \return new branch
+  */
+{
+  // Note: Intersection(A,B) holds A as the second leaf
+  if (interFlag)
+    return new Intersection(BPtr,APtr);
+  return new Union(APtr,BPtr);
+}
+
+const Rule*
+CompExpand::cellRule(const int cellN,const bool compFlag)
+  /*!
+    Get the expanded rule of a cell [built on first use]
+    \param cellN :: Cell number
+    \param compFlag :: Return the complement of the cell
+    \return Rule without cell references
+  */
+{
+  ELog::RegMethod RegA("CompExpand","cellRule");
+
+  RTYPE& RMap=(compFlag) ? negRule : posRule;
+  RTYPE::const_iterator mc=RMap.find(cellN);
+  if (mc!=RMap.end())
+    return mc->second.getTopRule();
+
+  std::unique_ptr<Rule> RPtr;
+  if (compFlag)
+    {
+      // expanded rule has no cell references left
+      RPtr.reset(expandRule(cellRule(cellN,0),1));
+    }
+  else
+    {
+      std::map<int,Qhull*>::const_iterator vc=MList.find(cellN);
+      if (vc==MList.end() || !vc->second->topRule())
+	throw ColErr::InContainerError<int>
+	  (cellN,"CompExpand unknown complementary unit");
+      if (!activeCells.insert(cellN).second)
+	throw ColErr::InContainerError<int>
+	  (cellN,"CompExpand cyclic complementary unit");
+      RPtr.reset(expandRule(vc->second->topRule(),0));
+      activeCells.erase(cellN);
+    }
+
+  mc=RMap.emplace(cellN,HeadRule(RPtr.get())).first;
+  return mc->second.getTopRule();
+}
+
+Rule*
+CompExpand::expandRule(const Rule* RPtr,const bool compFlag)
+  /*!
+    Copy a rule with the cell references replaced
+    \param RPtr :: Rule to expand
+    \param compFlag :: Take the complement [De Morgan]
+    \return new Rule
+  */
+{
+  ELog::RegMethod RegA("CompExpand","expandRule");
+
+  if (!RPtr) return 0;
+
+  const int typeN=RPtr->type();
+  if (typeN)
+    {
+      std::unique_ptr<Rule> APtr(expandRule(RPtr->leaf(0),compFlag));
+      Rule* BPtr=expandRule(RPtr->leaf(1),compFlag);
+      return makeBranch((typeN==1)!=compFlag,APtr.release(),BPtr);
+    }
+
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      SurfPoint* OutPtr=SPtr->clone();
+      if (compFlag)
+	OutPtr->setKeyN(-SPtr->getSignKeyN());
+      return OutPtr;
+    }
+
+  const CompObj* CPtr=dynamic_cast<const CompObj*>(RPtr);
+  if (CPtr)
+    return cellRule(CPtr->getObjN(),!compFlag)->clone();
+
+  const ContObj* COPtr=dynamic_cast<const ContObj*>(RPtr);
+  if (COPtr)
+    return cellRule(COPtr->getObjN(),compFlag)->clone();
+
+  if (dynamic_cast<const CompGrp*>(RPtr))
+    return expandRule(RPtr->leaf(0),!compFlag);
+  if (dynamic_cast<const ContGrp*>(RPtr))
+    return expandRule(RPtr->leaf(0),compFlag);
+
+  const BoolValue* BVPtr=dynamic_cast<const BoolValue*>(RPtr);
+  if (BVPtr)
+    {
+      if (compFlag)
+	return new BoolValue(BVPtr->isValid(std::map<int,int>()) ? 0 : 1);
+      return BVPtr->clone();
+    }
+
+  throw ColErr::ExBase(0,"CompExpand unknown rule type:"+RPtr->display());
+}
+
+HeadRule
+CompExpand::expandCell(const Qhull& QH,const bool compFlag)
+  /*!
+    Expand the rule of a cell
+    \param QH :: Cell to expand
+    \param compFlag :: Take the complement
+    \return rule without cell references
+  */
+{
+  ELog::RegMethod RegA("CompExpand","expandCell");
+
+  if (!QH.topRule())
+    return HeadRule();
+
+  // a cell may not refer to itself
+  const bool addFlag=activeCells.insert(QH.getName()).second;
+  std::unique_ptr<Rule> RPtr;
+  try
+    {
+      RPtr.reset(expandRule(QH.topRule(),compFlag));
+    }
+  catch(...)
+    {
+      if (addFlag) activeCells.erase(QH.getName());
+      throw;
+    }
+  if (addFlag) activeCells.erase(QH.getName());
+  return HeadRule(RPtr.get());
+}
+
+HeadRule
+CompExpand::expand(const Qhull& QH)
+  /*!
+    Remove the complements from a cell rule
+    \param QH :: Cell to expand
+    \return rule without cell references
+  */
+{
+  return expandCell(QH,0);
+}
+
+HeadRule
+CompExpand::complement(const Qhull& QH)
+  /*!
+    Build the complement of a cell rule
+    \param QH :: Cell to expand
+    \return complement rule without cell references
+  */
+{
+  return expandCell(QH,1);
+}
+
+} // NAMESPACE MonteCarlo
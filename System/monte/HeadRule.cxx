@@ -45,10 +45,16 @@
 #include "BaseModVisit.h"
 #include "support.h"
 #include "stringCombine.h"
+#include "NumberMap.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
 #include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Cylinder.h"
+#include "Sphere.h"
+#include "BoundBox.h"
 #include "surfIndex.h"
 #include "BnId.h"
 #include "Acomp.h"
@@ -637,6 +643,165 @@ HeadRule::pairValid(const int S,const Geometry::Vec3D& Pt)const
   return (HeadNode) ? HeadNode->pairValid(S,Pt) : 0;
 }
 
+Geometry::BoundBox
+HeadRule::surfBox(const SurfPoint* SPtr)
+  /*!
+    Calculate a conservative box for the valid side of 
+    a single surface. Only axis aligned planes, cylinders
+    and spheres give a bound. Everything else is unbounded.
+    \param SPtr :: Surface point
+    \return box [unbounded if not known]
+  */
+{
+  Geometry::BoundBox Out;
+  const Geometry::Surface* SurfPtr=SPtr->getKey();
+  if (!SurfPtr) return Out;
+  const int sign=SPtr->getSign();
+
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SurfPtr);
+  if (PPtr)
+    {
+      // valid : sign*(N.x - D) >= 0
+      const Geometry::Vec3D& N=PPtr->getNormal();
+      const size_t index=N.principleDir();
+      if (std::abs(std::abs(N[index])-1.0)<Geometry::zeroTol)
+	{
+	  const double D=PPtr->getDistance()/N[index];
+	  if (N[index]*sign>0)
+	    Out.setLow(index,D);
+	  else
+	    Out.setHigh(index,D);
+	}
+      return Out;
+    }
+  // Only the inside of cylinders/spheres is bounded 
+  if (sign>0) return Out;
+
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SurfPtr);
+  if (CPtr)
+    {
+      const Geometry::Vec3D& C=CPtr->getCentre();
+      const Geometry::Vec3D& N=CPtr->getNormal();
+      const double R=CPtr->getRadius();
+      for(size_t i=0;i<3;i++)
+	if (std::abs(N[i])<Geometry::zeroTol)
+	  {
+	    Out.setLow(i,C[i]-R);
+	    Out.setHigh(i,C[i]+R);
+	  }
+      return Out;
+    }
+
+  const Geometry::Sphere* SphPtr=
+    dynamic_cast<const Geometry::Sphere*>(SurfPtr);
+  if (SphPtr)
+    {
+      const Geometry::Vec3D& C=SphPtr->getCentre();
+      const double R=SphPtr->getRadius();
+      const Geometry::Vec3D RVec(R,R,R);
+      return Geometry::BoundBox(C-RVec,C+RVec);
+    }
+  return Out;
+}
+
+Geometry::BoundBox
+HeadRule::ruleBox(const Rule* RPtr)
+  /*!
+    Recursive calculation of a conservative bounding box
+    of a rule. Intersection chains are flattened so that
+    general planes can clip the box found from the 
+    bounded components.
+    \param RPtr :: Rule to process
+    \return box [unbounded if not known]
+  */
+{
+  if (!RPtr) return Geometry::BoundBox();
+
+  if (RPtr->type()==-1)    // Union
+    {
+      Geometry::BoundBox Out=ruleBox(RPtr->leaf(0));
+      Out.unite(ruleBox(RPtr->leaf(1)));
+      return Out;
+    }
+  if (RPtr->type()==1)     // Intersection : flatten
+    {
+      Geometry::BoundBox Out;
+      std::vector<const SurfPoint*> genPlanes;
+      std::stack<const Rule*> TreeLine;
+      TreeLine.push(RPtr);
+      while(!TreeLine.empty())
+	{
+	  const Rule* tmpA=TreeLine.top();
+	  TreeLine.pop();
+	  if (!tmpA) continue;
+	  if (tmpA->type()==1)
+	    {
+	      TreeLine.push(tmpA->leaf(0));
+	      TreeLine.push(tmpA->leaf(1));
+	    }
+	  else
+	    {
+	      Out.intersect(ruleBox(tmpA));
+	      const SurfPoint* SP=dynamic_cast<const SurfPoint*>(tmpA);
+	      if (SP && dynamic_cast<const Geometry::Plane*>(SP->getKey()))
+		genPlanes.push_back(SP);
+	    }
+	}
+      // Clip by the general planes: interval propagation over
+      // the half-space n.x >= d [two passes to propagate]
+      for(size_t pass=0;pass<2 && !Out.isEmpty();pass++)
+	for(const SurfPoint* SP : genPlanes)
+	  {
+	    const Geometry::Plane* PPtr=
+	      dynamic_cast<const Geometry::Plane*>(SP->getKey());
+	    const Geometry::Vec3D N=PPtr->getNormal()*SP->getSign();
+	    const double D=PPtr->getDistance()*SP->getSign();
+	    for(size_t i=0;i<3;i++)
+	      {
+		if (std::abs(N[i])<Geometry::zeroTol) continue;
+		const size_t jA((i+1) % 3);
+		const size_t jB((i+2) % 3);
+		if (!Out.isBounded(jA) || !Out.isBounded(jB)) continue;
+		const double maxRest=
+		  N[jA]*((N[jA]>0.0) ? Out.getHigh()[jA] : Out.getLow()[jA])+
+		  N[jB]*((N[jB]>0.0) ? Out.getHigh()[jB] : Out.getLow()[jB]);
+		const double V=(D-maxRest)/N[i];
+		if (N[i]>0.0 && V>Out.getLow()[i])
+		  Out.setLow(i,V);
+		else if (N[i]<0.0 && V<Out.getHigh()[i])
+		  Out.setHigh(i,V);
+	      }
+	  }
+      return Out;
+    }
+
+  const SurfPoint* SP=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SP)
+    return surfBox(SP);
+
+  // Complements/containers/booleans : unknown
+  return Geometry::BoundBox();
+}
+
+Geometry::BoundBox
+HeadRule::calcBoundBox() const
+  /*!
+    Calculate a conservative axis aligned box that contains
+    all the valid points of the rule. Surfaces must be 
+    populated. The box is grown by shiftTol to allow for 
+    points on the surface.
+    \return bounding box [unbounded sides at +/-infLimit]
+  */
+{
+  ELog::RegMethod RegA("HeadRule","calcBoundBox");
+
+  Geometry::BoundBox Out=ruleBox(HeadNode);
+  Out.grow(Geometry::shiftTol);
+  return Out;
+}
+
 void
 HeadRule::isolateSurfNum(const std::set<int>& SN) 
   /*!
@@ -1406,6 +1571,49 @@ HeadRule::substituteSurf(const int SurfN,const int newSurfN,
   return cnt;
 }
 
+int
+HeadRule::renumberSurfaces(const MapSupport::NumberMap& SMap)
+  /*!
+    Renumber all the surfaces in one pass of the tree. 
+    The surface objects are unchanged [only the numbers]
+    \param SMap :: Map of old : new surface numbers
+    \returns number of substitutions
+  */
+{
+  ELog::RegMethod RegA("HeadRule","renumberSurfaces");
+
+  if (!HeadNode || SMap.empty()) return 0;
+  int cnt(0);
+  std::stack<Rule*> TreeLine;
+  TreeLine.push(HeadNode);
+  while(!TreeLine.empty())
+    {
+      Rule* RPtr=TreeLine.top();
+      TreeLine.pop();
+      SurfPoint* SPtr=dynamic_cast<SurfPoint*>(RPtr);
+      if (SPtr)
+	{
+	  const int newN=SMap.find(SPtr->getKeyN());
+	  if (newN)
+	    {
+	      SPtr->setKeyN(SPtr->getSign()*newN);
+	      cnt++;
+	    }
+	}
+      else
+	{
+	  // single leaf rules return the same leaf for 0/1
+	  Rule* LA=RPtr->leaf(0);
+	  Rule* LB=RPtr->leaf(1);
+	  if (LA)
+	    TreeLine.push(LA);
+	  if (LB && LB!=LA)
+	    TreeLine.push(LB);
+	}
+    }
+  return cnt;
+}
+
 void
 HeadRule::makeComplement()
   /*!
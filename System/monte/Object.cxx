@@ -34,6 +34,7 @@
 #include <sstream>
 #include <algorithm>
 #include <memory>
+#include <atomic>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -43,19 +44,24 @@
 #include "OutputLog.h"
 #include "support.h"
 #include "stringCombine.h"
+#include "NumberMap.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Transform.h"
 #include "Track.h"
 #include "Line.h"
 #include "LineIntersectVisit.h"
 #include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
 #include "surfIndex.h"
 #include "Rules.h"
 #include "HeadRule.h"
+#include "RuleProgram.h"
 #include "Token.h"
 #include "neutron.h"
 #include "RuleCheck.h"
@@ -67,6 +73,12 @@
 namespace MonteCarlo
 {
 
+namespace
+{
+  /// Number of rule changes of all the objects
+  std::atomic<size_t> ruleCount(0);
+}
+
 std::ostream&
 operator<<(std::ostream& OX,const Object& A)
 /*!
@@ -161,10 +173,32 @@ Object::startLine(const std::string& Line)
   return 0;         
 }
 
+size_t
+Object::getRuleChange()
+  /*!
+    Access the number of rule changes of all objects.
+    Allows a cache of the cell geometry [e.g. the cell 
+    bounding boxes] to check if any cell has changed.
+    \return change count
+  */
+{
+  return ruleCount;
+}
+
+void
+Object::ruleChanged()
+  /*!
+    Record a change of HRule
+  */
+{
+  ruleIndex= ++ruleCount;
+  return;
+}
+
 Object::Object() :
   ObjName(0),listNum(-1),Tmp(300),MatN(-1),fill(0),trcl(0),
-  universe(0),imp(1),density(0.0),placehold(0),populated(0),
-  objSurfValid(0)
+  universe(0),lattice(0),imp(1),density(0.0),placehold(0),populated(0),
+  ruleIndex(0),ProgRule(0),objSurfValid(0)
  /*!
    Defaut constuctor, set temperature to 300C and material to vacuum
  */
@@ -173,8 +207,8 @@ Object::Object() :
 Object::Object(const int N,const int M,const double T,
 	       const std::string& Line) :
   ObjName(N),listNum(-1),Tmp(T),MatN(M),fill(0),trcl(0),
-  universe(0),imp(1),density(0.0),placehold(0),
-  populated(0),objSurfValid(0)
+  universe(0),lattice(0),imp(1),density(0.0),placehold(0),
+  populated(0),ruleIndex(0),ProgRule(0),objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -186,11 +220,28 @@ Object::Object(const int N,const int M,const double T,
   HRule.procString(Line);
 }
 
+Object::Object(const int N,const int M,const double T,
+	       const HeadRule& HR) :
+  ObjName(N),listNum(-1),Tmp(T),MatN(M),fill(0),trcl(0),
+  universe(0),lattice(0),imp(1),density(0.0),placehold(0),
+  populated(0),ruleIndex(0),HRule(HR),ProgRule(0),objSurfValid(0)
+ /*!
+   Constuctor from a built rule
+   \param N :: number
+   \param M :: material
+   \param T :: temperature (K)
+   \param HR :: Rule of the cell
+ */
+{}
+
 Object::Object(const Object& A) :
   ObjName(A.ObjName),listNum(A.listNum),Tmp(A.Tmp),MatN(A.MatN),
-  fill(A.fill),trcl(A.trcl),universe(A.universe),imp(A.imp),
+  fill(A.fill),trcl(A.trcl),universe(A.universe),lattice(A.lattice),
+  latSize(A.latSize),latFill(A.latFill),latAxis(A.latAxis),imp(A.imp),
   density(A.density),placehold(A.placehold),populated(A.populated),
-  HRule(A.HRule),objSurfValid(0),SurList(A.SurList),SurSet(A.SurSet)
+  ruleIndex(A.ruleIndex),HRule(A.HRule),
+  ProgRule((A.ProgRule) ? new RuleProgram(*A.ProgRule) : 0),
+  objSurfValid(0),SurList(A.SurList),SurSet(A.SurSet)
   /*!
     Copy constructor
     \param A :: Object to copy
@@ -214,11 +265,18 @@ Object::operator=(const Object& A)
       fill=A.fill;
       trcl=A.trcl;
       universe=A.universe;
+      lattice=A.lattice;
+      latSize=A.latSize;
+      latFill=A.latFill;
+      latAxis=A.latAxis;
       imp=A.imp;
       density=A.density;
       placehold=A.placehold;
       populated=A.populated;
       HRule=A.HRule;
+      ruleChanged();
+      delete ProgRule;
+      ProgRule=(A.ProgRule) ? new RuleProgram(*A.ProgRule) : 0;
       objSurfValid=0;
       SurList=A.SurList;
       SurSet=A.SurSet;
@@ -230,7 +288,9 @@ Object::~Object()
   /*!
     Delete operator : removes Object tree
   */
-{}
+{
+  delete ProgRule;
+}
 
 Object*
 Object::clone() const 
@@ -287,6 +347,8 @@ Object::complementaryObject(const int Cnum,std::string& Ln)
   density=0.0;
   if (!HRule.procString(Part))
     throw ColErr::ExBase(0,RegA.getFull()+"\n"+Part);
+  ruleChanged();
+  compileRule();
 
   SurList.clear();
   SurSet.erase(SurSet.begin(),SurSet.end());
@@ -392,6 +454,8 @@ Object::setObject(std::string Ln)
   populated=0;
   if (HRule.procString(Ln))     // this currently does not fail:
     {
+      ruleChanged();
+      compileRule();
       SurList.clear();
       SurSet.erase(SurSet.begin(),SurSet.end());
       objSurfValid=0;
@@ -412,7 +476,68 @@ Object::procString(const std::string& cellStr)
    */
 {
   populated=0;
-  return HRule.procString(cellStr);
+  const int flag=HRule.procString(cellStr);
+  ruleChanged();
+  compileRule();
+  return flag;
+}
+
+int
+Object::procHeadRule(const HeadRule& AHead)
+  /*!
+    Set the cell rule directly [as procString]
+    \param AHead :: Rule of the cell
+    \return 1 on success / 0 on an empty rule
+   */
+{
+  populated=0;
+  HRule=AHead;
+  ruleChanged();
+  compileRule();
+  return (HRule.hasRule()) ? 1 : 0;
+}
+
+void
+Object::setLattice(const int latType,const size_t ASize,
+		   const size_t BSize,const size_t CSize,
+		   const std::vector<int>& FillUniv)
+  /*!
+    Set the cell as a lattice with a fill array 
+    \param latType :: Lattice type [1 hexahedra : 2 hexagonal prism]
+    \param ASize :: Number of elements in the first index 
+    \param BSize :: Number of elements in the second index 
+    \param CSize :: Number of elements in the third index 
+    \param FillUniv :: Universe of each element [first index fastest]
+   */
+{
+  ELog::RegMethod RegA("Object","setLattice");
+
+  if (latType<1 || latType>2)
+    throw ColErr::RangeError<int>(latType,1,2,"lattice type");
+  if (FillUniv.size()!=ASize*BSize*CSize)
+    throw ColErr::MisMatch<size_t>(FillUniv.size(),ASize*BSize*CSize,
+				   "FillUniv/lattice size");
+  lattice=latType;
+  latSize={ASize,BSize,CSize};
+  latFill=FillUniv;
+  return;
+}
+
+void
+Object::setLatticeAxis(const Geometry::Vec3D& AAxis,
+		       const Geometry::Vec3D& BAxis,
+		       const Geometry::Vec3D& CAxis)
+  /*!
+    Set the directions of increasing lattice index. The 
+    faces of element [0,0,0] are then written in the 
+    order +i,-i,+j,-j,+k,-k whatever the order of the rule.
+    \param AAxis :: Direction of +i
+    \param BAxis :: Direction of +j
+    \param CAxis :: Direction of +k
+   */
+{
+  latAxis={AAxis.unit(),BAxis.unit(),CAxis.unit()};
+  return;
 }
 
 int
@@ -440,6 +565,8 @@ Object::setObject(const int N,const int matNum,
 
   if (HRule.procString(cx.str()))     // this currently does not fail:
     {
+      ruleChanged();
+      compileRule();
       SurList.clear();
       SurSet.erase(SurSet.begin(),SurSet.end());
       objSurfValid=0;
@@ -467,10 +594,34 @@ Object::populate()
     {
       HRule.populateSurf();
       populated=1;
+      compileRule();
     }
   return 0;
 }
 
+void
+Object::compileRule()
+  /*!
+    Build the flat program of HRule used by the 
+    point tests. Only done for populated objects
+    as the program holds the surface pointers. 
+    If the rule cannot be compiled the tree is used.
+  */
+{
+  delete ProgRule;
+  ProgRule=0;
+  if (populated)
+    {
+      ProgRule=new RuleProgram();
+      if (!ProgRule->build(HRule.getTopRule()))
+	{
+	  delete ProgRule;
+	  ProgRule=0;
+	}
+    }
+  return;
+}
+
 int
 Object::addSurfString(const std::string& XE)
   /*!
@@ -496,6 +647,33 @@ Object::addSurfString(const std::string& XE)
 }
 
 
+void
+Object::addIntersection(const HeadRule& AHead)
+  /*!
+    Intersect a rule with the object. Unlike addSurfString 
+    the rule is inserted directly into the tree so the cost
+    is proportional to the added rule and not the cell.
+    The object is left unpopulated [as addSurfString] 
+    so the surface list and the compiled rule are 
+    rebuilt once by the next populate/createSurfaceList.
+    \param AHead :: Rule to intersect with the cell
+  */
+{
+  ELog::RegMethod RegA("Object","addIntersection");
+
+  if (!AHead.hasRule()) return;
+  HRule.addIntersection(AHead);
+  ruleChanged();
+
+  populated=0;
+  objSurfValid=0;
+  delete ProgRule;
+  ProgRule=0;
+  SurList.clear();
+  SurSet.erase(SurSet.begin(),SurSet.end());
+  return;
+}
+
 int
 Object::isOnSide(const Geometry::Vec3D& Pt) const
   /*!
@@ -606,7 +784,7 @@ Object::isValid(const Geometry::Vec3D& Pt) const
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isValid(Pt);
+  return (ProgRule) ? ProgRule->isValid(Pt) : HRule.isValid(Pt);
 }
 
 int
@@ -620,7 +798,7 @@ Object::isValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isValid(Pt,ExSN);
+  return (ProgRule) ? ProgRule->isValid(Pt,ExSN) : HRule.isValid(Pt,ExSN);
 }
 
 int
@@ -634,7 +812,8 @@ Object::isDirectionValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isDirectionValid(Pt,ExSN);
+  return (ProgRule) ? ProgRule->isDirectionValid(Pt,ExSN) :
+    HRule.isDirectionValid(Pt,ExSN);
 }
 
 
@@ -649,7 +828,7 @@ Object::isValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isValid(Pt,ExSN);
+  return (ProgRule) ? ProgRule->isValid(Pt,ExSN) : HRule.isValid(Pt,ExSN);
 }
 
 int
@@ -683,6 +862,18 @@ Object::mapValid(const Geometry::Vec3D& Pt) const
   return SMap;
 }
 
+Geometry::BoundBox
+Object::calcBoundBox() const
+  /*!
+    Calculate a conservative axis aligned box of the 
+    object. The object needs to be populated for any
+    bound to be found.
+    \return Bounding box [unbounded if not known]
+  */
+{
+  return HRule.calcBoundBox();
+}
+
 int
 Object::pairValid(const int SN,const Geometry::Vec3D& Pt) const
   /*!
@@ -698,7 +889,7 @@ Object::pairValid(const int SN,const Geometry::Vec3D& Pt) const
     \retval 3 : valid [SN true/false]
   */
 {
-  return HRule.pairValid(SN,Pt);
+  return (ProgRule) ? ProgRule->pairValid(SN,Pt) : HRule.pairValid(SN,Pt);
 }
 
 int
@@ -839,6 +1030,8 @@ Object::removeSurface(const int SurfN)
   const int cnt=HRule.removeItems(SurfN);
   if (cnt>0)
     {
+      ruleChanged();
+      compileRule();
       createSurfaceList();
       objSurfValid=0;
     }
@@ -863,6 +1056,29 @@ Object::substituteSurf(const int SurfN,const int NsurfN,
     SPtr=ModelSupport::surfIndex::Instance().getSurf(abs(NsurfN));
   
   const int out=HRule.substituteSurf(SurfN,NsurfN,SPtr);
+  if ( out )
+    {
+      ruleChanged();
+      populated=0;
+      populate();
+      createSurfaceList();
+    }
+  return out;
+}
+
+int
+Object::renumberSurfaces(const MapSupport::NumberMap& SMap)
+  /*! 
+    Renumber all the surfaces in the cell and re-build
+    the surface lists once. The surface objects are 
+    the same [only renumbered]
+    \param SMap :: Map of old : new surface numbers
+    \return number of surfaces substituted
+  */
+{ 
+  ELog::RegMethod RegA("Object","renumberSurfaces");
+
+  const int out=HRule.renumberSurfaces(SMap);
   if ( out )
     {
       populated=0;
@@ -884,7 +1100,7 @@ Object::hasIntercept(const Geometry::Vec3D& IP,
     \return True(1)  / Fail(0)
   */
 {
-  ELog::RegMethod RegA("Object","hadIntercept");
+  ELog::RegHot RegA("Object","hadIntercept");
 
   MonteCarlo::LineIntersectVisit LI(IP,UV);
   std::vector<const Geometry::Surface*>::const_iterator vc;
@@ -915,7 +1131,7 @@ Object::forwardIntercept(const Geometry::Vec3D& IP,
     \return surface + distance forward : -ve on failure
   */
 {
-  ELog::RegMethod RegA("Object","forwardIntercept");
+  ELog::RegHot RegA("Object","forwardIntercept");
   
 
   MonteCarlo::LineIntersectVisit LI(IP,UV);
@@ -1016,7 +1232,7 @@ Object::trackCell(const MonteCarlo::neutron& N,double& D,
     \return surface number of intercept
    */
 {
-  ELog::RegMethod RegA("Object","trackCell[D,dir]");
+  ELog::RegHot RegA("Object","trackCell[D,dir]");
 
   MonteCarlo::LineIntersectVisit LI(N);
   for(const Geometry::Surface* isptr : SurList)
@@ -1080,7 +1296,7 @@ Object::forwardInterceptInit(const Geometry::Vec3D& IP,
     \return distance forward : -ve on failure
   */
 {
-  ELog::RegMethod RegA("Object","forwardInterceptInit");
+  ELog::RegHot RegA("Object","forwardInterceptInit");
   
   MonteCarlo::LineIntersectVisit LI(IP,UV);
   std::vector<const Geometry::Surface*>::const_iterator vc;
@@ -1134,6 +1350,8 @@ Object::makeComplement()
    */
 {
   HRule.makeComplement();
+  ruleChanged();
+  compileRule();
   return;
 }
 
@@ -1209,10 +1427,78 @@ Object::str() const
       cx<<"0 ";
     }
   
-  cx<<" "<<HRule.display();
+  if (lattice && !latAxis.empty())
+    cx<<" "<<latticeStr();
+  else
+    cx<<" "<<HRule.display();
+  return cx.str();
+}
+
+std::string
+Object::latticeStr() const
+  /*!
+    Write the planes of a lattice element in index order 
+    [+i,-i,+j,-j,+k,-k]. Anything that is not an 
+    intersection of six planes [one pair per axis] 
+    is written as the rule.
+    \return Ordered element faces
+  */
+{
+  const Rule* TopRule=HRule.getTopRule();
+  if (!TopRule || TopRule->type()!=1)
+    return HRule.display();
+  const std::vector<const Rule*> Items=HRule.findTopNodes();
+  if (Items.size()!=6)
+    return HRule.display();
+
+  std::vector<std::string> Faces(6);
+  for(const Rule* RPtr : Items)
+    {
+      const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+      const Geometry::Plane* PPtr=(SPtr) ?
+	dynamic_cast<const Geometry::Plane*>(SPtr->getKey()) : 0;
+      if (!PPtr)
+	return HRule.display();
+
+      // valid side is sign*(N.x-D)>=0 : outward normal is -sign*N
+      const Geometry::Vec3D Out=PPtr->getNormal()*(-SPtr->getSign());
+      size_t index(0);
+      for(size_t i=1;i<3;i++)
+	if (std::abs(Out.dotProd(latAxis[i]))>
+	    std::abs(Out.dotProd(latAxis[index])))
+	  index=i;
+      index=2*index+((Out.dotProd(latAxis[index])>0.0) ? 0 : 1);
+      if (!Faces[index].empty())
+	return HRule.display();
+      Faces[index]=SPtr->display();
+    }
+
+  std::ostringstream cx;
+  cx<<Faces[0];
+  for(size_t i=1;i<Faces.size();i++)
+    cx<<" "<<Faces[i];
   return cx.str();
 }
 
+void
+Object::writeLattice(std::ostream& OX) const
+  /*!
+    Write the lattice type and the fill array 
+    [same form for MCNP and PHITS]
+    \param OX :: Output stream
+   */
+{
+  if (lattice)
+    {
+      OX<<" lat="<<lattice<<" fill=0:"<<latSize[0]-1;
+      for(size_t i=1;i<latSize.size();i++)
+	OX<<" 0:"<<latSize[i]-1;
+      for(const int U : latFill)
+	OX<<" "<<U;
+    }
+  return;
+}
+
 void 
 Object::write(std::ostream& OX) const
   /*!
@@ -1232,6 +1518,7 @@ Object::write(std::ostream& OX) const
     cx<<" "<<"trcl="<<trcl;
   if (universe)
     cx<<" "<<"u="<<universe;
+  writeLattice(cx);
 
   if (placehold)
     StrFunc::writeMCNPXcomment(cx.str(),OX);
@@ -1247,17 +1534,27 @@ Object::writeFLUKAmat(std::ostream& OX) const
     in standard FLUKA output format.
     \param OX :: Output stream (required for multiple std::endl)
   */
+{
+  const ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
+  writeFLUKAmat(OX,OR.inRenumberRange(ObjName));
+  return;
+}
+
+void
+Object::writeFLUKAmat(std::ostream& OX,const std::string& regName) const
+  /*!
+    Write the object material assignment to a standard stream
+    in standard FLUKA output format.
+    \param OX :: Output stream (required for multiple std::endl)
+    \param regName :: Registered object name of the cell [empty : global]
+  */
 {
   ELog::RegMethod RegA("Object","writeFLUKAmat");
 
-  
-  ModelSupport::objectRegister& OR=
-    ModelSupport::objectRegister::Instance();
   if (!placehold)
     {
-      std::string objName=OR.inRenumberRange(ObjName);
-      if (objName.empty())
-	objName="global";
+      const std::string objName=(regName.empty()) ? "global" : regName;
       std::ostringstream cx;
       cx<<"ASSIGNMA    ";
       if (!MatN)
@@ -1279,16 +1576,27 @@ Object::writeFLUKA(std::ostream& OX) const
     in standard FLUKA output format.
     \param OX :: Output stream (required for multiple std::endl)
   */
+{
+  const ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
+  writeFLUKA(OX,OR.inRenumberRange(ObjName));
+  return;
+}
+
+void 
+Object::writeFLUKA(std::ostream& OX,const std::string& regName) const
+  /*!
+    Write the object to a standard stream
+    in standard FLUKA output format.
+    \param OX :: Output stream (required for multiple std::endl)
+    \param regName :: Registered object name of the cell [empty : global]
+  */
 {
   ELog::RegMethod RegA("Object","writeFLUKA");
 
-  ModelSupport::objectRegister& OR=
-    ModelSupport::objectRegister::Instance();
   if (!placehold)
     {
-      std::string objName=OR.inRenumberRange(ObjName);
-      if (objName.empty())
-	objName="global";
+      const std::string objName=(regName.empty()) ? "global" : regName;
       std::ostringstream cx;
       cx.precision(10);
 
@@ -1378,6 +1686,7 @@ Object::writePHITS(std::ostream& OX) const
     cx<<" "<<"trcl="<<trcl;
   if (universe)
     cx<<" "<<"u="<<universe;
+  writeLattice(cx);
 
   if (placehold)
     StrFunc::writeMCNPXcomment(cx.str(),OX);
@@ -3,7 +3,7 @@
  
  * File:   monte/Qhull.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,6 +33,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -46,11 +47,13 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "Triple.h"
 #include "Quaternion.h"
 #include "localRotate.h"
 #include "masterRotate.h"
 #include "OutputLog.h"
 #include "Transform.h"
+#include "BoundBox.h"
 #include "Surface.h"
 #include "Rules.h"
 #include "HeadRule.h"
@@ -58,6 +61,7 @@
 #include "SurfVertex.h"
 #include "Line.h"
 #include "SurInter.h"
+#include "TripleCache.h"
 #include "Qhull.h"
 
 namespace MonteCarlo
@@ -81,6 +85,18 @@ Qhull::Qhull(const int N,const int M,
   */
 {}
 
+Qhull::Qhull(const int N,const int M,
+	     const double T,const HeadRule& HR) :
+  Object(N,M,T,HR)
+  /*!
+    Constuctor, sets number/material and temperature 
+   \param N :: number
+   \param M :: material
+   \param T :: temperature
+   \param HR :: Rule of the cell
+  */
+{}
+
 Qhull::Qhull(const Qhull& A) : Object(A),
   VList(A.VList),CofM(A.CofM)
   /*!
@@ -130,35 +146,62 @@ Qhull::calcIntersections()
     intersection
     \return number of items intersection points.
   */
+{
+  Geometry::TripleCache TCache;
+  return calcIntersections(TCache);
+}
+
+int
+Qhull::calcIntersections(Geometry::TripleCache& TCache)
+  /*! 
+    Loops over all the surfaces and calculates the appropiate
+    intersection. Planes that miss the cell box and 
+    parallel plane pairs are skipped.
+    \param TCache :: Shared intersection points of the triples
+    \return number of items intersection points.
+  */
 {
   ELog::RegMethod RegA("Qhull","calcIntersections");
 
   VList.clear();                       // clear list of Vertex
-  std::vector<const Geometry::Surface*>::const_iterator ic,jc,kc;
+
+  // a vertex is in the cell box [small guard for the side test]
+  Geometry::BoundBox Box(calcBoundBox());
+  Box.grow(1e-5);
+  std::vector<const Geometry::Surface*> SVec;
+  for(const Geometry::Surface* SPtr : SurList)
+    if (Geometry::TripleCache::cutsBox(SPtr,Box))
+      SVec.push_back(SPtr);
+
   int cnt(0);
-  for(ic=SurList.begin();ic!=SurList.end();ic++)
-    for(jc=ic+1;jc!=SurList.end();jc++)
-      for(kc=jc+1;kc!=SurList.end();kc++)
-        {
-	  // This adds intersections to the VList
-	  cnt+=getIntersect(*ic,*jc,*kc);
-	}
+  for(size_t i=0;i<SVec.size();i++)
+    for(size_t j=i+1;j<SVec.size();j++)
+      {
+	if (Geometry::TripleCache::isParallel(SVec[i],SVec[j])) continue;
+	for(size_t k=j+1;k<SVec.size();k++)
+	  {
+	    // This adds intersections to the VList
+	    cnt+=getIntersect(SVec[i],SVec[j],SVec[k],
+			      TCache.getPoints(SVec[i],SVec[j],SVec[k]));
+	  }
+      }
   // return number of item found
   return cnt;
 }
-
 int
 Qhull::getIntersect(const Geometry::Surface* SurfX,
 		    const Geometry::Surface* SurfY,
-		    const Geometry::Surface* SurfZ)
+		    const Geometry::Surface* SurfZ,
+		    const std::vector<Geometry::Vec3D>& PntOut)
   /*!
-    Calculates the intersection between three surfaces.
-    Adds the point to the vertex list if the point is valid 
+    Adds the intersection points of three surfaces
+    to the vertex list if the point is valid 
     and is on a side.
     
     \param SurfX :: Surface pointer
     \param SurfY :: Surface pointer
     \param SurfZ :: Surface pointer
+    \param PntOut :: Intersection points of the surfaces
     \returns Number intersections found
   */
 {
@@ -168,9 +211,6 @@ Qhull::getIntersect(const Geometry::Surface* SurfX,
   const int BS=SurfY->getName();
   const int CS=SurfZ->getName();
 
-  std::vector<Geometry::Vec3D> PntOut=
-    SurInter::processPoint(SurfX,SurfY,SurfZ);
-
   int Ncnt(0);
   std::set<int> ExSN={AS,BS,CS};
 	
@@ -306,19 +346,31 @@ Qhull::calcVertex()
     the vertii
     \return Number of intersection vertexs found.
   */
+{
+  Geometry::TripleCache TCache;
+  return calcVertex(TCache);
+}
+
+int
+Qhull::calcVertex(Geometry::TripleCache& TCache)
+  /*!
+    Calculate the vertii using a shared set of 
+    surface intersection points
+    \param TCache :: Triple intersection points
+    \return Number of intersection vertexs found.
+  */
 {
   ELog::RegMethod RegA("Qhull","calcVertex");
   
   createSurfaceList();
   populate();
-  calcIntersections();
+  calcIntersections(TCache);
   if (!VList.empty())  
     calcCentreOfMass();
     
   return static_cast<int>(VList.size());
 }
 
-
   
 Geometry::Matrix<double>
 Qhull::getRotation(const unsigned int M,const unsigned int A,
@@ -0,0 +1,404 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RuleProgram.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Rules.h"
+#include "RuleProgram.h"
+
+RuleProgram::RuleProgram()
+  /*!
+    Constructor
+  */
+{}
+
+RuleProgram::RuleProgram(const RuleProgram& A) :
+  Prog(A.Prog)
+  /*!
+    Copy constructor
+    \param A :: RuleProgram to copy
+  */
+{}
+
+RuleProgram&
+RuleProgram::operator=(const RuleProgram& A)
+  /*!
+    Assignment operator
+    \param A :: RuleProgram to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Prog=A.Prog;
+    }
+  return *this;
+}
+
+size_t
+RuleProgram::addOp(const OpType OT,const int KN,const int S,
+		   const Geometry::Surface* SPtr)
+  /*!
+    Add an item to the program
+    \param OT :: Item type
+    \param KN :: Surface number
+    \param S :: Sign / value
+    \param SPtr :: Surface pointer
+    \return index of item
+  */
+{
+  const size_t index(Prog.size());
+  RuleOp Op;
+  Op.opType=OT;
+  Op.keyN=KN;
+  Op.sign=S;
+  Op.key=SPtr;
+  Op.endIndex=index+1;
+  Prog.push_back(Op);
+  return index;
+}
+
+bool
+RuleProgram::addGroup(const Rule* RPtr,const OpType OT)
+  /*!
+    Add an intersection/union chain as a single group.
+    The nested items of the same type are flattened.
+    \param RPtr :: Top rule of the chain
+    \param OT :: And / Or
+    \return true on success
+  */
+{
+  const int chainType=RPtr->type();
+
+  // depth first [left to right] over the chain
+  std::vector<const Rule*> Items;
+  std::vector<const Rule*> Stack;
+  Stack.push_back(RPtr);
+  while(!Stack.empty())
+    {
+      const Rule* R=Stack.back();
+      Stack.pop_back();
+      if (R!=RPtr && R->type()!=chainType)
+	{
+	  Items.push_back(R);
+	  continue;
+	}
+      for(int i=1;i>=0;i--)
+	{
+	  const Rule* L=R->leaf(i);
+	  if (L)
+	    Stack.push_back(L);
+	  else if (OT==OpType::And)
+	    {
+	      // null leaf of an intersection is always false
+	      addOp(OpType::Const,0,0,0);
+	      return 1;
+	    }
+	}
+    }
+
+  if (Items.empty())
+    {
+      addOp(OpType::Const,0,0,0);
+      return 1;
+    }
+  const size_t index=addOp(OT,0,0,0);
+  for(const Rule* R : Items)
+    if (!addRule(R))
+      return 0;
+  Prog[index].endIndex=Prog.size();
+  return 1;
+}
+
+bool
+RuleProgram::addRule(const Rule* RPtr)
+  /*!
+    Add a rule [and its sub-tree] to the program
+    \param RPtr :: Rule to add
+    \return true on success / false if not possible to compile
+  */
+{
+  if (RPtr->type()==1)
+    return addGroup(RPtr,OpType::And);
+  if (RPtr->type()==-1)
+    return addGroup(RPtr,OpType::Or);
+
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      addOp(OpType::Surf,SPtr->getKeyN(),SPtr->getSign(),SPtr->getKey());
+      return 1;
+    }
+
+  const CompGrp* CPtr=dynamic_cast<const CompGrp*>(RPtr);
+  if (CPtr)
+    {
+      if (!CPtr->leaf(0))
+	{
+	  addOp(OpType::Const,0,1,0);
+	  return 1;
+	}
+      const size_t index=addOp(OpType::Not,0,0,0);
+      if (!addRule(CPtr->leaf(0)))
+	return 0;
+      Prog[index].endIndex=Prog.size();
+      return 1;
+    }
+
+  const BoolValue* BPtr=dynamic_cast<const BoolValue*>(RPtr);
+  if (BPtr)
+    {
+      const int status=BPtr->isValid(Geometry::Vec3D(0,0,0)) ? 1 : 0;
+      addOp(OpType::Const,0,status,0);
+      return 1;
+    }
+  // CompObj / ContGrp / ContObj
+  return 0;
+}
+
+bool
+RuleProgram::build(const Rule* RPtr)
+  /*!
+    Compile the rule tree. The surface pointers are
+    copied so the rule needs to be populated.
+    \param RPtr :: Top rule
+    \return true on success [program empty on failure]
+  */
+{
+  Prog.clear();
+  if (!RPtr || !addRule(RPtr))
+    {
+      Prog.clear();
+      return 0;
+    }
+  return 1;
+}
+
+template<typename LeafFunc>
+bool
+RuleProgram::evalItem(const size_t index,const LeafFunc& LF) const
+  /*!
+    Evaluate an item of the program
+    \param index :: Item index
+    \param LF :: Functor to evaluate a surface item
+    \return true if valid
+  */
+{
+  const RuleOp& Op=Prog[index];
+  switch (Op.opType)
+    {
+    case OpType::Surf:
+      return LF(Op);
+    case OpType::And:
+      for(size_t i=index+1;i<Op.endIndex;i=Prog[i].endIndex)
+	if (!evalItem(i,LF)) return 0;
+      return 1;
+    case OpType::Or:
+      for(size_t i=index+1;i<Op.endIndex;i=Prog[i].endIndex)
+	if (evalItem(i,LF)) return 1;
+      return 0;
+    case OpType::Not:
+      return !evalItem(index+1,LF);
+    case OpType::Const:
+      return Op.sign;
+    }
+  return 0;
+}
+
+int
+RuleProgram::evalPair(const size_t index,const int SN,
+		      const Geometry::Vec3D& Pt) const
+  /*!
+    Evaluate an item of the program with the surface
+    SN false/true
+    \param index :: Item index
+    \param SN :: Surface number
+    \param Pt :: Point to test
+    \return valid(SN->false) : valid(SN->true) [bitwise]
+  */
+{
+  const RuleOp& Op=Prog[index];
+  int flag(0);
+  switch (Op.opType)
+    {
+    case OpType::Surf:
+      if (!Op.key) return 0;
+      if (Op.keyN==std::abs(SN))
+	return (Op.sign>0) ? 2 : 1;
+      return (Op.key->side(Pt)*Op.sign>=0) ? 3 : 0;
+    case OpType::And:
+      flag=3;
+      for(size_t i=index+1;flag && i<Op.endIndex;i=Prog[i].endIndex)
+	flag &= evalPair(i,SN,Pt);
+      return flag;
+    case OpType::Or:
+      for(size_t i=index+1;flag!=3 && i<Op.endIndex;i=Prog[i].endIndex)
+	flag |= evalPair(i,SN,Pt);
+      return flag;
+    case OpType::Not:
+      return (~evalPair(index+1,SN,Pt)) & 3;
+    case OpType::Const:
+      return (Op.sign) ? 3 : 0;
+    }
+  return 0;
+}
+
+bool
+RuleProgram::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Calculate if a point is valid
+    \param Pt :: Point to test
+    \return true/false
+  */
+{
+  if (Prog.empty()) return 0;
+  return evalItem(0,[&Pt](const RuleOp& Op) -> bool
+		  {
+		    return (Op.key && Op.key->side(Pt)*Op.sign>=0);
+		  });
+}
+
+bool
+RuleProgram::isValid(const Geometry::Vec3D& Pt,const int ExSN) const
+  /*!
+    Calculate if a point is valid
+    \param Pt :: Point to test
+    \param ExSN :: Excluded surface [always true]
+    \return true/false
+  */
+{
+  if (Prog.empty()) return 0;
+  const int absSN=std::abs(ExSN);
+  return evalItem(0,[&Pt,absSN](const RuleOp& Op) -> bool
+		  {
+		    if (!Op.key) return 0;
+		    if (Op.keyN==absSN) return 1;
+		    return (Op.key->side(Pt)*Op.sign>=0);
+		  });
+}
+
+bool
+RuleProgram::isValid(const Geometry::Vec3D& Pt,
+		     const std::set<int>& ExSN) const
+  /*!
+    Calculate if a point is valid
+    \param Pt :: Point to test
+    \param ExSN :: Excluded surfaces [always true]
+    \return true/false
+  */
+{
+  if (Prog.empty()) return 0;
+  return evalItem(0,[&Pt,&ExSN](const RuleOp& Op) -> bool
+		  {
+		    if (!Op.key) return 0;
+		    if (ExSN.find(Op.keyN)!=ExSN.end()) return 1;
+		    return (Op.key->side(Pt)*Op.sign>=0);
+		  });
+}
+
+bool
+RuleProgram::isDirectionValid(const Geometry::Vec3D& Pt,
+			      const int ExSN) const
+  /*!
+    Calculate if a point is valid
+    \param Pt :: Point to test
+    \param ExSN :: Surface to treat as true/false [based on sign]
+    \return true/false
+  */
+{
+  if (Prog.empty()) return 0;
+  const int absSN=std::abs(ExSN);
+  return evalItem(0,[&Pt,ExSN,absSN](const RuleOp& Op) -> bool
+		  {
+		    if (!Op.key) return 0;
+		    if (Op.keyN==absSN) return (Op.sign*ExSN>0);
+		    return (Op.key->side(Pt)*Op.sign>=0);
+		  });
+}
+
+int
+RuleProgram::pairValid(const int SN,const Geometry::Vec3D& Pt) const
+  /*!
+    Calculate if a point is valid with the surface SN
+    false/true
+    \param SN :: Surface number to alternate on
+    \param Pt :: Point to test
+    \return valid(SN->false) : valid(SN->true) [bitwise]
+  */
+{
+  return (Prog.empty()) ? 0 : evalPair(0,SN,Pt);
+}
+
+void
+RuleProgram::write(std::ostream& OX) const
+  /*!
+    Write out the program [debug]
+    \param OX :: Output stream
+  */
+{
+  for(size_t i=0;i<Prog.size();i++)
+    {
+      const RuleOp& Op=Prog[i];
+      OX<<i<<" ";
+      switch (Op.opType)
+	{
+	case OpType::Surf:
+	  OX<<"SURF "<<Op.sign*Op.keyN;
+	  break;
+	case OpType::And:
+	  OX<<"AND";
+	  break;
+	case OpType::Or:
+	  OX<<"OR";
+	  break;
+	case OpType::Not:
+	  OX<<"NOT";
+	  break;
+	case OpType::Const:
+	  OX<<"CONST "<<Op.sign;
+	  break;
+	}
+      OX<<" -> "<<Op.endIndex<<std::endl;
+    }
+  return;
+}
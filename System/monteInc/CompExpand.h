@@ -0,0 +1,77 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/CompExpand.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef MonteCarlo_CompExpand_h
+#define MonteCarlo_CompExpand_h
+
+class Rule;
+class HeadRule;
+
+namespace MonteCarlo
+{
+
+class Qhull;
+
+/*!
+  \class CompExpand
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Removes cell complements from a rule tree
+
+  Replaces each #N / %N cell reference with the rule of
+  cell N, and pushes each complement down to the surfaces
+  by De Morgan. The expanded rule of each referenced cell
+  [and its complement] is built once and then copied, so
+  one object can be used for a pass over all the cells.
+*/
+
+class CompExpand
+{
+ private:
+
+  /// Storage of expanded cells
+  typedef std::map<int,HeadRule> RTYPE;
+
+  const std::map<int,Qhull*>& MList;  ///< Cells to expand
+  RTYPE posRule;                      ///< Expanded cell rules
+  RTYPE negRule;                      ///< Expanded cell complements
+  std::set<int> activeCells;          ///< Cells being expanded
+
+  static Rule* makeBranch(const bool,Rule*,Rule*);
+
+  const Rule* cellRule(const int,const bool);
+  Rule* expandRule(const Rule*,const bool);
+  HeadRule expandCell(const Qhull&,const bool);
+
+ public:
+
+  explicit CompExpand(const std::map<int,Qhull*>&);
+  CompExpand(const CompExpand&);
+  ~CompExpand() {}       ///< Destructor
+
+  HeadRule expand(const Qhull&);
+  HeadRule complement(const Qhull&);
+};
+
+}
+
+#endif
@@ -30,6 +30,12 @@ class SurfPoint;
 namespace Geometry
 {
   class Surface;
+  class BoundBox;
+}
+
+namespace MapSupport
+{
+  class NumberMap;
 }
 
 
@@ -57,6 +63,9 @@ class HeadRule
   void createAddition(const int,const Rule*);
   const SurfPoint* findSurf(const int) const;
 
+  static Geometry::BoundBox surfBox(const SurfPoint*);
+  static Geometry::BoundBox ruleBox(const Rule*);
+
  public:
 
   HeadRule();
@@ -86,6 +95,8 @@ class HeadRule
   int pairValid(const int,const Geometry::Vec3D&) const;           
   bool isValid(const std::map<int,int>&) const; 
   bool isDirectionValid(const Geometry::Vec3D&,const int) const;
+
+  Geometry::BoundBox calcBoundBox() const;
   
   int trackSurf(const Geometry::Vec3D&,const Geometry::Vec3D&,
 		double&) const;
@@ -115,6 +126,7 @@ class HeadRule
   void isolateSurfNum(const std::set<int>&);
   int removeTopItem(const int);
   int substituteSurf(const int,const int,const Geometry::Surface*);
+  int renumberSurfaces(const MapSupport::NumberMap&);
   void removeCommon();
   
   void makeComplement();
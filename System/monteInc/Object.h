@@ -23,6 +23,17 @@
 #define MonteCarlo_Object_h
 
 class Token;
+class RuleProgram;
+
+namespace Geometry
+{
+  class BoundBox;
+}
+
+namespace MapSupport
+{
+  class NumberMap;
+}
 
 namespace MonteCarlo
 {
@@ -50,12 +61,18 @@ class Object
   int fill;          ///< fill number
   int trcl;          ///< transform number
   int universe;      ///< universe number
+  int lattice;       ///< lattice type [0 none]
+  std::vector<size_t> latSize;   ///< lattice fill extent [lattice only]
+  std::vector<int> latFill;      ///< lattice fill universes [first fastest]
+  std::vector<Geometry::Vec3D> latAxis;  ///< lattice +i/+j/+k [if set]
   int imp;           ///< importance / 0 
   double density;    ///< Density
   int placehold;     ///< Is cell virtual (ie not in output)
   int populated;     ///< Full population
+  size_t ruleIndex;  ///< Rule change count at the last change of HRule
 
   HeadRule HRule;    ///< Top rule
+  RuleProgram* ProgRule;   ///< Compiled HRule [0 if not compiled]
   /// Set of surfaces that are logically opposite in the rule.
   std::set<const Geometry::Surface*> logicOppSurf;
  
@@ -63,6 +80,10 @@ class Object
   int checkExteriorValid(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
   /// Calc in/out 
   int calcInOut(const int,const int) const;
+  void compileRule();
+  void ruleChanged();
+  std::string latticeStr() const;
+  void writeLattice(std::ostream&) const;
 
  protected:
   
@@ -79,9 +100,11 @@ class Object
  public:
   
   static int startLine(const std::string& Line);
+  static size_t getRuleChange();
 
   Object();
   Object(const int,const int,const double,const std::string&);
+  Object(const int,const int,const double,const HeadRule&);
   Object(const Object&);
   Object& operator=(const Object&);
   virtual Object* clone() const;
@@ -103,14 +126,23 @@ class Object
   int setObject(std::string);
   int setObject(const int,const int,const std::vector<Token>&);
   int procString(const std::string&);
+  int procHeadRule(const HeadRule&);
   void setDensity(const double D) { density=D; }       ///< Set Density [Atom/A^3]
   void setMaterial(const int M) { MatN=M; }            ///< Set Material number
+  void setFill(const int F) { fill=F; }                ///< Set fill universe
+  void setUniverse(const int U) { universe=U; }        ///< Set universe
+  void setLattice(const int,const size_t,const size_t,const size_t,
+		  const std::vector<int>&);
+  void setLatticeAxis(const Geometry::Vec3D&,const Geometry::Vec3D&,
+		      const Geometry::Vec3D&);
   void setPlaceHold(const int P) { placehold=P; }      ///< Set placeholder
   int isPlaceHold() const { return placehold; }        ///< Get placeholder
 
   int complementaryObject(const int,std::string&);
   int hasComplement() const;                           
   int isPopulated() const { return populated; }        ///< Is populated   
+  /// Rule change count at the last change of the cell rule
+  size_t getRuleIndex() const { return ruleIndex; }
   
   int getName() const  { return ObjName; }             ///< Get Name
   int getCreate() const  { return listNum; }           ///< Get Creation point
@@ -118,6 +150,9 @@ class Object
   double getTemp() const { return Tmp; }               ///< Get Temperature [K]
   double getDensity() const { return density; }        ///< Get Density [Atom/A^3]
   int getImp() const { return imp; }                   ///< Get importance
+  int getFill() const { return fill; }                 ///< Get fill universe
+  int getUniverse() const { return universe; }         ///< Get universe
+  int getLattice() const { return lattice; }           ///< Get lattice type
 
   /// Return the top rule
   const Rule* topRule() const { return HRule.getTopRule(); }
@@ -130,8 +165,10 @@ class Object
   int isObjSurfValid() const { return objSurfValid; }  ///< Check validity needed
   void setObjSurfValid()  { objSurfValid=1; }          ///< set as valid
   int addSurfString(const std::string&);   
+  void addIntersection(const HeadRule&);
   int removeSurface(const int);        
   int substituteSurf(const int,const int,Geometry::Surface*);  
+  int renumberSurfaces(const MapSupport::NumberMap&);
   void makeComplement();
 
   bool hasSurface(const int) const;
@@ -143,6 +180,8 @@ class Object
   int isValid(const std::map<int,int>&) const; 
   std::map<int,int> mapValid(const Geometry::Vec3D&) const;
 
+  Geometry::BoundBox calcBoundBox() const;
+
   int isOnSide(const Geometry::Vec3D&) const;
 
   int surfSign(const int) const;
@@ -187,7 +226,9 @@ class Object
   void write(std::ostream&) const;         
   void writePHITS(std::ostream&) const;    
   void writeFLUKA(std::ostream&) const;    
+  void writeFLUKA(std::ostream&,const std::string&) const;    
   void writeFLUKAmat(std::ostream&) const;
+  void writeFLUKAmat(std::ostream&,const std::string&) const;
   void writePOVRay(std::ostream&) const;    
   void writePOVRaymat(std::ostream&) const;
 
@@ -3,7 +3,7 @@
  
  * File:   monteInc/Qhull.h
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -25,6 +25,7 @@
 namespace Geometry
 {
   class Surface;
+  class TripleCache;
 }
 
 namespace MonteCarlo
@@ -50,7 +51,8 @@ class Qhull : public Object
   Geometry::Vec3D CofM;               ///< Effective centre of mass
 
   int getIntersect(const Geometry::Surface*,const Geometry::Surface*,
-		   const Geometry::Surface*);
+		   const Geometry::Surface*,
+		   const std::vector<Geometry::Vec3D>&);
 
   void calcCentreOfMass();
 
@@ -58,6 +60,7 @@ class Qhull : public Object
   
   Qhull();
   Qhull(const int,const int,const double,const std::string&);
+  Qhull(const int,const int,const double,const HeadRule&);
   Qhull(const Qhull&);
   Qhull& operator=(const Qhull&);
   virtual Qhull* clone() const;
@@ -66,7 +69,9 @@ class Qhull : public Object
   /// Determine if intersections has been calculted:
   bool hasIntersections() const { return !VList.empty(); }
   int calcIntersections();
+  int calcIntersections(Geometry::TripleCache&);
   int calcVertex();
+  int calcVertex(Geometry::TripleCache&);
   int calcMidVertex();
   
   Geometry::Matrix<double> getRotation(const unsigned int,const unsigned int,
@@ -0,0 +1,99 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/RuleProgram.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef RuleProgram_h
+#define RuleProgram_h
+
+class Rule;
+
+namespace Geometry
+{
+  class Surface;
+}
+
+/*!
+  \class RuleProgram
+  \brief Flat compiled form of a rule tree
+  \author S.Ansell
+  \version 1.0
+  \date November 2017
+
+  The rule tree is flattened into a contiguous prefix array.
+  Chains of intersections/unions become a single n-ary
+  group and each item holds the index one past its sub-tree
+  so a group can short-circuit by jumping over its remaining
+  items. Only Intersection/Union/SurfPoint/CompGrp/BoolValue
+  can be compiled: build fails on anything else [CompObj etc]
+  and the tree must then be used.
+*/
+
+class RuleProgram
+{
+ private:
+
+  /// Type of a program item
+  enum class OpType { Surf, And, Or, Not, Const };
+
+  /// Single program item
+  struct RuleOp
+  {
+    OpType opType;                  ///< Item type
+    int keyN;                       ///< Surface number [Surf]
+    int sign;                       ///< Surface sign / value [Const]
+    const Geometry::Surface* key;   ///< Surface [Surf]
+    size_t endIndex;                ///< One past the end of sub-tree
+  };
+
+  std::vector<RuleOp> Prog;         ///< Program [0 is top]
+
+  size_t addOp(const OpType,const int,const int,
+	       const Geometry::Surface*);
+  bool addRule(const Rule*);
+  bool addGroup(const Rule*,const OpType);
+
+  template<typename LeafFunc>
+  bool evalItem(const size_t,const LeafFunc&) const;
+  int evalPair(const size_t,const int,const Geometry::Vec3D&) const;
+
+ public:
+
+  RuleProgram();
+  RuleProgram(const RuleProgram&);
+  RuleProgram& operator=(const RuleProgram&);
+  ~RuleProgram() {}    ///< Destructor
+
+  bool build(const Rule*);
+  void clear() { Prog.clear(); }          ///< Remove program
+  /// Has no program
+  bool isEmpty() const { return Prog.empty(); }
+  /// Number of items
+  size_t size() const { return Prog.size(); }
+
+  bool isValid(const Geometry::Vec3D&) const;
+  bool isValid(const Geometry::Vec3D&,const int) const;
+  bool isValid(const Geometry::Vec3D&,const std::set<int>&) const;
+  bool isDirectionValid(const Geometry::Vec3D&,const int) const;
+  int pairValid(const int,const Geometry::Vec3D&) const;
+
+  void write(std::ostream&) const;
+};
+
+#endif
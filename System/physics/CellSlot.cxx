@@ -0,0 +1,198 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   physics/CellSlot.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "MapSupport.h"
+#include "NumberMap.h"
+#include "CellSlot.h"
+
+namespace physicsSystem
+{
+
+CellSlot::CellSlot()
+  /*!
+    Constructor
+  */
+{}
+
+CellSlot::CellSlot(const CellSlot& A) :
+  slotMap(A.slotMap),cellNum(A.cellNum)
+  /*!
+    Copy Constructor [slot numbers are kept]
+    \param A :: CellSlot to copy
+  */
+{}
+
+CellSlot&
+CellSlot::operator=(const CellSlot& A) 
+  /*!
+    Assignment operator [slot numbers are kept]
+    \param A :: CellSlot to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      slotMap=A.slotMap;
+      cellNum=A.cellNum;
+      listCells.clear();
+      listSlots.clear();
+    }
+  return *this;
+}
+
+void
+CellSlot::clear()
+  /*!
+    Remove all the slots
+  */
+{
+  slotMap.clear();
+  cellNum.clear();
+  listCells.clear();
+  listSlots.clear();
+  return;
+}
+
+size_t
+CellSlot::addCell(const int CN)
+  /*!
+    Get the slot of a cell. A new slot is added
+    if the cell does not have one
+    \param CN :: Cell number
+    \return slot
+  */
+{
+  std::pair<std::map<int,size_t>::iterator,bool> IR=
+    slotMap.emplace(CN,cellNum.size());
+  if (IR.second)
+    {
+      cellNum.push_back(CN);
+      // cache had this cell as missing
+      listCells.clear();
+      listSlots.clear();
+    }
+  return IR.first->second;
+}
+
+bool
+CellSlot::findSlot(const int CN,size_t& slot) const
+  /*!
+    Find the slot of a cell
+    \param CN :: Cell number
+    \param slot :: slot number [output]
+    \return true if cell has a slot
+  */
+{
+  std::map<int,size_t>::const_iterator mc=slotMap.find(CN);
+  if (mc==slotMap.end())
+    return 0;
+  slot=mc->second;
+  return 1;
+}
+
+const std::vector<long int>&
+CellSlot::getSlots(const std::vector<int>& CList) const
+  /*!
+    Get the slots of a list of cells. The result is kept 
+    until the next call with a different list, so 
+    each card of the same write uses the same look up.
+    \param CList :: List of cells
+    \return slot of each cell [-1 if the cell has no slot]
+  */
+{
+  if (CList!=listCells || listSlots.size()!=CList.size())
+    {
+      listCells=CList;
+      listSlots.resize(CList.size());
+      for(size_t i=0;i<CList.size();i++)
+	{
+	  std::map<int,size_t>::const_iterator mc=slotMap.find(CList[i]);
+	  listSlots[i]=(mc==slotMap.end()) ? -1 : 
+	    static_cast<long int>(mc->second);
+	}
+    }
+  return listSlots;
+}
+
+const std::vector<long int>&
+CellSlot::addCells(const std::vector<int>& CList)
+  /*!
+    Get the slots of a list of cells. A slot is added
+    for each cell that does not have one.
+    \param CList :: List of cells
+    \return slot of each cell 
+  */
+{
+  for(const int CN : CList)
+    addCell(CN);
+  return getSlots(CList);
+}
+
+void
+CellSlot::renumberCells(const MapSupport::NumberMap& CMap)
+  /*!
+    Renumbers all the cells in one pass. Every
+    renumbered cell must exist. The slots do not 
+    change so the cards using the map do not change.
+    \param CMap :: Map of old : new cell numbers
+  */
+{
+  ELog::RegMethod RegA("CellSlot","renumberCells");
+  if (slotMap.empty() || CMap.empty()) return;
+
+  std::map<int,size_t> newMap;
+  std::vector<int> newCellNum(cellNum.size());
+  size_t cnt(0);
+  for(size_t i=0;i<cellNum.size();i++)
+    {
+      const int newCellN=CMap.convert(cellNum[i]);
+      if (newCellN!=cellNum[i]) cnt++;
+      if (!newMap.emplace(newCellN,i).second)
+	throw ColErr::InContainerError<int>(newCellN,"New cell repeated");
+      newCellNum[i]=newCellN;
+    }
+  if (cnt!=CMap.size())
+    throw ColErr::InContainerError<size_t>(CMap.size()-cnt,
+					   "Old cells not found "+
+					   RegA.getFull());    
+  slotMap.swap(newMap);
+  cellNum.swap(newCellNum);
+  listCells.clear();
+  listSlots.clear();
+  return; 
+}
+
+} // NAMESPACE physicsSystem
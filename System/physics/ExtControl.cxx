@@ -42,6 +42,7 @@
 #include "support.h"
 #include "stringCombine.h"
 #include "MapRange.h"
+#include "NumberMap.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -313,6 +314,20 @@ ExtControl::renumberCell(const int originalCell,const int newCell)
     }
   return;
 }
+
+void
+ExtControl::renumberCells(const MapSupport::NumberMap& CMap)
+  /*!
+    Renumber the cells
+    \param CMap :: Map of old : new cell numbers
+  */
+{
+  ELog::RegMethod RegA("ExtControl","renumberCells");
+
+  for(const std::pair<int,int>& CN : CMap.getItems())
+    renumberCell(CN.first,CN.second);
+  return;
+}
   
 void
 ExtControl::writeHeader(std::ostream& OX) const
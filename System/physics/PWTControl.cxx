@@ -42,6 +42,7 @@
 #include "support.h"
 #include "stringCombine.h"
 #include "MapRange.h"
+#include "NumberMap.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -160,6 +161,20 @@ PWTControl::renumberCell(const int originalCell,const int newCell)
     }
   return;
 }
+
+void
+PWTControl::renumberCells(const MapSupport::NumberMap& CMap)
+  /*!
+    Renumber the cells
+    \param CMap :: Map of old : new cell numbers
+  */
+{
+  ELog::RegMethod RegA("PWTControl","renumberCells");
+
+  for(const std::pair<int,int>& CN : CMap.getItems())
+    renumberCell(CN.first,CN.second);
+  return;
+}
   
   
 void
@@ -30,6 +30,9 @@
 #include <map>
 #include <iterator>
 #include <algorithm>
+#include <memory>
+#include <limits>
+#include <cmath>
 
 
 #include "Exception.h"
@@ -45,31 +48,42 @@
 #include "MapSupport.h"
 #include "MapRange.h"
 #include "ZoneUnit.h"
+#include "CellSlot.h"
 #include "PhysImp.h"
 
 namespace physicsSystem
 {
 
 PhysImp::PhysImp() :
-  type("None"),nCutters(0)
+  type("None"),SlotPtr(new CellSlot),nActive(0),nCutters(0)
   /*!
     Constructor
   */
 {}
 
 PhysImp::PhysImp(const std::string& TP) :
-  type(TP),nCutters(0)
+  type(TP),SlotPtr(new CellSlot),nActive(0),nCutters(0)
   /*!
     Constructor with Type
     \param TP :: Type identifier
   */
 {}
 
+PhysImp::PhysImp(const std::string& TP,
+		 const std::shared_ptr<CellSlot>& SP) :
+  type(TP),SlotPtr(SP),nActive(0),nCutters(0)
+  /*!
+    Constructor with Type and a shared slot map
+    \param TP :: Type identifier
+    \param SP :: Cell slot map
+  */
+{}
+
 PhysImp::PhysImp(const PhysImp& A) :
-  type(A.type),particles(A.particles),
-  impNum(A.impNum),nCutters(A.nCutters)
+  type(A.type),particles(A.particles),SlotPtr(A.SlotPtr),
+  impNum(A.impNum),nActive(A.nActive),nCutters(A.nCutters)
   /*!
-    Copy Constructor
+    Copy Constructor [slot map is shared]
     \param A :: PhysImp to copy
   */
 {}
@@ -77,7 +91,7 @@ PhysImp::PhysImp(const PhysImp& A) :
 PhysImp&
 PhysImp::operator=(const PhysImp& A) 
   /*!
-    Assignment operator
+    Assignment operator [slot map is shared]
     \param A :: PhysImp to copy
     \return *this
   */
@@ -86,7 +100,9 @@ PhysImp::operator=(const PhysImp& A)
     {
       type=A.type;
       particles=A.particles;
+      SlotPtr=A.SlotPtr;
       impNum=A.impNum;
+      nActive=A.nActive;
       nCutters=A.nCutters;
     }
   return *this;
@@ -101,15 +117,46 @@ PhysImp::~PhysImp()
 void
 PhysImp::clear()
   /*!
-    Clear everything
+    Clear everything [slot map is kept]
    */
 {
   particles.clear();
-  impNum.erase(impNum.begin(),impNum.end());
+  impNum.clear();
+  nActive=0;
   nCutters=0;
   return;
 }
 
+void
+PhysImp::setSlotMap(const std::shared_ptr<CellSlot>& SP)
+  /*!
+    Set the slot map. The new map must have the same
+    slots as the old one [a copy] unless the card is empty.
+    \param SP :: Cell slot map
+  */
+{
+  SlotPtr=SP;
+  return;
+}
+
+size_t
+PhysImp::setSlot(const size_t slot,const double value)
+  /*!
+    Set the value of a slot
+    \param slot :: Slot index
+    \param value :: new value
+    \return slot
+  */
+{
+  if (slot>=impNum.size())
+    impNum.resize(SlotPtr->size(),
+		  std::numeric_limits<double>::quiet_NaN());
+  if (std::isnan(impNum[slot]))
+    nActive++;
+  impNum[slot]=value;
+  return slot;
+}
+  
 void
 PhysImp::setValue(const int ID,const double value)
   /*!
@@ -120,22 +167,19 @@ PhysImp::setValue(const int ID,const double value)
     \param value :: new value
   */
 {
-  impNum[ID]=value;
+  setSlot(SlotPtr->addCell(ID),value);
   return;
 }
 
 void
 PhysImp::setAllCells(const double value)
   /*!
-    Set a special interest in a cell ID
-    The existance of the cell is only 
-    checked at the write out stage.
+    Set all the cells that have a value
     \param value :: new value
   */
 {
-  std::map<int,double>::iterator mc;
-  for(mc=impNum.begin();mc!=impNum.end();mc++)
-    mc->second=value;
+  for(double& V : impNum)
+    if (!std::isnan(V)) V=value;
   return;
 }
 
@@ -146,11 +190,12 @@ PhysImp::removeCell(const int ID)
     \param ID :: Cell number
   */
 {
-  std::map<int,double>::iterator ac;
-  ac=impNum.find(ID);
-  if (ac!=impNum.end())
+  size_t slot;
+  if (SlotPtr->findSlot(ID,slot) && slot<impNum.size() &&
+      !std::isnan(impNum[slot]))
     {
-      impNum.erase(ac);
+      impNum[slot]=std::numeric_limits<double>::quiet_NaN();
+      nActive--;
       nCutters++;
     }
   return;
@@ -160,20 +205,17 @@ void
 PhysImp::modifyCells(const std::vector<int>& cellOrder,const double defValue)
   /*!
     Process the ordered list of the cells.
-    If the cell number does not exists a default value
-    of 1 is added.
+    Only cells that have a value are changed.
     \param cellOrder :: list of cells
     \param defValue :: default value to use (set to 1.0)
   */
 {
-  std::vector<int>::const_iterator vc;
-  std::map<int,double>::iterator ac;
-  std::map<int,double> nMap;
-  for(vc=cellOrder.begin();vc!=cellOrder.end();vc++)
+  size_t slot;
+  for(const int CN : cellOrder)
     {
-      ac=impNum.find(*vc);
-      if (ac!=impNum.end())
-	ac->second=defValue;
+      if (SlotPtr->findSlot(CN,slot) && slot<impNum.size() &&
+	  !std::isnan(impNum[slot]))
+	impNum[slot]=defValue;
     }
   return;
 }
@@ -181,17 +223,26 @@ PhysImp::modifyCells(const std::vector<int>& cellOrder,const double defValue)
 void
 PhysImp::updateCells(const ZoneUnit<double>& ZU)
   /*!
-    Given a zone unit update cells within the zone unit
+    Given a zone unit update cells within the zone unit.
+    The zones and the slot map are both ordered so 
+    this is a single merge over the two.
     \param ZU :: ZoneUnit to update
   */
 {
   ELog::RegMethod RegA("PhysImp","updateCells");
 
-  double V;
-  for(std::map<int,double>::value_type& MC : impNum)
+  const std::vector<MapSupport::Range<int>>& Zones=ZU.Zones;
+  size_t index(0);
+  for(const std::map<int,size_t>::value_type& MC : SlotPtr->getMap())
     {
-      if (ZU.inRange(MC.first,V))
-        MC.second=V;
+      const MapSupport::Range<int> CR(MC.first);
+      while(index<Zones.size() && Zones[index]<CR)
+	index++;
+      if (index==Zones.size()) break;
+      
+      if (MC.second<impNum.size() && !std::isnan(impNum[MC.second]) &&
+	  Zones[index].valid(MC.first))
+        impNum[MC.second]=ZU.ZoneData[index];
     }
   return;
 }
@@ -201,20 +252,27 @@ PhysImp::setCells(const std::vector<int>& cellOrder,const double defValue)
   /*!
     Process the ordered list of the cells.
     If the cell number does not exists a default value
-    of 1 is added.
+    of 1 is added. Cells not in the list are removed.
     \param cellOrder :: list of cells
     \param defValue :: default value to use (set to 1.0)
   */
 {
-  std::vector<int>::const_iterator vc;
-  std::map<int,double>::const_iterator ac;
-  std::map<int,double> nMap;
-  for(vc=cellOrder.begin();vc!=cellOrder.end();vc++)
+  const std::vector<long int>& Slots=SlotPtr->addCells(cellOrder);
+
+  std::vector<double> nImp(SlotPtr->size(),
+			   std::numeric_limits<double>::quiet_NaN());
+  nActive=0;
+  for(const long int SN : Slots)
     {
-      ac=impNum.find(*vc);
-      nMap[*vc]=(ac!=impNum.end()) ? ac->second : defValue;
+      const size_t slot=static_cast<size_t>(SN);
+      if (std::isnan(nImp[slot]))
+	{
+	  nImp[slot]=(slot<impNum.size() && !std::isnan(impNum[slot])) ?
+	    impNum[slot] : defValue;
+	  nActive++;
+	}
     }
-  impNum=nMap;
+  impNum.swap(nImp);
   return;
 }
 
@@ -223,22 +281,21 @@ PhysImp::setAllCells(const std::vector<int>& cellOrder,
 		     const std::vector<double>& impValue)
   /*!
     Process the ordered list of the cells.
-    If the cell number does not exists a default value
-    of 1 is added.
+    Cells not in the list are removed.
     \param cellOrder :: list of cells
     \param impValue :: list of importance values
   */
 {
-  std::vector<int>::const_iterator vc;
-  std::vector<double>::const_iterator ic;
-  std::map<int,double>::const_iterator ac;
-  std::map<int,double> nMap;
-  ic=impValue.begin();
-  for(vc=cellOrder.begin();vc!=cellOrder.end();vc++,ic++)
+  const std::vector<long int>& Slots=SlotPtr->addCells(cellOrder);
+
+  impNum.assign(SlotPtr->size(),std::numeric_limits<double>::quiet_NaN());
+  nActive=0;
+  for(size_t i=0;i<Slots.size() && i<impValue.size();i++)
     {
-      nMap[*vc]=*ic;
+      const size_t slot=static_cast<size_t>(Slots[i]);
+      if (std::isnan(impNum[slot])) nActive++;
+      impNum[slot]=impValue[i];
     }
-  impNum=nMap;
   return;
 }
 
@@ -292,38 +349,11 @@ PhysImp::getValue(const int cellN) const
     \return Importance Value
    */
 {
-  std::map<int,double>::const_iterator mc;
-  mc=impNum.find(cellN);
-  if (mc==impNum.end())
+  size_t slot;
+  if (!SlotPtr->findSlot(cellN,slot) || slot>=impNum.size() ||
+      std::isnan(impNum[slot]))
     throw ColErr::InContainerError<int>(cellN,"PhysImp::getValue");
-  return mc->second;
-}
-
-void
-PhysImp::renumberCell(const int oldCellN,const int newCellN)
-  /*!
-    Renumbers a cell 
-    \param oldCellN :: Old cell number
-    \param newCellN :: New cell nubmer
-  */
-{
-  ELog::RegMethod RegA("PhysImp","renumberCell");
-  if (impNum.empty() || oldCellN==newCellN) return;
-  
-  typedef std::map<int,double> ITYPE;
-  ITYPE::iterator mc;
-  if (impNum.find(newCellN)!=impNum.end())
-    throw ColErr::InContainerError<int>(oldCellN,"New cell not found");
-  mc=impNum.find(oldCellN);
-  if (mc==impNum.end())
-    throw ColErr::InContainerError<int>(oldCellN,"Old cell not found "+
-					RegA.getFull());    
-
-  // Doesn't invaidate 
-  impNum.insert(ITYPE::value_type(newCellN,mc->second));
-  impNum.erase(mc);
-
-  return; 
+  return impNum[slot];
 }
 
 int
@@ -354,9 +384,7 @@ PhysImp::write(std::ostream& OX,
 {
   ELog::RegMethod RegA("PhysImp","write");
 
-  std::map<int,double>::const_iterator vc;
-
-  if (!impNum.empty())
+  if (nActive)
     {
       std::ostringstream cx;
       cx<<type;
@@ -371,27 +399,25 @@ PhysImp::write(std::ostream& OX,
 	}
       cx<<" ";
 
-      // for(vc=impNum.begin();vc!=impNum.end();vc++)
-      // 	impList.push_back(std::pair<int,double>(vc->first,vc->second));
-      // impList.sort( mathSupport::PairFstLess<int,double>() );
-      NRange A;
+      // slots are shared by all the cards of the same write
+      const std::vector<long int>& Slots=SlotPtr->getSlots(cellOutOrder);
       std::vector<double> Index;
-      std::vector<int>::const_iterator cvec;
-      for(cvec=cellOutOrder.begin();cvec!=cellOutOrder.end();cvec++)
+      Index.reserve(Slots.size()+static_cast<size_t>(nCutters));
+      for(size_t i=0;i<Slots.size();i++)
 	{
-	  vc=impNum.find(*cvec);
-	  if (vc==impNum.end())
+	  const size_t slot=static_cast<size_t>(Slots[i]);
+	  if (Slots[i]<0 || slot>=impNum.size() || std::isnan(impNum[slot]))
 	    {
-	      ELog::EM<<"Unable to find cell "<<*cvec<<ELog::endCrit;
-	      throw ColErr::InContainerError<int>(*cvec,"Cellnumber in i,pNum");
+	      ELog::EM<<"Unable to find cell "<<cellOutOrder[i]<<ELog::endCrit;
+	      throw ColErr::InContainerError<int>
+		(cellOutOrder[i],"Cellnumber in i,pNum");
 	    }
-	  Index.push_back(vc->second);
+	  Index.push_back(impNum[slot]);
 	}
+      Index.resize(Index.size()+static_cast<size_t>(nCutters),0.0);
 
-      A.setVector(Index);
-      for(int i=0;i<nCutters;i++)
-	A.addComp(0.0);
-      A.condense();  
+      NRange A;
+      A.setCondensed(Index);
       A.write(cx);
       StrFunc::writeMCNPX(cx.str(),OX);
     }
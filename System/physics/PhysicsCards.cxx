@@ -43,6 +43,7 @@
 #include "OutputLog.h"
 #include "support.h"
 #include "MapRange.h"
+#include "NumberMap.h"
 #include "Triple.h"
 #include "SrcData.h"
 #include "SrcItem.h"
@@ -50,6 +51,7 @@
 #include "Source.h"
 #include "KCode.h"
 #include "ModeCard.h"
+#include "CellSlot.h"
 #include "PhysImp.h"
 #include "PhysCard.h"
 #include "PStandard.h"
@@ -72,7 +74,7 @@ PhysicsCards::PhysicsCards() :
   PTRAC(new nameCard("PTRAC",0)),
   dbCard(new nameCard("dbcn",1)),
   voidCard(0),nImpOut(0),prdmp("1e7 1e7 0 2 1e7"),
-  Volume("vol"),ExtCard(new ExtControl),
+  SlotPtr(new CellSlot),Volume("vol",SlotPtr),ExtCard(new ExtControl),
   PWTCard(new PWTControl),DXTCard(new DXTControl)
   /*!
     Constructor
@@ -122,7 +124,7 @@ PhysicsCards::PhysicsCards(const PhysicsCards& A) :
   dbCard(new nameCard(*dbCard)),
   Basic(A.Basic),mode(A.mode),
   voidCard(A.voidCard),nImpOut(A.nImpOut),printNum(A.printNum),
-  prdmp(A.prdmp),ImpCards(A.ImpCards),
+  prdmp(A.prdmp),SlotPtr(new CellSlot(*A.SlotPtr)),ImpCards(A.ImpCards),
   PCards(),LEA(A.LEA),sdefCard(A.sdefCard),
   Volume(A.Volume),
   ExtCard(new ExtControl(*A.ExtCard)),
@@ -133,6 +135,10 @@ PhysicsCards::PhysicsCards(const PhysicsCards& A) :
     \param A :: PhysicsCards to copy
   */
 {
+  // cards are copies of the A cards: move to the slot copy
+  for(PhysImp& PI : ImpCards)
+    PI.setSlotMap(SlotPtr);
+  Volume.setSlotMap(SlotPtr);
   for(const PhysCard* PC : A.PCards)
     PCards.push_back(PC->clone());      
 }
@@ -159,10 +165,14 @@ PhysicsCards::operator=(const PhysicsCards& A)
       voidCard=A.voidCard;
       printNum=A.printNum;
       prdmp=A.prdmp;
+      *SlotPtr=*A.SlotPtr;
       ImpCards=A.ImpCards;
       LEA=A.LEA;
       sdefCard=A.sdefCard;
       Volume=A.Volume;
+      for(PhysImp& PI : ImpCards)
+	PI.setSlotMap(SlotPtr);
+      Volume.setSlotMap(SlotPtr);
       *ExtCard= *A.ExtCard;
       *PWTCard= *A.PWTCard;
       *DXTCard= *A.DXTCard;
@@ -209,6 +219,7 @@ PhysicsCards::clearAll()
   ImpCards.clear();
   deletePCards();
   Volume.clear();
+  SlotPtr->clear();
   sdefCard.clear();
   RAND->reset();
   PTRAC->reset();
@@ -291,7 +302,7 @@ PhysicsCards::processCard(const std::string& Line)
   if (pos!=std::string::npos)
     {
       Comd.erase(0,pos+4);
-      ImpCards.push_back(PhysImp("imp"));
+      ImpCards.push_back(PhysImp("imp",SlotPtr));
       // Ugly hack to get all the a,b,c,d items 
       // since I can't think of the regular expression
       unsigned int index;
@@ -305,7 +316,7 @@ PhysicsCards::processCard(const std::string& Line)
   if (pos!=std::string::npos)
     {
       Comd.erase(0,pos+3);
-      Volume=PhysImp("vol");
+      Volume=PhysImp("vol",SlotPtr);
       return 1;
     }
   
@@ -457,7 +468,7 @@ PhysicsCards::addPhysImp(const std::string& Type,const std::string& Particle)
   catch (ColErr::InContainerError<std::string>&)
     { }       
   // Create a new object
-  ImpCards.push_back(PhysImp(Type));
+  ImpCards.push_back(PhysImp(Type,SlotPtr));
   ImpCards.back().addElm(Particle);
   return ImpCards.back();
 }
@@ -886,22 +897,19 @@ PhysicsCards::getRNDseed() const
 }
   
 void
-PhysicsCards::substituteCell(const int oldCell,const int newCell)
+PhysicsCards::substituteCells(const MapSupport::NumberMap& CMap)
   /*!
     Substitute all cells in all physics cards that use cells
-    \param oldCell :: old cell number
-    \param newCell :: new cell number
+    \param CMap :: Map of old : new cell numbers
    */
 {
-  ELog::RegMethod RegA("PhysicsCards","substituteCell");
-  sdefCard.substituteCell(oldCell,newCell);
-  histpCells.changeItem(oldCell,newCell);
-  for(PhysImp& PI : ImpCards)
-    PI.renumberCell(oldCell,newCell);
-  
-  Volume.renumberCell(oldCell,newCell);
-  PWTCard->renumberCell(oldCell,newCell);
-  ExtCard->renumberCell(oldCell,newCell);
+  ELog::RegMethod RegA("PhysicsCards","substituteCells");
+  sdefCard.substituteCells(CMap);
+  histpCells.changeItems(CMap);
+  // single change for all the PhysImp cards
+  SlotPtr->renumberCells(CMap);
+  PWTCard->renumberCells(CMap);
+  ExtCard->renumberCells(CMap);
 
   return;
 }
@@ -917,6 +925,17 @@ PhysicsCards::substituteSurface(const int oldSurf,const int newSurf)
   sdefCard.substituteSurface(oldSurf,newSurf);
   return;
 }
+
+void
+PhysicsCards::substituteSurfaces(const MapSupport::NumberMap& SMap)
+  /*!
+    Substitute all surfaces in all physics cards that use surface
+    \param SMap :: Map of old : new surface numbers
+  */
+{
+  sdefCard.substituteSurfaces(SMap);
+  return;
+}
   
 void
 PhysicsCards::setMode(std::string Particles) 
@@ -986,6 +1005,22 @@ PhysicsCards::writeHelp(const std::string& keyName) const
 }
   
    
+void
+PhysicsCards::writeRND(std::ostream& OX) const
+  /*!
+    Write the card that holds the random number seed
+    [dbcn for mcnp6 / rand otherwise]. This is the only
+    region of a deck that changes between the -multi files.
+    \param OX :: Output stream
+  */
+{
+  if (mcnpVersion==10)
+    dbCard->write(OX);
+  else
+    RAND->write(OX);
+  return;
+}
+
 void 
 PhysicsCards::write(std::ostream& OX,
 		    const std::vector<int>& cellOutOrder,
@@ -0,0 +1,84 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   physicsInc/CellSlot.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef physicsSystem_CellSlot_h
+#define physicsSystem_CellSlot_h
+
+namespace MapSupport
+{
+  class NumberMap;
+}
+
+namespace physicsSystem
+{
+
+/*!
+  \class CellSlot
+  \version 1.0
+  \date November 2017
+  \author S. Ansell
+  \brief Cell number to column index for the per-cell cards
+
+  Each cell is given a slot [index] when first used.
+  The per-cell cards [PhysImp] hold one value for each
+  slot and share this map, so a renumber is a single
+  change to the map and not to each card. Slots are 
+  never removed. The slots of the last cell list 
+  [normally cellOutOrder] are cached for the write.
+*/
+
+class CellSlot
+{
+ private:
+
+  std::map<int,size_t> slotMap;              ///< cell number : slot
+  std::vector<int> cellNum;                  ///< slot : cell number
+
+  mutable std::vector<int> listCells;        ///< Last cell list 
+  mutable std::vector<long int> listSlots;   ///< Slots of listCells [-1 none]
+
+ public:
+
+  CellSlot();
+  CellSlot(const CellSlot&);
+  CellSlot& operator=(const CellSlot&);
+  ~CellSlot() {}      ///< Destructor
+
+  void clear();
+
+  /// Number of slots
+  size_t size() const { return cellNum.size(); }
+  /// Access cell number of a slot
+  int getCell(const size_t I) const { return cellNum[I]; }
+  /// Access map
+  const std::map<int,size_t>& getMap() const { return slotMap; }
+
+  size_t addCell(const int);
+  bool findSlot(const int,size_t&) const;
+  const std::vector<long int>& getSlots(const std::vector<int>&) const;
+  const std::vector<long int>& addCells(const std::vector<int>&);
+
+  void renumberCells(const MapSupport::NumberMap&);
+};
+
+}
+
+#endif
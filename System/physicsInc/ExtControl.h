@@ -22,6 +22,11 @@
 #ifndef physicsSystem_ExtControl_h
 #define physicsSystem_ExtControl_h
 
+namespace MapSupport
+{
+  class NumberMap;
+}
+
 namespace physicsSystem
 {
  
@@ -70,6 +75,7 @@ class ExtControl
   void setVect(const size_t,const Geometry::Vec3D&);
   size_t addVect(const Geometry::Vec3D&);
   void renumberCell(const int,const int);
+  void renumberCells(const MapSupport::NumberMap&);
   
   void write(std::ostream&,const std::vector<int>&,
 	     const std::set<int>&) const;
@@ -22,6 +22,11 @@
 #ifndef physicsSystem_PWTControl_h
 #define physicsSystem_PWTControl_h
 
+namespace MapSupport
+{
+  class NumberMap;
+}
+
 namespace physicsSystem
 {
  
@@ -61,6 +66,7 @@ class PWTControl
   void setUnit(const int,const double);
 
   void renumberCell(const int,const int);
+  void renumberCells(const MapSupport::NumberMap&);
   
   void write(std::ostream&,const std::vector<int>&,
 	     const std::set<int>&) const;
@@ -25,18 +25,21 @@
 namespace physicsSystem
 {
   template<typename T> class ZoneUnit;
+  class CellSlot;
+  
 /*!
   \class PhysImp 
-  \version 1.0
+  \version 1.1
   \date June 2006
-  \version 1.0
   \author S. Ansell
   \brief Holds imp cards
   
   Holds any card which indexes.
   Has a particle list ie imp:n,h nad
-  a cell mapping to number. The map is ordered
-  prior to being written.
+  a cell mapping to number. The values are held 
+  as a column over the slots of a CellSlot map that
+  is shared with the other cards of the PhysicsCards
+  [and copies]. Unset cells are NaN.
 */
 
 class PhysImp
@@ -45,18 +48,24 @@ class PhysImp
   
   std::string type;                    ///< Type vol,imp etc
   std::list<std::string> particles;    ///< Particle list (if any)
-  std::map<int,double> impNum;         ///< Scale factors etc
+  std::shared_ptr<CellSlot> SlotPtr;   ///< Cell : slot map [shared]
+  std::vector<double> impNum;          ///< Value of each slot 
+  size_t nActive;                      ///< Number of cells set
   int nCutters;                        ///< number of cutter cells (0 at end)
 
+  size_t setSlot(const size_t,const double);
+  
  public:
 
   PhysImp();
   explicit PhysImp(const std::string&);
+  PhysImp(const std::string&,const std::shared_ptr<CellSlot>&);
   PhysImp(const PhysImp&);
   PhysImp& operator=(const PhysImp&);
   ~PhysImp();
 
   void clear();
+  void setSlotMap(const std::shared_ptr<CellSlot>&);
 
   int hasElm(const std::string&) const;
   std::string getParticles() const;
@@ -65,7 +74,8 @@ class PhysImp
   
   ///< Get particle count
   size_t particleCount() const { return particles.size(); }
-  bool isEmpty() const { return impNum.empty(); }
+  /// Check if any cell is set
+  bool isEmpty() const { return !nActive; }
   int removeParticle(const std::string&);
   
   double getValue(const int) const;
@@ -78,7 +88,6 @@ class PhysImp
   void updateCells(const ZoneUnit<double>&);
   void modifyCells(const std::vector<int>&,const double =1.0);
   void removeCell(const int);
-  void renumberCell(const int,const int);
 
   void write(std::ostream&,const std::vector<int>&) const;
   
@@ -22,10 +22,16 @@
 #ifndef PhysicsSystem_PhysicsCards_h
 #define PhysicsSystem_PhysicsCards_h
 
+namespace MapSupport
+{
+  class NumberMap;
+}
+
 namespace physicsSystem
 {
   class dbcnCard;
   class nameCard;
+  class CellSlot;
   class ExtControl;
   class PWTControl;
   class DXTControl;
@@ -63,6 +69,7 @@ class PhysicsCards
   int nImpOut;                            ///< nImp flag [wwg | wcell]
   std::list<int> printNum;                ///< print numbers
   std::string prdmp;                      ///< prdmp string
+  std::shared_ptr<CellSlot> SlotPtr;      ///< Cell slots of the PhysImp cards
   std::vector<PhysImp> ImpCards;          ///< Importance cards
   std::vector<PhysCard*> PCards;          ///< Physics cards
   LSwitchCard LEA;                        ///< LEA/LCA Card
@@ -161,10 +168,12 @@ class PhysicsCards
   long int getRNDseed() const;
 
   void rotateMaster();
-  void substituteCell(const int,const int);
+  void substituteCells(const MapSupport::NumberMap&);
   void substituteSurface(const int,const int); 
+  void substituteSurfaces(const MapSupport::NumberMap&);
 
   void writeHelp(const std::string&) const;
+  void writeRND(std::ostream&) const;
   
   void write(std::ostream&,const std::vector<int>&,
 	     const std::set<int>&) const;   
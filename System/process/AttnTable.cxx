@@ -0,0 +1,161 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/AttnTable.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "AttnTable.h"
+
+namespace ModelSupport
+{
+
+const double AttnTable::r0(1.4);
+const double AttnTable::EMin(1.0);
+
+AttnTable::AttnTable() :
+  NE(1)
+  /*!
+    Constructor : High energy limit only
+  */
+{
+  build();
+}
+
+AttnTable::AttnTable(const std::vector<double>& EVec) :
+  EPts(EVec),NE(std::max<size_t>(1,EVec.size()))
+  /*!
+    Constructor
+    \param EVec :: Energy points [MeV]
+  */
+{
+  build();
+}
+
+AttnTable::AttnTable(const AttnTable& A) :
+  EPts(A.EPts),NE(A.NE),matIndex(A.matIndex),Sigma(A.Sigma)
+  /*!
+    Copy constructor
+    \param A :: AttnTable to copy
+  */
+{}
+
+AttnTable&
+AttnTable::operator=(const AttnTable& A)
+  /*!
+    Assignment operator
+    \param A :: AttnTable to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      EPts=A.EPts;
+      NE=A.NE;
+      matIndex=A.matIndex;
+      Sigma=A.Sigma;
+    }
+  return *this;
+}
+
+double
+AttnTable::lambdaFactor(const double E)
+  /*!
+    Reduced neutron wavelength in units of r0.
+    Energies below EMin are held at EMin as the black
+    nucleus does not hold at low energy.
+    \param E :: Energy [MeV]
+    \return lambda-bar / r0
+  */
+{
+  const double hbarC(197.327);      // MeV fm
+  const double massN(939.565);      // MeV
+  const double EUse=std::max(E,EMin);
+  const double pc=std::sqrt(EUse*(EUse+2.0*massN));
+  return hbarC/(pc*r0);
+}
+
+void
+AttnTable::build()
+  /*!
+    Populate the table from DBMaterial
+  */
+{
+  ELog::RegMethod RegA("AttnTable","build");
+
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+  const std::map<int,MonteCarlo::Material>& MStore=DB.getStore();
+
+  std::vector<double> LFactor;
+  for(const double E : EPts)
+    LFactor.push_back(lambdaFactor(E));
+
+  matIndex.clear();
+  Sigma.clear();
+  Sigma.reserve(MStore.size()*NE);
+  for(const std::map<int,MonteCarlo::Material>::value_type& MItem : MStore)
+    {
+      matIndex.emplace(MItem.first,Sigma.size()/NE);
+      const double density=MItem.second.getAtomDensity();
+      const double ARoot=std::pow(MItem.second.getMeanA(),0.33);
+      if (LFactor.empty())
+	Sigma.push_back(density*ARoot*ARoot);
+      for(const double LF : LFactor)
+	Sigma.push_back(density*(ARoot+LF)*(ARoot+LF));
+    }
+  return;
+}
+
+const double*
+AttnTable::getRow(const int matN) const
+  /*!
+    Access the energy row of a material
+    \param matN :: Material number
+    \return pointer to NE values
+  */
+{
+  std::map<int,size_t>::const_iterator mc=matIndex.find(matN);
+  if (mc==matIndex.end())
+    throw ColErr::InContainerError<int>(matN,"matN in AttnTable");
+  return &Sigma[mc->second*NE];
+}
+
+} // Namespace ModelSupport
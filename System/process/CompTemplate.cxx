@@ -0,0 +1,380 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/CompTemplate.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "CompTemplate.h"
+
+namespace ModelSupport
+{
+
+CompTemplate::CompTemplate(const std::string& baseString) :
+  ruleFlag(0)
+  /*!
+    Constructor
+    \param baseString :: getComposite template
+  */
+{
+  tokenise(baseString);
+}
+
+CompTemplate::CompTemplate(const CompTemplate& A) :
+  TType(A.TType),TValue(A.TValue),TText(A.TText),
+  ruleFlag(A.ruleFlag)
+  /*!
+    Copy constructor
+    \param A :: CompTemplate to copy
+  */
+{}
+
+CompTemplate&
+CompTemplate::operator=(const CompTemplate& A)
+  /*!
+    Assignment operator
+    \param A :: CompTemplate to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      TType=A.TType;
+      TValue=A.TValue;
+      TText=A.TText;
+      ruleFlag=A.ruleFlag;
+    }
+  return *this;
+}
+
+const CompTemplate&
+CompTemplate::getTemplate(const std::string& baseString)
+  /*!
+    Get the template of a string [tokenised on first use].
+    Each thread holds its own cache so no lock is needed.
+    Once the cache is full a new template is built in a
+    scratch item that is replaced by the next such call.
+    Templates built at run time should not come here
+    [use the CompTemplate constructor].
+    \param baseString :: getComposite template
+    \return template 
+  */
+{
+  static thread_local std::map<std::string,CompTemplate> TCache;
+  static thread_local std::unique_ptr<CompTemplate> Scratch;
+
+  std::map<std::string,CompTemplate>::iterator mc=
+    TCache.find(baseString);
+  if (mc!=TCache.end())
+    return mc->second;
+  if (TCache.size()<maxCache)
+    return TCache.emplace(baseString,CompTemplate(baseString)).first->second;
+
+  Scratch.reset(new CompTemplate(baseString));
+  return *Scratch;
+}
+
+void
+CompTemplate::tokenise(const std::string& baseString)
+  /*!
+    Split the template into tokens [as getComposite]
+    \param baseString :: getComposite template
+  */
+{
+  ELog::RegMethod RegA("CompTemplate","tokenise");
+
+  std::string segment=spcDelimString(baseString);
+  std::string OutUnit;
+  int cellN;
+  while(StrFunc::section(segment,OutUnit))
+    {
+      const size_t oL=OutUnit.length();
+      if (!oL) continue;
+
+      int tokT(surfTok);
+      if (OutUnit[oL-1]=='T')
+	tokT=trueTok;
+      else if (OutUnit[oL-1]=='M')
+	tokT=minorTok;
+      else if (OutUnit[oL-1]=='N')
+	tokT=secondTok;
+      if (tokT!=surfTok)
+	OutUnit.erase(oL-1);
+
+      if (StrFunc::convert(OutUnit,cellN))
+	{
+	  TType.push_back(tokT);
+	  TValue.push_back(cellN);
+	  TText.push_back("");
+	  continue;
+	}
+
+      if (OutUnit=="(")
+	tokT=openTok;
+      else if (OutUnit==")")
+	tokT=closeTok;
+      else if (OutUnit==":")
+	tokT=unionTok;
+      else if (OutUnit=="#")
+	tokT=compTok;
+      else if (OutUnit[0]=='#' &&
+	       StrFunc::convert(OutUnit.substr(1),cellN))
+	tokT=cellTok;
+      else
+	tokT=rawTok;
+
+      TType.push_back(tokT);
+      TValue.push_back((tokT==cellTok) ? cellN : 0);
+      TText.push_back(OutUnit);
+    }
+
+  // Check the structure once
+  if (std::find(TType.begin(),TType.end(),rawTok)==TType.end())
+    {
+      Rule* RPtr=buildRule(TValue);
+      ruleFlag=(RPtr) ? 1 : 0;
+      delete RPtr;
+    }
+  return;
+}
+
+std::vector<int>
+CompTemplate::calcSurf(const surfRegister& SMap,const int SOffset,
+		       const int SminorOffset,const int SsecondOffset) const
+  /*!
+    Calculate the real surface number of each token
+    \param SMap :: Surf register
+    \param SOffset :: signed offset number to add
+    \param SminorOffset :: signed minor offset number to add [M]
+    \param SsecondOffset :: signed second offset number to add [N]
+    \return surface/cell number of each token
+  */
+{
+  const int offset[]={SOffset,0,SminorOffset,SsecondOffset};
+
+  std::vector<int> Out(TValue);
+  for(size_t i=0;i<TType.size();i++)
+    {
+      const int tokT(TType[i]);
+      if (tokT==trueTok)
+	Out[i]=SMap.realSurf(TValue[i]);
+      else if (tokT<=secondTok)
+	{
+	  const int SO(offset[tokT]);
+	  const int signV((SO<0) ? -1 : 1);
+	  const int absO((SO<0) ? -SO : SO);
+	  const int cellN(TValue[i]);
+	  Out[i]=(cellN>0) ? signV*SMap.realSurf(cellN+absO) :
+	    signV*SMap.realSurf(cellN-absO);
+	}
+    }
+  return Out;
+}
+
+Rule*
+CompTemplate::procFactor(size_t& index,const std::vector<int>& SN) const
+  /*!
+    Process a surface / cell complement / bracket unit
+    \param index :: token index [updated]
+    \param SN :: surface number of each token
+    \return Rule [new] / 0 on failure
+  */
+{
+  if (index>=TType.size())
+    return 0;
+
+  const int tokT(TType[index]);
+  if (tokT<=secondTok)
+    {
+      SurfPoint* SPtr=new SurfPoint();
+      SPtr->setKeyN(SN[index++]);
+      return SPtr;
+    }
+  if (tokT==cellTok)
+    {
+      CompObj* CPtr=new CompObj();
+      CPtr->setObjN(SN[index++]);
+      return CPtr;
+    }
+  // #( unit ) or ( unit ):
+  const bool compFlag(tokT==compTok);
+  if (compFlag)
+    index++;
+  if (index>=TType.size() || TType[index]!=openTok)
+    return 0;
+  index++;
+
+  Rule* RPtr=procExpr(index,SN);
+  if (!RPtr)
+    return 0;
+  if (index>=TType.size() || TType[index]!=closeTok)
+    {
+      delete RPtr;
+      return 0;
+    }
+  index++;
+  return (compFlag) ? new CompGrp(0,RPtr) : RPtr;
+}
+
+Rule*
+CompTemplate::procTerm(size_t& index,const std::vector<int>& SN) const
+  /*!
+    Process an intersection of units [left to right]
+    \param index :: token index [updated]
+    \param SN :: surface number of each token
+    \return Rule [new] / 0 on failure
+  */
+{
+  Rule* RPtr=procFactor(index,SN);
+  while(RPtr && index<TType.size() &&
+	TType[index]!=unionTok && TType[index]!=closeTok)
+    {
+      Rule* BPtr=procFactor(index,SN);
+      if (!BPtr)
+	{
+	  delete RPtr;
+	  return 0;
+	}
+      RPtr=new Intersection(RPtr,BPtr);
+    }
+  return RPtr;
+}
+
+Rule*
+CompTemplate::procExpr(size_t& index,const std::vector<int>& SN) const
+  /*!
+    Process a union of intersections [left to right]
+    \param index :: token index [updated]
+    \param SN :: surface number of each token
+    \return Rule [new] / 0 on failure
+  */
+{
+  Rule* RPtr=procTerm(index,SN);
+  while(RPtr && index<TType.size() && TType[index]==unionTok)
+    {
+      index++;
+      Rule* BPtr=procTerm(index,SN);
+      if (!BPtr)
+	{
+	  delete RPtr;
+	  return 0;
+	}
+      RPtr=new Union(RPtr,BPtr);
+    }
+  return RPtr;
+}
+
+Rule*
+CompTemplate::buildRule(const std::vector<int>& SN) const
+  /*!
+    Build the rule tree [same tree as HeadRule::procString]
+    \param SN :: surface number of each token
+    \return Rule [new] / 0 if not a complete expression
+  */
+{
+  size_t index(0);
+  Rule* RPtr=procExpr(index,SN);
+  if (RPtr && index!=TType.size())
+    {
+      delete RPtr;
+      return 0;
+    }
+  return RPtr;
+}
+
+std::string
+CompTemplate::makeString(const surfRegister& SMap,const int SOffset,
+			 const int SminorOffset,
+			 const int SsecondOffset) const
+  /*!
+    Write the template with the offsets applied
+    \param SMap :: Surf register
+    \param SOffset :: signed offset number to add
+    \param SminorOffset :: signed minor offset number to add [M]
+    \param SsecondOffset :: signed second offset number to add [N]
+    \return String with offset components
+  */
+{
+  const std::vector<int> SN=
+    calcSurf(SMap,SOffset,SminorOffset,SsecondOffset);
+
+  std::ostringstream cx;
+  cx<<" ";
+  for(size_t i=0;i<TType.size();i++)
+    {
+      if (TType[i]<=secondTok)
+	cx<<SN[i]<<" ";
+      else
+	cx<<TText[i]<<" ";
+    }
+  return cx.str();
+}
+
+HeadRule
+CompTemplate::makeRule(const surfRegister& SMap,const int SOffset,
+		       const int SminorOffset,
+		       const int SsecondOffset) const
+  /*!
+    Build the HeadRule of the template with the offsets applied
+    \param SMap :: Surf register
+    \param SOffset :: signed offset number to add
+    \param SminorOffset :: signed minor offset number to add [M]
+    \param SsecondOffset :: signed second offset number to add [N]
+    \return HeadRule [empty if the template is empty]
+  */
+{
+  HeadRule Out;
+  if (!ruleFlag)
+    {
+      Out.procString(makeString(SMap,SOffset,SminorOffset,SsecondOffset));
+      return Out;
+    }
+  Rule* RPtr=buildRule(calcSurf(SMap,SOffset,SminorOffset,SsecondOffset));
+  Out.procRule(RPtr);
+  delete RPtr;
+  return Out;
+}
+
+} // NAMESPACE ModelSupport
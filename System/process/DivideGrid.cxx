@@ -52,6 +52,7 @@
 #include "XMLobject.h"
 #include "XMLgroup.h"
 #include "XMLcollect.h"
+#include "XMLpull.h"
 #include "MaterialSupport.h"
 
 #include "DivideGrid.h"
@@ -139,61 +140,55 @@ int
 DivideGrid::loadXML(const std::string& FName,
 		    const std::string& objName) 
   /*!
-    Process an XML file to set/add variables
-    
+    Process an XML file to set the materials. The
+    file is read as a stream and each objName element
+    is processed as it is found.
     \param FName :: filename 
-    \param objName :: Object name
+    \param objName :: Object name [or path A/B]
     \return 1 on success / 0 on fail
   */
 {
   ELog::RegMethod RegA("DivideGrid","loadXML");
   
-  XML::XMLcollect CO;
-  if (FName.empty() || CO.loadXML(FName))
+  XML::XMLpull XP;
+  if (FName.empty() || XP.openFile(FName))
     return 0;
 
-
   MatMap.clear();
-  // Check parameters;
-  XML::XMLobject* AR;
-  // Parse for variables:
-  AR=CO.findObj(objName);
-  std::string MatName;
-  if (!AR)
-    throw ColErr::InContainerError<std::string>(objName,"ObjName not in XML");
-
-  while(AR)
+  bool foundFlag(0);
+  std::vector<size_t> SVec,VVec,RVec;
+  XML::XMLpull::EventType ET;
+  while( (ET=XP.next())!=XML::XMLpull::endFile )
     {
+      if ((ET!=XML::XMLpull::startElm && ET!=XML::XMLpull::emptyElm) ||
+	  !XP.matchPath(objName))
+	continue;
 
-      std::vector<size_t> SVec,VVec,RVec;
-      std::string SStr=AR->getItem<std::string>(IJKnames[0]);    
-      std::string VStr=AR->getItem<std::string>(IJKnames[1]);
-      std::string RStr=AR->getItem<std::string>(IJKnames[2]);
+      foundFlag=1;
+      std::string SStr=XP.getAttribute(IJKnames[0]);    
+      std::string VStr=XP.getAttribute(IJKnames[1]);
+      std::string RStr=XP.getAttribute(IJKnames[2]);
 
       // Input form is for type A:B:C / A,B,C
       // Take input and convert the range into number
-
+      SVec.clear();
+      VVec.clear();
+      RVec.clear();
       StrFunc::sectionRange(SStr,SVec);
       StrFunc::sectionRange(VStr,VVec);
       StrFunc::sectionRange(RStr,RVec);
 
-
+      const std::string MatName=
+	StrFunc::fullBlock(XP.getValue("Material"));
       for(const size_t SN : SVec)
 	for(const size_t VN : VVec)
 	  for(const size_t RN : RVec)
-	    {
-	      MatName= AR->getNamedItem<std::string>("Material");
-	      MatName=StrFunc::fullBlock(MatName);
-	      const size_t HN=DivideGrid::hash(SN,VN,RN);
-	      std::map<size_t,std::string>::iterator mc=MatMap.find(HN);
-	      if (mc!=MatMap.end())
-		mc->second=MatName;
-	      else
-		MatMap.emplace(HN,MatName);
-	    }
-      CO.deleteObj(AR);      
-      AR=CO.findObj(objName);
+	    MatMap[DivideGrid::hash(SN,VN,RN)]=MatName;
     }
+  
+  if (!foundFlag)
+    throw ColErr::InContainerError<std::string>(objName,"ObjName not in XML");
+
   return (MatMap.empty()) ? 0 : 1;
 }
 
@@ -3,7 +3,7 @@
  
  * File:   essBuild/LayerDivide3D.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -345,18 +345,21 @@ LayerDivide1D::divideCell(Simulation& System,const int cellN)
 
   ALen=processSurface(AWall,AFrac);
 
-  std::string Out;
+  HeadRule DRule;
+  if (!divider.empty())
+    DRule.procString(divider);
+
   int aIndex(divIndex);
   for(size_t i=0;i<ALen;i++,aIndex++)
     {
       const std::string layerNum(StrFunc::makeString(i));
-      const std::string ACut=
-        ModelSupport::getComposite(SMap,aIndex,"1 -2");
+      HeadRule ACut=
+        ModelSupport::getCompositeRule(SMap,aIndex,"1 -2");
+      ACut.addIntersection(DRule);
       
       const int Mat=DGPtr->getMaterial(i+1,0,0);
-      ELog::EM<<"ADD Cell"<<ACut<<ELog::endDiag;
-      System.addCell(MonteCarlo::Qhull(cellIndex++,Mat,0.0,
-                                       ACut+divider));
+      ELog::EM<<"ADD Cell"<<ACut.display()<<ELog::endDiag;
+      System.addCell(MonteCarlo::Qhull(cellIndex++,Mat,0.0,ACut));
       ELog::EM<<"Post Remove"<<ELog::endDiag;
       attachSystem::CellMap::addCell("LD1:"+layerNum,cellIndex-1);
     }
@@ -3,7 +3,7 @@
  
  * File:   essBuild/LayerDivide3D.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -91,7 +91,8 @@ LayerDivide3D::LayerDivide3D(const std::string& Key)  :
   FixedComp(Key,0),
   divIndex(ModelSupport::objectRegister::Instance().cell(Key,20000)),
   cellIndex(divIndex+1),
-  WallID({"Sector","Vert","Radial"}),DGPtr(0)
+  WallID({"Sector","Vert","Radial"}),latticeFlag(0),
+  latticeCell(0),fillCell(0),DGPtr(0)
   /*!
     Constructor BUT ALL variable are left unpopulated.
     \param Key :: Name for item in search
@@ -105,6 +106,8 @@ LayerDivide3D::LayerDivide3D(const LayerDivide3D& A) :
   AFrac(A.AFrac),BFrac(A.BFrac),CFrac(A.CFrac),
   ALen(A.ALen),BLen(A.BLen),CLen(A.CLen),WallID(A.WallID),
   AWall(A.AWall),BWall(A.BWall),CWall(A.CWall),divider(A.divider),
+  latticeFlag(A.latticeFlag),latticeCell(A.latticeCell),
+  fillCell(A.fillCell),elemCell(A.elemCell),
   DGPtr((A.DGPtr) ? new DivideGrid(*A.DGPtr) : 0),
   objName(A.objName),
   loadFile(A.loadFile),outputFile(A.outputFile)
@@ -140,6 +143,10 @@ LayerDivide3D::operator=(const LayerDivide3D& A)
       BWall=A.BWall;
       CWall=A.CWall;
       divider=A.divider;
+      latticeFlag=A.latticeFlag;
+      latticeCell=A.latticeCell;
+      fillCell=A.fillCell;
+      elemCell=A.elemCell;
       delete DGPtr;
       DGPtr=(A.DGPtr) ? new DivideGrid(*A.DGPtr) : 0;
       objName=A.objName;
@@ -382,6 +389,19 @@ LayerDivide3D::setDivider(const std::string& SurfStr)
   return;
 }
   
+void
+LayerDivide3D::setLattice(const bool LFlag)
+  /*!
+    Set the division to be written as a lat=1 universe 
+    with a fill array. Only used if all the layers are 
+    evenly spaced parallel planes.
+    \param LFlag :: Lattice flag
+  */
+{
+  latticeFlag=LFlag;
+  return;
+}
+  
 void
 LayerDivide3D::checkDivide() const
   /*!
@@ -475,65 +495,257 @@ LayerDivide3D::setMaterialXML(const std::string& LFile,
 }
 
   
-void
-LayerDivide3D::divideCell(Simulation& System,const int cellN)
+bool
+LayerDivide3D::isRegular(const size_t Index,const size_t NLen) const
   /*!
-    Create a tesselated main wall
-    \param System :: Simulation to use
-    \param cellN :: Cell number
+    Determine if a layer set is evenly spaced parallel planes
+    \param Index :: A/B/C surface
+    \param NLen :: Number of segments
+    \return true if a lattice can step the layers
   */
 {
-  ELog::RegMethod RegA("LayerDivide3D","divideCell");
+  ELog::RegMethod RegA("LayerDivide3D","isRegular");
 
-  checkDivide();
-  
-  ModelSupport::DBMaterial& DB=
-    ModelSupport::DBMaterial::Instance();
+  const int surfN(divIndex+1000*static_cast<int>(Index)+1);
+  const Geometry::Plane* APtr=
+    dynamic_cast<const Geometry::Plane*>(SMap.realSurfPtr(surfN));
+  if (!APtr) return 0;
 
-  const MonteCarlo::Object* CPtr=System.findQhull(cellN);
-  if (!CPtr)
-    throw ColErr::InContainerError<int>(cellN,"cellN");
+  const Geometry::Vec3D& ANorm=APtr->getNormal();
+  double prevD(APtr->getDistance());
+  double gap(0.0);
+  for(size_t i=1;i<=NLen;i++)
+    {
+      const Geometry::Plane* PPtr=dynamic_cast<const Geometry::Plane*>
+	(SMap.realSurfPtr(surfN+static_cast<int>(i)));
+      if (!PPtr) return 0;
+      const double NDot=ANorm.dotProd(PPtr->getNormal());
+      if (std::abs(NDot)<1.0-Geometry::zeroTol)
+	return 0;
+      const double D((NDot>0.0) ? PPtr->getDistance() : -PPtr->getDistance());
+      if (i==1)
+	gap=D-prevD;
+      else if (std::abs(D-prevD-gap)>Geometry::zeroTol*(1.0+std::abs(gap)))
+	return 0;
+      prevD=D;
+    }
+  return 1;
+}
 
+Geometry::Vec3D
+LayerDivide3D::layerAxis(const size_t Index) const
+  /*!
+    Direction from the first layer to the second layer 
+    of a set of parallel planes
+    \param Index :: A/B/C surface
+    \return direction of increasing layer index
+  */
+{
+  ELog::RegMethod RegA("LayerDivide3D","layerAxis");
+
+  const int surfN(divIndex+1000*static_cast<int>(Index)+1);
+  const Geometry::Plane* APtr=
+    dynamic_cast<const Geometry::Plane*>(SMap.realSurfPtr(surfN));
+  const Geometry::Plane* BPtr=
+    dynamic_cast<const Geometry::Plane*>(SMap.realSurfPtr(surfN+1));
+  if (!APtr || !BPtr)
+    throw ColErr::InContainerError<int>(surfN,"Layer planes");
+
+  const Geometry::Vec3D& ANorm=APtr->getNormal();
+  const double D((ANorm.dotProd(BPtr->getNormal())>0.0) ?
+		 BPtr->getDistance() : -BPtr->getDistance());
+  return (D>APtr->getDistance()) ? ANorm : ANorm*-1.0;
+}
 
-  ALen=processSurface(0,AWall,AFrac);
-  BLen=processSurface(1,BWall,BFrac);
-  CLen=processSurface(2,CWall,CFrac);
+void
+LayerDivide3D::divideExplicit(Simulation& System,const int cellN)
+  /*!
+    Replace the cell with a cell for each element
+    \param System :: Simulation to use
+    \param cellN :: Cell number
+  */
+{
+  ELog::RegMethod RegA("LayerDivide3D","divideExplicit");
 
+  // rules are built directly : no string per element
+  HeadRule DRule;
+  if (!divider.empty())
+    DRule.procString(divider);
 
-  std::string Out;
   int aIndex(divIndex);
   for(size_t i=0;i<ALen;i++,aIndex++)
     {
       const std::string layerNum(StrFunc::makeString(i));
-      const std::string ACut=
-        ModelSupport::getComposite(SMap,aIndex,"1 -2");
+      HeadRule ACut=
+        ModelSupport::getCompositeRule(SMap,aIndex,"1 -2");
+      ACut.addIntersection(DRule);
       
       int bIndex(divIndex+1000);
       
       for(size_t j=0;j<BLen;j++,bIndex++)
 	{
-	  const std::string BCut=
-	    ModelSupport::getComposite(SMap,bIndex," 1 -2 ")+ACut;
+	  HeadRule BCut=
+	    ModelSupport::getCompositeRule(SMap,bIndex,"1 -2");
+	  BCut.addIntersection(ACut);
 	  int cIndex(divIndex+2000);
 	  
 	  for(size_t k=0;k<CLen;k++,cIndex++)
 	    {
-	      const std::string CCut=
-		ModelSupport::getComposite(SMap,cIndex,"1 -2")+BCut;
+	      HeadRule CCut=
+		ModelSupport::getCompositeRule(SMap,cIndex,"1 -2");
+	      CCut.addIntersection(BCut);
 	      const int Mat=DGPtr->getMaterial(i+1,j+1,k+1);
 	      
-	      System.addCell(MonteCarlo::Qhull(cellIndex++,Mat,0.0,
-					       CCut+divider));
+	      System.addCell(MonteCarlo::Qhull(cellIndex++,Mat,0.0,CCut));
+	      elemCell.push_back(cellIndex-1);
 	      attachSystem::CellMap::addCell
                 ("LD3:"+layerNum,cellIndex-1);
       	    }
 	}
     }
   System.removeCell(cellN);
+  return;
+}
+
+void
+LayerDivide3D::divideLattice(Simulation& System,const int cellN)
+  /*!
+    Fill the cell with a lat=1 lattice. Each material 
+    is a universe of a single cell covering all space. 
+    The cell keeps its boundary [walls+divider] but becomes 
+    void and is filled with the lattice universe.
+    \param System :: Simulation to use
+    \param cellN :: Cell number
+  */
+{
+  ELog::RegMethod RegA("LayerDivide3D","divideLattice");
+
+  MonteCarlo::Qhull* CPtr=System.findQhull(cellN);
+
+  // universe numbers are the number of the universe cell
+  const std::string allSpace=
+    ModelSupport::getComposite(SMap,divIndex," 1 : -1 ");
+  std::map<int,int> matUniv;
+  for(size_t i=0;i<ALen;i++)
+    for(size_t j=0;j<BLen;j++)
+      for(size_t k=0;k<CLen;k++)
+	{
+	  const int Mat=DGPtr->getMaterial(i+1,j+1,k+1);
+	  std::map<int,int>::const_iterator mc=matUniv.find(Mat);
+	  if (mc==matUniv.end())
+	    {
+	      MonteCarlo::Qhull UCell(cellIndex,Mat,0.0,allSpace);
+	      UCell.setUniverse(cellIndex);
+	      System.addCell(UCell);
+	      mc=matUniv.emplace(Mat,cellIndex++).first;
+	    }
+	  elemCell.push_back(mc->second);
+	}
+
+  // MCNP fill order : first index fastest
+  std::vector<int> fillUniv;
+  fillUniv.reserve(elemCell.size());
+  for(size_t k=0;k<CLen;k++)
+    for(size_t j=0;j<BLen;j++)
+      for(size_t i=0;i<ALen;i++)
+	fillUniv.push_back(elemCell[(i*BLen+j)*CLen+k]);
+
+  // Element [0,0,0] : the faces are written in index order
+  // [+i,-i,+j,-j,+k,-k] from the layer directions
+  latticeCell=cellIndex++;
+  fillCell=cellN;
+  MonteCarlo::Qhull LCell
+    (latticeCell,0,0.0,ModelSupport::getCompositeRule
+     (SMap,divIndex," 1 -2 1001 -1002 2001 -2002 "));
+  LCell.setUniverse(latticeCell);
+  LCell.setLattice(1,ALen,BLen,CLen,fillUniv);
+  LCell.setLatticeAxis(layerAxis(0),layerAxis(1),layerAxis(2));
+  System.addCell(LCell);
+
+  CPtr->setMaterial(0);
+  CPtr->setFill(latticeCell);
+
+  // A universe is shared by every element of its material so
+  // there are no LD3:<layer> cells : use getCellRef for an element
+  for(const std::map<int,int>::value_type& MU : matUniv)
+    attachSystem::CellMap::addCell("LD3Universe",MU.second);
+  attachSystem::CellMap::addCell("LD3Lattice",latticeCell);
+  return;
+}
+
+void
+LayerDivide3D::divideCell(Simulation& System,const int cellN)
+  /*!
+    Create a tesselated main wall
+    \param System :: Simulation to use
+    \param cellN :: Cell number
+  */
+{
+  ELog::RegMethod RegA("LayerDivide3D","divideCell");
+
+  checkDivide();
+  
+  const MonteCarlo::Object* CPtr=System.findQhull(cellN);
+  if (!CPtr)
+    throw ColErr::InContainerError<int>(cellN,"cellN");
+
+  ALen=processSurface(0,AWall,AFrac);
+  BLen=processSurface(1,BWall,BFrac);
+  CLen=processSurface(2,CWall,CFrac);
+
+  elemCell.clear();
+  if (latticeFlag && isRegular(0,ALen) &&
+      isRegular(1,BLen) && isRegular(2,CLen))
+    divideLattice(System,cellN);
+  else
+    {
+      if (latticeFlag)
+	ELog::EM<<"Lattice not possible for "<<keyName
+		<<" [layers not even parallel planes] : "
+		<<"using explicit cells"<<ELog::endWarn;
+      divideExplicit(System,cellN);
+    }
+  
   if (DGPtr && !outputFile.empty())
     DGPtr->writeXML(outputFile,objName,ALen,BLen,CLen);
 
   return;
 }
 
+std::string
+LayerDivide3D::getCellRef(const size_t i,const size_t j,
+			  const size_t k) const
+  /*!
+    Get the tally reference of an element. This is the cell 
+    number for explicit cells or the universe-qualified
+    path ( cell < lattice[i j k] < fill cell ) for a lattice.
+    A lattice has no LD3:<layer> cells [the universes are
+    shared between layers] so this is the only element reference.
+    \param i :: A index
+    \param j :: B index
+    \param k :: C index
+    \return tally cell reference
+  */
+{
+  ELog::RegMethod RegA("LayerDivide3D","getCellRef");
+
+  if (i>=ALen)
+    throw ColErr::IndexError<size_t>(i,ALen,"A index");
+  if (j>=BLen)
+    throw ColErr::IndexError<size_t>(j,BLen,"B index");
+  if (k>=CLen)
+    throw ColErr::IndexError<size_t>(k,CLen,"C index");
+  if (elemCell.size()!=ALen*BLen*CLen)
+    throw ColErr::EmptyValue<int>("Cell not divided");
+
+  const int CN=elemCell[(i*BLen+j)*CLen+k];
+  if (!latticeCell)
+    return StrFunc::makeString(CN);
+
+  std::ostringstream cx;
+  cx<<"( "<<CN<<" < "<<latticeCell<<"["<<i<<" "<<j<<" "<<k
+    <<"] < "<<fillCell<<" )";
+  return cx.str();
+}
+
 }  // NAMESPACE ModelSupport
@@ -149,7 +149,7 @@ LineTrack::calculate(const Simulation& ASim)
     \param ASim :: Simulation to use						
   */
 {
-  ELog::RegMethod RegA("LineTrack","calculate");
+  ELog::RegHot RegA("LineTrack","calculate");
 
   double aDist(0);                         // Length of track
   const Geometry::Surface* SPtr;           // Surface
@@ -290,7 +290,7 @@ LineTrack::updateDistance(MonteCarlo::Object* OPtr,const double D)
     \return 1 if distance insufficient / 0 if at end of line
    */
 {
-  ELog::RegMethod RegA("LineTrack","updateDistance");
+  ELog::RegHot RegA("LineTrack","updateDistance");
 
   Cells.push_back(OPtr->getName());
   ObjVec.push_back(OPtr);
@@ -94,6 +94,7 @@ createInputs(inputParam& IParam)
   IParam.regFlag("md5","md5");
   IParam.regItem("memStack","memStack");
   IParam.regDefItem<int>("n","nps",1,10000);
+  IParam.regItem("nThread","nThread",1);
   IParam.regFlag("p","PHITS");
   IParam.regFlag("fluka","FLUKA");
   IParam.regItem("povray","PovRay");
@@ -140,6 +141,8 @@ createInputs(inputParam& IParam)
   IParam.regItem("volCard","volCard");
   IParam.regDefItem<int>("VN","volNum",1,20000);
   IParam.regMulti("volCell","volCells",100,1,100);
+  IParam.regItem("volError","volError",1);
+  IParam.regItem("volSample","volSample",1);
     
   IParam.regFlag("void","void");
   IParam.regFlag("vtk","vtk");
@@ -210,6 +213,7 @@ createInputs(inputParam& IParam)
   IParam.setDesc("md5","MD5 track of cells");
   IParam.setDesc("memStack","Memstack verbrosity value");
   IParam.setDesc("n","Number of starting particles");
+  IParam.setDesc("nThread","Number of threads for the threaded calculations");
   IParam.setDesc("MCNP","MCNP version");
   IParam.setDesc("FLUKA","FLUKA output");
   IParam.setDesc("PovRay","PovRay output");
@@ -246,6 +250,8 @@ createInputs(inputParam& IParam)
   IParam.setDesc("volume","Create volume about point/radius for f4 tally");
   IParam.setDesc("volCells","Cells [object/range]");
   IParam.setDesc("volCard","set/delete the vol card");
+  IParam.setDesc("volError","Relative error to stop volume calculation");
+  IParam.setDesc("volSample","Volume points : random/stratified/halton");
   IParam.setDesc("vtk","Write out VTK plot mesh");
   IParam.setDesc("vcell","Use cell id rather than material");
   IParam.setDesc("vmat","Material sections to be written by vtk output");
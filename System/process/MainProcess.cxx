@@ -491,7 +491,6 @@ buildFullSimulation(Simulation* SimPtr,
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimulation");
 
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
 
   tallyAddition(*SimPtr,IParam);
@@ -514,13 +513,14 @@ buildFullSimulation(Simulation* SimPtr,
   tallyModification(*SimPtr,IParam);
 
   SDef::sourceSelection(*SimPtr,IParam);
-  // Ensure we done loop
-  do
-    {
-      SimProcess::writeIndexSim(*SimPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  // card write threads [-nThread : replaces -writeThread]
+  if (IParam.flag("nThread"))
+    SimPtr->setWriteThreads(IParam.getValue<size_t>("nThread"));
+  // the -multi decks only differ in the RND seed
+  if (multi>1)
+    SimProcess::writeMultiSim(*SimPtr,OName,multi);
+  else
+    SimProcess::writeIndexSim(*SimPtr,OName,0);
 
   return;
 }
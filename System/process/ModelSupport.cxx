@@ -3,7 +3,7 @@
  
  * File:   process/ModelSupport.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -32,9 +32,21 @@
 #include <string>
 #include <algorithm>
 
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
 #include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "HeadRule.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
+#include "CompTemplate.h"
 
 namespace ModelSupport
 {
@@ -187,65 +199,8 @@ getComposite(const surfRegister& SMap,const int SOffset,
     \return String with offset components
    */
 {
-  std::ostringstream cx;
-  
-  int cellN;
-  int TrueNum,MinorNum,SecondNum;
-  std::string segment=spcDelimString(baseString);
-  std::string OutUnit;
-
-  const int Offset((SOffset<0) ? -SOffset : SOffset);
-  const int signV((SOffset<0) ? -1 : 1); 
-  const int minorOffset((SminorOffset<0) ? -SminorOffset : SminorOffset);
-  const int minorSignV((SminorOffset<0) ? -1 : 1); 
-  const int secondOffset((SsecondOffset<0) ? -SsecondOffset : SsecondOffset);
-  const int secondSignV((SsecondOffset<0) ? -1 : 1); 
-
-  
-  cx<<" ";
-  while(StrFunc::section(segment,OutUnit))
-    {
-      const size_t oL=OutUnit.length();
-      if (oL)
-	{
-	  TrueNum=MinorNum=SecondNum=0;
-	  if (OutUnit[oL-1]=='T')
-	    {
-	      OutUnit[oL-1]=' ';
-	      TrueNum=1;
-	    }
-	  else if (OutUnit[oL-1]=='M')
-	    {
-	      OutUnit[oL-1]=' ';
-	      MinorNum=1;
-	    }
-	  else if (OutUnit[oL-1]=='N')
-	    {
-	      OutUnit[oL-1]=' ';
-	      SecondNum=1;
-	    }
-	  if (StrFunc::convert(OutUnit,cellN))
-	    {
-	      if (TrueNum)
-		cx<<SMap.realSurf(cellN);
-	      else if (MinorNum)
-		cx<<((cellN>0) ?
-                     minorSignV*SMap.realSurf(cellN+minorOffset) 
-		     : minorSignV*SMap.realSurf(cellN-minorOffset))<<" ";
-	      else if (SecondNum)
-		cx<<((cellN>0) ?
-                     secondSignV*SMap.realSurf(cellN+secondOffset) 
-		     : secondSignV*SMap.realSurf(cellN-secondOffset))<<" ";
-	      else
-		cx<<((cellN>0) ?
-                     signV*SMap.realSurf(cellN+Offset) 
-		     : signV*SMap.realSurf(cellN-Offset))<<" ";
-	    }
-	  else
-	    cx<<OutUnit<<" ";
-	}
-    }
-  return cx.str();
+  return CompTemplate::getTemplate(baseString).
+    makeString(SMap,SOffset,SminorOffset,SsecondOffset);
 }
 
 std::string
@@ -255,7 +210,7 @@ getComposite(const surfRegister& SMap,const int SOffset,
   /*!
     Given a base string add an offset to the numbers
     If a number is preceeded by T then it is a true number.
-    Use T-4000 etc.
+    Use T-4000 etc. The second offset [N] is the minor offset.
     \param SMap :: Surf register 
     \param SOffset :: Offset nubmer to add
     \param SminorOffset :: minor Offset nubmer to add [M]
@@ -263,52 +218,8 @@ getComposite(const surfRegister& SMap,const int SOffset,
     \return String with offset components
    */
 {
-  std::ostringstream cx;
-  
-  int cellN;
-  int TrueNum,MinorNum;
-  std::string segment=spcDelimString(BaseString);
-  std::string OutUnit;
-
-  const int Offset((SOffset<0) ? -SOffset : SOffset);
-  const int signV((SOffset<0) ? -1 : 1); 
-  const int minorOffset((SminorOffset<0) ? -SminorOffset : SminorOffset);
-  const int minorSignV((SminorOffset<0) ? -1 : 1); 
-
-  
-  cx<<" ";
-  while(StrFunc::section(segment,OutUnit))
-    {
-      const size_t oL=OutUnit.length();
-      if (oL)
-	{
-	  TrueNum=MinorNum=0;
-	  if (OutUnit[oL-1]=='T')
-	    {
-	      OutUnit[oL-1]=' ';
-	      TrueNum=1;
-	    }
-	  else if (OutUnit[oL-1]=='M')
-	    {
-	      OutUnit[oL-1]=' ';
-	      MinorNum=1;
-	    }
-	  if (StrFunc::convert(OutUnit,cellN))
-	    {
-	      if (TrueNum)
-		cx<<SMap.realSurf(cellN);
-	      else if (MinorNum)
-		cx<<((cellN>0) ? minorSignV*SMap.realSurf(cellN+minorOffset) 
-		     : minorSignV*SMap.realSurf(cellN-minorOffset))<<" ";
-	      else
-		cx<<((cellN>0) ? signV*SMap.realSurf(cellN+Offset) 
-		     : signV*SMap.realSurf(cellN-Offset))<<" ";
-	    }
-	  else
-	    cx<<OutUnit<<" ";
-	}
-    }
-  return cx.str();
+  return CompTemplate::getTemplate(BaseString).
+    makeString(SMap,SOffset,SminorOffset,SminorOffset);
 }
 
 std::string
@@ -328,8 +239,75 @@ getComposite(const surfRegister& SMap,
   return getComposite(SMap,Offset,Offset,BaseString);
 }
 
+std::string
+getDynamicComposite(const surfRegister& SMap,const int Offset,
+		    const std::string& BaseString)
+  /*!
+    As getComposite for a template built at run time.
+    The template is not held in the cache.
+    \param SMap :: Surf register 
+    \param Offset :: Offset nubmer to add
+    \param BaseString :: BaseString number
+    \return String with offset components
+   */
+{
+  return CompTemplate(BaseString).makeString(SMap,Offset,Offset,Offset);
+}
 
 
+
+HeadRule
+getCompositeRule(const surfRegister& SMap,const int SOffset,
+		 const int SminorOffset,const int SsecondOffset,
+		 const std::string& BaseString)
+  /*!
+    Given a base string add an offset to the numbers and
+    build the rule without an intermediate string.
+    \param SMap :: Surf register 
+    \param SOffset :: Offset nubmer to add
+    \param SminorOffset :: minor Offset nubmer to add [M]
+    \param SsecondOffset :: second Offset nubmer to add [N]
+    \param BaseString :: BaseString number
+    \return HeadRule of the offset components
+   */
+{
+  return CompTemplate::getTemplate(BaseString).
+    makeRule(SMap,SOffset,SminorOffset,SsecondOffset);
+}
+
+HeadRule
+getCompositeRule(const surfRegister& SMap,const int SOffset,
+		 const int SminorOffset,const std::string& BaseString)
+  /*!
+    Given a base string add an offset to the numbers and
+    build the rule without an intermediate string.
+    \param SMap :: Surf register 
+    \param SOffset :: Offset nubmer to add
+    \param SminorOffset :: minor Offset nubmer to add [M/N]
+    \param BaseString :: BaseString number
+    \return HeadRule of the offset components
+   */
+{
+  return CompTemplate::getTemplate(BaseString).
+    makeRule(SMap,SOffset,SminorOffset,SminorOffset);
+}
+
+HeadRule
+getCompositeRule(const surfRegister& SMap,const int Offset,
+		 const std::string& BaseString)
+  /*!
+    Given a base string add an offset to the numbers and
+    build the rule without an intermediate string.
+    \param SMap :: Surf register 
+    \param Offset :: Offset nubmer to add
+    \param BaseString :: BaseString number
+    \return HeadRule of the offset components
+   */
+{
+  return CompTemplate::getTemplate(BaseString).
+    makeRule(SMap,Offset,Offset,Offset);
+}
+
 std::string
 getSetComposite(const surfRegister& SMap,const int Offset,
 		const int MinorOffset,
@@ -0,0 +1,373 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/ObjBVH.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ObjBVH.h"
+
+namespace ModelSupport
+{
+
+const size_t ObjBVH::leafSize(4);
+
+ObjBVH::ObjBVH() :
+  validFlag(0),ruleChange(0)
+  /*!
+    Constructor
+  */
+{}
+
+ObjBVH::ObjBVH(const ObjBVH&) :
+  validFlag(0),ruleChange(0)
+  /*!
+    Copy constructor : The object pointers belong
+    to another simulation so the tree is not copied.
+  */
+{}
+
+ObjBVH&
+ObjBVH::operator=(const ObjBVH& A)
+  /*!
+    Assignment operator : tree must be rebuilt
+    \param A :: ObjBVH to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    clearAll();
+  return *this;
+}
+
+void
+ObjBVH::clearAll()
+  /*!
+    Remove the tree
+  */
+{
+  validFlag=0;
+  ruleChange=0;
+  ObjVec.clear();
+  BoxVec.clear();
+  RuleVec.clear();
+  TreeFlag.clear();
+  cellIndex.clear();
+  unBound.clear();
+  itemIndex.clear();
+  Nodes.clear();
+  return;
+}
+
+Geometry::BoundBox
+ObjBVH::cellBox(const MonteCarlo::Object& Obj)
+  /*!
+    Box of a cell : unpopulated cells are unbounded
+    \param Obj :: Cell
+    \return bounding box
+  */
+{
+  return (Obj.isPopulated()) ? Obj.calcBoundBox() : Geometry::BoundBox();
+}
+
+void
+ObjBVH::build(const std::map<int,MonteCarlo::Qhull*>& OMap)
+  /*!
+    Build the tree from the cell map. Cells must
+    be populated.
+    \param OMap :: Map of cells [cell number order]
+  */
+{
+  ELog::RegMethod RegA("ObjBVH","build");
+
+  clearAll();
+  ruleChange=MonteCarlo::Object::getRuleChange();
+  ObjVec.reserve(OMap.size());
+  BoxVec.reserve(OMap.size());
+  RuleVec.reserve(OMap.size());
+  TreeFlag.reserve(OMap.size());
+  for(const std::map<int,MonteCarlo::Qhull*>::value_type& MC : OMap)
+    {
+      MonteCarlo::Object* OPtr=MC.second;
+      cellIndex.insert(std::map<int,size_t>::value_type
+		       (MC.first,ObjVec.size()));
+      BoxVec.push_back(cellBox(*OPtr));
+      RuleVec.push_back(OPtr->getRuleIndex());
+      TreeFlag.push_back(BoxVec.back().isFinite() ? 1 : 0);
+
+      if (TreeFlag.back())
+	itemIndex.push_back(ObjVec.size());
+      else if (!BoxVec.back().isEmpty())
+	unBound.push_back(ObjVec.size());
+      ObjVec.push_back(OPtr);
+    }
+
+  if (!itemIndex.empty())
+    {
+      Nodes.reserve(2*itemIndex.size()/leafSize+2);
+      buildNode(0,itemIndex.size());
+    }
+  validFlag=1;
+  return;
+}
+
+void
+ObjBVH::update(const std::map<int,MonteCarlo::Qhull*>& OMap)
+  /*!
+    Bring the tree up to date : build if invalid, otherwise
+    refit the cells whose rule has changed since the last fit.
+    Not thread safe : update before concurrent queries.
+    \param OMap :: Map of cells [cell number order]
+  */
+{
+  if (!validFlag)
+    build(OMap);
+  else if (ruleChange!=MonteCarlo::Object::getRuleChange())
+    refit();
+  return;
+}
+
+void
+ObjBVH::refit()
+  /*!
+    Recalculate the boxes of the cells with a changed rule
+    and the node boxes above them. The tree structure is kept:
+    a tree cell that loses its finite box [or a cell that
+    was empty] is added to the unbounded list so it is 
+    always tested.
+  */
+{
+  ELog::RegMethod RegA("ObjBVH","refit");
+
+  ruleChange=MonteCarlo::Object::getRuleChange();
+  bool treeChange(0);
+  for(size_t index=0;index<ObjVec.size();index++)
+    {
+      const MonteCarlo::Object* OPtr=ObjVec[index];
+      if (OPtr->getRuleIndex()==RuleVec[index]) continue;
+
+      RuleVec[index]=OPtr->getRuleIndex();
+      BoxVec[index]=cellBox(*OPtr);
+      if (TreeFlag[index])
+	treeChange=1;
+      if (!BoxVec[index].isEmpty() &&
+	  (!TreeFlag[index] || !BoxVec[index].isFinite()) &&
+	  std::find(unBound.begin(),unBound.end(),index)==unBound.end())
+	unBound.push_back(index);
+    }
+  if (!treeChange)
+    return;
+
+  // children always follow their parent [buildNode]
+  for(size_t i=Nodes.size();i>0;i--)
+    {
+      BVHNode& N=Nodes[i-1];
+      N.Box=Geometry::BoundBox::emptyBox();
+      if (N.nItem)
+	{
+	  for(size_t j=N.firstItem;j<N.firstItem+N.nItem;j++)
+	    if (BoxVec[itemIndex[j]].isFinite())
+	      N.Box.unite(BoxVec[itemIndex[j]]);
+	}
+      else
+	{
+	  N.Box.unite(Nodes[N.leftIndex].Box);
+	  N.Box.unite(Nodes[N.rightIndex].Box);
+	}
+    }
+  return;
+}
+
+size_t
+ObjBVH::buildNode(const size_t first,const size_t last)
+  /*!
+    Recursive build of the tree node [first,last)
+    Split at the median centre on the longest axis of
+    the box centres.
+    \param first :: first item in itemIndex
+    \param last :: one past the last item in itemIndex
+    \return node index
+  */
+{
+  const size_t nodeIndex(Nodes.size());
+  Nodes.push_back(BVHNode());
+
+  Geometry::BoundBox Box(Geometry::BoundBox::emptyBox());
+  Geometry::BoundBox CBox(Geometry::BoundBox::emptyBox());
+  for(size_t i=first;i<last;i++)
+    {
+      Box.unite(BoxVec[itemIndex[i]]);
+      CBox.addPoint(BoxVec[itemIndex[i]].getCentre());
+    }
+  Nodes[nodeIndex].Box=Box;
+  Nodes[nodeIndex].leftIndex=0;
+  Nodes[nodeIndex].rightIndex=0;
+  Nodes[nodeIndex].firstItem=first;
+  Nodes[nodeIndex].nItem=0;
+
+  if (last-first<=leafSize)
+    {
+      Nodes[nodeIndex].nItem=last-first;
+      return nodeIndex;
+    }
+
+  const Geometry::Vec3D Extent=CBox.getHigh()-CBox.getLow();
+  const size_t axis=Extent.principleDir();
+  const size_t mid=(first+last)/2;
+  std::nth_element(itemIndex.begin()+static_cast<long int>(first),
+		   itemIndex.begin()+static_cast<long int>(mid),
+		   itemIndex.begin()+static_cast<long int>(last),
+		   [this,axis](const size_t A,const size_t B)
+		   {
+		     return BoxVec[A].getCentre()[axis]<
+		       BoxVec[B].getCentre()[axis];
+		   });
+
+  const size_t LIndex=buildNode(first,mid);
+  const size_t RIndex=buildNode(mid,last);
+  Nodes[nodeIndex].leftIndex=LIndex;
+  Nodes[nodeIndex].rightIndex=RIndex;
+  return nodeIndex;
+}
+
+void
+ObjBVH::candidates(const Geometry::Vec3D& Pt,
+		   std::vector<size_t>& Out) const
+  /*!
+    Find all the cells whose box contains the point
+    \param Pt :: Point to test
+    \param Out :: Index of cells [sorted]
+  */
+{
+  for(const size_t index : unBound)
+    if (BoxVec[index].isInside(Pt))
+      Out.push_back(index);
+
+  if (!Nodes.empty())
+    {
+      std::vector<size_t> Stack;
+      Stack.reserve(64);
+      Stack.push_back(0);
+      while(!Stack.empty())
+	{
+	  const BVHNode& N=Nodes[Stack.back()];
+	  Stack.pop_back();
+	  if (!N.Box.isInside(Pt)) continue;
+	  if (N.nItem)
+	    {
+	      for(size_t i=N.firstItem;i<N.firstItem+N.nItem;i++)
+		if (BoxVec[itemIndex[i]].isInside(Pt))
+		  Out.push_back(itemIndex[i]);
+	    }
+	  else
+	    {
+	      Stack.push_back(N.rightIndex);
+	      Stack.push_back(N.leftIndex);
+	    }
+	}
+    }
+  // refitted cells can be both in the tree and unbounded
+  std::sort(Out.begin(),Out.end());
+  Out.erase(std::unique(Out.begin(),Out.end()),Out.end());
+  return;
+}
+
+MonteCarlo::Object*
+ObjBVH::findCell(const Geometry::Vec3D& Pt) const
+  /*!
+    Find the first cell [in number order] that contains
+    the point. Placeholder cells and cells within a 
+    universe [lattice fill] are ignored.
+    \param Pt :: Point to find
+    \return Object ptr / 0 if not found
+  */
+{
+  std::vector<size_t> CIndex;
+  CIndex.reserve(32);
+  candidates(Pt,CIndex);
+  for(const size_t index : CIndex)
+    {
+      MonteCarlo::Object* OPtr=ObjVec[index];
+      if (!OPtr->isPlaceHold() && !OPtr->getUniverse() &&
+	  OPtr->isValid(Pt))
+	return OPtr;
+    }
+  return 0;
+}
+
+bool
+ObjBVH::inBox(const int cellN,const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if a point can be in a cell. Unknown cells
+    return true.
+    \param cellN :: Cell number
+    \param Pt :: Point to test
+    \return false if the point is outside the cell box
+  */
+{
+  std::map<int,size_t>::const_iterator mc=cellIndex.find(cellN);
+  if (mc==cellIndex.end())
+    return 1;
+  return BoxVec[mc->second].isInside(Pt);
+}
+
+const Geometry::BoundBox&
+ObjBVH::getBox(const int cellN) const
+  /*!
+    Access the box of a cell
+    \param cellN :: Cell number
+    \return bounding box
+  */
+{
+  ELog::RegMethod RegA("ObjBVH","getBox");
+
+  std::map<int,size_t>::const_iterator mc=cellIndex.find(cellN);
+  if (mc==cellIndex.end())
+    throw ColErr::InContainerError<int>(cellN,"cellN");
+  return BoxVec[mc->second];
+}
+
+} // NAMESPACE ModelSupport
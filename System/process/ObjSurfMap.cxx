@@ -151,7 +151,7 @@ ObjSurfMap::getObjects(const int SNum) const
 {
   static STYPE emptyVec;
 
-  ELog::RegMethod RegA("ObjSurfMap","getObjects");
+  ELog::RegHot RegA("ObjSurfMap","getObjects");
 
   OMTYPE::const_iterator mc=SMap.find(SNum);
   return (mc==SMap.end()) ? emptyVec : mc->second;
@@ -252,6 +252,29 @@ ObjSurfMap::addSurface(const int SurfN,MonteCarlo::Object* OPtr)
   return;
 }
 
+MonteCarlo::Object*
+ObjSurfMap::getNextObject(const int SN,
+			  const Geometry::Vec3D& Pos,
+			  const int objExclude) const
+  /*!
+    Calculate the next object without any failure
+    reporting [safe for concurrent use]
+    \param SN :: Surface number
+    \param Pos :: position
+    \param objExclude :: Excluded object
+    \return Next Object Ptr / 0 on point not valid
+  */
+{
+  const STYPE& MVec=getObjects(SN);
+  for(MonteCarlo::Object* MPtr : MVec)
+    {
+      if (MPtr->getName()!=objExclude && 
+	  MPtr->isDirectionValid(Pos,SN))
+	return MPtr;
+    }
+  return 0;
+}
+
 MonteCarlo::Object*
 ObjSurfMap::findNextObject(const int SN,
 			   const Geometry::Vec3D& Pos,
@@ -264,18 +287,13 @@ ObjSurfMap::findNextObject(const int SN,
     \return Next Object Ptr / 0 on point not valid
   */
 {
-  ELog::RegMethod RegA("ObjSurfMap","findNextObject");
+  ELog::RegHot RegA("ObjSurfMap","findNextObject");
 
+  MonteCarlo::Object* OPtr=getNextObject(SN,Pos,objExclude);
+  if (OPtr) return OPtr;
 
   const STYPE& MVec=getObjects(SN);
   STYPE::const_iterator mc;
-
-  for(MonteCarlo::Object* MPtr : MVec)
-    {
-      if (MPtr->getName()!=objExclude && 
-	  MPtr->isDirectionValid(Pos,SN))
-	return MPtr;
-    }
   
   // DEBUG CODE FOR FAILURE:
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
@@ -54,10 +54,7 @@
 #include "Qhull.h"
 #include "ObjSurfMap.h"
 #include "Simulation.h"
-#include "Zaid.h"
-#include "MXcards.h"
-#include "Material.h"
-#include "DBMaterial.h"
+#include "AttnTable.h"
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
 
@@ -144,18 +141,19 @@ ObjectTrackAct::getMatSum(const long int objN) const
   return sum;
 }
   
-double
-ObjectTrackAct::getAttnSum(const long int objN) const
+void
+ObjectTrackAct::getAttnSum(const long int objN,
+			   const AttnTable& ATable,
+			   std::vector<double>& AttnSum) const
   /*!
-    Calculate the sum in the material
+    Calculate the attenuation sum at each energy of 
+    the table in one pass of the track
     \param objN :: Cell number to use
-    \return sum of distance in non-void
+    \param ATable :: Attenuation table [material/energy]
+    \param AttnSum :: sum of distance*attenuation [per energy]
   */
 {
-  ELog::RegMethod RegA("ObjectTrackAct","getAttnSum");
-
-  const ModelSupport::DBMaterial& DB=
-    ModelSupport::DBMaterial::Instance();
+  ELog::RegHot RegA("ObjectTrackAct","getAttnSum");
 
   std::map<long int,LineTrack>::const_iterator mc=Items.find(objN);
   if (mc==Items.end())
@@ -166,21 +164,27 @@ ObjectTrackAct::getAttnSum(const long int objN) const
     mc->second.getObjVec();
   const std::vector<double>& TVec=
     mc->second.getTrack();
-  
-  double sum(0.0);
+
+  const size_t NE(ATable.getNE());
+  AttnSum.assign(NE,0.0);
+  // adjacent segments are often the same material
+  long int prevMat(0);
+  const double* Row(0);
   for(size_t i=0;i<TVec.size();i++)
     {
       const long int matN=OVec[i]->getMat();
       if (matN)
 	{
-	  const MonteCarlo::Material& matInfo=
-	    DB.getMaterial(static_cast<int>(matN));
-	  const double density=matInfo.getAtomDensity();
-	  const double AMean=matInfo.getMeanA();
-	  sum+=TVec[i]*std::pow(AMean,0.66)*density;
+	  if (matN!=prevMat)
+	    {
+	      Row=ATable.getRow(static_cast<int>(matN));
+	      prevMat=matN;
+	    }
+	  for(size_t e=0;e<NE;e++)
+	    AttnSum[e]+=TVec[i]*Row[e];
 	}
     }
-  return sum;
+  return;
 }
 
 double
@@ -191,7 +195,7 @@ ObjectTrackAct::getDistance(const long int objN) const
     \return sum of distance in non-void
   */
 {
-  ELog::RegMethod RegA("ObjectTrackAct","getDistance");
+  ELog::RegHot RegA("ObjectTrackAct","getDistance");
 
   std::map<long int,LineTrack>::const_iterator mc=Items.find(objN);
   if (mc==Items.end())
@@ -3,7 +3,7 @@
  
  * File:   process/SimInput.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -127,6 +127,9 @@ processExitChecks(Simulation& System,const mainSystem::inputParam& IParam)
       
       if (IParam.flag("validPoint"))
 	SValidCheck.setCentre(IParam.getValue<Geometry::Vec3D>("validPoint"));
+      // -nThread [was -validThread]
+      if (IParam.flag("nThread"))
+	SValidCheck.setThreads(IParam.getValue<size_t>("nThread"));
 
       if (!SValidCheck.run(System,IParam.getValue<size_t>("validCheck")))
 	errFlag += -1;
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -118,6 +119,37 @@ writeIndexSim(Simulation& System,const std::string& FName,const int Number)
   return;
 }
   
+void
+writeMultiSim(Simulation& System,const std::string& FName,const int Number)
+  /*!
+    Writes out Number files, each with a new random
+    number. The seeds follow writeIndexSim [seed of file
+    i is increased by 10*i over file i-1] but the deck
+    is only built once.
+    \param System :: Simuation object 
+    \param FName :: basic filename
+    \param Number :: number of files
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSim");
+
+  physicsSystem::PhysicsCards& PC=System.getPC();
+  long int seed=PC.getRNDseed();
+  std::vector<std::string> Fnames;
+  std::vector<long int> RNDseed;
+  for(int i=0;i<Number;i++)
+    {
+      seed+=i*10;
+      std::ostringstream cx;
+      cx<<FName<<i+1<<".x";
+      Fnames.push_back(cx.str());
+      RNDseed.push_back(seed);
+    }
+  System.prepareWrite();
+  System.writeMulti(Fnames,RNDseed);
+  return;
+}
+  
 void
 writeIndexSimPHITS(Simulation& System,const std::string& FName,
 		   const int Number)
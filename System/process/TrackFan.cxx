@@ -0,0 +1,264 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/TrackFan.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <list>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "threadSupport.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "BnId.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ObjSurfMap.h"
+#include "neutron.h"
+#include "Simulation.h"
+#include "AttnTable.h"
+#include "TrackFan.h"
+
+namespace ModelSupport
+{
+
+TrackFan::TrackFan(const Simulation& S,const AttnTable& AT) :
+  System(S),ATable(AT),nThread(0)
+  /*!
+    Constructor
+    \param S :: Simulation to track
+    \param AT :: Attenuation table
+  */
+{}
+
+TrackFan::TrackFan(const TrackFan& A) :
+  System(A.System),ATable(A.ATable),nThread(A.nThread)
+  /*!
+    Copy constructor
+    \param A :: TrackFan to copy
+  */
+{}
+
+void
+TrackFan::traceRay(const Geometry::Vec3D& APt,
+		   const Geometry::Vec3D& BPt,
+		   MonteCarlo::Object* startObj,
+		   std::vector<MonteCarlo::Object*>& cellPath,
+		   double* AttnSum) const
+  /*!
+    Track from APt to BPt [as LineTrack::calculate]
+    and sum the attenuation.
+    \param APt :: Start point
+    \param BPt :: End point
+    \param startObj :: First guess of the start cell
+    \param cellPath :: Cells of the last ray [first guess] /
+                       cells of this ray on exit
+    \param AttnSum :: sum of distance*attenuation [NE]
+  */
+{
+  const size_t NE(ATable.getNE());
+  std::fill(AttnSum,AttnSum+NE,0.0);
+
+  const double aimDist=APt.Distance(BPt);
+  if (aimDist<Geometry::zeroTol)
+    return;
+
+  std::vector<MonteCarlo::Object*> prevPath;
+  prevPath.swap(cellPath);
+
+  const ModelSupport::ObjSurfMap* OSMPtr=System.getOSM();
+  const Geometry::Vec3D uVec((BPt-APt)/aimDist);
+  MonteCarlo::neutron nOut(1.0,APt,uVec);
+
+  MonteCarlo::Object* OPtr=System.findCell(APt+uVec*1e-5,startObj);
+  if (!OPtr)
+    {
+      ELog::EM<<"Initial point not in model:"<<APt<<ELog::endErr;
+      return;
+    }
+  int SN=OPtr->isOnSide(APt);
+
+  double TDist(0.0);
+  double aDist(0.0);
+  const Geometry::Surface* SPtr;
+  long int prevMat(0);
+  const double* Row(0);
+  while(OPtr)
+    {
+      // Note: Need OPPOSITE Sign on exiting surface
+      SN=OPtr->trackOutCell(nOut,aDist,SPtr,abs(SN));
+      if (!SN) break;
+
+      cellPath.push_back(OPtr);
+      const bool endFlag(aimDist-(TDist+aDist) < -Geometry::zeroTol);
+      const double D=(endFlag) ? aimDist-TDist : aDist;
+      TDist+=aDist;
+
+      const long int matN=OPtr->getMat();
+      if (matN)
+	{
+	  if (matN!=prevMat)
+	    {
+	      Row=ATable.getRow(static_cast<int>(matN));
+	      prevMat=matN;
+	    }
+	  for(size_t e=0;e<NE;e++)
+	    AttnSum[e]+=D*Row[e];
+	}
+      if (endFlag) break;
+
+      nOut.moveForward(aDist);
+      MonteCarlo::Object* nextPtr=
+	OSMPtr->findNextObject(SN,nOut.Pos,OPtr->getName());
+      if (!nextPtr || aDist<Geometry::zeroTol)
+	{
+	  // nearby ray is likely to be in the same cell at this step
+	  MonteCarlo::Object* guessPtr=
+	    (cellPath.size()<prevPath.size()) ? prevPath[cellPath.size()] : 0;
+	  nextPtr=System.findCell(nOut.Pos,guessPtr);
+	}
+      OPtr=nextPtr;
+    }
+  return;
+}
+
+void
+TrackFan::traceBlock(const Geometry::Vec3D* OriginPt,
+		     const Geometry::Plane* TPlane,
+		     const std::vector<Geometry::Vec3D>& Pts,
+		     const size_t startIndex,const size_t endIndex,
+		     const RayFunc& outFunc) const
+  /*!
+    Trace the rays [startIndex,endIndex) [thread unit]
+    \param OriginPt :: Common start point [or 0 for plane]
+    \param TPlane :: Target plane [if no OriginPt]
+    \param Pts :: Ray end points
+    \param startIndex :: First ray
+    \param endIndex :: One past last ray
+    \param outFunc :: Ray output
+  */
+{
+  std::vector<double> AttnSum(ATable.getNE());
+  std::vector<MonteCarlo::Object*> cellPath;
+
+  MonteCarlo::Object* startObj(0);
+  if (OriginPt)
+    startObj=System.findCell(*OriginPt,0);
+
+  for(size_t i=startIndex;i<endIndex;i++)
+    {
+      const Geometry::Vec3D APt((OriginPt) ? *OriginPt : Pts[i]);
+      const Geometry::Vec3D BPt((OriginPt) ?
+				Pts[i] : TPlane->closestPt(Pts[i]));
+      // plane rays : start cell of the last ray is the guess
+      if (!OriginPt && !cellPath.empty())
+	startObj=cellPath.front();
+      traceRay(APt,BPt,startObj,cellPath,AttnSum.data());
+      outFunc(i,APt.Distance(BPt),AttnSum.data());
+    }
+  return;
+}
+
+void
+TrackFan::traceAll(const Geometry::Vec3D* OriginPt,
+		   const Geometry::Plane* TPlane,
+		   const std::vector<Geometry::Vec3D>& Pts,
+		   const RayFunc& outFunc) const
+  /*!
+    Split the rays in to one contiguous block per thread
+    \param OriginPt :: Common start point [or 0 for plane]
+    \param TPlane :: Target plane [if no OriginPt]
+    \param Pts :: Ray end points
+    \param outFunc :: Ray output [called concurrently]
+  */
+{
+  ELog::RegMethod RegA("TrackFan","traceAll");
+
+  if (nThread>1)
+    System.getCellIndex();
+  threadSupport::parallelFor
+    (nThread,Pts.size(),[&](const size_t,const size_t AIndex,
+			    const size_t BIndex)
+     {
+       traceBlock(OriginPt,TPlane,Pts,AIndex,BIndex,outFunc);
+     });
+  return;
+}
+
+void
+TrackFan::trace(const Geometry::Vec3D& OriginPt,
+		const std::vector<Geometry::Vec3D>& Pts,
+		const RayFunc& outFunc) const
+  /*!
+    Trace the rays from a common point to each point
+    \param OriginPt :: Start point of all rays
+    \param Pts :: Ray end points
+    \param outFunc :: Ray output [called concurrently]
+  */
+{
+  traceAll(&OriginPt,0,Pts,outFunc);
+  return;
+}
+
+void
+TrackFan::trace(const Geometry::Plane& TPlane,
+		const std::vector<Geometry::Vec3D>& Pts,
+		const RayFunc& outFunc) const
+  /*!
+    Trace the rays from each point to the closest point
+    on the plane
+    \param TPlane :: Target plane
+    \param Pts :: Ray start points
+    \param outFunc :: Ray output [called concurrently]
+  */
+{
+  traceAll(0,&TPlane,Pts,outFunc);
+  return;
+}
+
+} // Namespace ModelSupport
@@ -3,7 +3,7 @@
  
  * File:   process/VolSum.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -31,6 +31,8 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <functional>
 #include <boost/format.hpp>
 
 #include "Exception.h"
@@ -43,6 +45,7 @@
 #include "BaseModVisit.h"
 #include "support.h"
 #include "mathSupport.h"
+#include "threadSupport.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -76,7 +79,8 @@ VolSum::VolSum(const Geometry::Vec3D& OPt,
 	       const Geometry::Vec3D& AxisRange) : 
   Origin(OPt),X(fabs(AxisRange[0]),0,0),
   Y(0,fabs(AxisRange[1]),0),Z(0,0,fabs(AxisRange[2])),
-  fullVol(0.0),totalDist(0),nTracks(0)
+  fullVol(0.0),totalDist(0),nTracks(0),nBatch(0),
+  nThread(0),sampleType(0),replicaErr(0),targetErr(0.0)
   /*!
     Constructor
     \param OPt :: Centre
@@ -88,7 +92,10 @@ VolSum::VolSum(const VolSum& A) :
   Origin(A.Origin),X(A.X),Y(A.Y),Z(A.Z),
   fracX(A.fracX),fracY(A.fracY),
   fullVol(A.fullVol),totalDist(A.totalDist),
-  nTracks(A.nTracks),tallyVols(A.tallyVols)
+  nTracks(A.nTracks),nBatch(A.nBatch),nThread(A.nThread),
+  sampleType(A.sampleType),replicaErr(A.replicaErr),
+  targetErr(A.targetErr),haltonShift(A.haltonShift),
+  tallyVols(A.tallyVols)
   /*!
     Copy constructor
     \param A :: VolSum to copy
@@ -112,6 +119,12 @@ VolSum::operator=(const VolSum& A)
       fullVol=A.fullVol;
       totalDist=A.totalDist;
       nTracks=A.nTracks;
+      nBatch=A.nBatch;
+      nThread=A.nThread;
+      sampleType=A.sampleType;
+      replicaErr=A.replicaErr;
+      targetErr=A.targetErr;
+      haltonShift=A.haltonShift;
       tallyVols=A.tallyVols;
     }
   return *this;
@@ -289,48 +302,155 @@ VolSum::reset()
   for(mc=tallyVols.begin();mc!=tallyVols.end();mc++)
     mc->second.reset();
   nTracks=0;
+  nBatch=0;
   totalDist=0.0;
   return;
 }
 
 void
-VolSum::pointRun(const Simulation& System,const size_t N) 
+VolSum::setSampling(const std::string& ST)
   /*!
-    Calculate the tracking
-    \param System :: Simulation to use
-    \param N :: Number of points to test
+    Set the sampling of the points in pointRun
+    \param ST :: random / stratified / halton
   */
 {
-  ELog::RegMethod RegA("VolSum","run");
-  
-  MonteCarlo::Object* OPtr(0);
+  ELog::RegMethod RegA("VolSum","setSampling");
+
+  if (ST=="random")
+    sampleType=0;
+  else if (ST=="stratified")
+    sampleType=1;
+  else if (ST=="halton")
+    sampleType=2;
+  else
+    throw ColErr::InContainerError<std::string>(ST,"Sampling type");
+  return;
+}
 
-  reset();
-  fullVol=X.abs()*Y.abs()*Z.abs();
-  // Note for sphere that you can use X,Y,Z in any orthogonal 
-  // directiron
+void
+VolSum::addUnit(tvTYPE& TV,const int ObjN,const double D)
+  /*!
+    Adds distance to all the tally units
+    \param TV :: Tally units
+    \param ObjN :: Object number
+    \param D :: Distance to add to tally calc
+   */
+{
+  for(tvTYPE::value_type& mc : TV)
+    mc.second.addUnit(ObjN,D);
+  return;
+}
 
-  for(size_t i=0;i<N;i++)
+void
+VolSum::endHistory(tvTYPE& TV)
+  /*!
+    Close the history in all the tally units
+    \param TV :: Tally units
+   */
+{
+  for(tvTYPE::value_type& mc : TV)
+    mc.second.endHistory();
+  return;
+}
+
+double
+VolSum::radicalInverse(size_t index,const size_t base)
+  /*!
+    Van der Corput radical inverse
+    \param index :: Index in sequence
+    \param base :: Prime base
+    \return value [0-1)
+  */
+{
+  const double invBase(1.0/static_cast<double>(base));
+  double f(invBase);
+  double R(0.0);
+  while(index)
     {
-      Geometry::Vec3D Pt(Origin+
-			 X*(RNG.rand()-0.5)+
-			 Y*(RNG.rand()-0.5)+
-			 Z*(RNG.rand()-0.5));
+      R+=f*static_cast<double>(index % base);
+      index/=base;
+      f*=invBase;
+    }
+  return R;
+}
+
+Geometry::Vec3D
+VolSum::getBoxPoint(const size_t index,const size_t offset,
+		    const size_t NB,MTRand& RN) const
+  /*!
+    Get a point in the box. A stratified batch has one point
+    in each of the nStrat^3 cells of the box and the remaining
+    points random, so each part is an unbiased estimate.
+    \param index :: Point index in the batch
+    \param offset :: Index of the first point of the batch [halton]
+    \param NB :: Number of points in the batch
+    \param RN :: Random number stream
+    \return point
+  */
+{
+  double U[3];
+  const size_t nStrat=(sampleType==1) ?
+    static_cast<size_t>(std::cbrt(static_cast<double>(NB))+1e-6) : 0;
+  if (index<nStrat*nStrat*nStrat)
+    {
+      const size_t IJK[3]={ index % nStrat,
+			    (index/nStrat) % nStrat,
+			    index/(nStrat*nStrat) };
+      for(size_t i=0;i<3;i++)
+	U[i]=(static_cast<double>(IJK[i])+RN.rand())/
+	  static_cast<double>(nStrat);
+    }
+  else if (sampleType==2)
+    {
+      const size_t primes[3]={2,3,5};
+      for(size_t i=0;i<3;i++)
+	U[i]=std::fmod(radicalInverse(offset+index+1,primes[i])+
+		       haltonShift[i],1.0);
+    }
+  else
+    {
+      for(size_t i=0;i<3;i++)
+	U[i]=RN.rand();
+    }
+  return Origin+X*(U[0]-0.5)+Y*(U[1]-0.5)+Z*(U[2]-0.5);
+}
+
+void
+VolSum::pointBlock(const Simulation& System,const size_t offset,
+		   const size_t first,const size_t last,
+		   const size_t NB,MTRand& RN,tvTYPE& TV) const
+  /*!
+    Calculate the points in a block [thread unit]
+    \param System :: Simulation to use
+    \param offset :: Index of the first point of the batch
+    \param first :: First point index in the batch
+    \param last :: One past the last point index in the batch
+    \param NB :: Number of points in the batch
+    \param RN :: Random number stream
+    \param TV :: Tally units to add to
+  */
+{
+  MonteCarlo::Object* OPtr(0);
+  for(size_t i=first;i<last;i++)
+    {
+      const Geometry::Vec3D Pt=getBoxPoint(i,offset,NB,RN);
       OPtr=System.findCell(Pt,OPtr);
-      addDistance(OPtr->getName(),1.0);
+      if (OPtr)
+	addUnit(TV,OPtr->getName(),1.0);
+      endHistory(TV);
     }
-  nTracks+=N;
   return;
 }
 
 Geometry::Vec3D
-VolSum::getCubePoint() const
+VolSum::getCubePoint(MTRand& RN) const
   /*!
     Get a random point on the cuboic
+    \param RN :: Random number stream
     \return surface point
   */
 {
-  double R=RNG.rand();
+  double R=RN.rand();
   double pm(0.5);
   if (R>0.5)   
     {
@@ -340,62 +460,48 @@ VolSum::getCubePoint() const
   Geometry::Vec3D Pt(Origin);
   if (R<fracX) // XY surface
     {
-      Pt+=X*(RNG.rand()-0.5)+Y*(RNG.rand()-0.5);
+      Pt+=X*(RN.rand()-0.5)+Y*(RN.rand()-0.5);
       Pt+=Z*pm;
     }
   else if (R<fracY)
     {
-      Pt+=X*(RNG.rand()-0.5)+Z*(RNG.rand()-0.5);
+      Pt+=X*(RN.rand()-0.5)+Z*(RN.rand()-0.5);
       Pt+=Y*pm;
     }
   else 
     {
-      Pt+=Y*(RNG.rand()-0.5)+Z*(RNG.rand()-0.5);
+      Pt+=Y*(RN.rand()-0.5)+Z*(RN.rand()-0.5);
       Pt+=X*pm;
     }
   return Pt;
 }
-  
 
-  
-void
-VolSum::trackRun(const Simulation& System,const size_t N) 
+double
+VolSum::trackBlock(const Simulation& System,const size_t N,
+		   MTRand& RN,tvTYPE& TV) const
   /*!
-    Calculate the tracking
+    Calculate the tracks in a block [thread unit]
     \param System :: Simulation to use
-    \param N :: Number of points to test
+    \param N :: Number of tracks
+    \param RN :: Random number stream
+    \param TV :: Tally units to add to
+    \return total track distance
   */
 {
-  ELog::RegMethod RegA("VolSum","run");
-  
   const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
-
   MonteCarlo::Object* InitObj(0);
-  reset();
-  
-  const double AreaXY(X[0]*Y[1]);
-  const double AreaXZ(X[0]*Z[2]);
-  const double AreaYZ(Y[1]*Z[2]);
-  fullVol=X[0]*Y[1]*Z[2];
-
-  const double totalArea(2.0*(AreaXY+AreaXZ+AreaYZ));
 
-  fracX=AreaXY/totalArea;
-  fracY=(AreaXZ+AreaXY)/totalArea;
-  
   const Geometry::Surface* SPtr;          // Output surface
   double aDist;       
-
-  // Note for sphere that you can use X,Y,Z in any orthogonal 
-  // directiron
-
+  double sumDist(0.0);
+  
   for(size_t i=0;i<N;i++)
     {
-      Geometry::Vec3D Pt=getCubePoint();
-      Geometry::Vec3D XPt=getCubePoint();
+      Geometry::Vec3D Pt=getCubePoint(RN);
+      Geometry::Vec3D XPt=getCubePoint(RN);
       double trackDistance=Pt.Distance(XPt);
       XPt-=Pt;
-      totalDist+=trackDistance;
+      sumDist+=trackDistance;
       
       // track length to go == [Max]
       
@@ -412,26 +518,181 @@ VolSum::trackRun(const Simulation& System,const size_t N)
 	  trackDistance-=aDist;
 	  if (trackDistance > 0.0)
 	    {
-	      addDistance(OPtr->getName(),aDist);
+	      addUnit(TV,OPtr->getName(),aDist);
 	      trackDistance-=aDist;
 	      TNeut.moveForward(aDist+2.0*Geometry::zeroTol);
 
 	      OPtr=(SN) ?
-		OSMPtr->findNextObject
+		OSMPtr->getNextObject
 		(SN,TNeut.Pos,OPtr->getName()) : 0;		
 	    }
 	  else
-	    {
-	      //	      ELog::EM<<"Adding "<<
-	      //		trackDistance-TNeut.travel<<ELog::endDebug;
-	      //	      addDistance(OPtr->getName(),
-	      //			  trackDistance-TNeut.travel);
-	      OPtr=0;
-	    }
+	    OPtr=0;
 	}
+      endHistory(TV);
     }
-  ELog::EM<<"Total Dist == "<<totalDist<<ELog::endTrace;  
+  return sumDist;
+}
+
+void
+VolSum::runBatch(const Simulation& System,const size_t first,
+		 const size_t N,const bool trackFlag)
+  /*!
+    Run a batch of points/tracks over the threads
+    \param System :: Simulation to use
+    \param first :: Index of the first point
+    \param N :: Number of points/tracks
+    \param trackFlag :: Tracks rather than points
+  */
+{
+  ELog::RegMethod RegA("VolSum","runBatch");
+
+  // each batch is an independent replicate
+  if (sampleType==2)
+    haltonShift=Geometry::Vec3D(RNG.rand(),RNG.rand(),RNG.rand());
+
+  if (nThread<=1)
+    {
+      if (trackFlag)
+	totalDist+=trackBlock(System,N,RNG,tallyVols);
+      else
+	pointBlock(System,first,0,N,N,RNG,tallyVols);
+      endBatch(N);
+      return;
+    }
+
+  // findCell is only safe for concurrent use with the index built
+  System.getCellIndex();
+  
+  tvTYPE emptyVols(tallyVols);
+  for(tvTYPE::value_type& mc : emptyVols)
+    mc.second.reset();
+
+  const size_t nT=threadSupport::threadCount(nThread,N);
+  std::vector<unsigned int> Seeds(nT);
+  for(size_t i=0;i<nT;i++)
+    Seeds[i]=RNG.randInt();
+
+  std::vector<tvTYPE> threadVols(nT,emptyVols);
+  std::vector<double> threadDist(nT,0.0);
+  threadSupport::parallelFor
+    (nT,N,[&](const size_t i,const size_t startIndex,const size_t endIndex)
+     {
+       MTRand RN(Seeds[i]);
+       if (trackFlag)
+	 threadDist[i]=trackBlock(System,endIndex-startIndex,
+				  RN,threadVols[i]);
+       else
+	 pointBlock(System,first,startIndex,endIndex,N,
+		    RN,threadVols[i]);
+     });
+
+  for(size_t i=0;i<nT;i++)
+    {
+      for(const tvTYPE::value_type& mc : threadVols[i])
+	tallyVols[mc.first].merge(mc.second);
+      totalDist+=threadDist[i];
+    }
+  endBatch(N);
+  return;
+}
+
+void
+VolSum::endBatch(const size_t N)
+  /*!
+    Close a batch of points/tracks in the tallies
+    \param N :: Number of points/tracks in the batch
+  */
+{
+  for(tvTYPE::value_type& mc : tallyVols)
+    mc.second.endBatch(static_cast<double>(N));
   nTracks+=N;
+  nBatch++;
+  return;
+}
+
+void
+VolSum::runAll(const Simulation& System,const size_t N,
+	       const bool trackFlag)
+  /*!
+    Run the points/tracks. If a target error is set then
+    run in batches until the target or N is reached.
+    Stratified/halton points are always run in batches, as 
+    the spread of the batches is their error. They need 
+    minReplica batches before the error is used to stop.
+    \param System :: Simulation to use
+    \param N :: Number of points/tracks [maximum]
+    \param trackFlag :: Tracks rather than points
+  */
+{
+  ELog::RegMethod RegA("VolSum","runAll");
+
+  replicaErr=(!trackFlag && sampleType);
+  if (targetErr<=0.0 && !replicaErr)
+    {
+      runBatch(System,0,N,trackFlag);
+      return;
+    }
+
+  const size_t minReplica(10);
+  const size_t batchSize=std::max<size_t>
+    (1,std::max<size_t>(N/50,std::min<size_t>(10000,N/10)));
+  size_t nDone(0);
+  while(nDone<N)
+    {
+      const size_t NB=std::min(batchSize,N-nDone);
+      runBatch(System,nDone,NB,trackFlag);
+      nDone+=NB;
+      if (targetErr>0.0 && (!replicaErr || nBatch>=minReplica) &&
+	  maxRelError()<=targetErr)
+	break;
+    }
+  if (targetErr>0.0)
+    ELog::EM<<"Relative error == "<<maxRelError()<<" ["<<targetErr
+	    <<"] after "<<nDone<<ELog::endDiag;
+  return;
+}
+
+void
+VolSum::pointRun(const Simulation& System,const size_t N) 
+  /*!
+    Calculate the volumes from points in the box
+    \param System :: Simulation to use
+    \param N :: Number of points to test [maximum]
+  */
+{
+  ELog::RegMethod RegA("VolSum","pointRun");
+  
+  reset();
+  fullVol=X.abs()*Y.abs()*Z.abs();
+  runAll(System,N,0);
+  return;
+}
+
+void
+VolSum::trackRun(const Simulation& System,const size_t N) 
+  /*!
+    Calculate the tracking
+    \param System :: Simulation to use
+    \param N :: Number of points to test [maximum]
+  */
+{
+  ELog::RegMethod RegA("VolSum","trackRun");
+  
+  reset();
+  
+  const double AreaXY(X[0]*Y[1]);
+  const double AreaXZ(X[0]*Z[2]);
+  const double AreaYZ(Y[1]*Z[2]);
+  fullVol=X[0]*Y[1]*Z[2];
+
+  const double totalArea(2.0*(AreaXY+AreaXZ+AreaYZ));
+
+  fracX=AreaXY/totalArea;
+  fracY=(AreaXZ+AreaXY)/totalArea;
+
+  runAll(System,N,1);
+  ELog::EM<<"Total Dist == "<<totalDist<<ELog::endTrace;  
   return;
 }
 
@@ -449,11 +710,46 @@ VolSum::calcVolume(const int TN) const
   std::map<int,volUnit>::const_iterator mc;
   mc=tallyVols.find(TN);
   if (mc!=tallyVols.end())
-    return fullVol*mc->second.calcVol(1.0/nTracks);
+    return fullVol*mc->second.calcVol(1.0/static_cast<double>(nTracks));
   ELog::EM<<"No tally of value "<<TN<<ELog::endErr;
   return 0.0;
 }
 
+double
+VolSum::calcRelError(const int TN) const
+  /*!
+    Calcuate the relative error of a tally unit
+    \param TN :: Tally number
+    \return Relative error
+   */
+{
+  ELog::RegMethod RegA("VolSum","calcRelError");
+
+  std::map<int,volUnit>::const_iterator mc;
+  mc=tallyVols.find(TN);
+  if (mc!=tallyVols.end())
+    return (replicaErr) ?
+      mc->second.calcBatchError(static_cast<double>(nTracks),nBatch) :
+      mc->second.calcRelError(static_cast<double>(nTracks));
+  ELog::EM<<"No tally of value "<<TN<<ELog::endErr;
+  return 1.0;
+}
+
+double
+VolSum::maxRelError() const
+  /*!
+    Calcuate the largest relative error of the tally units
+    \return Relative error
+   */
+{
+  double maxErr(0.0);
+  for(const tvTYPE::value_type& mc : tallyVols)
+    maxErr=std::max(maxErr,(replicaErr) ?
+      mc.second.calcBatchError(static_cast<double>(nTracks),nBatch) :
+      mc.second.calcRelError(static_cast<double>(nTracks)));
+  return maxErr;
+}
+
 
 void 
 VolSum::write(const std::string& OFile) const
@@ -476,7 +772,7 @@ VolSum::write(const std::string& OFile) const
   for(mc=tallyVols.begin();mc!=tallyVols.end();mc++)
     {
       OX<<"tally"<<(FMTI3 % mc->first % 
-		    (fullVol*mc->second.calcVol(1.0/nTracks)) %
+		    (fullVol*mc->second.calcVol(1.0/static_cast<double>(nTracks))) %
 		    sf % mc->second.getMat() % 
 		    mc->second.getComment())<<std::endl;
       sf++;
@@ -3,7 +3,7 @@
  
  * File:   process/Volumes.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -80,6 +80,13 @@ calcVolumes(Simulation* SimPtr,const mainSystem::inputParam& IParam)
 
       const size_t NP=IParam.getValue<size_t>("volNum");
       VolSum VTally(Org,XYZ);
+      // volume threads from -nThread [replaces -volThread]
+      if (IParam.flag("nThread"))
+	VTally.setThreads(IParam.getValue<size_t>("nThread"));
+      if (IParam.flag("volSample"))
+	VTally.setSampling(IParam.getValue<std::string>("volSample"));
+      if (IParam.flag("volError"))
+	VTally.setTargetError(IParam.getValue<double>("volError"));
       if (IParam.flag("volCells") )
 	populateCells(*SimPtr,IParam,VTally);
       else
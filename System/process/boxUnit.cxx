@@ -439,7 +439,7 @@ boxUnit::createOuterObjects()
   for(int j=0;j<static_cast<int>(nSides);j++)
     outerCX<<-(j+3)<<" ";
   const std::string Out=
-    ModelSupport::getComposite(SMap,SI,outerCX.str());
+    ModelSupport::getDynamicComposite(SMap,SI,outerCX.str());
   addOuterSurf(Out+FBSurf);
   return;
 }
@@ -478,9 +478,9 @@ boxUnit::createObjects(Simulation& System)
     {
       if (!activeFlag || (activeFlag & bitIndex))
 	{
-	  Out=ModelSupport::getComposite(SMap,SI,outerCX.str());
+	  Out=ModelSupport::getDynamicComposite(SMap,SI,outerCX.str());
 	  if (SIprev)
-	    Out+=ModelSupport::getComposite(SMap,SIprev,innerCX.str());
+	    Out+=ModelSupport::getDynamicComposite(SMap,SIprev,innerCX.str());
 	  Out+=FBSurf;
 	  System.addCell(MonteCarlo::Qhull(cellIndex++,
 					   boxVar[i].getMat(),
@@ -489,7 +489,7 @@ boxUnit::createObjects(Simulation& System)
 	}
     }
   // Final outer layer is controlled by SIprev
-  Out=ModelSupport::getComposite(SMap,SIprev,outerCX.str());
+  Out=ModelSupport::getDynamicComposite(SMap,SIprev,outerCX.str());
   Out+=FBSurf;
   addOuterSurf(Out);
   return;
@@ -682,14 +682,15 @@ boxUnit::addExcludeStrings(const std::map<int,MonteCarlo::Object*>& OMap) const
 {
   ELog::RegMethod RegA("boxUnit","addExcludeString");
 
-  // Add exclude string
+  // Add exclude rule
+  const HeadRule excludeRule(getExcludeRule());
   typedef std::map<int,MonteCarlo::Object*> MTYPE;
   MTYPE::const_iterator ac;
   for(ac=OMap.begin();ac!=OMap.end();ac++)
     {
       if (ac->first!=cellIndex-1)
 	{
-	  ac->second->addSurfString(getExclude());
+	  ac->second->addIntersection(excludeRule);
 	  ac->second->populate();
 	  ac->second->createSurfaceList();
 	}
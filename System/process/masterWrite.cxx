@@ -68,6 +68,7 @@ masterWrite::setSigFig(const int S)
   std::ostringstream cx;
   cx<<"\%1."<<S<<"g";
   FMTdouble=boost::format(cx.str());
+  sigFig=S;
   return;
 }
 
@@ -82,6 +83,26 @@ masterWrite::setZero(const double Z)
   return;
 }
 
+boost::format&
+masterWrite::threadFMT() const
+  /*!
+    Get this thread's copy of the double format. 
+    A boost::format holds the bound argument so can not
+    be used by two threads at once [surfaces/cells are written
+    in parallel]
+    \return format for the current sigFig
+  */
+{
+  thread_local int tSigFig(0);
+  thread_local boost::format tFMT;
+  if (tSigFig!=sigFig)
+    {
+      tFMT=FMTdouble;
+      tSigFig=sigFig;
+    }
+  return tFMT;
+}
+
 std::string
 masterWrite::Num(const double& D)
   /*!
@@ -93,7 +114,7 @@ masterWrite::Num(const double& D)
   if (fabs(D)<zeroTol)
     return "0.0";
 
-  return (FMTdouble % D).str();
+  return (threadFMT() % D).str();
 }
   
 std::string
@@ -104,7 +125,8 @@ masterWrite::Num(const int& I)
     \return formated number
   */
 {
-  return (FMTinteger % I).str();
+  thread_local boost::format tFMT(FMTinteger);
+  return (tFMT % I).str();
 }
 
 std::string
@@ -119,7 +141,7 @@ masterWrite::Num(const Geometry::Vec3D& V)
   for(int i=0;i<3;i++)
     {
       Out +=(fabs(V[i])<zeroTol) ? "0.0" :
-	(FMTdouble % V[i]).str();
+	(threadFMT() % V[i]).str();
       if (i!=2) Out+=" ";
     }
   return Out;
@@ -137,7 +159,7 @@ masterWrite::NumComma(const Geometry::Vec3D& V)
   for(int i=0;i<3;i++)
     {
       Out +=(fabs(V[i])<zeroTol) ? "0.0" :
-	(FMTdouble % V[i]).str();
+	(threadFMT() % V[i]).str();
       if (i!=2) Out+=",";
     }
   return Out;
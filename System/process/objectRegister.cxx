@@ -3,7 +3,7 @@
  
  * File:   process/objectRegister.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -146,34 +146,113 @@ objectRegister::getLast(const std::string& Name) const
     mc->second.second : 0;
 }
   
-std::string
-objectRegister::inRange(const int Index) const
+void
+objectRegister::addIndex(ITYPE& IVec,const MTYPE::const_iterator& mc)
   /*!
-    Determine in the cell in within range
-    \param Index :: cell number to test
-    \return string
-   */
+    Insert a range unit into an index sorted by start cell.
+    Equal starts are placed after the existing units so
+    that a zero sized unit is masked by its successor.
+    \param IVec :: Index to add to
+    \param mc :: Range unit
+  */
 {
-  static std::string prev;
-  
-  MTYPE::const_iterator mc;
-  mc=regionMap.find(prev);
-
-  if (mc!=regionMap.end() && 
-      Index>=mc->second.first && 
-      Index<=mc->second.second)
-    return mc->first;
-    
-  for(mc=regionMap.begin();mc!=regionMap.end();mc++)
+  const int startN(mc->second.first);
+  ITYPE::iterator vc=
+    std::upper_bound(IVec.begin(),IVec.end(),startN,
+		     [](const int N,const MTYPE::const_iterator& A)
+		     { return N<A->second.first; });
+  IVec.insert(vc,mc);
+  return;
+}
+
+void
+objectRegister::removeIndex(ITYPE& IVec,const MTYPE::const_iterator& mc)
+  /*!
+    Remove a range unit from an index
+    \param IVec :: Index to remove from
+    \param mc :: Range unit
+  */
+{
+  ITYPE::iterator vc=std::find(IVec.begin(),IVec.end(),mc);
+  if (vc!=IVec.end())
+    IVec.erase(vc);
+  return;
+}
+
+objectRegister::ITYPE::const_iterator
+objectRegister::findIndex(const ITYPE& IVec,const int Index)
+  /*!
+    Find the range unit that holds a cell number
+    \param IVec :: Index to search
+    \param Index :: cell number to find
+    \return unit in IVec / IVec.end() if not found
+  */
+{
+  // last unit with start <= Index
+  ITYPE::const_iterator vc=
+    std::upper_bound(IVec.begin(),IVec.end(),Index,
+		     [](const int N,const MTYPE::const_iterator& A)
+		     { return N<A->second.first; });
+  if (vc==IVec.begin())
+    return IVec.end();
+  vc--;
+  return (Index<=(*vc)->second.second) ? vc : IVec.end();
+}
+
+std::vector<std::string>
+objectRegister::findIndex(const ITYPE& IVec,
+			  const std::vector<int>& CellN)
+  /*!
+    Find the range unit names of a set of cells. Runs of
+    cells in the same unit [the normal case for sorted
+    cells] are found without a search.
+    \param IVec :: Index to search
+    \param CellN :: cell numbers to find
+    \return names of the units [empty if not found]
+  */
+{
+  std::vector<std::string> Out(CellN.size());
+  ITYPE::const_iterator prev(IVec.end());
+  ITYPE::const_iterator next(IVec.end());
+  for(size_t i=0;i<CellN.size();i++)
     {
-      const std::pair<int,int>& IP=mc->second;
-      if (Index>=IP.first && Index<=IP.second)
+      const int Index(CellN[i]);
+      // shared end points belong to the later unit [as findIndex]
+      if (prev==IVec.end() ||
+	  Index<(*prev)->second.first ||
+	  Index>(*prev)->second.second ||
+	  (next!=IVec.end() && Index>=(*next)->second.first))
 	{
-	  prev=mc->first;
-	  return mc->first;
+	  prev=findIndex(IVec,Index);
+	  next=(prev!=IVec.end()) ? prev+1 : prev;
 	}
+      if (prev!=IVec.end())
+	Out[i]=(*prev)->first;
     }
-  return std::string("");
+  return Out;
+}
+
+std::string
+objectRegister::inRange(const int Index) const
+  /*!
+    Determine the object whose range holds the cell
+    \param Index :: cell number to test
+    \return object name [empty if not found]
+   */
+{
+  ITYPE::const_iterator vc=findIndex(regionIndex,Index);
+  return (vc!=regionIndex.end()) ? (*vc)->first : std::string("");
+}
+
+std::vector<std::string>
+objectRegister::inRange(const std::vector<int>& CellN) const
+  /*!
+    Determine the objects whose ranges hold the cells
+    \param CellN :: cell numbers to test
+    \return object names [empty if not found]
+   */
+{
+  return findIndex(regionIndex,CellN);
 }
 
 void
@@ -239,7 +318,9 @@ objectRegister::cell(const std::string& Name,const int size)
 	ELog::EM<<"Insufficient space reserved for "<<Name<<ELog::endErr;
       return mc->second.first;
     }
-  regionMap.emplace(Name,std::pair<int,int>(cellNumber,cellNumber+size));
+  mc=regionMap.emplace(Name,
+		       std::pair<int,int>(cellNumber,cellNumber+size)).first;
+  addIndex(regionIndex,mc);
   cellNumber+=size;
   return cellNumber-size;
 }
@@ -495,36 +576,26 @@ objectRegister::getRenumberRange(const std::string& Name) const
 std::string
 objectRegister::inRenumberRange(const int Index) const
   /*!
-    Get the range of an object
-    \param Index :: Offset number
-    \return string of object
+    Determine the object whose renumbered range holds the cell
+    \param Index :: renumbered cell number
+    \return object name [empty if not found]
    */
 {
-  static std::string prev;
-  
-  MTYPE::const_iterator mc;
-  // normally same as previous search
-  if (!prev.empty())
-    {
-      mc=renumMap.find(prev);
-      if (mc!=renumMap.end() && 
-	  Index>=mc->second.first && 
-	  Index<=mc->second.second)
-	return mc->first;
-    }
-  for(mc=renumMap.begin();mc!=renumMap.end();mc++)
-    {
-      const std::pair<int,int>& IP=mc->second;
-      if (Index>=IP.first && Index<=IP.second)
-	{
-	  prev=mc->first;
-	  return mc->first;
-	}
-    }
-  return std::string("");
+  ITYPE::const_iterator vc=findIndex(renumIndex,Index);
+  return (vc!=renumIndex.end()) ? (*vc)->first : std::string("");
+}
+
+std::vector<std::string>
+objectRegister::inRenumberRange(const std::vector<int>& CellN) const
+  /*!
+    Determine the objects whose renumbered ranges hold the cells
+    \param CellN :: renumbered cell numbers
+    \return object names [empty if not found]
+   */
+{
+  return findIndex(renumIndex,CellN);
 }
 
-  
 void
 objectRegister::setRenumber(const std::string& key,
 			    const int startN,const int endN)
@@ -540,9 +611,13 @@ objectRegister::setRenumber(const std::string& key,
     {
       MTYPE::iterator mc=renumMap.find(key);
       if (mc!=renumMap.end())
-	mc->second=std::pair<int,int>(startN,endN);
+	{
+	  removeIndex(renumIndex,mc);
+	  mc->second=std::pair<int,int>(startN,endN);
+	}
       else
-	renumMap.emplace(key,std::pair<int,int>(startN,endN));
+	mc=renumMap.emplace(key,std::pair<int,int>(startN,endN)).first;
+      addIndex(renumIndex,mc);
     }
   return;
 }
@@ -3,7 +3,7 @@
  
  * File:   process/pipeUnit.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -485,11 +485,12 @@ pipeUnit::insertObjects(Simulation& System)
 	    OMap.insert(MTYPE::value_type(forceCellN,SObj));
 	}
     }     
-  // Add exclude string
+  // Add exclude rule
+  const HeadRule excludeRule(getExcludeRule());
   MTYPE::const_iterator ac;
   for(ac=OMap.begin();ac!=OMap.end();ac++)
     {
-      ac->second->addSurfString(getExclude());
+      ac->second->addIntersection(excludeRule);
       ac->second->populate();
       ac->second->createSurfaceList();
     }
@@ -172,7 +172,10 @@ equalSurface(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  SMAP Cand;
+  return (SurI.equalCandidates(SPtr,Cand)) ?
+    FTYPE::dispatch(Index,SPtr,Cand) :
+    FTYPE::dispatch(Index,SPtr,SurI.surMap());
 }
 
 Geometry::Surface*
@@ -194,7 +197,10 @@ equalSurface(Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  SMAP Cand;
+  return (SurI.equalCandidates(SPtr,Cand)) ?
+    FTYPE::dispatch(Index,SPtr,Cand) :
+    FTYPE::dispatch(Index,SPtr,SurI.surMap());
 }
 
 
@@ -244,7 +250,10 @@ equalSurfNum(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  const Geometry::Surface* OutPtr=FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  SMAP Cand;
+  const Geometry::Surface* OutPtr=(SurI.equalCandidates(SPtr,Cand)) ?
+    FTYPE::dispatch(Index,SPtr,Cand) :
+    FTYPE::dispatch(Index,SPtr,SurI.surMap());
   return OutPtr->getName();
 }
 
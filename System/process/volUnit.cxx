@@ -3,7 +3,7 @@
  
  * File:   process/volUnit.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -58,7 +58,8 @@ operator<<(std::ostream& OX,const volUnit& A)
 }
 
 volUnit::volUnit() : 
-  npts(0),lineSum(0.0),matNum(0)
+  npts(0),lineSum(0.0),histSum(0.0),sumSq(0.0),
+  batchLine(0.0),batchSq(0.0),matNum(0)
   /*!
     Constructor
   */
@@ -67,7 +68,8 @@ volUnit::volUnit() :
 
 volUnit::volUnit(const int MN,const std::string& CM,
 		 const std::vector<int>& CList) : 
-  npts(0),lineSum(0.0),comment(CM),matNum(MN)
+  npts(0),lineSum(0.0),histSum(0.0),sumSq(0.0),
+  batchLine(0.0),batchSq(0.0),comment(CM),matNum(MN)
   /*!
     Constructor
     \param MN :: Material number
@@ -80,7 +82,8 @@ volUnit::volUnit(const int MN,const std::string& CM,
 
 volUnit::volUnit(const volUnit& A) : 
   npts(A.npts),cells(A.cells),lineSum(A.lineSum),
-  comment(A.comment),matNum(A.matNum)
+  histSum(A.histSum),sumSq(A.sumSq),batchLine(A.batchLine),
+  batchSq(A.batchSq),comment(A.comment),matNum(A.matNum)
   /*!
     Copy constructor
     \param A :: volUnit to copy
@@ -100,6 +103,10 @@ volUnit::operator=(const volUnit& A)
       npts=A.npts;
       cells=A.cells;
       lineSum=A.lineSum;
+      histSum=A.histSum;
+      sumSq=A.sumSq;
+      batchLine=A.batchLine;
+      batchSq=A.batchSq;
       comment=A.comment;
       matNum=A.matNum;
     }
@@ -152,6 +159,7 @@ volUnit::addUnit(const int CN,const double D)
       // 	ELog::EM<<"D = "<<D<<ELog::endTrace;
       npts++;
       lineSum+=D;
+      histSum+=D;
     }
   return;
 }
@@ -168,8 +176,10 @@ volUnit::addFlux(const int CN,const double R,const double D)
   std::set<int>::iterator sc=cells.find(CN);
   if (sc!=cells.end())
     {
+      const double V=1.0/R-1.0/(R+D);
       npts++;
-      lineSum+=1.0/R-1.0/(R+D);
+      lineSum+=V;
+      histSum+=V;
     }
   return;
 }
@@ -182,6 +192,50 @@ volUnit::reset()
 {
   npts=0;
   lineSum=0.0;
+  histSum=0.0;
+  sumSq=0.0;
+  batchLine=0.0;
+  batchSq=0.0;
+  return;
+}
+
+void 
+volUnit::endHistory()
+  /*!
+    Close the current history [for the variance]
+  */
+{
+  sumSq+=histSum*histSum;
+  histSum=0.0;
+  return;
+}
+
+void 
+volUnit::endBatch(const double NB)
+  /*!
+    Close the current batch [for the replicate variance]
+    \param NB :: Number of histories in the batch
+  */
+{
+  if (NB>0.0)
+    {
+      const double S=lineSum-batchLine;
+      batchSq+=S*S/NB;
+    }
+  batchLine=lineSum;
+  return;
+}
+
+void 
+volUnit::merge(const volUnit& A)
+  /*!
+    Add the sums of another unit [same cells]
+    \param A :: Unit to add
+  */
+{
+  npts+=A.npts;
+  lineSum+=A.lineSum;
+  sumSq+=A.sumSq;
   return;
 }
 
@@ -199,10 +253,47 @@ volUnit::calcVol(const double D) const
 
 double
 volUnit::calcLine(const double D) const
+  /*!
+    Calculate the scaled number of contributions
+    \param D :: Track divider
+    \return scaled count
+  */
 {
   return D*npts;
 }
 
+double
+volUnit::calcRelError(const double N) const
+  /*!
+    Calculate the relative error of the volume
+    \param N :: Number of histories
+    \return relative error [1.0 if no contribution]
+  */
+{
+  if (lineSum<=0.0 || N<1.0) return 1.0;
+  const double mean=lineSum/N;
+  const double var=sumSq/N-mean*mean;
+  return (var>0.0) ? std::sqrt(var/N)/mean : 0.0;
+}
+
+double
+volUnit::calcBatchError(const double N,const size_t nBatch) const
+  /*!
+    Calculate the relative error of the volume from the
+    spread of the batch results. Each batch must be an
+    independent estimate [e.g. a full stratified set or
+    a Halton set with its own random shift].
+    \param N :: Number of histories
+    \param nBatch :: Number of batches
+    \return relative error [1.0 if no contribution/one batch]
+  */
+{
+  if (lineSum<=0.0 || N<1.0 || nBatch<2) return 1.0;
+  const double mean=lineSum/N;
+  const double var=(batchSq/N-mean*mean)/static_cast<double>(nBatch-1);
+  return (var>0.0) ? std::sqrt(var)/mean : 0.0;
+}
+
 void 
 volUnit::write(std::ostream& OX) const
   /*!
@@ -0,0 +1,77 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/AttnTable.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_AttnTable_h
+#define ModelSupport_AttnTable_h
+
+namespace ModelSupport
+{
+
+/*!
+  \class AttnTable
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Macroscopic attenuation of each material at each energy
+
+  Built once from the DBMaterial store so that a track sum
+  is a table lookup per segment. The value per unit length is
+  \f$ \rho (A^{0.33}+\bar{\lambda}(E)/r_0)^2 \f$
+  [black nucleus] which is the old \f$ \rho A^{0.66} \f$
+  in the high energy limit. An empty energy list gives
+  the single high energy column.
+*/
+
+class AttnTable
+{
+ private:
+
+  static const double r0;        ///< Nuclear radius constant [fm]
+  static const double EMin;      ///< Lowest energy used [MeV]
+
+  std::vector<double> EPts;           ///< Energy points [MeV]
+  size_t NE;                          ///< Number of columns
+  std::map<int,size_t> matIndex;      ///< material : row
+  std::vector<double> Sigma;          ///< Values [row*NE+energy]
+
+  void build();
+
+ public:
+
+  AttnTable();
+  explicit AttnTable(const std::vector<double>&);
+  AttnTable(const AttnTable&);
+  AttnTable& operator=(const AttnTable&);
+  ~AttnTable() {}        ///< Destructor
+
+  static double lambdaFactor(const double);
+
+  /// Number of energy columns
+  size_t getNE() const { return NE; }
+  /// Energy points
+  const std::vector<double>& getEnergy() const { return EPts; }
+  const double* getRow(const int) const;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/CompTemplate.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_CompTemplate_h
+#define ModelSupport_CompTemplate_h
+
+class Rule;
+class HeadRule;
+
+namespace ModelSupport
+{
+
+class surfRegister;
+
+/*!
+  \class CompTemplate
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Pre-tokenised getComposite template
+
+  Splits a getComposite template once into surface tokens
+  [plain/T/M/N], cell complements and operators. Each
+  literal template string is held in a per-thread cache 
+  [bounded] so repeated calls only map the surfaces. 
+  A template with a regular structure builds the HeadRule 
+  directly. Anything else goes through the string and 
+  HeadRule::procString.
+*/
+
+class CompTemplate
+{
+ private:
+
+  /// Token types
+  enum tokType { surfTok=0,trueTok=1,minorTok=2,secondTok=3,
+		 cellTok=4,openTok=5,closeTok=6,compTok=7,
+		 unionTok=8,rawTok=9 };
+
+  static const size_t maxCache=4096;   ///< Max templates per thread
+
+  std::vector<int> TType;           ///< Token type
+  std::vector<int> TValue;          ///< Surface/cell number
+  std::vector<std::string> TText;   ///< Text of non-surface tokens
+  bool ruleFlag;                    ///< Rule can be built directly
+
+  void tokenise(const std::string&);
+  std::vector<int> calcSurf(const surfRegister&,const int,
+			    const int,const int) const;
+
+  Rule* procExpr(size_t&,const std::vector<int>&) const;
+  Rule* procTerm(size_t&,const std::vector<int>&) const;
+  Rule* procFactor(size_t&,const std::vector<int>&) const;
+  Rule* buildRule(const std::vector<int>&) const;
+
+ public:
+
+  explicit CompTemplate(const std::string&);
+  CompTemplate(const CompTemplate&);
+  CompTemplate& operator=(const CompTemplate&);
+  ~CompTemplate() {}         ///< Destructor
+
+  static const CompTemplate& getTemplate(const std::string&);
+
+  /// Can the rule be built without a string
+  bool isDirect() const { return ruleFlag; }
+  /// Number of tokens
+  size_t size() const { return TType.size(); }
+
+  std::string makeString(const surfRegister&,const int,
+			 const int,const int) const;
+  HeadRule makeRule(const surfRegister&,const int,
+		    const int,const int) const;
+};
+
+}
+
+#endif
@@ -3,7 +3,7 @@
  
  * File:   processInc/LayerDivide3D.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -61,6 +61,11 @@ class LayerDivide3D  : public attachSystem::FixedComp,
   std::pair<int,int> CWall;      ///< C wall surf numbers
   std::string divider;           ///< divider string [if any]
 
+  bool latticeFlag;              ///< Write as a lattice [if regular]
+  int latticeCell;               ///< Lattice cell [0 : explicit cells]
+  int fillCell;                  ///< Cell filled by the lattice 
+  std::vector<int> elemCell;     ///< Cell [or universe cell] of elements
+
   DivideGrid* DGPtr;             ///< Main divider materials
 
   std::string objName;           ///< XML component name
@@ -82,6 +87,11 @@ class LayerDivide3D  : public attachSystem::FixedComp,
   size_t processSurface(const size_t,
 		     const std::pair<int,int>&,
 		     const std::vector<double>&);
+  bool isRegular(const size_t,const size_t) const;
+  Geometry::Vec3D layerAxis(const size_t) const;
+
+  void divideExplicit(Simulation&,const int);
+  void divideLattice(Simulation&,const int);
   
  public:
 
@@ -97,6 +107,7 @@ class LayerDivide3D  : public attachSystem::FixedComp,
   void setIndexNames(const std::string&,const std::string&,
 		  const std::string&);
   void setDivider(const std::string&);
+  void setLattice(const bool);
 
   void setMaterials(const std::string&);
   void setMaterials(const size_t,const std::vector<std::string>&);
@@ -104,6 +115,7 @@ class LayerDivide3D  : public attachSystem::FixedComp,
 		     const std::string&,const std::string&);
   
   void divideCell(Simulation&,const int);
+  std::string getCellRef(const size_t,const size_t,const size_t) const;
     
 };
 
@@ -3,7 +3,7 @@
  
  * File:   processInc/ModelSupport.h
 *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -22,6 +22,8 @@
 #ifndef ModelSupport_h
 #define ModelSupport_h
 
+class HeadRule;
+
 /*!
   \namespace ModelSupport
   \author S. Ansell
@@ -32,6 +34,7 @@
 
 namespace ModelSupport
 {
+  std::string spcDelimString(const std::string&);
   std::string getExclude(const int);
   std::string removeOpenPair(const std::string&);
 
@@ -41,12 +44,21 @@ namespace ModelSupport
 			   const std::string&);
   std::string getComposite(const surfRegister&,const int,const int,
 			   const int,const std::string&);
+  std::string getDynamicComposite(const surfRegister&,const int,
+				  const std::string&);
 
   std::string getComposite(const surfRegister&,const int,const int);
   std::string getComposite(const surfRegister&,const int,const int,const int);
   std::string getComposite(const surfRegister&,const int,
 			   const int,const int,const int);
 
+  HeadRule getCompositeRule(const surfRegister&,const int,
+			    const std::string&);
+  HeadRule getCompositeRule(const surfRegister&,const int,const int,
+			    const std::string&);
+  HeadRule getCompositeRule(const surfRegister&,const int,const int,
+			    const int,const std::string&);
+
 
 
   std::string getSetComposite(const surfRegister&,const int,
@@ -0,0 +1,111 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/ObjBVH.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_ObjBVH_h
+#define ModelSupport_ObjBVH_h
+
+namespace MonteCarlo
+{
+  class Object;
+  class Qhull;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class ObjBVH
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Bounding volume hierarchy over the cells
+
+  Holds a conservative bounding box of each cell and
+  a binary tree of boxes, so that a point query
+  only tests the cells whose box contains the point.
+  Cells without a finite box are kept in a separate list
+  and are always tested. Candidates are tested in cell
+  number order so the result matches a linear search.
+  Cells whose rule has changed since the build are refitted
+  [update] : only their boxes are recalculated.
+*/
+
+class ObjBVH
+{
+ private:
+
+  /// Tree node [leaf if nItem!=0]
+  struct BVHNode
+  {
+    Geometry::BoundBox Box;   ///< Box of all items below
+    size_t leftIndex;         ///< Left child
+    size_t rightIndex;        ///< Right child
+    size_t firstItem;         ///< First item in itemIndex [leaf]
+    size_t nItem;             ///< Number of items [leaf]
+  };
+
+  static const size_t leafSize;      ///< Max items in a leaf
+
+  bool validFlag;                                ///< Tree is up to date
+  size_t ruleChange;                             ///< Object rule count at fit
+  std::vector<MonteCarlo::Object*> ObjVec;       ///< Cells [number order]
+  std::vector<Geometry::BoundBox> BoxVec;        ///< Box of each cell
+  std::vector<size_t> RuleVec;                   ///< Rule index of each cell
+  std::vector<int> TreeFlag;                     ///< Cell is in the tree
+  std::map<int,size_t> cellIndex;                ///< Cell number : index
+  std::vector<size_t> unBound;                   ///< Cells without a box
+  std::vector<size_t> itemIndex;                 ///< Tree ordered index
+  std::vector<BVHNode> Nodes;                    ///< Tree [0 is root]
+
+  static Geometry::BoundBox cellBox(const MonteCarlo::Object&);
+  size_t buildNode(const size_t,const size_t);
+  void refit();
+  void candidates(const Geometry::Vec3D&,std::vector<size_t>&) const;
+
+ public:
+
+  ObjBVH();
+  ObjBVH(const ObjBVH&);
+  ObjBVH& operator=(const ObjBVH&);
+  ~ObjBVH() {}          ///< Destructor
+
+  /// Is the tree up to date
+  bool isValid() const { return validFlag; }
+  /// Mark the tree as out of date
+  void setInvalid() { validFlag=0; }
+  void clearAll();
+
+  void build(const std::map<int,MonteCarlo::Qhull*>&);
+  void update(const std::map<int,MonteCarlo::Qhull*>&);
+
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&) const;
+  bool inBox(const int,const Geometry::Vec3D&) const;
+  const Geometry::BoundBox& getBox(const int) const;
+
+  /// Number of cells in the tree
+  size_t getNCells() const { return ObjVec.size(); }
+  /// Number of cells not bounded
+  size_t getNUnbound() const { return unBound.size(); }
+};
+
+}
+
+#endif
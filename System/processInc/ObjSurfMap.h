@@ -76,6 +76,8 @@ class ObjSurfMap
   
   MonteCarlo::Object* getObj(const int,const size_t) const;
   const STYPE& getObjects(const int) const;
+  MonteCarlo::Object* getNextObject(const int,const Geometry::Vec3D&,
+				    const int) const;
   MonteCarlo::Object* findNextObject(const int,
 				     const Geometry::Vec3D&,const int) const;
 
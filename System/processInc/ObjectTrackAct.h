@@ -36,6 +36,7 @@ namespace ModelSupport
 {
 
   class LineTrack;
+  class AttnTable;
 
 /*!
   \class ObjectTrackAct
@@ -73,7 +74,8 @@ class ObjectTrackAct
   void clearAll();
 
   double getMatSum(const long int) const;
-  double getAttnSum(const long int) const;
+  void getAttnSum(const long int,const AttnTable&,
+		  std::vector<double>&) const;
   double getDistance(const long int) const;
   /// Debug function effectivley
   //  const std::map<int,ObjTrackItem>& getMap() const { return Items; }
@@ -0,0 +1,97 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/TrackFan.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_TrackFan_h
+#define ModelSupport_TrackFan_h
+
+class Simulation;
+
+namespace Geometry
+{
+  class Plane;
+}
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+  class AttnTable;
+
+/*!
+  \class TrackFan
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Traces a set of rays for the attenuation sum
+
+  Replaces an ObjectTrackPoint/Plane per ray for mesh
+  weights. The rays are split into contiguous blocks over
+  the threads. The start cell of a point origin is found once.
+  The cell path of the previous ray in the block is the first
+  guess when a cell has to be searched for. Each ray result
+  [index : distance : attenuation per energy] is passed to
+  the RayFunc without storing the track.
+*/
+
+class TrackFan
+{
+ public:
+
+  /// Ray output [index : distance : attenuation[NE] ]
+  typedef std::function<void(const size_t,const double,
+			     const double*)> RayFunc;
+
+ private:
+
+  const Simulation& System;           ///< Simulation to track
+  const AttnTable& ATable;            ///< Attenuation table
+  size_t nThread;                     ///< Number of threads [0/1 serial]
+
+  void traceRay(const Geometry::Vec3D&,const Geometry::Vec3D&,
+		MonteCarlo::Object*,
+		std::vector<MonteCarlo::Object*>&,double*) const;
+  void traceBlock(const Geometry::Vec3D*,const Geometry::Plane*,
+		  const std::vector<Geometry::Vec3D>&,
+		  const size_t,const size_t,const RayFunc&) const;
+  void traceAll(const Geometry::Vec3D*,const Geometry::Plane*,
+		const std::vector<Geometry::Vec3D>&,const RayFunc&) const;
+
+ public:
+
+  TrackFan(const Simulation&,const AttnTable&);
+  TrackFan(const TrackFan&);
+  ~TrackFan() {}         ///< Destructor
+
+  /// Set the number of threads
+  void setThreads(const size_t N) { nThread=N; }
+
+  void trace(const Geometry::Vec3D&,const std::vector<Geometry::Vec3D>&,
+	     const RayFunc&) const;
+  void trace(const Geometry::Plane&,const std::vector<Geometry::Vec3D>&,
+	     const RayFunc&) const;
+};
+
+}
+
+#endif
@@ -3,7 +3,7 @@
  
  * File:   processInc/VolSum.h
 *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,6 +23,7 @@
 #define ModelSupport_VolSum_h
 
 class Simulation;
+class MTRand;
 namespace MonteCarlo
 {
   class Object;
@@ -36,7 +37,16 @@ namespace ModelSupport
   \brief Hold an official model number
   \date August 2010
   \author S. Ansell
-  \version 1.0
+  \version 1.1
+
+  Points/tracks can be split over threads [each with its own 
+  random stream and tally copy, merged at the end of a batch].
+  Points can be random, stratified [jittered grid] or from a
+  shifted Halton sequence. Stratified/Halton points are run in
+  batches [each a full grid / a new Halton shift] and their
+  error is from the spread of the batches. If a target
+  relative error is set the run stops once all the tallies
+  have reached it.
 */
 						
 class VolSum
@@ -56,11 +66,31 @@ class VolSum
   
   double fullVol;                           ///< Full volume  
   double totalDist;                         ///< Total distance
-  int nTracks;                              ///< Number of full tracks
+  size_t nTracks;                           ///< Number of full tracks
+  size_t nBatch;                            ///< Number of batches run
+
+  size_t nThread;                           ///< Number of threads
+  int sampleType;                           ///< 0 random/1 strat/2 halton
+  bool replicaErr;                          ///< Error from batch spread
+  double targetErr;                         ///< Relative error to stop
+  Geometry::Vec3D haltonShift;              ///< Shift of Halton points
    
   tvTYPE tallyVols;                         ///< TallyNum:Volumes
 
-  Geometry::Vec3D getCubePoint() const;
+  static void addUnit(tvTYPE&,const int,const double);
+  static void endHistory(tvTYPE&);
+  static double radicalInverse(size_t,const size_t);
+
+  Geometry::Vec3D getCubePoint(MTRand&) const;
+  Geometry::Vec3D getBoxPoint(const size_t,const size_t,
+			      const size_t,MTRand&) const;
+  void pointBlock(const Simulation&,const size_t,const size_t,
+		  const size_t,const size_t,MTRand&,tvTYPE&) const;
+  double trackBlock(const Simulation&,const size_t,
+		    MTRand&,tvTYPE&) const;
+  void runBatch(const Simulation&,const size_t,const size_t,const bool);
+  void endBatch(const size_t);
+  void runAll(const Simulation&,const size_t,const bool);
   
  public:
   
@@ -70,6 +100,11 @@ class VolSum
   ~VolSum();
 
   void reset();
+  /// Set the number of threads
+  void setThreads(const size_t N) { nThread=N; }
+  /// Set the relative error to stop at [0 : run all]
+  void setTargetError(const double E) { targetErr=E; }
+  void setSampling(const std::string&);
   void addDistance(const int,const double);
   void addFlux(const int,const double&,const double&);
   
@@ -80,6 +115,8 @@ class VolSum
   void trackRun(const Simulation&,const size_t);
   void pointRun(const Simulation&,const size_t);
   double calcVolume(const int) const;
+  double calcRelError(const int) const;
+  double maxRelError() const;
   void populateTally(const Simulation&);
   void populateAll(const Simulation&);
   void populateVSet(const Simulation&,const std::vector<int>&);
@@ -41,6 +41,7 @@ class masterWrite
   boost::format FMTinteger;      ///< Format statement for integer
 
   masterWrite();
+  boost::format& threadFMT() const;
 
   ///\cond SINGLETON
   masterWrite(const masterWrite&);
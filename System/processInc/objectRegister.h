@@ -3,7 +3,7 @@
  
  * File:   processInc/objectRegister.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -48,10 +48,14 @@ class objectRegister
   typedef std::shared_ptr<attachSystem::FixedComp> CTYPE;
   /// Index of them
   typedef std::map<std::string,CTYPE> cMapTYPE;
+  /// Range units sorted by start cell
+  typedef std::vector<MTYPE::const_iterator> ITYPE;
 
   int cellNumber;                  ///< Current new cell number
   MTYPE regionMap;                 ///< Index of kept object number
   MTYPE renumMap;                  ///< Index of renumbered units
+  ITYPE regionIndex;               ///< regionMap sorted by start
+  ITYPE renumIndex;                ///< renumMap sorted by start
   std::set<int> activeCells;       ///< Active cells
   cMapTYPE Components;             ///< Pointer to real objects
 
@@ -66,6 +70,12 @@ class objectRegister
     getInternalObject(const std::string&) const;
   attachSystem::FixedComp*
     getInternalObject(const std::string&);
+
+  static void addIndex(ITYPE&,const MTYPE::const_iterator&);
+  static void removeIndex(ITYPE&,const MTYPE::const_iterator&);
+  static ITYPE::const_iterator findIndex(const ITYPE&,const int);
+  static std::vector<std::string>
+    findIndex(const ITYPE&,const std::vector<int>&);
   
  public:
   
@@ -79,12 +89,15 @@ class objectRegister
   int getRange(const std::string&) const;
   
   std::string inRange(const int) const;
+  std::vector<std::string> inRange(const std::vector<int>&) const;
 
   int getRenumberCell(const std::string&) const;
   int getRenumberLast(const std::string&) const;
   int getRenumberRange(const std::string&) const;
   
   std::string inRenumberRange(const int) const;
+  std::vector<std::string>
+    inRenumberRange(const std::vector<int>&) const;
 
   int calcRenumber(const int) const;
     
@@ -3,7 +3,7 @@
  
  * File:   processInc/volUnit.h
 *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -40,6 +40,10 @@ class volUnit
   int npts;              ///< Number of contributions
   std::set<int> cells;   ///< Cell units
   double lineSum;        ///< Sum of length
+  double histSum;        ///< Sum of length in current history
+  double sumSq;          ///< Sum of history length squared
+  double batchLine;      ///< Length sum at the end of the last batch
+  double batchSq;        ///< Sum of batch length squared / batch size
 
   std::string comment;   ///< Description
   int matNum;            ///< Material number
@@ -55,9 +59,14 @@ class volUnit
   void setCells(const std::vector<int>&);
   void addCell(const int);
   void reset();
+  void endHistory();
+  void endBatch(const double);
+  void merge(const volUnit&);
   
   double calcVol(const double) const;
   double calcLine(const double) const;
+  double calcRelError(const double) const;
+  double calcBatchError(const double,const size_t) const;
   void addUnit(const int,const double);
   void addFlux(const int,const double,const double);
 
@@ -0,0 +1,207 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   support/CardWriter.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "threadSupport.h"
+#include "CardWriter.h"
+
+namespace StrFunc
+{
+
+CardBuffer::CardBuffer(const size_t N) :
+  Buffer((N>1024) ? N : 1024)
+  /*!
+    Constructor
+    \param N :: Buffer size
+  */
+{
+  setp(Buffer.data(),Buffer.data()+Buffer.size());
+  // all the buffering is done here
+  FB.pubsetbuf(0,0);
+}
+
+CardBuffer::~CardBuffer()
+  /*!
+    Destructor [writes any remaining output]
+  */
+{
+  close();
+}
+
+bool
+CardBuffer::open(const std::string& FName)
+  /*!
+    Open the file [truncated]
+    \param FName :: File name
+    \return true on success
+  */
+{
+  close();
+  return (FB.open(FName.c_str(),std::ios::out | std::ios::trunc)!=0);
+}
+
+bool
+CardBuffer::writeOut()
+  /*!
+    Write the buffer to the file and reset it
+    \return true on success
+  */
+{
+  const std::streamsize N(pptr()-pbase());
+  setp(Buffer.data(),Buffer.data()+Buffer.size());
+  return (!N || FB.sputn(Buffer.data(),N)==N);
+}
+
+CardBuffer::int_type
+CardBuffer::overflow(int_type C)
+  /*!
+    Buffer is full : write it out 
+    \param C :: Character to add [after the write]
+    \return eof on failure
+  */
+{
+  if (!FB.is_open() || !writeOut())
+    return traits_type::eof();
+  if (!traits_type::eq_int_type(C,traits_type::eof()))
+    {
+      *pptr()=traits_type::to_char_type(C);
+      pbump(1);
+    }
+  return traits_type::not_eof(C);
+}
+
+int
+CardBuffer::sync()
+  /*!
+    Ignore the flush from std::endl
+    \return 0 [success]
+  */
+{
+  return 0;
+}
+
+bool
+CardBuffer::flushAll()
+  /*!
+    Write the buffer to the file
+    \return true on success
+  */
+{
+  if (!FB.is_open()) return 0;
+  return (writeOut() && !FB.pubsync());
+}
+
+bool
+CardBuffer::close()
+  /*!
+    Write the buffer and close the file
+    \return true on success [or nothing to close]
+  */
+{
+  if (!FB.is_open()) return 1;
+  const bool flag=flushAll();
+  return (FB.close()!=0 && flag);
+}
+
+CardWriter::CardWriter(const std::string& FName,const size_t N) :
+  std::ostream(0),Buf(N)
+  /*!
+    Constructor 
+    \param FName :: File name
+    \param N :: Buffer size
+  */
+{
+  rdbuf(&Buf);
+  if (!Buf.open(FName))
+    setstate(std::ios::failbit);
+}
+
+CardWriter::~CardWriter()
+  /*!
+    Destructor [closes the file]
+  */
+{
+  Buf.close();
+}
+
+void
+CardWriter::close()
+  /*!
+    Write the buffer and close the file 
+  */
+{
+  if (!Buf.close())
+    setstate(std::ios::failbit);
+  return;
+}
+
+void
+parallelWrite(std::ostream& OX,const size_t N,const size_t nThread,
+	      const std::function<void(std::ostream&,const size_t)>& writeFunc)
+  /*!
+    Write N items in order. The items are divided into
+    contiguous blocks that are formatted by nThread threads
+    into separate buffers. The buffers are then written in
+    block order so the output is the same as the serial write.
+    The write function must not change the stream state 
+    that a later item depends on.
+    \param OX :: Output stream
+    \param N :: Number of items
+    \param nThread :: Number of threads [0/1 : serial]
+    \param writeFunc :: Function to write item i to a stream
+  */
+{
+  const size_t nT=std::min(nThread,N);
+  if (nT<2)
+    {
+      for(size_t i=0;i<N;i++)
+	writeFunc(OX,i);
+      return;
+    }
+
+  // more blocks than threads for load balance
+  const size_t nBlock=std::min(N,4*nT);
+  std::vector<std::string> Buffer(nBlock);
+  threadSupport::parallelQueue
+    (nT,nBlock,[&](const size_t BN)
+     {
+       std::ostringstream cx;
+       cx.copyfmt(OX);
+       const size_t endIndex((N*(BN+1))/nBlock);
+       for(size_t j=(N*BN)/nBlock;j<endIndex;j++)
+	 writeFunc(cx,j);
+       Buffer[BN]=cx.str();
+     });
+
+  for(const std::string& Out : Buffer)
+    OX.write(Out.data(),static_cast<std::streamsize>(Out.size()));
+  return;
+}
+
+} // NAMESPACE StrFunc
@@ -0,0 +1,136 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   support/NumberMap.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "NumberMap.h"
+
+namespace MapSupport
+{
+
+NumberMap::NumberMap() :
+  sorted(1)
+  /*!
+    Constructor
+  */
+{}
+
+NumberMap::NumberMap(const NumberMap& A) :
+  sorted(A.sorted),Items(A.Items)
+  /*!
+    Copy constructor
+    \param A :: NumberMap to copy
+  */
+{}
+
+NumberMap&
+NumberMap::operator=(const NumberMap& A)
+  /*!
+    Assignment operator
+    \param A :: NumberMap to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      sorted=A.sorted;
+      Items=A.Items;
+    }
+  return *this;
+}
+
+void
+NumberMap::addItem(const int oldN,const int newN)
+  /*!
+    Add a change. Null changes are ignored
+    \param oldN :: Original number [+ve]
+    \param newN :: New number [+ve]
+  */
+{
+  if (oldN<=0 || newN<=0)
+    throw ColErr::IndexError<int>(oldN,newN,"NumberMap::addItem");
+  if (oldN!=newN)
+    {
+      if (sorted && !Items.empty() && Items.back().first>=oldN)
+	sorted=0;
+      Items.push_back(std::pair<int,int>(oldN,newN));
+    }
+  return;
+}
+
+void
+NumberMap::sortItems()
+  /*!
+    Sort the items [required before find if they were
+    not added in order]. 
+    \throw InContainerError if an old number is repeated
+  */
+{
+  if (!sorted)
+    {
+      std::sort(Items.begin(),Items.end());
+      sorted=1;
+    }
+  for(size_t i=1;i<Items.size();i++)
+    if (Items[i].first==Items[i-1].first)
+      throw ColErr::InContainerError<int>
+	(Items[i].first,"NumberMap repeated number");
+  return;
+}
+
+int
+NumberMap::find(const int oldN) const
+  /*!
+    Find the new number 
+    \param oldN :: Original number [+ve]
+    \return new number / 0 if not changed
+  */
+{
+  if (!sorted)
+    throw ColErr::EmptyValue<void>("NumberMap::find unsorted");
+
+  std::vector<std::pair<int,int>>::const_iterator vc=
+    std::lower_bound(Items.begin(),Items.end(),
+		     std::pair<int,int>(oldN,0));
+  return (vc!=Items.end() && vc->first==oldN) ? vc->second : 0;
+}
+
+int
+NumberMap::convert(const int N) const
+  /*!
+    Convert a signed number
+    \param N :: Number [sign is preserved]
+    \return new number / N if not changed
+  */
+{
+  const int newN=find((N>0) ? N : -N);
+  if (!newN) return N;
+  return (N>0) ? newN : -newN;
+}
+
+} // NAMESPACE MapSupport
@@ -837,13 +837,60 @@ writeMCNPXcont(const std::string& Line,std::ostream& OX)
   return;
 }
 
+size_t
+lastBreak(const char* X,const size_t N)
+/*!
+  Find the last space/comma in a section of a line
+  \param X :: Start of section
+  \param N :: Length of section
+  \return index / std::string::npos if none
+*/
+{
+  for(size_t i=N;i;i--)
+    if (X[i-1]==' ' || X[i-1]==',')
+      return i-1;
+  return std::string::npos;
+}
+
+void
+writeBlock(std::ostream& OX,const size_t spcLen,
+	   const char* X,size_t N)
+/*!
+  Write a section of a line [stripped of leading/trailing
+  space] after an indent. Nothing is written if the 
+  section is empty. The line is not flushed.
+  \param OX :: ostream to write to
+  \param spcLen :: Number of leading spaces
+  \param X :: Start of section
+  \param N :: Length of section
+*/
+{
+  static const char spc[]="                                ";
+  const size_t spcSize(sizeof(spc)-1);
+  
+  for(;N && isspace(X[N-1]);N--) ;
+  for(;N && isspace(*X);X++,N--) ;
+  if (!N) return;
+
+  for(size_t i=spcLen;i;)
+    {
+      const size_t nSpc=std::min(i,spcSize);
+      OX.write(spc,static_cast<std::streamsize>(nSpc));
+      i-=nSpc;
+    }
+  OX.write(X,static_cast<std::streamsize>(N));
+  OX.put('\n');
+  return;
+}
+
 void
 writeControl(const std::string& Line,std::ostream& OX,
 	     const size_t LNmax,int insertDepth)
 /*!
   Write out the line in the limited form for MCNPX
   ie initial line from 0::72 after that 8 to 72
-  (split on a space or comma)
+  (split on a space or comma). Each output line is
+  written as a slice of Line [no copy].
   \param Line :: full MCNPX line
   \param OX :: ostream to write to
   \param LNmax :: Maximium char count in a line
@@ -857,27 +904,25 @@ writeControl(const std::string& Line,std::ostream& OX,
       insertDepth *= -1;
       spcLen=static_cast<size_t>(insertDepth);
     }
+  const char* LPtr=Line.c_str();
+  const size_t LSize=Line.size();
 
-  std::string::size_type pos(0);
-  std::string X=Line.substr(0,LNmax-spcLen);    
-  std::string::size_type posB=X.find_last_of(" ,");
-  while(X.length() == LNmax-spcLen &&
+  size_t pos(0);
+  size_t XLen=std::min(LNmax-spcLen,LSize);
+  size_t posB=lastBreak(LPtr,XLen);
+  while(XLen == LNmax-spcLen &&
 	posB!=std::string::npos)
     {
+      const char* X=LPtr+pos;
       pos+=posB+1;
       if (!isspace(X[posB])) posB++;  // skip pass comma 
-      X=fullBlock(X.substr(0,posB));
-      if (!isEmpty(X))
-	OX<<std::string(spcLen,' ')<<X<<std::endl;
+      writeBlock(OX,spcLen,X,posB);
 
       spcLen=static_cast<size_t>(insertDepth);
-      X=Line.substr(pos,LNmax-spcLen);
-      posB=X.find_last_of(" ,");
+      XLen=std::min(LNmax-spcLen,LSize-pos);
+      posB=lastBreak(LPtr+pos,XLen);
     }
-    
-  X=fullBlock(X);
-  if (!isEmpty(X))
-    OX<<std::string(spcLen,' ')<<X<<std::endl;
+  writeBlock(OX,spcLen,LPtr+pos,XLen);
   return;
 }
 
@@ -910,7 +955,7 @@ writeMCNPXcomment(const std::string& Line,std::ostream& OX)
 	  OX<<"c ";
 	  if (spc)
 	    OX<<std::string(spc,' ');
-	  OX<<X.substr(0,posB)<<std::endl;
+	  OX<<X.substr(0,posB)<<'\n';
 	}
       spc=8;
       X=Line.substr(pos,MaxLine-spc);
@@ -921,7 +966,7 @@ writeMCNPXcomment(const std::string& Line,std::ostream& OX)
       OX<<"c ";
       if (spc)
 	OX<<std::string(spc,' ');
-      OX<<X<<std::endl;
+      OX<<X<<'\n';
     }
   return;
 }
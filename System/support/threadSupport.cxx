@@ -0,0 +1,117 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   support/threadSupport.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <exception>
+
+#include "threadSupport.h"
+
+namespace threadSupport
+{
+
+size_t
+threadCount(const size_t nThread,const size_t N)
+  /*!
+    Number of threads to use for N items
+    \param nThread :: Requested threads [0/1 : serial]
+    \param N :: Number of items
+    \return threads to use [at least 1]
+  */
+{
+  return std::max<size_t>(1,std::min(nThread,N));
+}
+
+size_t
+parallelFor(const size_t nThread,const size_t N,const BlockFunc& blockFunc)
+  /*!
+    Split N items into one contiguous block per thread.
+    Each block is processed by blockFunc(thread,first,last).
+    With one thread the call is made on the calling thread.
+    Any object used by the threads that builds itself on
+    first use [e.g. Simulation::getCellIndex] must be built
+    before the call. The first exception of a thread is
+    rethrown after all the threads have finished.
+    \param nThread :: Number of threads [0/1 : serial]
+    \param N :: Number of items
+    \param blockFunc :: Function for a block
+    \return number of threads used
+  */
+{
+  const size_t nT=threadCount(nThread,N);
+  if (nT==1)
+    {
+      blockFunc(0,0,N);
+      return 1;
+    }
+
+  std::vector<std::exception_ptr> errVec(nT);
+  std::vector<std::thread> Workers;
+  for(size_t i=0;i<nT;i++)
+    {
+      const size_t startIndex((N*i)/nT);
+      const size_t endIndex((N*(i+1))/nT);
+      Workers.push_back
+	(std::thread([=,&blockFunc,&errVec]()
+		     {
+		       try
+			 {
+			   blockFunc(i,startIndex,endIndex);
+			 }
+		       catch(...)
+			 {
+			   errVec[i]=std::current_exception();
+			 }
+		     }));
+    }
+  for(std::thread& T : Workers)
+    T.join();
+  for(const std::exception_ptr& EP : errVec)
+    if (EP) std::rethrow_exception(EP);
+  return nT;
+}
+
+size_t
+parallelQueue(const size_t nThread,const size_t N,const ItemFunc& itemFunc)
+  /*!
+    Process N items of unequal cost. Each thread takes
+    the next unprocessed item until none are left, so the
+    order of the calls is not fixed.
+    \param nThread :: Number of threads [0/1 : serial]
+    \param N :: Number of items
+    \param itemFunc :: Function for an item
+    \return number of threads used
+  */
+{
+  std::atomic<size_t> nextItem(0);
+  return parallelFor
+    (nThread,N,[&](const size_t,const size_t,const size_t)
+     {
+       size_t index;
+       while((index=nextItem++)<N)
+	 itemFunc(index);
+     });
+}
+
+} // NAMESPACE threadSupport
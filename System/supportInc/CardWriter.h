@@ -0,0 +1,105 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   supportInc/CardWriter.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef StrFunc_CardWriter_h
+#define StrFunc_CardWriter_h
+
+namespace StrFunc
+{
+
+/*!
+  \class CardBuffer
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Large output buffer to a file 
+
+  The buffer is only written to the file when full
+  or on close. A sync [std::endl / flush] is ignored.
+*/
+
+class CardBuffer : public std::streambuf
+{
+ private:
+
+  std::filebuf FB;              ///< Unbuffered file
+  std::vector<char> Buffer;     ///< Output buffer
+
+  bool writeOut();
+
+ protected:
+
+  virtual int_type overflow(int_type);
+  virtual int sync();
+
+ public:
+
+  explicit CardBuffer(const size_t);
+  CardBuffer(const CardBuffer&) =delete;
+  CardBuffer& operator=(const CardBuffer&) =delete;
+  virtual ~CardBuffer();
+
+  /// Check file
+  bool isOpen() const { return FB.is_open(); }
+  bool open(const std::string&);
+  bool flushAll();
+  bool close();
+};
+
+/*!
+  \class CardWriter
+  \version 1.0
+  \author S. Ansell
+  \date November 2017
+  \brief Output file stream for the MCNP/PHITS/FLUKA decks
+
+  Replaces std::ofstream for the deck write. The cards
+  [writeMCNPX / writeControl] go into a large buffer that 
+  is only flushed when full or on close. 
+*/
+
+class CardWriter : public std::ostream
+{
+ private:
+
+  CardBuffer Buf;          ///< Output buffer
+
+ public:
+
+  /// Default buffer size
+  static const size_t defSize=1 << 22;
+  
+  explicit CardWriter(const std::string&,const size_t =defSize);
+  CardWriter(const CardWriter&) =delete;
+  CardWriter& operator=(const CardWriter&) =delete;
+  virtual ~CardWriter();
+
+  /// Check file
+  bool isOpen() const { return Buf.isOpen(); }
+  void close();
+};
+
+void parallelWrite(std::ostream&,const size_t,const size_t,
+		   const std::function<void(std::ostream&,const size_t)>&);
+
+}
+
+#endif
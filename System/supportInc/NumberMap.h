@@ -0,0 +1,74 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   supportInc/NumberMap.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef MapSupport_NumberMap_h
+#define MapSupport_NumberMap_h
+
+namespace MapSupport
+{
+/*!
+  \class NumberMap
+  \author S. Ansell
+  \date November 2017
+  \version 1.0
+  \brief Old to new number map for renumbering
+
+  Held as a flat vector sorted on the old number so that
+  a lookup is a binary search over contiguous memory.
+  All the changes are applied simultaneously, so the old
+  and new numbers can overlap [a->b and b->c]. 
+  Numbers are +ve [0 is not a valid number], a -ve 
+  number given to convert keeps its sign.
+*/
+
+class NumberMap
+{
+ private:
+
+  bool sorted;                              ///< Items are sorted
+  std::vector<std::pair<int,int>> Items;    ///< old : new 
+
+ public:
+
+  NumberMap();
+  NumberMap(const NumberMap&);
+  NumberMap& operator=(const NumberMap&);
+  ~NumberMap() {}   ///< Destructor
+
+  void addItem(const int,const int);
+  void sortItems();
+  
+  /// Has no changes
+  bool empty() const { return Items.empty(); }
+  /// Number of changes
+  size_t size() const { return Items.size(); }
+  /// Access items [old:new]
+  const std::vector<std::pair<int,int>>& getItems() const
+    { return Items; }
+
+  int find(const int) const;
+  int convert(const int) const;
+
+};
+
+} // NAMESPACE MapSupport
+
+#endif
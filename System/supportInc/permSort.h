@@ -41,7 +41,7 @@ sortPermutation(const std::vector<T>& mainVec,
   std::vector<size_t> index(mainVec.size());
   
   for(size_t i=0;i<index.size();i++)
-    index.push_back(i);
+    index[i]=i;
 // std::iota(index.begin(),index.end(),0);
   std::sort(index.begin(),index.end(),
             [&](const size_t i, const size_t j)
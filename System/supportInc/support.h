@@ -84,6 +84,10 @@ template<typename T> int sectionCINDER(std::string&,T&);
 template<typename T> int itemize(std::string&,std::string&,T&);
 
 
+/// Position of the last space/comma
+size_t lastBreak(const char*,const size_t);
+/// Write a stripped section of a line
+void writeBlock(std::ostream&,const size_t,const char*,size_t);
 // Write file in standard MCNPX input form
 void writeControl(const std::string&,std::ostream&,
 		  const size_t,const int);
@@ -0,0 +1,48 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   supportInc/threadSupport.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef threadSupport_h
+#define threadSupport_h
+
+/*!
+  \namespace threadSupport
+  \brief Thread pool free loops over an index range
+  \author S. Ansell
+  \version 1.0
+  \date November 2017
+*/
+
+namespace threadSupport
+{
+
+/// Block function : thread index : first item : one past last item
+typedef std::function<void(const size_t,const size_t,const size_t)> BlockFunc;
+/// Item function : item index
+typedef std::function<void(const size_t)> ItemFunc;
+
+size_t threadCount(const size_t,const size_t);
+
+size_t parallelFor(const size_t,const size_t,const BlockFunc&);
+size_t parallelQueue(const size_t,const size_t,const ItemFunc&);
+
+}
+
+#endif
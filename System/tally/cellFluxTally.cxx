@@ -44,6 +44,7 @@
 #include "Vec3D.h"
 #include "Triple.h"
 #include "NList.h"
+#include "NumberMap.h"
 #include "NRange.h"
 #include "Tally.h"
 #include "cellFluxTally.h"
@@ -203,14 +204,13 @@ cellFluxTally::addIndividualCells(const std::vector<int>& AVec)
 }
 
 void
-cellFluxTally::renumberCell(const int oldCell,const int newCell)
+cellFluxTally::renumberCells(const MapSupport::NumberMap& CMap)
   /*!
-    Renumbers a cell from the active list
-    \param oldCell :: Old cell numb
-    \param newCell :: New cell numb
+    Renumbers the cells in the active list
+    \param CMap :: Map of old : new cell numbers
   */
 {
-  cellList.changeItem(oldCell,newCell);
+  cellList.changeItems(CMap);
   return;
 }
 
@@ -43,6 +43,7 @@
 #include "Vec3D.h"
 #include "Triple.h"
 #include "NList.h"
+#include "NumberMap.h"
 #include "NRange.h"
 #include "Tally.h"
 #include "heatTally.h"
@@ -170,15 +171,14 @@ heatTally::addCells(const std::vector<int>& AVec)
 }
 
 void
-heatTally::renumberCell(const int oldN,const int newN)
+heatTally::renumberCells(const MapSupport::NumberMap& CMap)
   /*!
-    renumber the cell based on the old/New numbers
-    \param oldN :: Old number to find
-    \param newN :: new number to replace the cell with
+    Renumber the cells based on the old/New numbers
+    \param CMap :: Map of old : new cell numbers
    */
 {
-  ELog::RegMethod RegA("heatTally","renumberCell");
-  cellList.changeItem(oldN,newN);
+  ELog::RegMethod RegA("heatTally","renumberCells");
+  cellList.changeItems(CMap);
   return;
 }
 
@@ -53,6 +53,7 @@
 #include "Triple.h"
 #include "NRange.h"
 #include "NList.h"
+#include "NumberMap.h"
 #include "Tally.h"
 #include "Transform.h"
 #include "Surface.h"
@@ -147,6 +148,20 @@ sswTally::renumberSurf(const int oldN,const int newN)
   return;
 }
 
+void
+sswTally::renumberSurfaces(const MapSupport::NumberMap& SMap)
+  /*!
+    Renumber the surfaces in one pass [signs are kept]
+    \param SMap :: Map of old : new surface numbers
+  */
+{
+  ELog::RegMethod RegA("sswTally","renumberSurfaces");
+
+  for(int& SN : surfList)
+    SN=SMap.convert(SN);
+  return;
+}
+
 void
 sswTally::write(std::ostream& OX) const
   /*!
@@ -42,6 +42,7 @@
 #include "Triple.h"
 #include "NRange.h"
 #include "NList.h"
+#include "NumberMap.h"
 #include "Tally.h"
 #include "surfaceTally.h"
 
@@ -220,15 +221,14 @@ surfaceTally::setSurfDivider(const std::vector<int>& TS)
 }
 
 void
-surfaceTally::renumberCell(const int oldN,const int newN)
+surfaceTally::renumberCells(const MapSupport::NumberMap& CMap)
   /*!
-    Renumber the cell based on the old/New numbers
-    \param oldN :: Old number to find
-    \param newN :: new number to replace the cell with
+    Renumber the cells based on the old/New numbers
+    \param CMap :: Map of old : new cell numbers
    */
 {
-  ELog::RegMethod RegA("surfaceTally","renumberCell");
-  CellFlag.changeItem(oldN,newN);
+  ELog::RegMethod RegA("surfaceTally","renumberCells");
+  CellFlag.changeItems(CMap);
   return;
 }
 
@@ -260,6 +260,23 @@ surfaceTally::renumberSurf(const int oldN,const int newN)
 		  -newN);
   return;
 }
+
+void
+surfaceTally::renumberSurfaces(const MapSupport::NumberMap& SMap)
+  /*!
+    Renumber the surfaces in one pass [signs are kept]
+    \param SMap :: Map of old : new surface numbers
+   */
+{
+  ELog::RegMethod RegA("surfaceTally","renumberSurfaces");
+
+  SurfFlag.changeItems(SMap);
+  for(int& SN : SurfList)
+    SN=SMap.convert(SN);
+  for(int& SN : FSfield)
+    SN=SMap.convert(SN);
+  return;
+}
   
 
 void
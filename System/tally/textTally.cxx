@@ -114,14 +114,13 @@ textTally::addLine(const std::string& LX)
 
 
 void
-textTally::renumberCell(const int ,const int )
+textTally::renumberCells(const MapSupport::NumberMap&)
   /*!
     Renumber the cell based on the old/New numbers
-    \param :: Old number to find
-    \param :: new number to replace the cell with
+    \param :: Map of old : new cell numbers
    */
 {
-  ELog::RegMethod RegA("textTally","renumberCell");
+  ELog::RegMethod RegA("textTally","renumberCells");
   return;
 }
 
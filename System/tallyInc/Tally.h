@@ -22,6 +22,11 @@
 #ifndef tallySystem_Tally_h
 #define tallySystem_Tally_h
 
+namespace MapSupport
+{
+  class NumberMap;
+}
+
 namespace tallySystem
 {
 
@@ -109,9 +114,11 @@ class Tally
   virtual void rotateMaster() { }          ///< Rotation to Master
   virtual int addLine(const std::string&);     
   /// Renumber [not normally required]
-  virtual void renumberCell(const int,const int) {}
+  virtual void renumberCells(const MapSupport::NumberMap&) {}
   /// Renumber [not normally required]
   virtual void renumberSurf(const int,const int) {}
+  /// Renumber [not normally required]
+  virtual void renumberSurfaces(const MapSupport::NumberMap&) {}
   /// make a group sum into single units
   virtual int makeSingle() { return 0; }
 
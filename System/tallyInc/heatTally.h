@@ -54,7 +54,7 @@ class heatTally : public Tally
   void clearCells();
   void setPlus(const int V) { plus=V; } ///< Set the + flag
   
-  virtual void renumberCell(const int,const int);
+  virtual void renumberCells(const MapSupport::NumberMap&);
   virtual int addLine(const std::string&); 
   virtual void write(std::ostream&) const;
   
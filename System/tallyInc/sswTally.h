@@ -51,6 +51,7 @@ class sswTally : public Tally
 
   void addSurfaces(const std::vector<int>&);
   virtual void renumberSurf(const int,const int);
+  virtual void renumberSurfaces(const MapSupport::NumberMap&);
 
   virtual void write(std::ostream&) const;
 };
@@ -63,8 +63,9 @@ class surfaceTally : public Tally
     void setSurfDivider(const std::vector<int>&);
     void setCellDivider(const std::vector<int>&);
     
-    virtual void renumberCell(const int,const int);
+    virtual void renumberCells(const MapSupport::NumberMap&);
     virtual void renumberSurf(const int,const int);
+    virtual void renumberSurfaces(const MapSupport::NumberMap&);
 
     virtual void write(std::ostream&) const;
     
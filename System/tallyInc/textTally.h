@@ -51,7 +51,7 @@ class textTally : public Tally
     /// Accessor to lines
     const std::vector<std::string>& getLines() const 
       { return Lines; }
-    virtual void renumberCell(const int,const int);
+    virtual void renumberCells(const MapSupport::NumberMap&);
     virtual void renumberSurf(const int,const int);
     
     virtual void write(std::ostream&) const;      
@@ -58,6 +58,7 @@
 #include "SimProcess.h"
 #include "SurInter.h"
 #include "Simulation.h"
+#include "VoxelTrack.h"
 #include "MatMD5.h"
 #include "MD5sum.h"
 
@@ -76,7 +77,7 @@ operator<<(std::ostream& OX,const MD5sum& A)
 }
 
 MD5sum::MD5sum(const size_t MaxN) : 
-  Results(MaxN)
+  nThread(0),Results(MaxN)
   /*!
     Constructor
     \param MaxN :: Maximum number of materials
@@ -85,7 +86,7 @@ MD5sum::MD5sum(const size_t MaxN) :
 
 MD5sum::MD5sum(const MD5sum& A) : 
   Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),
-  Results(A.Results)
+  nThread(A.nThread),Results(A.Results)
   /*!
     Copy constructor
     \param A :: MD5sum to copy
@@ -105,6 +106,7 @@ MD5sum::operator=(const MD5sum& A)
       Origin=A.Origin;
       XYZ=A.XYZ;
       nPts=A.nPts;
+      nThread=A.nThread;
       Results=A.Results;
     }
   return *this;
@@ -156,13 +158,8 @@ MD5sum::populate(const Simulation* SimPtr)
 {
   ELog::RegMethod RegA("MD5sum","populate");
   const size_t RSize(Results.size());
-  MonteCarlo::Object* ObjPtr(0);
   Geometry::Vec3D aVec;
 
-  size_t percent(0);
-  size_t cnt(0);
-  size_t reportTime(nPts[0]*nPts[1]*nPts[2] / 100);
-  
   std::vector<double> sizeXYZ(3);
   std::vector<size_t> index(3);
   for(size_t i=0;i<3;i++)
@@ -175,32 +172,43 @@ MD5sum::populate(const Simulation* SimPtr)
   const size_t a=index[2];  
   const size_t b=index[1];
   const size_t c=index[0];
+
+  // scanlines along the finest axis
+  VoxelTrack VTrack(Origin,XYZ,nPts);
+  VTrack.setThreads(nThread);
+  VTrack.populate(*SimPtr,c);
+
+  // results added in a fixed order [independent of threads]
   for(size_t i=0;i<nPts[a];i++)
     {
       aVec[a]=XYZ[a]*((i+0.5)/nPts[a]);
       for(size_t j=0;j<nPts[b];j++)
         {
-	  aVec[1]=XYZ[b]*((j+0.5)/nPts[b]);
-	  for(size_t k=0;k<nPts[c];k++)
+	  aVec[b]=XYZ[b]*((j+0.5)/nPts[b]);
+	  const VoxelTrack::LineTYPE& LT=(a<b) ?
+	    VTrack.getLine(i,j) : VTrack.getLine(j,i);
+	  size_t k(0);
+	  for(const VoxelTrack::RunTYPE& RT : LT)
 	    {
-	      aVec[c]=XYZ[c]*((k+0.5)/nPts[c]);
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=SimPtr->findCell(Pt,ObjPtr);
-	      const size_t matN=static_cast<size_t>(ObjPtr->getMat());
+	      if (!RT.second)
+		{
+		  aVec[c]=XYZ[c]*((static_cast<double>(k)+0.5)/
+				   static_cast<double>(nPts[c]));
+		  throw ColErr::InContainerError<Geometry::Vec3D>
+		    (Origin+aVec,"Point not in model");
+		}
+	      const size_t matN=static_cast<size_t>(RT.second->getMat());
 	      if (matN>=RSize)
 		{
 		  ELog::EM<<"Error at point "<<aVec<<ELog::endCrit;
 		  throw ColErr::IndexError<size_t>(matN,RSize,"RSize");
 		}
-	      Results[matN].addUnit(aVec);
-	      if (cnt>reportTime)
+	      for(size_t n=0;n<RT.first;n++,k++)
 		{
-		  percent++;
-		  cnt=0;
-		  ELog::EM<<"On section "<<percent<<" ["
-			  <<reportTime*percent<<"]"<<ELog::endTrace;
+		  aVec[c]=XYZ[c]*((static_cast<double>(k)+0.5)/
+				   static_cast<double>(nPts[c]));
+		  Results[matN].addUnit(aVec);
 		}
-	      cnt++;
 	    }
 	}
     }
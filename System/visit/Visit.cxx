@@ -61,10 +61,11 @@
 #include "SimProcess.h"
 #include "SurInter.h"
 #include "Simulation.h"
+#include "VoxelTrack.h"
 #include "Visit.h"
 
 Visit::Visit() :
-  outType(VISITenum::cellID),nPts(0,0,0)
+  outType(VISITenum::cellID),nPts(0,0,0),nThread(0)
   /*!
     Constructor
   */
@@ -72,7 +73,7 @@ Visit::Visit() :
 
 Visit::Visit(const Visit& A) : 
   outType(A.outType),Origin(A.Origin),
-  XYZ(A.XYZ),nPts(A.nPts),mesh(A.mesh)
+  XYZ(A.XYZ),nPts(A.nPts),nThread(A.nThread),mesh(A.mesh)
   /*!
     Copy constructor
     \param A :: Visit to copy
@@ -93,6 +94,7 @@ Visit::operator=(const Visit& A)
       Origin=A.Origin;
       XYZ=A.XYZ;
       nPts=A.nPts;
+      nThread=A.nThread;
       mesh=A.mesh;
     }
   return *this;
@@ -180,53 +182,44 @@ Visit::populate(const Simulation* SimPtr,
    */
 {
   ELog::RegMethod RegA("Visit","populate");
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
 
+  if (!nPts[0] || !nPts[1] || !nPts[2]) return;
+  
   const ModelSupport::objectRegister& OR=
     ModelSupport::objectRegister::Instance();
   
   const bool aEmptyFlag=Active.empty();
 
-  size_t beCnt(0);
-  double stepXYZ[3];
-  for(size_t i=0;i<3;i++)
-    stepXYZ[i]=XYZ[i]/nPts[i];
+  // scanlines along z [inner index of mesh]
+  VoxelTrack VTrack(Origin,XYZ,
+		    Triple<size_t>(static_cast<size_t>(nPts[0]),
+				   static_cast<size_t>(nPts[1]),
+				   static_cast<size_t>(nPts[2])));
+  VTrack.setThreads(nThread);
+  VTrack.populate(*SimPtr,2);
 
   for(long int i=0;i<nPts[0];i++)
-    {
-      aVec[0]=stepXYZ[0]*(i+0.5);
-      for(long int j=0;j<nPts[1];j++)
-        {
-	  aVec[1]=stepXYZ[1]*(0.5+j);
-	  for(long int k=0;k<nPts[2];k++)
-	    {
-	      aVec[2]=stepXYZ[2]*(0.5+k);
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=SimPtr->findCell(Pt,ObjPtr);
-	      // Active Set Code:
-	      if (!aEmptyFlag)
-		{
-		  const std::string rangeStr=OR.inRange(ObjPtr->getName());
-		  if (Active.find(rangeStr)!=Active.end())
-		    {
-		      mesh[i][j][k]=getResult(ObjPtr);
-		    }
-		  else
-		    mesh[i][j][k]=0.0;
-		}
-	      // OLD Code:
-	      else
-		{
-		  mesh[i][j][k]=getResult(ObjPtr);
-		  if (outType==VISITenum::material && 
-		      fabs(mesh[i][j][k]-37)<1e-4)
-		    beCnt++;
-		}
-
-	    }
-	}
-    }
+    for(long int j=0;j<nPts[1];j++)
+      {
+	const VoxelTrack::LineTYPE& LT=
+	  VTrack.getLine(static_cast<size_t>(i),static_cast<size_t>(j));
+	long int k(0);
+	for(const VoxelTrack::RunTYPE& RT : LT)
+	  {
+	    double value(0.0);
+	    // Active Set Code:
+	    if (aEmptyFlag)
+	      value=getResult(RT.second);
+	    else if (RT.second)
+	      {
+		const std::string rangeStr=OR.inRange(RT.second->getName());
+		if (Active.find(rangeStr)!=Active.end())
+		  value=getResult(RT.second);
+	      }
+	    for(size_t n=0;n<RT.first;n++)
+	      mesh[i][j][k++]=value;
+	  }
+      }
   return;
 }
 
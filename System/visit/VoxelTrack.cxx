@@ -0,0 +1,302 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   visit/VoxelTrack.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <sstream>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "threadSupport.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Quaternion.h"
+#include "Triple.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "SimProcess.h"
+#include "SurInter.h"
+#include "ObjSurfMap.h"
+#include "neutron.h"
+#include "Simulation.h"
+#include "VoxelTrack.h"
+
+VoxelTrack::VoxelTrack(const Geometry::Vec3D& O,
+		       const Geometry::Vec3D& X,
+		       const Triple<size_t>& N) :
+  Origin(O),XYZ(X),
+  nPts((N[0]>0) ? N[0] : 1,(N[1]>0) ? N[1] : 1,(N[2]>0) ? N[2] : 1),
+  nThread(0),scanAxis(2),axisA(0),axisB(1)
+  /*!
+    Constructor
+    \param O :: Origin [corner of mesh]
+    \param X :: Extent of the mesh
+    \param N :: Number of voxels in each direction
+  */
+{}
+
+VoxelTrack::VoxelTrack(const VoxelTrack& A) :
+  Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),nThread(A.nThread),
+  scanAxis(A.scanAxis),axisA(A.axisA),axisB(A.axisB),
+  Lines(A.Lines)
+  /*!
+    Copy constructor
+    \param A :: VoxelTrack to copy
+  */
+{}
+
+VoxelTrack&
+VoxelTrack::operator=(const VoxelTrack& A)
+  /*!
+    Assignment operator
+    \param A :: VoxelTrack to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Origin=A.Origin;
+      XYZ=A.XYZ;
+      nPts=A.nPts;
+      nThread=A.nThread;
+      scanAxis=A.scanAxis;
+      axisA=A.axisA;
+      axisB=A.axisB;
+      Lines=A.Lines;
+    }
+  return *this;
+}
+
+void
+VoxelTrack::addRun(LineTYPE& Runs,const size_t N,
+		   MonteCarlo::Object* OPtr)
+  /*!
+    Add voxels to the end of a line [joined to the last run
+    if the object is the same]
+    \param Runs :: Line to add to
+    \param N :: Number of voxels
+    \param OPtr :: Object
+  */
+{
+  if (!Runs.empty() && Runs.back().second==OPtr)
+    Runs.back().first+=N;
+  else
+    Runs.push_back(RunTYPE(N,OPtr));
+  return;
+}
+
+Geometry::Vec3D
+VoxelTrack::voxelPoint(const size_t iA,const size_t iB,
+		       const size_t index) const
+  /*!
+    Centre of a voxel
+    \param iA :: Index on axisA
+    \param iB :: Index on axisB
+    \param index :: Index on the scan axis
+    \return voxel centre
+  */
+{
+  Geometry::Vec3D Pt(Origin);
+  Pt[axisA]+=XYZ[axisA]*((static_cast<double>(iA)+0.5)/
+			 static_cast<double>(nPts[axisA]));
+  Pt[axisB]+=XYZ[axisB]*((static_cast<double>(iB)+0.5)/
+			 static_cast<double>(nPts[axisB]));
+  Pt[scanAxis]+=XYZ[scanAxis]*((static_cast<double>(index)+0.5)/
+			       static_cast<double>(nPts[scanAxis]));
+  return Pt;
+}
+
+void
+VoxelTrack::trackLine(const Simulation& System,
+		      const ModelSupport::ObjSurfMap* OSMPtr,
+		      const size_t iA,const size_t iB,
+		      MonteCarlo::Object*& hintObj,
+		      LineTYPE& Runs) const
+  /*!
+    Track a single scanline. The voxel centres up to
+    each surface crossing are filled as one run. No output is
+    written so this can be used by many threads.
+    \param System :: Simulation
+    \param OSMPtr :: Object surface map
+    \param iA :: Index on axisA
+    \param iB :: Index on axisB
+    \param hintObj :: Object of the first voxel of the last line
+       [updated]
+    \param Runs :: Runs of the line
+  */
+{
+  const size_t N(nPts[scanAxis]);
+  const double stepLen=std::abs(XYZ[scanAxis])/static_cast<double>(N);
+  const double endT=stepLen*static_cast<double>(N);
+
+  Runs.clear();
+  if (stepLen<Geometry::zeroTol)
+    {
+      // all the voxel centres are the same point
+      hintObj=System.findCell(voxelPoint(iA,iB,0),hintObj);
+      addRun(Runs,N,hintObj);
+      return;
+    }
+
+  Geometry::Vec3D D;
+  D[scanAxis]=(XYZ[scanAxis]<0.0) ? -1.0 : 1.0;
+  MonteCarlo::neutron TNeut(1.0,voxelPoint(iA,iB,0),D);
+
+  MonteCarlo::Object* OPtr(0);
+  const Geometry::Surface* SPtr;
+  double aDist;
+  double T(0.0);           // distance from the first voxel centre
+  int SN(0);
+  size_t index(0);         // first voxel not yet filled
+  while(index<N)
+    {
+      if (!OPtr)
+	{
+	  // point search at the next voxel centre
+	  TNeut.Pos=voxelPoint(iA,iB,index);
+	  T=stepLen*static_cast<double>(index);
+	  SN=0;
+	  OPtr=System.findCell(TNeut.Pos,(index) ? 0 : hintObj);
+	  if (!index)
+	    hintObj=OPtr;
+	  addRun(Runs,1,OPtr);
+	  index++;
+	  if (!OPtr) continue;
+	}
+
+      // Note: Need OPPOSITE Sign on exiting surface
+      SN=OPtr->trackOutCell(TNeut,aDist,SPtr,std::abs(SN));
+      const double exitT=T+aDist;
+      size_t endIndex(N);
+      if (SN && exitT<endT)
+	endIndex=std::min(N,static_cast<size_t>(std::ceil(exitT/stepLen)));
+      if (endIndex>index)
+	{
+	  addRun(Runs,endIndex-index,OPtr);
+	  index=endIndex;
+	}
+
+      // no exit or too short a step : restart from a point search
+      if (!SN || aDist<Geometry::zeroTol)
+	OPtr=0;
+      else
+	{
+	  TNeut.moveForward(aDist);
+	  T=exitT;
+	  OPtr=OSMPtr->getNextObject(SN,TNeut.Pos,OPtr->getName());
+	}
+    }
+  return;
+}
+
+void
+VoxelTrack::runRange(const Simulation& System,
+		     const ModelSupport::ObjSurfMap* OSMPtr,
+		     const size_t startA,const size_t endA)
+  /*!
+    Track a slab of scanlines [thread unit]
+    \param System :: Simulation
+    \param OSMPtr :: Object surface map
+    \param startA :: First index on axisA
+    \param endA :: One past the last index on axisA
+  */
+{
+  const size_t NB(nPts[axisB]);
+  MonteCarlo::Object* hintObj(0);
+  for(size_t iA=startA;iA<endA;iA++)
+    for(size_t iB=0;iB<NB;iB++)
+      trackLine(System,OSMPtr,iA,iB,hintObj,Lines[iA*NB+iB]);
+  return;
+}
+
+void
+VoxelTrack::populate(const Simulation& System,const size_t SA)
+  /*!
+    Calculate the object at each voxel centre
+    \param System :: Simulation [cells populated / ObjSurfMap built]
+    \param SA :: Axis of the scanlines [0-2]
+  */
+{
+  ELog::RegMethod RegA("VoxelTrack","populate");
+
+  if (SA>2)
+    throw ColErr::IndexError<size_t>(SA,3,"scanAxis");
+
+  scanAxis=SA;
+  axisA=(SA) ? 0 : 1;
+  axisB=(SA==2) ? 1 : 2;
+
+  const size_t NA(nPts[axisA]);
+  Lines.clear();
+  Lines.resize(NA*nPts[axisB]);
+
+  const ModelSupport::ObjSurfMap* OSMPtr=System.getOSM();
+  System.getCellIndex();
+
+  const size_t nT=threadSupport::parallelFor
+    (nThread,NA,[&](const size_t,const size_t startA,const size_t endA)
+     {
+       runRange(System,OSMPtr,startA,endA);
+     });
+
+  ELog::EM<<"Voxel scanlines == "<<Lines.size()<<" ["
+	  <<nT<<" threads]"<<ELog::endDiag;
+  return;
+}
+
+const VoxelTrack::LineTYPE&
+VoxelTrack::getLine(const size_t iA,const size_t iB) const
+  /*!
+    Access a scanline
+    \param iA :: Index on the lower of the other two axes
+    \param iB :: Index on the higher of the other two axes
+    \return runs of the line
+  */
+{
+  if (iA>=nPts[axisA])
+    throw ColErr::IndexError<size_t>(iA,nPts[axisA],"iA");
+  if (iB>=nPts[axisB])
+    throw ColErr::IndexError<size_t>(iB,nPts[axisB],"iB");
+  return Lines[iA*nPts[axisB]+iB];
+}
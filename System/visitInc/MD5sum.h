@@ -46,6 +46,7 @@ class MD5sum
   Geometry::Vec3D Origin;     ///< Origin
   Geometry::Vec3D XYZ;        ///< XYZ extent
   Triple<size_t> nPts;        ///< Number x points
+  size_t nThread;             ///< Number of threads [0/1 : serial]
   
   /// Calc results:
   std::vector<MatMD5> Results;
@@ -60,6 +61,8 @@ class MD5sum
   void setBox(const Geometry::Vec3D&,
               const Geometry::Vec3D&);
   void setIndex(const size_t,const size_t,const size_t);
+  /// Set the number of threads
+  void setThreads(const size_t N) { nThread=N; }
 
   void populate(const Simulation*);
   void write(std::ostream&) const;
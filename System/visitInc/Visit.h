@@ -54,6 +54,7 @@ class Visit
   Geometry::Vec3D XYZ;        ///< XYZ extent
 
   Triple<long int> nPts;        ///< Number x points
+  size_t nThread;               ///< Number of threads [0/1 : serial]
   boost::multi_array<double,3> mesh;  ///< results mesh
 
   double getResult(const MonteCarlo::Object*) const;
@@ -69,6 +70,8 @@ class Visit
   void setBox(const Geometry::Vec3D&,
               const Geometry::Vec3D&);
   void setIndex(const size_t,const size_t,const size_t);
+  /// Set the number of threads
+  void setThreads(const size_t N) { nThread=N; }
 
   void populate(const Simulation*);
   void populate(const Simulation*,const std::set<std::string>&);
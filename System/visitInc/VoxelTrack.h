@@ -0,0 +1,95 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   visitInc/VoxelTrack.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef VoxelTrack_h
+#define VoxelTrack_h
+
+class Simulation;
+namespace MonteCarlo
+{
+  class Object;
+}
+namespace ModelSupport
+{
+  class ObjSurfMap;
+}
+
+/*!
+  \class VoxelTrack
+  \brief Cell of each voxel centre of a regular mesh
+  \date November 2017
+  \author S. Ansell
+  \version 1.0
+
+  The mesh is divided into scanlines along one axis.
+  Each scanline is tracked from cell to cell [trackOutCell /
+  ObjSurfMap] and the voxel centres between two surface
+  crossings are filled as a single run. A point search
+  [findCell] is only used at the start of a line and when
+  the tracking fails. The lines are divided into slabs
+  over nThread threads.
+*/
+
+class VoxelTrack
+{
+ public:
+
+  /// Number of voxels : Object [0 if outside the model]
+  typedef std::pair<size_t,MonteCarlo::Object*> RunTYPE;
+  /// Runs of a scanline [in order]
+  typedef std::vector<RunTYPE> LineTYPE;
+
+ private:
+
+  Geometry::Vec3D Origin;     ///< Origin
+  Geometry::Vec3D XYZ;        ///< XYZ extent
+  Triple<size_t> nPts;        ///< Number of points in each direction
+  size_t nThread;             ///< Number of threads [0/1 : serial]
+
+  size_t scanAxis;            ///< Axis of the scanlines
+  size_t axisA;               ///< First axis of the line index
+  size_t axisB;               ///< Second axis of the line index
+  std::vector<LineTYPE> Lines;  ///< Scanlines [A*nPts[B]+B]
+
+  static void addRun(LineTYPE&,const size_t,MonteCarlo::Object*);
+  Geometry::Vec3D voxelPoint(const size_t,const size_t,const size_t) const;
+  void trackLine(const Simulation&,const ModelSupport::ObjSurfMap*,
+		 const size_t,const size_t,MonteCarlo::Object*&,
+		 LineTYPE&) const;
+  void runRange(const Simulation&,const ModelSupport::ObjSurfMap*,
+		const size_t,const size_t);
+
+ public:
+
+  VoxelTrack(const Geometry::Vec3D&,const Geometry::Vec3D&,
+	     const Triple<size_t>&);
+  VoxelTrack(const VoxelTrack&);
+  VoxelTrack& operator=(const VoxelTrack&);
+  ~VoxelTrack() {}    ///< Destructor
+
+  /// Set the number of threads
+  void setThreads(const size_t N) { nThread=N; }
+
+  void populate(const Simulation&,const size_t);
+  const LineTYPE& getLine(const size_t,const size_t) const;
+};
+
+#endif
@@ -31,6 +31,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
 #include <boost/multi_array.hpp>
 
 #include "Exception.h"
@@ -43,6 +44,7 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "threadSupport.h"
 #include "MapSupport.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
@@ -61,6 +63,7 @@
 #include "Simulation.h"
 
 #include "LineTrack.h"
+#include "AttnTable.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
 #include "WWG.h"
@@ -72,15 +75,18 @@ namespace WeightSystem
 {
 
 
-MarkovProcess::MarkovProcess()
+MarkovProcess::MarkovProcess() :
+  nIteration(0),nThread(0),attnCut(-20.0),
+  WX(0),WY(0),WZ(0),FSize(0)
  /*! 
     Constructor 
   */
 {}
 
 MarkovProcess::MarkovProcess(const MarkovProcess& A) : 
-  nIteration(A.nIteration),WX(A.WX),WY(A.WY),WZ(A.WZ),
-  FSize(A.FSize),fluxField(A.fluxField)
+  nIteration(A.nIteration),nThread(A.nThread),attnCut(A.attnCut),
+  WX(A.WX),WY(A.WY),WZ(A.WZ),FSize(A.FSize),
+  rowIndex(A.rowIndex),colIndex(A.colIndex),fluxValue(A.fluxValue)
   /*!
     Copy constructor
     \param A :: MarkovProcess to copy
@@ -98,11 +104,15 @@ MarkovProcess::operator=(const MarkovProcess& A)
   if (this!=&A)
     {
       nIteration=A.nIteration;
+      nThread=A.nThread;
+      attnCut=A.attnCut;
       WX=A.WX;
       WY=A.WY;
       WZ=A.WZ;
       FSize=A.FSize;
-      fluxField=A.fluxField;
+      rowIndex=A.rowIndex;
+      colIndex=A.colIndex;
+      fluxValue=A.fluxValue;
     }
   return *this;
 }
@@ -129,9 +139,105 @@ MarkovProcess::initializeData(const WWG& wSet)
   WZ=static_cast<long int>(grid.getZSize());
 
   FSize=WX*WY*WZ;
-  
-  fluxField.resize(boost::extents[FSize][FSize]);
-  
+
+  rowIndex.clear();
+  colIndex.clear();
+  fluxValue.clear();
+  return;
+}
+
+void
+MarkovProcess::computeRows(const Simulation& System,
+			   const std::vector<Geometry::Vec3D>& midPts,
+			   const ModelSupport::AttnTable& ATable,
+			   const long int startRow,const long int rowStep,
+			   const double densityFactor,
+			   const double r2Length,
+			   const double r2Power,
+			   std::vector<ROWTYPE>& upperRows) const
+  /*!
+    Calculate the upper triangle of the rows startRow,
+    startRow+rowStep ... [thread unit]
+    \param System :: Simualation
+    \param midPts :: Mesh points
+    \param ATable :: Attenuation table [single energy]
+    \param startRow :: First row
+    \param rowStep :: Step between rows
+    \param densityFactor :: Scaling factor for density
+    \param r2Length :: scale factor for length
+    \param r2Power :: power of 1/r^2 factor
+    \param upperRows :: rows to fill [only those of this unit]
+   */
+{
+  std::vector<double> AT;
+  for(long int i=startRow;i<FSize;i+=rowStep)
+    {
+      const size_t uI(static_cast<size_t>(i));
+      ROWTYPE& Row=upperRows[uI];
+      ModelSupport::ObjectTrackPoint OTrack(midPts[uI]); 
+      for(long int j=i+1;j<FSize;j++)
+	{
+	  const size_t uJ(static_cast<size_t>(j));
+	  double DistT=midPts[uI].Distance(midPts[uJ])/r2Length;
+	  if (DistT<1.0) DistT=1.0;
+	  const double RFactor= -r2Power*log(DistT);
+	  // attenuation can only reduce the factor : no track needed
+	  if (densityFactor>=0.0 && RFactor<=attnCut)
+	    continue;
+	  // single track held [replaced on each pair]
+	  OTrack.addUnit(System,0,midPts[uJ]);
+	  OTrack.getAttnSum(0,ATable,AT);
+	  const double WFactor=RFactor-densityFactor*AT.front();
+	  if (WFactor>attnCut)
+	    Row.push_back(ROWTYPE::value_type(j,exp(WFactor)));
+	}
+    }
+  return;
+}
+
+void
+MarkovProcess::buildMatrix(const std::vector<ROWTYPE>& upperRows)
+  /*!
+    Build the full symmetric matrix [compressed rows] from
+    the upper triangle. The diagonal is unity. Each row
+    is in column order.
+    \param upperRows :: Upper triangle items of each row
+   */
+{
+  ELog::RegMethod RegA("MarkovProcess","buildMatrix");
+
+  const size_t NRow(static_cast<size_t>(FSize));
+  std::vector<size_t> rowCount(NRow,1);
+  for(size_t i=0;i<NRow;i++)
+    for(const ROWTYPE::value_type& RItem : upperRows[i])
+      {
+	rowCount[i]++;
+	rowCount[static_cast<size_t>(RItem.first)]++;
+      }
+
+  rowIndex.resize(NRow+1);
+  rowIndex[0]=0;
+  for(size_t i=0;i<NRow;i++)
+    rowIndex[i+1]=rowIndex[i]+rowCount[i];
+  colIndex.resize(rowIndex.back());
+  fluxValue.resize(rowIndex.back());
+
+  // rows are taken in order so the lower items of row i are
+  // placed before the diagonal/upper items of row i
+  std::vector<size_t> fillIndex(rowIndex.begin(),rowIndex.end()-1);
+  for(size_t i=0;i<NRow;i++)
+    {
+      colIndex[fillIndex[i]]=static_cast<long int>(i);
+      fluxValue[fillIndex[i]++]=1.0;
+      for(const ROWTYPE::value_type& RItem : upperRows[i])
+	{
+	  const size_t j(static_cast<size_t>(RItem.first));
+	  colIndex[fillIndex[i]]=RItem.first;
+	  fluxValue[fillIndex[i]++]=RItem.second;
+	  colIndex[fillIndex[j]]=static_cast<long int>(i);
+	  fluxValue[fillIndex[j]++]=RItem.second;
+	}
+    }
   return;
 }
 
@@ -152,37 +258,165 @@ MarkovProcess::computeMatrix(const Simulation& System,
 {
   ELog::RegMethod RegA("MarkovProcess","computeMatrix");
 
-  const Geometry::Mesh3D& grid=wSet.getGrid();
-  const std::vector<Geometry::Vec3D> midPts=wSet.getMidPoints();
+  const std::vector<Geometry::Vec3D>& midPts=wSet.getMidPoints();
 
   if (static_cast<long int>(midPts.size())!=FSize)
     throw ColErr::MisMatch<long int>
       (static_cast<long int>(midPts.size()),FSize,"MidPts.size != FSize");
 
-  for(long int i=0;i<FSize;i++)
-    fluxField[i][i]=1.0;
+  std::vector<ROWTYPE> upperRows(static_cast<size_t>(FSize));
+  const ModelSupport::AttnTable ATable;
+
+  // rows are handed out one at a time as the row length falls with i
+  if (nThread>1)
+    System.getCellIndex();
+  const size_t nT=threadSupport::parallelQueue
+    (nThread,static_cast<size_t>(FSize),[&](const size_t row)
+     {
+       computeRows(System,midPts,ATable,static_cast<long int>(row),FSize,
+		   densityFactor,r2Length,r2Power,upperRows);
+     });
+
+  buildMatrix(upperRows);
+  ELog::EM<<"Markov matrix["<<FSize<<"] non-zero == "<<fluxValue.size()
+	  <<" ["<<nT<<" threads]"<<ELog::endDiag;
+  return;
+}
+
+void
+MarkovProcess::multiply(const std::vector<double>& V,
+			std::vector<double>& Out) const
+  /*!
+    Calculate the matrix product Out = M.V
+    \param V :: Vector [FSize]
+    \param Out :: Result [FSize]
+   */
+{
+  const size_t NRow(rowIndex.size()-1);
+  Out.resize(NRow);
+  for(size_t i=0;i<NRow;i++)
+    {
+      double sum(0.0);
+      for(size_t index=rowIndex[i];index<rowIndex[i+1];index++)
+	sum+=fluxValue[index]*V[static_cast<size_t>(colIndex[index])];
+      Out[i]=sum;
+    }
+  return;
+}
 
-  for(long int i=0;i<FSize;i++)
+size_t
+MarkovProcess::powerIterate(std::vector<double>& V,
+			    const double tol) const
+  /*!
+    Apply the matrix nIteration times to V, scaling the
+    maximum to unity each step. Stops early when V no
+    longer changes. Converges to the principle eigenvector.
+    \param V :: Initial vector / result
+    \param tol :: Max change in a component to stop
+    \return number of iterations carried out
+   */
+{
+  ELog::RegMethod RegA("MarkovProcess","powerIterate");
+
+  if (rowIndex.size()!=static_cast<size_t>(FSize+1))
+    throw ColErr::EmptyValue<void>("Markov matrix not computed");
+  if (V.size()!=static_cast<size_t>(FSize))
+    throw ColErr::MisMatch<size_t>(V.size(),static_cast<size_t>(FSize),
+				   "V.size != FSize");
+
+  std::vector<double> Out;
+  for(size_t n=0;n<nIteration;n++)
     {
-      const size_t uI(static_cast<size_t>(i));
-      ModelSupport::ObjectTrackPoint OTrack(midPts[uI]); 
-      for(long int j=i+1;j<FSize;j++)
+      multiply(V,Out);
+      const double maxV= *std::max_element(Out.begin(),Out.end());
+      if (maxV<1e-38)
+	return n;
+      double diff(0.0);
+      for(size_t i=0;i<Out.size();i++)
 	{
-	  const size_t uJ(static_cast<size_t>(i));
-	  OTrack.addUnit(System,j,midPts[uJ]);
-	  double DistT=OTrack.getDistance(j)/r2Length;
-	  if (DistT<1.0) DistT=1.0;
-	  const double AT=OTrack.getAttnSum(j);  // this can take an
-	  const double WFactor= -densityFactor*AT-r2Power*log(DistT);
-	  if (WFactor>-20)
-	    fluxField[i][j]=fluxField[j][i]=exp(-WFactor);
-	  else
-	    fluxField[i][j]=fluxField[j][i]=0.0;
+	  Out[i]/=maxV;
+	  diff=std::max(diff,std::abs(Out[i]-V[i]));
 	}
+      V.swap(Out);
+      if (diff<tol)
+	return n+1;
     }
-  return;
+  return nIteration;
 }
 
+double
+MarkovProcess::getItem(const long int i,const long int j) const
+  /*!
+    Get a matrix item [zero if dropped]
+    \param i :: Row index
+    \param j :: Column index
+    \return M[i][j]
+   */
+{
+  ELog::RegMethod RegA("MarkovProcess","getItem");
+
+  if (rowIndex.size()!=static_cast<size_t>(FSize+1))
+    throw ColErr::EmptyValue<void>("Markov matrix not computed");
+  if (i<0 || i>=FSize)
+    throw ColErr::IndexError<long int>(i,FSize,"i");
+  if (j<0 || j>=FSize)
+    throw ColErr::IndexError<long int>(j,FSize,"j");
+
+  const size_t uI(static_cast<size_t>(i));
+  const std::vector<long int>::const_iterator aIter=
+    colIndex.begin()+static_cast<long int>(rowIndex[uI]);
+  const std::vector<long int>::const_iterator bIter=
+    colIndex.begin()+static_cast<long int>(rowIndex[uI+1]);
+  const std::vector<long int>::const_iterator mc=
+    std::lower_bound(aIter,bIter,j);
+  return (mc!=bIter && *mc==j) ?
+    fluxValue[static_cast<size_t>(mc-colIndex.begin())] : 0.0;
+}
+
+std::vector<double>
+MarkovProcess::importance(const double tol) const
+  /*!
+    Calculate the importance of each mesh point : the
+    principle eigenvector of the matrix [max unity] from
+    a uniform start.
+    \param tol :: Max change in a component to stop
+    \return importance [FSize]
+   */
+{
+  ELog::RegMethod RegA("MarkovProcess","importance");
+
+  std::vector<double> V(static_cast<size_t>(FSize),1.0);
+  const size_t nIter=powerIterate(V,tol);
+  ELog::EM<<"Importance iterations == "<<nIter<<ELog::endDiag;
+  return V;
+}
+
+void
+MarkovProcess::multiplyOut(WWG& wSet) const
+  /*!
+    Scale each energy bin of the WWG mesh by the
+    importance of the mesh point. The importance does
+    not depend on energy so it is found once.
+    \param wSet :: WWG to update
+   */
+{
+  ELog::RegMethod RegA("MarkovProcess","multiplyOut");
+
+  boost::multi_array<double,4>& WMesh=wSet.getMesh();
+  const size_t NE(WMesh.shape()[3]);
+  if (!NE) return;
   
+  const long int NPts=static_cast<long int>(WMesh.num_elements()/NE);
+  if (NPts!=FSize)
+    throw ColErr::MisMatch<long int>(NPts,FSize,"WMesh.size != FSize");
+
+  const std::vector<double> I=importance(1e-6);
+  double* WData=WMesh.data();
+  for(size_t i=0;i<I.size();i++)
+    for(size_t e=0;e<NE;e++)
+      WData[i*NE+e]*=I[i];
+  return;
+}
+
   
 } // namespace WeightSystem
@@ -41,6 +41,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
+#include "NumberMap.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -414,34 +415,32 @@ WCells::balanceScale(const std::vector<double>& W)
 }
 
 void
-WCells::renumberCell(const int oldIndex,const int newIndex)
+WCells::renumberCells(const MapSupport::NumberMap& CMap)
   /*!
-    Renumber all the cells. No checking or error report 
-    on missing cell
-    \param oldIndex :: oldIndex 
-    \param newIndex :: newValue
+    Renumber all the cells in one pass. No checking or 
+    error report on missing cell
+    \param CMap :: Map of old : new cell numbers
   */
 {
-  ELog::RegMethod RegA("WCells","renumberCell");
-  if (newIndex!=oldIndex)
+  ELog::RegMethod RegA("WCells","renumberCells");
+  if (CMap.empty()) return;
+
+  ItemTYPE newWVal;
+  for(ItemTYPE::value_type& WV : WVal)
     {
-      ItemTYPE::iterator mc=WVal.find(oldIndex);
-      if (mc!=WVal.end())
+      const int newIndex=CMap.convert(WV.first);
+      WV.second.setCellNumber(newIndex);
+      ItemTYPE::const_iterator newmc=newWVal.find(newIndex);
+      if (newmc!=newWVal.end())
 	{
-	  ItemTYPE::const_iterator newmc=WVal.find(newIndex);
-	  mc->second.setCellNumber(newIndex);
-	  if (newmc!=WVal.end())
-	    {
-	      ELog::EM<<"New point found "<<oldIndex<<" "<<newIndex<<
-		ELog::endCrit;
-	      ELog::EM<<"Mc == "<<newmc->first<<" "
-		      <<mc->second.getCellNumber()<<ELog::endErr;
-	    }
-	  WVal.insert(ItemTYPE::value_type(newIndex,mc->second));
-	  WVal.erase(mc);
+	  ELog::EM<<"New point found "<<WV.first<<" "<<newIndex<<
+	    ELog::endCrit;
+	  ELog::EM<<"Mc == "<<newmc->first<<" "
+		  <<WV.second.getCellNumber()<<ELog::endErr;
 	}
-      mc=WVal.find(newIndex);
+      newWVal.insert(ItemTYPE::value_type(newIndex,WV.second));
     }
+  WVal.swap(newWVal);
   return;
 }
 
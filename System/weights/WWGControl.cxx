@@ -140,7 +140,13 @@ WeightControl::wwgMarkov(const Simulation& System,
       if (nMarkov)
 	{
 	  MarkovProcess MCalc;
+	  MCalc.setIterations(nMarkov);
+	  // Markov matrix threads : -nThread [was -wwgThread]
+	  if (IParam.flag("nThread"))
+	    MCalc.setThreads(IParam.getValue<size_t>("nThread"));
 	  MCalc.initializeData(wwg);
+	  MCalc.computeMatrix(System,wwg,density,r2Length,r2Power);
+	  MCalc.multiplyOut(wwg);
 	}
     }
 
@@ -169,6 +175,9 @@ WeightControl::wwgCreate(const Simulation& System,
     {
       // local mesh - zeroed
       WWGWeight wSet(EBin.size(),wwg.getGrid());   
+      // ray fan threads [-nThread : the old -wwgThread]
+      if (IParam.flag("nThread"))
+	wSet.setThreads(IParam.getValue<size_t>("nThread"));
       procParam(IParam,"wwgCalc",index,0);
 
       if (activePtType=="Plane")   //
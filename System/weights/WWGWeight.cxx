@@ -30,6 +30,7 @@
 #include <map> 
 #include <string>
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <boost/multi_array.hpp>
 
@@ -68,10 +69,8 @@
 #include "WCells.h"
 #include "CellWeight.h"
 #include "Simulation.h"
-#include "LineTrack.h"
-#include "ObjectTrackAct.h"
-#include "ObjectTrackPoint.h"
-#include "ObjectTrackPlane.h"
+#include "AttnTable.h"
+#include "TrackFan.h"
 #include "weightManager.h"
 #include "WWG.h"
 #include "WWGItem.h"
@@ -85,7 +84,7 @@ WWGWeight::WWGWeight(const size_t EB,
   WX(static_cast<long int>(Grid.getXSize())),
   WY(static_cast<long int>(Grid.getYSize())),
   WZ(static_cast<long int>(Grid.getZSize())),
-  WE(static_cast<long int>(EB)),
+  WE(static_cast<long int>(EB)),nThread(0),
   WGrid(boost::extents[WX][WY][WZ][WE])
   /*! 
     Constructor 
@@ -98,7 +97,7 @@ WWGWeight::WWGWeight(const size_t EB,
 
 WWGWeight::WWGWeight(const WWGWeight& A)  :
   WX(A.WX),WY(A.WY),WZ(A.WZ),WE(A.WE),
-  WGrid(A.WGrid)
+  nThread(A.nThread),WGrid(A.WGrid)
   /*! 
     Copy Constructor 
     \param A :: WWGWeight to copy
@@ -115,6 +114,7 @@ WWGWeight::operator=(const WWGWeight& A)
 {
   if (this!=&A)
     {
+      nThread=A.nThread;
       WGrid=A.WGrid;
     }
   return *this;
@@ -253,6 +253,32 @@ WWGWeight::makeAdjoint(const double MValue)
   return;
 }
   
+void
+WWGWeight::setTrackPoint(const size_t index,const double dist,
+			 const double* AT,const double densityFactor,
+			 const double r2Length,const double r2Power)
+  /*!
+    Set the log weight of a mesh point from its track
+    \param index :: Mesh index
+    \param dist :: Track length
+    \param AT :: Attenuation sum [per energy]
+    \param densityFactor :: Scaling factor for density
+    \param r2Length :: scale factor for length
+    \param r2Power :: power of 1/r^2 factor
+  */
+{
+  double DistT=dist/r2Length;
+  if (DistT<1.0) DistT=1.0;
+  const double RFactor=r2Power*log(DistT);
+  const long int cIndex(static_cast<long int>(index));
+  for(long int e=0;e<WE;e++)
+    {
+      // exp(-Sigma)/r^2  in log form
+      setPoint(cIndex,e,-densityFactor*AT[e]-RFactor);
+    }
+  return;
+}
+
 void
 WWGWeight::wTrack(const Simulation& System,
 		  const Geometry::Vec3D& initPt,
@@ -262,7 +288,7 @@ WWGWeight::wTrack(const Simulation& System,
 		  const double r2Length,
 		  const double r2Power)
   /*!
-    Calculate a specific track from sourcePoint to position
+    Calculate the tracks from sourcePoint to each mesh position
     \param System :: Simulation to use    
     \param initPt :: Point for outgoing track
     \param EBin :: Energy points
@@ -274,32 +300,16 @@ WWGWeight::wTrack(const Simulation& System,
 {
   ELog::RegMethod RegA("WWGWeight","wTrack(Vec3D)");
 
-  ModelSupport::ObjectTrackPoint OTrack(initPt);
+  const ModelSupport::AttnTable ATable(EBin);
+  ModelSupport::TrackFan TFan(System,ATable);
+  TFan.setThreads(nThread);
 
-  long int cN(1);
   ELog::EM<<"Processing  "<<MidPt.size()<<" for WWG"<<ELog::endDiag;
-  double minV(1.0);
-  for(const Geometry::Vec3D& Pt : MidPt)
-    {
-      ModelSupport::ObjectTrackPoint OTrack(initPt);
-      OTrack.addUnit(System,cN,Pt);
-      double DistT=OTrack.getDistance(cN)/r2Length;
-      if (DistT<1.0) DistT=1.0;
-      const double AT=OTrack.getAttnSum(cN);    // this can take an
-                                                // energy
-      for(long int index=0;index<WE;index++)
-        {
-	  //	  ELog::EM<<"Pt["<<Pt<<"] == "<<densityFactor*AT
-	  //		  <<" "<<r2Power*log(DistT)<<ELog::endDiag;
-	  // exp(-Sigma)/r^2  in log form
-          setPoint(cN-1,index,-densityFactor*AT-r2Power*log(DistT));
-        }
-
-      if (!(cN % 10000))
-	ELog::EM<<"Item "<<cN<<" "<<MidPt.size()<<" "<<densityFactor<<" "
-		<<r2Length<<ELog::endDiag;
-      cN++;
-    }
+  TFan.trace(initPt,MidPt,
+	     [&](const size_t index,const double D,const double* AT)
+	     {
+	       setTrackPoint(index,D,AT,densityFactor,r2Length,r2Power);
+	     });
   return;
 }
 
@@ -313,7 +323,7 @@ WWGWeight::wTrack(const Simulation& System,
 		  const double r2Length,
 		  const double r2Power)
   /*!
-    Calculate a specific trac from sourcePoint to  postion
+    Calculate the tracks from each mesh position to the plane
     \param System :: Simulation to use    
     \param initPlane :: Plane for outgoing track
     \param EBin :: Energy points
@@ -325,28 +335,15 @@ WWGWeight::wTrack(const Simulation& System,
 {
   ELog::RegMethod RegA("WWGWeight","wTrack(Plane)");
 
-  ModelSupport::ObjectTrackPlane OTrack(initPlane);
-  long int cN(1);
-  double minV(1.0);
-  for(const Geometry::Vec3D& Pt : MidPt)
-    {
-      OTrack.addUnit(System,cN,Pt);
-      double DistT=OTrack.getDistance(cN)/r2Length;
-      if (DistT<1.0) DistT=1.0;
-      const double AT=OTrack.getAttnSum(cN);    // this can take an energy
-      double V= -densityFactor*AT-r2Power*log(DistT);
-      if (V<minV)
-	{
-	  minV=V;
-	  ELog::EM<<"Min == "<<V<<ELog::endDiag;
-	}
-      for(long int index=0;index<WE;index++)
-        {
-          // exp(-Sigma)/r^2  in log form
-          setPoint(cN-1,index,-densityFactor*AT-r2Power*log(DistT));
-        }
-      cN++;
-    }
+  const ModelSupport::AttnTable ATable(EBin);
+  ModelSupport::TrackFan TFan(System,ATable);
+  TFan.setThreads(nThread);
+
+  TFan.trace(initPlane,MidPt,
+	     [&](const size_t index,const double D,const double* AT)
+	     {
+	       setTrackPoint(index,D,AT,densityFactor,r2Length,r2Power);
+	     });
   return;
 }
 
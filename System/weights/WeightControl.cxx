@@ -73,6 +73,7 @@
 #include "ImportControl.h"
 
 #include "LineTrack.h"
+#include "AttnTable.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
 #include "ObjectTrackPlane.h"
@@ -497,14 +498,16 @@ WeightControl::cTrack(const Simulation& System,
   // SOURCE Point
 
   ModelSupport::ObjectTrackPoint OTrack(initPt);
-  std::vector<double> WVec;
+  const ModelSupport::AttnTable ATable;
+  std::vector<double> AT;
 
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
     {
       const long int unit(i>=index.size() ? cN++ : index[i]);
       OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
+      OTrack.getAttnSum(unit,ATable,AT);
+      CTrack.addTracks(unit,AT.front());
     } 
   return;
 }
@@ -528,14 +531,16 @@ WeightControl::cTrack(const Simulation& System,
   // SOURCE Point
 
   ModelSupport::ObjectTrackPlane OTrack(initPlane);
-  std::vector<double> WVec;
+  const ModelSupport::AttnTable ATable;
+  std::vector<double> AT;
 
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
     {
       const long int unit(i>=index.size() ? cN++ : index[i]);
       OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
+      OTrack.getAttnSum(unit,ATable,AT);
+      CTrack.addTracks(unit,AT.front());
     } 
   return;
 }
@@ -925,10 +930,11 @@ WeightControl::processWeights(Simulation& System,
   if (IParam.flag("weight"))
     setWeights(System);
       
-  // requirements for vertex:
+  // requirements for vertex [threads : -nThread, was -vertexThread]:
   if (IParam.flag("weightObject") ||
       IParam.flag("tallyWeight") )
-    System.calcAllVertex();
+    System.calcAllVertex((IParam.flag("nThread")) ?
+			 IParam.getValue<size_t>("nThread") : 0);
   
   if (IParam.flag("weightSource"))
     procSourcePoint(IParam);
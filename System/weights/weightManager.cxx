@@ -164,19 +164,15 @@ weightManager::maskCell(const int zCell)
   
 
 void
-weightManager::renumberCell(const int OCell,const int NCell)  
+weightManager::renumberCells(const MapSupport::NumberMap& CMap)  
   /*!
     Renumber cells [if required]
-    \param OCell :: Original Cell
-    \param NCell :: New Cell number
+    \param CMap :: Map of old : new cell numbers
   */
 {
-  ELog::RegMethod RegA("weightManager","renumberCell");
-  for_each(WMap.begin(),WMap.end(),
-	   std::bind(&WForm::renumberCell,
-		     std::bind(&CtrlTYPE::value_type::second,
-				 std::placeholders::_1),
-		       OCell,NCell));
+  ELog::RegMethod RegA("weightManager","renumberCells");
+  for(CtrlTYPE::value_type& WF : WMap)
+    WF.second->renumberCells(CMap);
   return;
 }
 
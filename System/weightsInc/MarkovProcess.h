@@ -30,6 +30,11 @@ namespace Geometry
   class Plane;
 }
 
+namespace ModelSupport
+{
+  class AttnTable;
+}
+
 /*!
   \namespace WeightSystem
   \brief Adds a layer of shutters to the Target/Reflect/Moderatr
@@ -50,22 +55,41 @@ namespace WeightSystem
     \author S. Ansell
     \date October 2015
     \brief Input to Weights controller
+
+    Symmetric transfer matrix between the WWG mesh points
+    [exp(-rho*Attn)/r^n]. Pairs below the cut are dropped
+    and the rest is held in compressed row form. The WWG
+    mesh is scaled by the importance [principle eigenvector].
   */
   
 class MarkovProcess
 {
  private:
 
+  /// Upper triangle items of a row [column : value]
+  typedef std::vector<std::pair<long int,double>> ROWTYPE;
   
   size_t nIteration;       ///< number of iterations
+  size_t nThread;          ///< Number of threads [0/1 : serial]
+  double attnCut;          ///< Log factor below which a pair is dropped
 
   long int WX;             ///< WX size of WWG
   long int WY;             ///< WY size of WWG 
   long int WZ;             ///< WZ size of WWG
 
   long int FSize;          ///< size of fluxField [square]
-  /// Array of interaction [initialCell][finalCell]
-  boost::multi_array<double,2> fluxField;
+
+  /// Start of each row in the sparse matrix [FSize+1]
+  std::vector<size_t> rowIndex;
+  std::vector<long int> colIndex;     ///< Column of each item
+  std::vector<double> fluxValue;      ///< Value of each item
+
+  void computeRows(const Simulation&,const std::vector<Geometry::Vec3D>&,
+		   const ModelSupport::AttnTable&,
+		   const long int,const long int,const double,
+		   const double,const double,std::vector<ROWTYPE>&) const;
+  void buildMatrix(const std::vector<ROWTYPE>&);
+  void multiply(const std::vector<double>&,std::vector<double>&) const;
   
  public:
 
@@ -74,10 +98,22 @@ class MarkovProcess
   MarkovProcess& operator=(const MarkovProcess&);
   ~MarkovProcess();
 
+  /// Set the number of power iterations
+  void setIterations(const size_t N) { nIteration=N; }
+  /// Set the number of threads
+  void setThreads(const size_t N) { nThread=N; }
+  /// Set the cut value [log form]
+  void setCut(const double C) { attnCut=C; }
+  /// Number of non-zero items in the matrix
+  size_t nonZero() const { return fluxValue.size(); }
+  double getItem(const long int,const long int) const;
 
   void initializeData(const WWG&);
   void computeMatrix(const Simulation&,const WWG&,const double,
 		     const double,const double);
+  size_t powerIterate(std::vector<double>&,const double) const;
+  std::vector<double> importance(const double) const;
+  void multiplyOut(WWG&) const;
     
 };
 
@@ -59,7 +59,7 @@ class WCells : public WForm
 
   bool isMasked(const int) const;
 
-  void renumberCell(const int,const int);  
+  void renumberCells(const MapSupport::NumberMap&);  
   void populateCells(const std::map<int,MonteCarlo::Qhull*>&);
   void maskCell(const int); 
   void maskCellComp(const int,const size_t); 
@@ -27,6 +27,11 @@ namespace MonteCarlo
   class Qhull;
 }
 
+namespace MapSupport
+{
+  class NumberMap;
+}
+
 /*!
   \namespace WeightSystem
   \brief Weigh modifications
@@ -93,7 +98,7 @@ class WForm
   virtual void scaleWeights(const int,const double&) =0;
   virtual void maskCell(const int) =0;
   virtual void populateCells(const std::map<int,MonteCarlo::Qhull*>&) =0;
-  virtual void renumberCell(const int,const int) =0;
+  virtual void renumberCells(const MapSupport::NumberMap&) =0;
   virtual void balanceScale(const std::vector<double>&) =0;
   virtual void write(std::ostream&) const =0;
 
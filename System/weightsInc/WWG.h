@@ -77,6 +77,8 @@ class WWG
   /// get grid mid point
   const std::vector<Geometry::Vec3D>& getMidPoints() const
     {return GridMidPt; }
+  /// access to weight mesh [x,y,z,energy]
+  boost::multi_array<double,4>& getMesh() { return WMesh; }
   /// Access to EBin
   const std::vector<double>& getEBin() const { return EBin; }
   void setEnergyBin(const std::vector<double>&,
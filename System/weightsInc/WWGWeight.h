@@ -41,9 +41,13 @@ class WWGWeight
   const long int WY;             ///< Weight YIndex size
   const long int WZ;             ///< Weight ZIndex size
   const long int WE;             ///< Energy size
+  size_t nThread;                ///< Number of track threads [0/1 serial]
   
   /// local storage for data [i,j,j,Energy]
   boost::multi_array<double,4> WGrid; 
+
+  void setTrackPoint(const size_t,const double,const double*,
+		     const double,const double,const double);
   
  public:
 
@@ -56,6 +60,8 @@ class WWGWeight
   long int getYSize() const { return WY; }
   long int getZSize() const { return WZ; }
   long int getESize() const { return WE; }
+  /// Set the number of track threads
+  void setThreads(const size_t N) { nThread=N; }
 
   void zeroWGrid();
   double calcMaxAttn(const long int) const;
@@ -24,6 +24,11 @@
 
 class Simulation;
 
+namespace MapSupport
+{
+  class NumberMap;
+}
+
 namespace WeightSystem
 {
   class WForm;
@@ -63,7 +68,7 @@ class weightManager
   const WWG& getWWG() const;
   template<typename T> void addParticle(const char);
   
-  void renumberCell(const int,const int);  
+  void renumberCells(const MapSupport::NumberMap&);  
   void maskCell(const int);
   bool isMasked(const int) const;
   void write(std::ostream&) const;
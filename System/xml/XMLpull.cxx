@@ -0,0 +1,526 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   xml/XMLpull.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "XMLpull.h"
+
+namespace XML
+{
+
+namespace
+{
+  /// XML white space
+  inline bool isSpace(const char c)
+    { return (c==' ' || c=='\t' || c=='\n' || c=='\r'); }
+  /// Character that stops a key/attribute name
+  inline bool isNameEnd(const char c)
+    { return (isSpace(c) || c=='=' || c=='>' || c=='/'); }
+}
+
+bool
+XMLview::operator==(const std::string& A) const
+  /*!
+    Comparison with a string [no copy]
+    \param A :: String to compare
+    \return true if identical
+  */
+{
+  return (A.size()==len && !A.compare(0,len,ptr,len));
+}
+
+XMLpull::XMLpull() :
+  fd(-1),mapBase(0),mapSize(0),cPtr(0),endPtr(0),
+  event(endFile),popFlag(0)
+  /*!
+    Constructor
+  */
+{}
+
+XMLpull::~XMLpull()
+  /*!
+    Destructor
+  */
+{
+  closeFile();
+}
+
+void
+XMLpull::closeFile()
+  /*!
+    Release the mapping / buffer
+  */
+{
+  if (mapBase)
+    munmap(mapBase,mapSize);
+  if (fd>=0)
+    close(fd);
+  fd=-1;
+  mapBase=0;
+  mapSize=0;
+  fallBuffer.clear();
+  cPtr=0;
+  endPtr=0;
+  event=endFile;
+  Attr.clear();
+  openStack.clear();
+  popFlag=0;
+  return;
+}
+
+int
+XMLpull::openFile(const std::string& Fname)
+  /*!
+    Map a file. If the map fails the file is read
+    into a buffer instead.
+    \param Fname :: file
+    \retval 0 :: success
+    \retval -1 :: fail [or empty file]
+  */
+{
+  ELog::RegMethod RegA("XMLpull","openFile");
+
+  closeFile();
+  if (Fname.empty()) return -1;
+
+  fd=open(Fname.c_str(),O_RDONLY);
+  struct stat FStat;
+  if (fd>=0 && !fstat(fd,&FStat) && FStat.st_size>0)
+    {
+      mapSize=static_cast<size_t>(FStat.st_size);
+      mapBase=mmap(0,mapSize,PROT_READ,MAP_PRIVATE,fd,0);
+      if (mapBase==MAP_FAILED)
+	{
+	  mapBase=0;
+	  mapSize=0;
+	}
+      else
+	{
+	  cPtr=static_cast<const char*>(mapBase);
+	  endPtr=cPtr+mapSize;
+	  return 0;
+	}
+    }
+  if (fd>=0)
+    {
+      close(fd);
+      fd=-1;
+    }
+  // Non-mappable [pipe etc]:
+  std::ifstream IX(Fname.c_str(),std::ios::binary);
+  if (!IX.good())
+    {
+      ELog::EM<<"Failed to open file :"<<Fname<<":"<<ELog::endWarn;
+      return -1;
+    }
+  std::ostringstream cx;
+  cx<<IX.rdbuf();
+  fallBuffer=cx.str();
+  cPtr=fallBuffer.data();
+  endPtr=cPtr+fallBuffer.size();
+  return (fallBuffer.empty()) ? -1 : 0;
+}
+
+void
+XMLpull::parseError(const std::string& Msg) const
+  /*!
+    Throw a parse error with the local text
+    \param Msg :: Error message
+  */
+{
+  const char* ePtr=cPtr;
+  while(ePtr!=endPtr && *ePtr!='\n' && ePtr-cPtr<60)
+    ePtr++;
+  throw ColErr::InvalidLine(Msg,std::string(cPtr,ePtr),0);
+}
+
+bool
+XMLpull::skipTo(const char* Tag)
+  /*!
+    Move past the next occurance of Tag
+    \param Tag :: Closing string
+    \return true if found
+  */
+{
+  const size_t TLen=std::strlen(Tag);
+  while(static_cast<size_t>(endPtr-cPtr)>=TLen)
+    {
+      if (*cPtr==*Tag && !std::strncmp(cPtr,Tag,TLen))
+	{
+	  cPtr+=TLen;
+	  return 1;
+	}
+      cPtr++;
+    }
+  cPtr=endPtr;
+  return 0;
+}
+
+void
+XMLpull::processTag()
+  /*!
+    Process the tag after the '<' of a start/empty
+    element. Sets key and attributes
+  */
+{
+  const char* sPtr=cPtr;
+  while(cPtr!=endPtr && !isNameEnd(*cPtr))
+    cPtr++;
+  key=XMLview(sPtr,static_cast<size_t>(cPtr-sPtr));
+  if (key.empty())
+    parseError("Empty tag");
+
+  while(cPtr!=endPtr)
+    {
+      while(cPtr!=endPtr && isSpace(*cPtr))
+	cPtr++;
+      if (cPtr==endPtr) break;
+      if (*cPtr=='>')
+	{
+	  cPtr++;
+	  event=startElm;
+	  return;
+	}
+      if (*cPtr=='/')
+	{
+	  if (cPtr+1==endPtr || cPtr[1]!='>')
+	    parseError("Bad empty tag");
+	  cPtr+=2;
+	  event=emptyElm;
+	  return;
+	}
+      // attribute
+      sPtr=cPtr;
+      while(cPtr!=endPtr && !isNameEnd(*cPtr))
+	cPtr++;
+      const XMLview AKey(sPtr,static_cast<size_t>(cPtr-sPtr));
+      while(cPtr!=endPtr && isSpace(*cPtr))
+	cPtr++;
+      if (AKey.empty() || cPtr==endPtr || *cPtr!='=')
+	parseError("Attribute without value");
+      cPtr++;
+      while(cPtr!=endPtr && isSpace(*cPtr))
+	cPtr++;
+      if (cPtr==endPtr || (*cPtr!='"' && *cPtr!='\''))
+	parseError("Attribute value not quoted");
+      const char quote= *cPtr++;
+      sPtr=cPtr;
+      while(cPtr!=endPtr && *cPtr!=quote)
+	cPtr++;
+      if (cPtr==endPtr) break;
+      Attr.push_back(std::pair<XMLview,XMLview>
+		     (AKey,XMLview(sPtr,static_cast<size_t>(cPtr-sPtr))));
+      cPtr++;
+    }
+  parseError("Unterminated tag "+key.str());
+}
+
+XMLpull::EventType
+XMLpull::next()
+  /*!
+    Move to the next event. Text that is only white space
+    is not reported.
+    \return event type [endFile at end]
+  */
+{
+  if (popFlag)
+    {
+      openStack.pop_back();
+      popFlag=0;
+    }
+  Attr.clear();
+  key=XMLview();
+  text=XMLview();
+
+  while(cPtr!=endPtr)
+    {
+      if (*cPtr!='<')
+	{
+	  const char* sPtr=cPtr;
+	  const char* tPtr=static_cast<const char*>
+	    (std::memchr(cPtr,'<',static_cast<size_t>(endPtr-cPtr)));
+	  cPtr=(tPtr) ? tPtr : endPtr;
+	  for(const char* aPtr=sPtr;aPtr!=cPtr;aPtr++)
+	    if (!isSpace(*aPtr))
+	      {
+		text=XMLview(sPtr,static_cast<size_t>(cPtr-sPtr));
+		event=textElm;
+		return event;
+	      }
+	  continue;
+	}
+      // '<' found
+      cPtr++;
+      if (cPtr==endPtr)
+	parseError("Unterminated <");
+      if (*cPtr=='?')
+	{
+	  if (!skipTo("?>"))
+	    parseError("Unterminated <?");
+	}
+      else if (*cPtr=='!')
+	{
+	  if (endPtr-cPtr>=3 && !std::strncmp(cPtr,"!--",3))
+	    {
+	      if (!skipTo("-->"))
+		parseError("Unterminated comment");
+	    }
+	  else if (endPtr-cPtr>=8 && !std::strncmp(cPtr,"![CDATA[",8))
+	    {
+	      cPtr+=8;
+	      const char* sPtr=cPtr;
+	      if (!skipTo("]]>"))
+		parseError("Unterminated CDATA");
+	      text=XMLview(sPtr,static_cast<size_t>(cPtr-sPtr)-3);
+	      event=textElm;
+	      return event;
+	    }
+	  else if (!skipTo(">"))
+	    parseError("Unterminated <!");
+	}
+      else if (*cPtr=='/')
+	{
+	  cPtr++;
+	  const char* sPtr=cPtr;
+	  while(cPtr!=endPtr && !isNameEnd(*cPtr))
+	    cPtr++;
+	  key=XMLview(sPtr,static_cast<size_t>(cPtr-sPtr));
+	  while(cPtr!=endPtr && isSpace(*cPtr))
+	    cPtr++;
+	  if (cPtr==endPtr || *cPtr!='>')
+	    parseError("Bad close tag");
+	  cPtr++;
+	  if (openStack.empty() ||
+	      openStack.back().len!=key.len ||
+	      std::strncmp(openStack.back().ptr,key.ptr,key.len))
+	    parseError("Close tag does not match "+key.str());
+	  openStack.pop_back();
+	  event=endElm;
+	  return event;
+	}
+      else
+	{
+	  processTag();
+	  openStack.push_back(key);
+	  popFlag=(event==emptyElm);
+	  return event;
+	}
+    }
+
+  if (!openStack.empty())
+    throw ColErr::InvalidLine("Unclosed element",openStack.back().str(),0);
+  event=endFile;
+  return event;
+}
+
+std::string
+XMLpull::getText() const
+  /*!
+    Get the current text with white space runs as
+    a single space and no leading/trailing space
+    \return text
+  */
+{
+  std::string Out;
+  Out.reserve(text.len);
+  bool spc(0);
+  for(size_t i=0;i<text.len;i++)
+    {
+      if (isSpace(text.ptr[i]))
+	spc=1;
+      else
+	{
+	  if (spc && !Out.empty())
+	    Out+=' ';
+	  spc=0;
+	  Out+=text.ptr[i];
+	}
+    }
+  return Out;
+}
+
+bool
+XMLpull::matchPath(const std::string& Path) const
+  /*!
+    Determine if the open elements end in Path
+    \param Path :: Key or keyA/keyB/keyC to match
+    \return true if the current element matches
+  */
+{
+  if (openStack.empty() || Path.empty()) return 0;
+
+  std::vector<XMLview>::const_reverse_iterator rc=openStack.rbegin();
+  std::string::size_type ePos=Path.size();
+  while(rc!=openStack.rend())
+    {
+      const std::string::size_type pos=(ePos) ?
+	Path.rfind('/',ePos-1) : std::string::npos;
+      const std::string::size_type sPos=
+	(pos==std::string::npos) ? 0 : pos+1;
+      if (rc->len!=ePos-sPos ||
+	  Path.compare(sPos,rc->len,rc->ptr,rc->len))
+	return 0;
+      if (pos==std::string::npos)
+	return 1;
+      ePos=pos;
+      ++rc;
+    }
+  return 0;
+}
+
+bool
+XMLpull::hasAttribute(const std::string& Name) const
+  /*!
+    Determine if the current element has an attribute
+    \param Name :: Attribute name
+    \return true if present
+  */
+{
+  for(const std::pair<XMLview,XMLview>& AV : Attr)
+    if (AV.first==Name)
+      return 1;
+  return 0;
+}
+
+std::string
+XMLpull::getAttribute(const std::string& Name) const
+  /*!
+    Get an attribute of the current element
+    \param Name :: Attribute name
+    \throw InContainerError if not present
+    \return value
+  */
+{
+  for(const std::pair<XMLview,XMLview>& AV : Attr)
+    if (AV.first==Name)
+      return AV.second.str();
+  throw ColErr::InContainerError<std::string>(Name,"XMLpull::getAttribute");
+}
+
+std::string
+XMLpull::getAttribute(const std::string& Name,
+		      const std::string& DefValue) const
+  /*!
+    Get an attribute of the current element
+    \param Name :: Attribute name
+    \param DefValue :: Value if not present
+    \return value
+  */
+{
+  for(const std::pair<XMLview,XMLview>& AV : Attr)
+    if (AV.first==Name)
+      return AV.second.str();
+  return DefValue;
+}
+
+void
+XMLpull::skipElement()
+  /*!
+    Skip past the end of the current start element
+  */
+{
+  if (event!=startElm) return;
+  const size_t D=openStack.size();
+  while(openStack.size()>=D && next()!=endFile) ;
+  return;
+}
+
+std::string
+XMLpull::getValue(const std::string& ChildName)
+  /*!
+    Read the value of the current start/empty element and
+    move past its end. If the element holds other elements
+    the text of the first ChildName element is used,
+    otherwise the element text [as XMLobject::getNamedItem].
+    \param ChildName :: Child key holding the value
+    \throw InContainerError if no value 
+    \return text [white space reduced]
+  */
+{
+  ELog::RegMethod RegA("XMLpull","getValue");
+
+  if (event!=startElm && event!=emptyElm)
+    throw ColErr::InContainerError<std::string>
+      (ChildName,"XMLpull::getValue: not at element");
+
+  const std::string KeyName=key.str();
+  std::string Own;
+  std::string Child;
+  bool groupFlag(0);
+  bool childFlag(0);
+  bool inChild(0);
+  if (event==startElm)
+    {
+      const size_t D=openStack.size();
+      while(next()!=endFile && openStack.size()>=D)
+	{
+	  if (event==textElm)
+	    {
+	      std::string& Out((openStack.size()==D) ? Own : Child);
+	      if (openStack.size()==D || inChild)
+		{
+		  if (!Out.empty()) Out+=' ';
+		  Out+=getText();
+		}
+	    }
+	  else if (event==endElm)
+	    {
+	      if (openStack.size()==D) inChild=0;
+	    }
+	  else if (openStack.size()==D+1)
+	    {
+	      groupFlag=1;
+	      if (!childFlag && key==ChildName)
+		{
+		  childFlag=1;
+		  inChild=(event==startElm);
+		}
+	    }
+	}
+    }
+  if (groupFlag && !childFlag)
+    throw ColErr::InContainerError<std::string>
+      (ChildName,"XMLpull::getValue:"+KeyName);
+
+  const std::string& Out((groupFlag) ? Child : Own);
+  if (Out.empty())
+    throw ColErr::InContainerError<std::string>
+      (KeyName,"XMLpull::getValue: no value");
+  return Out;
+}
+
+}  // NAMESPACE XML
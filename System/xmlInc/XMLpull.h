@@ -0,0 +1,129 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   xmlInc/XMLpull.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef XML_XMLpull_h
+#define XML_XMLpull_h
+
+namespace XML
+{
+
+/*!
+  \struct XMLview
+  \version 1.0
+  \date November 2017
+  \author S. Ansell
+  \brief Non-owning [pointer:length] view into the file buffer
+*/
+
+struct XMLview
+{
+  const char* ptr;         ///< Start of text
+  size_t len;              ///< Length of text
+
+  XMLview() : ptr(0),len(0) {}  ///< Constructor
+  /// Constructor
+  XMLview(const char* P,const size_t L) : ptr(P),len(L) {}
+
+  /// Is empty
+  bool empty() const { return len==0; }
+  /// Copy out
+  std::string str() const { return std::string(ptr,len); }
+
+  bool operator==(const std::string&) const;
+  /// Not equal
+  bool operator!=(const std::string& A) const { return !(*this==A); }
+};
+
+/*!
+  \class XMLpull
+  \version 1.0
+  \date November 2017
+  \author S. Ansell
+  \brief Pull parser over a memory mapped XML file
+
+  Each call to next() moves to the next element event.
+  The key, attributes and text are views into the
+  mapped file and are only valid until the following next().
+  Comments, <?..?> and <!..> are skipped. No DOM is built.
+*/
+
+class XMLpull
+{
+ public:
+
+  /// Event types from next()
+  enum EventType { endFile=0, startElm=1, endElm=2, emptyElm=-1, textElm=3 };
+
+ private:
+
+  int fd;                          ///< file descriptor [-1 not mapped]
+  void* mapBase;                   ///< Base of mapping
+  size_t mapSize;                  ///< Size of mapping
+  std::string fallBuffer;          ///< Buffer if mmap not possible
+
+  const char* cPtr;                ///< Current point
+  const char* endPtr;              ///< End of buffer
+
+  EventType event;                 ///< Current event
+  XMLview key;                     ///< Current key
+  XMLview text;                    ///< Current text
+  std::vector<std::pair<XMLview,XMLview>> Attr;   ///< Attribute [key:value]
+  std::vector<XMLview> openStack;  ///< Open elements
+  bool popFlag;                    ///< Pop empty element on next
+
+  XMLpull(const XMLpull&);               ///< Private: copy constructor
+  XMLpull& operator=(const XMLpull&);    ///< Private: assignment
+
+  void closeFile();
+  void parseError(const std::string&) const;
+  bool skipTo(const char*);
+  void processTag();
+
+ public:
+
+  XMLpull();
+  ~XMLpull();
+
+  int openFile(const std::string&);
+  EventType next();
+
+  /// Current event
+  EventType getEvent() const { return event; }
+  /// Current key [start/end/empty]
+  const XMLview& getKey() const { return key; }
+  /// Raw current text [text]
+  const XMLview& getRawText() const { return text; }
+  std::string getText() const;
+  /// Number of open elements (including current start)
+  size_t depth() const { return openStack.size(); }
+
+  bool matchPath(const std::string&) const;
+  bool hasAttribute(const std::string&) const;
+  std::string getAttribute(const std::string&) const;
+  std::string getAttribute(const std::string&,const std::string&) const;
+
+  void skipElement();
+  std::string getValue(const std::string&);
+};
+
+}    // NAMESPACE XML
+
+#endif
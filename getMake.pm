@@ -1073,7 +1073,7 @@ sub printHeaders
     }
   print "\n";
 
-  print "LIBS=-L/usr/X11/lib -lX11 -L/usr/lib -lm\n";
+  print "LIBS=-L/usr/X11/lib -lX11 -L/usr/lib -lm -lpthread\n";
   print "FORTLIBS=-lgfortranbegin -lgfortran \n";
   print "OPENLIBS=-lglut -lGLU -lGL -L/usr/X11R6/lib -lXmu -lX11\n";
   print "MOTIF_LIBS=-L/usr/X11R6/lib -lXm -lXtst -lX11\n";
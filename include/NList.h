@@ -74,6 +74,8 @@ class NList
 
   void splitComp();
   int changeItem(const Unit&,const Unit&);
+  template<typename MapType> 
+  int changeItems(const MapType&);
   
   int processString(const std::string&);  
   std::vector<Unit> actualItems() const;  
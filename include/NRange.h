@@ -72,6 +72,7 @@ class NRange
 
   int processString(const std::string&);       ///< process string
   void condense(const double = 1e-6);     
+  void setCondensed(const std::vector<double>&,const double = 1e-6);
   void addComp(const double);
   template<typename T>
   void setVector(const std::vector<T>&);
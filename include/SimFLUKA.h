@@ -33,6 +33,8 @@ class SimFLUKA : public Simulation
 {
  private:
 
+  std::vector<std::string> regionNames() const;
+
   // ALL THE sub-write stuff
   void writeCells(std::ostream&) const;
   void writeSurfaces(std::ostream&) const;
@@ -42,6 +44,7 @@ class SimFLUKA : public Simulation
   void writeTally(std::ostream&) const;
   void writePhysics(std::ostream&) const;
   void writeVariables(std::ostream&) const;
+  virtual void writeDeck(std::ostream&) const;
   
  public:
   
@@ -50,8 +53,6 @@ class SimFLUKA : public Simulation
   SimFLUKA& operator=(const SimFLUKA&);
   virtual ~SimFLUKA() {}           ///< Destructor
 
-  virtual void write(const std::string&) const;
-
 };
 
 #endif
@@ -42,6 +42,7 @@ class SimPHITS : public Simulation
   void writeTally(std::ostream&) const;
   void writePhysics(std::ostream&) const;
   void writeVariables(std::ostream&) const;
+  virtual void writeDeck(std::ostream&) const;
   
  public:
   
@@ -50,8 +51,6 @@ class SimPHITS : public Simulation
   SimPHITS& operator=(const SimPHITS&);
   virtual ~SimPHITS() {}           ///< Destructor
 
-  virtual void write(const std::string&) const;
-
 };
 
 #endif
@@ -37,6 +37,7 @@ class SimPOVRay : public Simulation
   void writeCells(std::ostream&) const;
   void writeSurfaces(std::ostream&) const;
   void writeMaterial(std::ostream&) const;
+  virtual void writeDeck(std::ostream&) const;
   
  public:
   
@@ -45,8 +46,6 @@ class SimPOVRay : public Simulation
   SimPOVRay& operator=(const SimPOVRay&);
   virtual ~SimPOVRay() {}           ///< Destructor
 
-  virtual void write(const std::string&) const;
-
 };
 
 #endif
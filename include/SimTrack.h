@@ -43,6 +43,7 @@ namespace ModelSupport
   In a given simulation tracks or isValid operations based on points
   typically start from the last used cell : This keeps a track of the 
   last used cell as an optimization point.
+  There is one instance per thread.
 */
 
 
@@ -22,6 +22,7 @@
 #ifndef SimValid_h
 #define SimValid_h
 
+class MTRand;
 
 namespace ModelSupport
 {
@@ -66,25 +67,50 @@ struct simPoint
   \class SimValid
   \brief Applies simple test to a simulation to check validity
   \author S. Ansell
-  \version 1.0
+  \version 1.1
   \date March 2013
+
+  Random rays are tracked from the centre to an importance
+  zero cell. With more than one thread the rays are split in
+  blocks and each thread has its own random stream seeded
+  from the global RNG, so the rays only depend on the seed
+  and the number of threads.
 */
 
 class SimValid
 {
  private:
 
-  Geometry::Vec3D Centre;  // Centre for tracks
+  Geometry::Vec3D Centre;  ///< Centre for tracks
+  size_t nThread;          ///< Number of threads [0/1 : serial]
+
+  /// Failed ray : index / direction
+  typedef std::pair<size_t,Geometry::Vec3D> failTYPE;
+
+  static Geometry::Vec3D randDirection(MTRand&);
+  int trackRay(const ModelSupport::ObjSurfMap*,
+	       MonteCarlo::Object*,const int,
+	       const Geometry::Vec3D&,std::vector<simPoint>&,int&) const;
+  void reportFail(const Simulation&,const size_t,
+		  const Geometry::Vec3D&,std::vector<simPoint>&,
+		  const int) const;
+  void runRange(const ModelSupport::ObjSurfMap*,MonteCarlo::Object*,
+		const int,const size_t,const size_t,const unsigned int,
+		std::vector<failTYPE>&) const;
+  int runThreads(const Simulation&,MonteCarlo::Object*,
+		 const int,const size_t) const;
   
  public:
   
   SimValid();
   SimValid(const SimValid&);
   SimValid& operator=(const SimValid&);
-  ~SimValid() {}        /// Destructor
+  ~SimValid() {}        ///< Destructor
 
   /// Set the centre
   void setCentre(const Geometry::Vec3D C) { Centre=C;} 
+  /// Set the number of threads
+  void setThreads(const size_t N) { nThread=N; }
   // MAIN RUN:
   int run(const Simulation&,const size_t) const;
 
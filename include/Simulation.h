@@ -25,6 +25,7 @@
 namespace Geometry
 {
   class Transform;
+  class Surface;
 }
 
 namespace tallySystem
@@ -48,6 +49,7 @@ class RemoveCell;
 namespace ModelSupport
 {
   class ObjSurfMap;
+  class ObjBVH;
 }
 
 namespace WeightSystem
@@ -90,11 +92,13 @@ class Simulation
  protected:
 
   int mcnpVersion;                      ///< version of mcnp
+  size_t writeThread;                   ///< Threads for the card write
   std::string inputFile;                ///< Input file
   std::string cmdLine;                  ///< Command line : historical recall 
   int CNum;                             ///< Number of complementary components
   FuncDataBase DB;                      ///< DataBase of variables
   ModelSupport::ObjSurfMap* OSMPtr;     ///< Object surface map [if required]
+  ModelSupport::ObjBVH* BVHPtr;         ///< Cell bounding box tree
 
   TransTYPE TList;                      ///< Transforms List (key=Transform)
 
@@ -115,6 +119,8 @@ class Simulation
   int readTally(std::istream&);        
 
   // ALL THE sub-write stuff
+  std::vector<const MonteCarlo::Qhull*> cellVector() const;
+  std::vector<const Geometry::Surface*> surfaceVector() const;
   void writeCells(std::ostream&) const;
   void writeSurfaces(std::ostream&) const;
   void writeMaterial(std::ostream&) const;
@@ -123,6 +129,7 @@ class Simulation
   void writeTally(std::ostream&) const;
   void writePhysics(std::ostream&) const;
   void writeVariables(std::ostream&,const char ='c') const;
+  virtual void writeDeck(std::ostream&) const;
 
   // The Cinder Write stuff
   void writeCinderMat() const;
@@ -142,6 +149,8 @@ class Simulation
   
   /// set the command line
   void setCmdLine(const std::string& S) { cmdLine=S; }
+  /// Set the number of threads for the cell/surface write
+  void setWriteThreads(const size_t N) { writeThread=N; }
   void resetAll();
   void readMaster(const std::string&);   
   int applyTransforms();  
@@ -173,7 +182,7 @@ class Simulation
 
   
   const OTYPE& getCells() const { return OList; } ///< Get cells(const)
-  OTYPE& getCells() { return OList; } ///< Get cells
+  OTYPE& getCells();
   Geometry::Transform* createSourceTransform();
   
 
@@ -183,7 +192,7 @@ class Simulation
   int populateCells(const std::vector<int>&);  
 
   int calcVertex(const int); 
-  void calcAllVertex();
+  void calcAllVertex(const size_t =0);
   
   void masterRotation();
 
@@ -221,6 +230,8 @@ class Simulation
 
   void createObjSurfMap();
   void validateObjSurfMap();
+  void invalidateCellIndex();
+  const ModelSupport::ObjBVH& getCellIndex() const;
   /// Access surface map
   const ModelSupport::ObjSurfMap* getOSM() const;
 
@@ -251,6 +262,8 @@ class Simulation
   void writeCinder() const;          
 
   virtual void write(const std::string&) const;  
+  void writeMulti(const std::vector<std::string>&,
+		  const std::vector<long int>&);
     
   // Debug stuff
   
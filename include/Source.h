@@ -30,6 +30,11 @@ namespace Geometry
 }
 class Simulation;
 
+namespace MapSupport
+{
+  class NumberMap;
+}
+
 namespace SDef
 {
 
@@ -96,8 +101,9 @@ class Source
   void clear();
 
   void cutEnergy(const double);
-  void substituteCell(const int,const int);
+  void substituteCells(const MapSupport::NumberMap&);
   void substituteSurface(const int,const int);
+  void substituteSurfaces(const MapSupport::NumberMap&);
   void addComp(const std::string&,const SrcBase*);
   /// Set the transform number if needed
   void setTransform(Geometry::Transform* TP) { transPTR=TP; }
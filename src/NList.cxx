@@ -38,6 +38,7 @@
 #include "RegMethod.h"
 #include "OutputLog.h"
 #include "Triple.h"
+#include "NumberMap.h"
 #include "support.h"
 #include "NList.h"
 
@@ -373,6 +374,32 @@ NList<Unit>::changeItem(const Unit& oldI,const Unit& newI)
   return 0;
 }
 
+template<typename Unit>
+template<typename MapType>
+int
+NList<Unit>::changeItems(const MapType& NMap)
+  /*!
+    Change all the actual items in one pass 
+    \param NMap :: Map of old : new values [convert]
+    \return number of items changed
+  */
+{
+  int cnt(0);
+  for(CompUnit& CU : Items)
+    {
+      if (CU.first==0)
+	{
+	  const Unit newI=NMap.convert(CU.second);
+	  if (newI!=CU.second)
+	    {
+	      CU.second=newI;
+	      cnt++;
+	    }
+	}
+    }
+  return cnt;
+}
+
 template<typename Unit>
 void
 NList<Unit>::write(std::ostream& OX) const
@@ -399,6 +426,9 @@ NList<Unit>::write(std::ostream& OX) const
 template class NList<int>;
 template class NList<double>;
 
+template int
+NList<int>::changeItems(const MapSupport::NumberMap&);
+
 template std::ostream&
 operator<<(std::ostream&,const NList<double>&);
 template std::ostream&
@@ -318,15 +318,9 @@ NRange::setVector(const std::vector<double>& Vec)
 {
   ELog::RegMethod RegA("NRange","setVector");
   
-  Items.erase(Items.begin(),Items.end());
-  
-  std::vector<double>::const_iterator vc;
-  for(vc=Vec.begin();vc!=Vec.end();vc++)
-    Items.push_back(NRunit(0,0,*vc));	 
-  
   double TValue(mathFunc::minDifference(Vec,1e-15)/10.0);
   if (TValue>1e-6) TValue=1e-6;
-  condense(TValue);
+  setCondensed(Vec,TValue);
   return;
 }
 
@@ -340,13 +334,7 @@ NRange::setVector(const std::vector<int>& Vec)
 {
   ELog::RegMethod RegA("NRange","setVector");
 
-  Items.erase(Items.begin(),Items.end());
-  
-  std::vector<int>::const_iterator vc;
-  for(vc=Vec.begin();vc!=Vec.end();vc++)
-    Items.push_back(NRunit(0,0,*vc));	 
-  
-  condense(1e-3);
+  setCondensed(std::vector<double>(Vec.begin(),Vec.end()),1e-3);
   return;
 }
 
@@ -375,14 +363,34 @@ NRange::condense(const double Tol)
   writeVector(Values);
   if (Values.size()<2)
     return;
+  setCondensed(Values,Tol);
+  return;
+}
+
+void
+NRange::setCondensed(const std::vector<double>& Values,const double Tol)
+  /*!
+    Set the range from a vector of values and determine
+    the intervals in one pass [no list of single items]
+    \param Values :: Values to condense
+    \param Tol :: Tolerance value
+  */
+{
+  Items.clear();
+  if (Values.size()<2)
+    {
+      for(const double V : Values)
+	Items.push_back(NRunit(0,0,V));
+      return;
+    }
   
-  std::list<NRunit> Out;
   // Extra value here a guard item
   std::vector<int> type(Values.size()+1,0);
   for(size_t i=1;i<Values.size();i++)
     {
-      // Basic repeat:
-      if (identVal(Tol,Values[i],Values[i-1]))
+      // Basic repeat [exact repeat is the common case]:
+      if (Values[i]==Values[i-1] ||
+	  identVal(Tol,Values[i],Values[i-1]))
 	type[i]=1;
       else if (i>1 && intervalVal(Tol,Values[i-2],Values[i-1],Values[i]))
 	{
@@ -398,22 +406,20 @@ NRange::condense(const double Tol)
     {
       size_t repCnt=1;
       if (type[cnt]==0)
-	Out.push_back(NRunit(0,0,Values[cnt]));
+	Items.push_back(NRunit(0,0,Values[cnt]));
       else if (type[cnt])
 	{
 	  // count repeats/interval/
 	  for(repCnt=1;type[cnt+repCnt]==type[cnt];repCnt++) ;
 	  if (repCnt>1)
-	    Out.push_back(NRunit(type[cnt],
-				 static_cast<int>(repCnt),
-				 Values[cnt]));
+	    Items.push_back(NRunit(type[cnt],
+				   static_cast<int>(repCnt),
+				   Values[cnt]));
 	  else
-	    Out.push_back(NRunit(0,0,Values[cnt]));
+	    Items.push_back(NRunit(0,0,Values[cnt]));
 	}
       cnt+=repCnt;
     }
-
-  Items=Out;
   return;
 }
 
@@ -47,6 +47,7 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "CardWriter.h"
 #include "version.h"
 #include "Element.h"
 #include "MapSupport.h"
@@ -93,6 +94,7 @@
 #include "HeadRule.h"
 #include "Object.h"
 #include "Qhull.h"
+#include "objectRegister.h"
 #include "weightManager.h"
 #include "ModeCard.h"
 #include "LSwitchCard.h"
@@ -178,6 +180,24 @@ SimFLUKA::writeTransform(std::ostream& OX) const
 }
 
 
+std::vector<std::string>
+SimFLUKA::regionNames() const
+  /*!
+    Get the registered object name of each cell in 
+    output order [empty for unregistered cells]
+    \return object names
+  */
+{
+  const ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
+
+  std::vector<int> CellN;
+  CellN.reserve(OList.size());
+  for(const OTYPE::value_type& mp : OList)
+    CellN.push_back(mp.first);
+  return OR.inRenumberRange(CellN);
+}
+
 void
 SimFLUKA::writeCells(std::ostream& OX) const
   /*!
@@ -192,9 +212,11 @@ SimFLUKA::writeCells(std::ostream& OX) const
   OX<<"* -------------------------------------------------------"<<std::endl;
   
   
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writeFLUKA(OX);
+  const std::vector<const MonteCarlo::Qhull*> OVec=cellVector();
+  const std::vector<std::string> RVec=regionNames();
+  StrFunc::parallelWrite(OX,OVec.size(),writeThread,
+			 [&OVec,&RVec](std::ostream& cx,const size_t i)
+			 { OVec[i]->writeFLUKA(cx,RVec[i]); });
   OX<<"END"<<std::endl;
   OX<<"* ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   return;
@@ -212,11 +234,10 @@ SimFLUKA::writeSurfaces(std::ostream& OX) const
   OX<<"* --------------- SURFACE CARDS -------------------------"<<std::endl;
   OX<<"* -------------------------------------------------------"<<std::endl;
 
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
-
-  for(const ModelSupport::surfIndex::STYPE::value_type& sm : SurMap)
-    sm.second->writeFLUKA(OX);
+  const std::vector<const Geometry::Surface*> SVec=surfaceVector();
+  StrFunc::parallelWrite(OX,SVec.size(),writeThread,
+			 [&SVec](std::ostream& cx,const size_t i)
+			 { SVec[i]->writeFLUKA(cx); });
   OX<<"END"<<std::endl;
   OX<<"* ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;
@@ -237,8 +258,10 @@ SimFLUKA::writeMaterial(std::ostream& OX) const
   OX<<"* --------------- MATERIAL CARDS ------------------------"<<std::endl;
   OX<<"* -------------------------------------------------------"<<std::endl;
   // WRITE OUT ASSIGNMENT:
+  const std::vector<std::string> RVec=regionNames();
+  size_t index(0);
   for(const OTYPE::value_type& mp : OList)
-    mp.second->writeFLUKAmat(OX);
+    mp.second->writeFLUKAmat(OX,RVec[index++]);
     
   ModelSupport::DBMaterial& DB=ModelSupport::DBMaterial::Instance();  
   DB.resetActive();
@@ -317,16 +340,15 @@ SimFLUKA::writePhysics(std::ostream& OX) const
 }
 
 void
-SimFLUKA::write(const std::string& Fname) const
+SimFLUKA::writeDeck(std::ostream& OX) const
   /*!
     Write out all the system (in PHITS output format)
-    \param Fname :: Output file 
+    \param OX :: Output stream
   */
 {
-  ELog::RegMethod RegA("SimFLUKA","write");
+  ELog::RegMethod RegA("SimFLUKA","writeDeck");
   boost::format FmtStr("%1%%|71t|%2%\n");  
 
-  std::ofstream OX(Fname.c_str()); 
   OX<<"TITLE "<<std::endl;
   OX<<" Fluka model from CombLayer"<<std::endl;
   Simulation::writeVariables(OX,'*');
@@ -339,6 +361,5 @@ SimFLUKA::write(const std::string& Fname) const
   writeWeights(OX);
   writeTally(OX);
   writePhysics(OX);
-  OX.close();
   return;
 }
@@ -47,6 +47,7 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "CardWriter.h"
 #include "version.h"
 #include "Element.h"
 #include "MapSupport.h"
@@ -188,9 +189,11 @@ SimPHITS::writeCells(std::ostream& OX) const
 {
   boost::format FmtStr("  %1$d%|20t|%2$d\n");
   OX<<"[cell]"<<std::endl;
+  const std::vector<const MonteCarlo::Qhull*> OVec=cellVector();
+  StrFunc::parallelWrite(OX,OVec.size(),writeThread,
+			 [&OVec](std::ostream& cx,const size_t i)
+			 { OVec[i]->writePHITS(cx); });
   OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writePHITS(OX);
 
   OX<<std::endl;  // Empty line manditory for MCNPX
 
@@ -218,13 +221,10 @@ SimPHITS::writeSurfaces(std::ostream& OX) const
 {
   OX<<"  [surface] " <<std::endl;
 
-  const ModelSupport::surfIndex::STYPE& SurMap=
-    ModelSupport::surfIndex::Instance().surMap();
-  std::map<int,Geometry::Surface*>::const_iterator mp;
-  for(mp=SurMap.begin();mp!=SurMap.end();mp++)
-    {
-      (mp->second)->write(OX);
-    }
+  const std::vector<const Geometry::Surface*> SVec=surfaceVector();
+  StrFunc::parallelWrite(OX,SVec.size(),writeThread,
+			 [&SVec](std::ostream& cx,const size_t i)
+			 { SVec[i]->write(cx); });
   return;
 } 
 
@@ -305,13 +305,12 @@ SimPHITS::writePhysics(std::ostream& OX) const
 }
 
 void
-SimPHITS::write(const std::string& Fname) const
+SimPHITS::writeDeck(std::ostream& OX) const
   /*!
     Write out all the system (in PHITS output format)
-    \param Fname :: Output file 
+    \param OX :: Output stream
   */
 {
-  std::ofstream OX(Fname.c_str());
   Simulation::writeVariables(OX);
   writeCells(OX);
   writeSurfaces(OX);
@@ -320,6 +319,5 @@ SimPHITS::write(const std::string& Fname) const
   writeWeights(OX);
   writeTally(OX);
   writePhysics(OX);
-  OX.close();
   return;
 }
@@ -47,6 +47,7 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "CardWriter.h"
 #include "Element.h"
 #include "MapSupport.h"
 #include "MXcards.h"
@@ -113,9 +114,10 @@ SimPOVRay::writeCells(std::ostream& OX) const
   ELog::RegMethod RegA("SimPOVRay","writeCells");
   
   
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writePOVRay(OX);
+  const std::vector<const MonteCarlo::Qhull*> OVec=cellVector();
+  StrFunc::parallelWrite(OX,OVec.size(),writeThread,
+			 [&OVec](std::ostream& cx,const size_t i)
+			 { OVec[i]->writePOVRay(cx); });
   return;
 }
 
@@ -127,11 +129,10 @@ SimPOVRay::writeSurfaces(std::ostream& OX) const
     \param OX :: Output stream
   */
 {
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
-
-  for(const ModelSupport::surfIndex::STYPE::value_type& sm : SurMap)
-    sm.second->writePOVRay(OX);
+  const std::vector<const Geometry::Surface*> SVec=surfaceVector();
+  StrFunc::parallelWrite(OX,SVec.size(),writeThread,
+			 [&SVec](std::ostream& cx,const size_t i)
+			 { SVec[i]->writePOVRay(cx); });
   OX<<std::endl;
   return;
 } 
@@ -163,15 +164,14 @@ SimPOVRay::writeMaterial(std::ostream& OX) const
 }
   
 void
-SimPOVRay::write(const std::string& Fname) const
+SimPOVRay::writeDeck(std::ostream& OX) const
   /*!
     Write out all the system for povray
-    \param Fname :: Output file 
+    \param OX :: Output stream
   */
 {
-  ELog::RegMethod RegA("SimPOVRay","write");
+  ELog::RegMethod RegA("SimPOVRay","writeDeck");
 
-  std::ofstream OX(Fname.c_str()); 
   OX << "// POV-Ray model from CombLayer."<<std::endl;
   OX << "// This file contains only geomety." << std::endl;
   OX << "// It is supposed to be included from a .pov file with defined camera, light source and material textures" << std::endl;
@@ -182,6 +182,5 @@ SimPOVRay::write(const std::string& Fname) const
   writeSurfaces(OX);
   OX << "// Cells" << std::endl;
   writeCells(OX);
-  OX.close();
   return;
 }
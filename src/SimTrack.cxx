@@ -52,11 +52,12 @@ SimTrack::SimTrack()
 SimTrack&
 SimTrack::Instance()
   /*!
-    Singleton this
+    Singleton this [one per thread so that concurrent
+    readers of a simulation do not share the last cell]
     \return SimTrack object
    */
 {
-  static SimTrack ST;
+  static thread_local SimTrack ST;
   return ST;
 }
 
@@ -100,13 +101,8 @@ SimTrack::setCell(const Simulation* SimPtr,MonteCarlo::Object* OPtr)
   ELog::RegMethod RegA("SimTrack","setCell");
 
   fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
-  fcTYPE::iterator mc=findCell.find(sInt);
-  if (mc==findCell.end())
-    {
-      throw ColErr::InContainerError<fcTYPE::key_type>
-	(sInt,"sInt not fould in findCell");
-    }
-  mc->second=OPtr;
+  // other threads do not see addSim : so add here
+  findCell[sInt]=OPtr;
   return;
 }
 
@@ -115,17 +111,14 @@ SimTrack::curCell(const Simulation* SimPtr) const
   /*!
     Get the current cell
     \param SimPtr :: Significant figures
-    \return :: Object Pointer
+    \return :: Object Pointer [0 if not set in this thread]
   */
 {
   ELog::RegMethod RegA("SimTrack","curCell");
 
   fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
   fcTYPE::const_iterator mc=findCell.find(sInt);
-  if (mc==findCell.end())
-    throw ColErr::InContainerError<fcTYPE::key_type>
-      (sInt,"simluation<long Int>");
-  return mc->second;
+  return (mc!=findCell.end()) ? mc->second : 0;
 }
 
 void
@@ -3,7 +3,7 @@
  
  * File:   src/SimValid.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -31,6 +31,8 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -42,6 +44,7 @@
 #include "BaseModVisit.h"
 #include "support.h"
 #include "mathSupport.h"
+#include "threadSupport.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -68,14 +71,14 @@ namespace ModelSupport
 {
 
 SimValid::SimValid() :
-  Centre(Geometry::Vec3D(0.15,-0.45,0.15))
+  Centre(Geometry::Vec3D(0.15,-0.45,0.15)),nThread(0)
   /*!
     Constructor
   */
 {}
 
 SimValid::SimValid(const SimValid& A) : 
-  Centre(A.Centre)
+  Centre(A.Centre),nThread(A.nThread)
   /*!
     Copy constructor
     \param A :: SimValid to copy
@@ -93,10 +96,227 @@ SimValid::operator=(const SimValid& A)
   if (this!=&A)
     {
       Centre=A.Centre;
+      nThread=A.nThread;
     }
   return *this;
 }
 
+Geometry::Vec3D
+SimValid::randDirection(MTRand& RN)
+  /*!
+    Get a random direction 
+    \param RN :: Random number stream
+    \return direction
+  */
+{
+  // Note for sphere that you can use X,Y,Z in any orthogonal 
+  // directiron
+  const double phi=RN.rand()*M_PI;
+  const double theta=2.0*RN.rand()*M_PI;
+  return Geometry::Vec3D(cos(theta)*sin(phi),
+			 sin(theta)*sin(phi),
+			 cos(phi));
+}
+
+int
+SimValid::trackRay(const ModelSupport::ObjSurfMap* OSMPtr,
+		   MonteCarlo::Object* InitObj,const int initSurfNum,
+		   const Geometry::Vec3D& D,
+		   std::vector<simPoint>& Pts,int& SN) const
+  /*!
+    Track a single ray from the centre until an importance zero
+    cell is reached. No output is written so this can be
+    used by many threads.
+    \param OSMPtr :: Object surface map
+    \param InitObj :: Initial object
+    \param initSurfNum :: Surface the centre is on [if any]
+    \param D :: Direction 
+    \param Pts :: Track points 
+    \param SN :: Last surface crossed
+    \return 1 on success / 0 if no next cell found
+  */
+{
+  const Geometry::Surface* SPtr;          // Output surface
+  double aDist;       
+
+  MonteCarlo::neutron TNeut(1,Centre,D);
+  MonteCarlo::Object* OPtr=InitObj;
+  SN= -initSurfNum;
+
+  Pts.clear();
+  Pts.push_back(simPoint(TNeut.Pos,OPtr->getName(),SN,OPtr));
+  while(OPtr && OPtr->getImp())
+    {
+      // Note: Need OPPOSITE Sign on exiting surface
+      SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
+      // Fail on Pts==1 and aDist inf : step off
+      if (aDist>1e30 && Pts.size()<=1)
+	aDist=1e-5;
+
+      TNeut.moveForward(aDist);
+      Pts.push_back(simPoint(TNeut.Pos,OPtr->getName(),SN,OPtr));
+      OPtr=(SN) ?
+	OSMPtr->getNextObject(SN,TNeut.Pos,OPtr->getName()) : 0;	    
+    }
+  return (OPtr) ? 1 : 0;
+}
+
+void
+SimValid::reportFail(const Simulation& System,const size_t rayIndex,
+		     const Geometry::Vec3D& D,std::vector<simPoint>& Pts,
+		     const int SN) const
+  /*!
+    Write out the failure of a ray
+    \param System :: Simulation
+    \param rayIndex :: Index of ray
+    \param D :: Direction of ray
+    \param Pts :: Track points of the ray
+    \param SN :: Last surface
+  */
+{
+  ELog::RegMethod RegA("SimValid","reportFail");
+  ELog::debugMethod DebA;
+
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+  const Geometry::Surface* SPtr;          // Output surface
+  double aDist;       
+
+  ELog::EM<<"------------"<<ELog::endCrit;
+  ELog::EM<<"I/SN == "<<rayIndex<<" "<<SN<<ELog::endCrit;
+  for(size_t j=0;j<Pts.size();j++)
+    {
+      ELog::EM<<"Pos["<<j<<"]=="<<Pts[j].Pt<<" :: Obj:"
+	      <<Pts[j].objN<<" Surf:"<<Pts[j].surfN<<ELog::endDiag;
+    }
+  if (Pts.size()<3)
+    {
+      ELog::EM<<"Failed on first cell"<<ELog::endCrit;
+      return;
+    }
+  
+  const size_t index(Pts.size()-3);
+  ELog::EM<<"Base Obj == "<<*Pts[index].OPtr
+	  <<ELog::endDiag;
+  ELog::EM<<"Next Obj == "<<*Pts[index+1].OPtr
+	  <<ELog::endDiag;
+  // RESET:
+  MonteCarlo::neutron TNeut(1,Pts[index].Pt,D);
+  MonteCarlo::Object* OPtr=Pts[index].OPtr;
+  DebA.activate();
+  ELog::EM<<"RESET POS== "<<TNeut.Pos<<ELog::endDiag;
+  ELog::EM<<"RESET Obj== "<<OPtr->getName()<<ELog::endDiag;
+  ELog::EM<<"RESET SurfN== "<<Pts[index].surfN<<ELog::endDiag;
+  ELog::EM<<"----------------------------------"<<ELog::endDebug;
+  OPtr=OSMPtr->findNextObject(Pts[index].surfN,
+			      TNeut.Pos,OPtr->getName());	    
+  if (OPtr)
+    {
+      ELog::EM<<"Found Obj == "<<*OPtr<<" :: "<<Pts[index].Pt<<" "
+	      <<OPtr->pointStr(Pts[index].Pt)<<ELog::endDiag;
+      ELog::EM<<OPtr->isValid(Pts[index].Pt)<<ELog::endDiag;
+    }
+  else
+    ELog::EM<<"No object "<<ELog::endDiag;
+  TNeut.Pos+=D*0.00001;
+
+  MonteCarlo::Object* NOPtr=System.findCell(TNeut.Pos,0);
+  if (NOPtr)
+    {
+      ELog::EM<<"Neutron == "<<TNeut<<ELog::endDiag;
+      ELog::EM<<"Actual object == "<<*NOPtr<<ELog::endDiag;
+      ELog::EM<<" IMP == "<<NOPtr->getImp()<<ELog::endDiag;
+    }
+  ELog::EM<<"TRACK to NEXT"<<ELog::endDiag;
+  ELog::EM<<"--------------"<<ELog::endDiag;
+  if (OPtr)
+    OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
+  ELog::EM<<"Failed to calculate cell correctly: "<<rayIndex<<ELog::endCrit;
+  return;
+}
+
+void
+SimValid::runRange(const ModelSupport::ObjSurfMap* OSMPtr,
+		   MonteCarlo::Object* InitObj,const int initSurfNum,
+		   const size_t startIndex,const size_t endIndex,
+		   const unsigned int seed,
+		   std::vector<failTYPE>& failVec) const
+  /*!
+    Track a block of rays [thread unit]
+    \param OSMPtr :: Object surface map
+    \param InitObj :: Initial object
+    \param initSurfNum :: Surface the centre is on [if any]
+    \param startIndex :: First ray index
+    \param endIndex :: One past last ray index
+    \param seed :: Seed of the random stream
+    \param failVec :: Failed rays
+  */
+{
+  MTRand RN(seed);
+  std::vector<simPoint> Pts;
+  int SN;
+  for(size_t i=startIndex;i<endIndex;i++)
+    {
+      const Geometry::Vec3D D=randDirection(RN);
+      if (!trackRay(OSMPtr,InitObj,initSurfNum,D,Pts,SN))
+	failVec.push_back(failTYPE(i,D));
+    }
+  return;
+}
+
+int
+SimValid::runThreads(const Simulation& System,
+		     MonteCarlo::Object* InitObj,const int initSurfNum,
+		     const size_t N) const
+  /*!
+    Calculate the tracking over nThread threads
+    \param System :: Simulation to use
+    \param InitObj :: Initial object
+    \param initSurfNum :: Surface the centre is on [if any]
+    \param N :: Number of points to test
+    \return true if valid
+  */
+{
+  ELog::RegMethod RegA("SimValid","runThreads");
+
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+
+  const size_t nT=threadSupport::threadCount(nThread,N);
+  std::vector<unsigned int> Seeds(nT);
+  for(size_t i=0;i<nT;i++)
+    Seeds[i]=RNG.randInt();
+
+  std::vector<std::vector<failTYPE>> failVec(nT);
+  threadSupport::parallelFor
+    (nT,N,[&](const size_t i,const size_t startIndex,const size_t endIndex)
+     {
+       runRange(OSMPtr,InitObj,initSurfNum,startIndex,endIndex,
+		Seeds[i],failVec[i]);
+     });
+
+  // blocks are in ray order
+  std::vector<failTYPE> allFail;
+  for(const std::vector<failTYPE>& FV : failVec)
+    allFail.insert(allFail.end(),FV.begin(),FV.end());
+
+  if (!allFail.empty())
+    {
+      ELog::EM<<"Failed rays == "<<allFail.size()<<" / "<<N<<ELog::endCrit;
+      for(const failTYPE& FT : allFail)
+	ELog::EM<<"Ray["<<FT.first<<"] == "<<FT.second<<ELog::endCrit;
+      // replay the first failure for full output
+      std::vector<simPoint> Pts;
+      int SN;
+      trackRay(OSMPtr,InitObj,initSurfNum,allFail.front().second,Pts,SN);
+      reportFail(System,allFail.front().first,
+		 allFail.front().second,Pts,SN);
+      return 0;
+    }
+  
+  ELog::EM<<"Finished Validation check ["<<nT
+	  <<" threads]"<<ELog::endDiag;
+  return 1;
+}
+
 int
 SimValid::run(const Simulation& System,const size_t N) const
   /*!
@@ -107,16 +327,9 @@ SimValid::run(const Simulation& System,const size_t N) const
   */
 {
   ELog::RegMethod RegA("SimValid","run");
-  ELog::debugMethod DebA;
   
   const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
   MonteCarlo::Object* InitObj(0);
-  const Geometry::Surface* SPtr;          // Output surface
-  double aDist;       
-
-  // Note for sphere that you can use X,Y,Z in any orthogonal 
-  // directiron
-  double phi,theta;
 
   // Find Initial cell [Store for next time]
   //  Centre+=Geometry::Vec3D(0.001,0.001,0.001);
@@ -125,91 +338,20 @@ SimValid::run(const Simulation& System,const size_t N) const
 
   ELog::EM<<"Init Object nubmer == "<<InitObj->getName()<<ELog::endDiag;      
   ELog::EM<<"Initial surface [if on surf] == "<<initSurfNum<<ELog::endDiag; 
-     
+
+  if (nThread>1)
+    return runThreads(System,InitObj,initSurfNum,N);
+  
   // check surfaces
+  std::vector<simPoint> Pts;
+  int SN;
   for(size_t i=0;i<N;i++)
     {
-      std::vector<simPoint> Pts;
       // Get random starting point on edge of volume
-      phi=RNG.rand()*M_PI;
-      theta=2.0*RNG.rand()*M_PI;
-      Geometry::Vec3D D(cos(theta)*sin(phi),
-			sin(theta)*sin(phi),
-			cos(phi));
-      MonteCarlo::neutron TNeut(1,Centre,D);
-
-      MonteCarlo::Object* OPtr=InitObj;
-      int SN(-initSurfNum);
-
-      Pts.push_back(simPoint(TNeut.Pos,OPtr->getName(),SN,OPtr));
-      while(OPtr && OPtr->getImp())
-	{
-	  // Note: Need OPPOSITE Sign on exiting surface
-	  SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
-
-	  if (aDist>1e30 && Pts.size()<=1)
-	    {
-	      ELog::EM<<"Fail on Pts==1 and aDist inf"<<ELog::endDiag;
-	      ELog::EM<<"Index == "<<Pts.size()-2<<ELog::endDiag;
-	      ELog::EM<<"Pts[0] == "<<Pts[0].Pt<<ELog::endDiag;
-	      ELog::EM<<"SN == "<<SN<<ELog::endDiag;
-	      aDist=1e-5;
-	    }
-
-	  TNeut.moveForward(aDist);
-	  Pts.push_back(simPoint(TNeut.Pos,OPtr->getName(),SN,OPtr));
-	  OPtr=(SN) ?
-	    OSMPtr->findNextObject(SN,TNeut.Pos,OPtr->getName()) : 0;	    
-	}
-
-      if (!OPtr)
+      const Geometry::Vec3D D=randDirection(RNG);
+      if (!trackRay(OSMPtr,InitObj,initSurfNum,D,Pts,SN))
 	{
-	  ELog::EM<<"------------"<<ELog::endCrit;
-	  ELog::EM<<"I/SN == "<<i<<" "<<SN<<ELog::endCrit;
-	  for(size_t j=0;j<Pts.size();j++)
-	    {
-	      ELog::EM<<"Pos["<<j<<"]=="<<Pts[j].Pt<<" :: Obj:"
-		      <<Pts[j].objN<<" Surf:"<<Pts[j].surfN<<ELog::endDiag;
-	    }
-
-	  const size_t index(Pts.size()-3);
-	  ELog::EM<<"Base Obj == "<<*Pts[index].OPtr
-		  <<ELog::endDiag;
-	  ELog::EM<<"Next Obj == "<<*Pts[index+1].OPtr
-		  <<ELog::endDiag;
-	  // RESET:
-	  TNeut.Pos=Pts[index].Pt;  // Reset point
-	  OPtr=Pts[index].OPtr;
-          SN=Pts[index].surfN;
-          DebA.activate();
-          ELog::EM<<"RESET POS== "<<TNeut.Pos<<ELog::endDiag;
-          ELog::EM<<"RESET Obj== "<<OPtr->getName()<<ELog::endDiag;
-          ELog::EM<<"RESET SurfN== "<<Pts[index].surfN<<ELog::endDiag;
-          ELog::EM<<"----------------------------------"<<ELog::endDebug;
-	  OPtr=OSMPtr->findNextObject(Pts[index].surfN,
-				      TNeut.Pos,OPtr->getName());	    
-	  if (OPtr)
-	    {
-	      ELog::EM<<"Found Obj == "<<*OPtr<<" :: "<<Pts[index].Pt<<" "
-		      <<OPtr->pointStr(Pts[index].Pt)<<ELog::endDiag;
-	      ELog::EM<<OPtr->isValid(Pts[index].Pt)<<ELog::endDiag;
-	    }
-	  else
-	    ELog::EM<<"No object "<<ELog::endDiag;
-	  TNeut.Pos+=D*0.00001;
-
-	  MonteCarlo::Object* NOPtr=System.findCell(TNeut.Pos,0);
-	  if (NOPtr)
-	    {
-	      ELog::EM<<"Neutron == "<<TNeut<<ELog::endDiag;
-	      ELog::EM<<"Actual object == "<<*NOPtr<<ELog::endDiag;
-	      ELog::EM<<" IMP == "<<NOPtr->getImp()<<ELog::endDiag;
-	    }
-          ELog::EM<<"TRACK to NEXT"<<ELog::endDiag;
-          ELog::EM<<"--------------"<<ELog::endDiag;
-          
-          OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
-	  ELog::EM<<"Failed to calculate cell correctly: "<<i<<ELog::endCrit;
+	  reportFail(System,i,D,Pts,SN);
 	  return 0;
 	}
     }
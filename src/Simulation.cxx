@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -35,6 +36,7 @@
 #include <iterator>
 #include <memory>
 #include <array>
+#include <mutex>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -46,19 +48,24 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "threadSupport.h"
+#include "CardWriter.h"
 #include "version.h"
 #include "Element.h"
 #include "MapSupport.h"
+#include "NumberMap.h"
 #include "MXcards.h"
 #include "Material.h"
 #include "DBMaterial.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Quaternion.h"
 #include "localRotate.h"
 #include "masterRotate.h"
 #include "Triple.h"
+#include "TripleCache.h"
 #include "NList.h"
 #include "NRange.h"
 #include "Tally.h"
@@ -86,6 +93,7 @@
 #include "HeadRule.h"
 #include "Object.h"
 #include "Qhull.h"
+#include "CompExpand.h"
 #include "WForm.h"
 #include "weightManager.h"
 #include "ModeCard.h"
@@ -95,6 +103,7 @@
 #include "Source.h"
 #include "KCode.h"
 #include "ObjSurfMap.h"
+#include "ObjBVH.h"
 #include "PhysicsCards.h"
 #include "ReadFunctions.h"
 #include "BaseMap.h"
@@ -103,7 +112,8 @@
 #include "Simulation.h"
 
 Simulation::Simulation()  :
-  mcnpVersion(6),CNum(100000),OSMPtr(new ModelSupport::ObjSurfMap),
+  mcnpVersion(6),writeThread(0),CNum(100000),OSMPtr(new ModelSupport::ObjSurfMap),
+  BVHPtr(new ModelSupport::ObjBVH),
   PhysPtr(new physicsSystem::PhysicsCards)
   /*!
     Start of simulation Object
@@ -113,9 +123,10 @@ Simulation::Simulation()  :
 }
 
 Simulation::Simulation(const Simulation& A)  :
-  mcnpVersion(A.mcnpVersion),inputFile(A.inputFile),
-  CNum(A.CNum),DB(A.DB),
+  mcnpVersion(A.mcnpVersion),writeThread(A.writeThread),
+  inputFile(A.inputFile),CNum(A.CNum),DB(A.DB),
   OSMPtr(new ModelSupport::ObjSurfMap),
+  BVHPtr(new ModelSupport::ObjBVH),
   TList(A.TList),  cellOutOrder(A.cellOutOrder),
   PhysPtr(new physicsSystem::PhysicsCards(*A.PhysPtr))
   /*!
@@ -157,6 +168,7 @@ Simulation::operator=(const Simulation& A)
 
   if (this!=&A)
     {
+      writeThread=A.writeThread;
       inputFile=A.inputFile;
       CNum=A.CNum;
       DB=A.DB;
@@ -180,6 +192,7 @@ Simulation::operator=(const Simulation& A)
 			(tc->first,(tc->second)->clone()));
 	}
       ModelSupport::SimTrack::Instance().setCell(this,0);
+      BVHPtr->clearAll();
       createObjSurfMap();
     }
   return *this;
@@ -196,6 +209,7 @@ Simulation::~Simulation()
   delete PhysPtr;
   delete OSMPtr;
   deleteObjects();
+  delete BVHPtr;
   deleteTally();
   ModelSupport::SimTrack::Instance().clearSim(this);
 
@@ -210,6 +224,7 @@ Simulation::resetAll()
   ModelSupport::surfIndex::Instance().reset();
   TList.erase(TList.begin(),TList.end());
   OSMPtr->clearAll();
+  BVHPtr->clearAll();
   PhysPtr->clearAll();
   deleteTally();
   deleteObjects();
@@ -229,6 +244,7 @@ Simulation::deleteObjects()
   ELog::RegMethod RegA("Simulation","deleteObjects");
   
   ModelSupport::SimTrack::Instance().setCell(this,0);
+  BVHPtr->clearAll();
   for(OTYPE::value_type& mc : OList)
     delete mc.second;
   
@@ -390,6 +406,7 @@ Simulation::checkInsert(const MonteCarlo::Qhull& A)
 
   const int cellNumber=A.getName();
   OTYPE::iterator mpt=OList.find(cellNumber);
+  BVHPtr->setInvalid();
   
   if (mpt!=OList.end())
     {
@@ -481,6 +498,7 @@ Simulation::addCell(const int cellNumber,const MonteCarlo::Qhull& A)
       ELog::EM<<"Call from: "<<RegA.getBasePtr()->getItem(-1)<<ELog::endCrit;
       throw ColErr::ExitAbort("Cell number in use");
     }
+  BVHPtr->setInvalid();
   OList.insert(OTYPE::value_type(cellNumber,A.clone()));
   MonteCarlo::Qhull* QHptr=OList[cellNumber];
 
@@ -710,6 +728,7 @@ Simulation::removeCells(const int startN,const int endN)
   ModelSupport::objectRegister& OR=
     ModelSupport::objectRegister::Instance();
 
+  BVHPtr->setInvalid();
   // It seems quicker to create a new map and copy
   OTYPE newOList;
   OTYPE::iterator vc;
@@ -752,6 +771,7 @@ Simulation::removeCell(const int cellNumber)
   
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
   ST.checkDelete(this,vc->second);
+  BVHPtr->setInvalid();
   delete vc->second;
   OList.erase(vc);
 
@@ -772,6 +792,7 @@ Simulation::removeAllSurface(const int KeyN)
     \returns Number of surface removed (will do)
   */
 {
+  BVHPtr->setInvalid();
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
     {
@@ -802,6 +823,7 @@ Simulation::substituteAllSurface(const int KeyN,const int NsurfN)
     throw ColErr::InContainerError<int>
       (NsurfN,"Surface number not found");
 
+  BVHPtr->setInvalid();
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
     oc->second->substituteSurf(KeyN,NsurfN,XPtr);
@@ -831,15 +853,12 @@ Simulation::bindCell(const int CellVirtual,const int CellBound)
   MonteCarlo::Qhull* CB=findQhull(CellBound);
   if (!CV || !CB)
     return -1;
+  BVHPtr->setInvalid();
   if (CVN!=CellVirtual)
     {
-      
-      MonteCarlo::Qhull* CX=new MonteCarlo::Qhull(*CV);
-      CX->makeComplement();
-      removeComplement(*CX);
-      const int res=CB->addSurfString(CX->cellCompStr());
-      delete CX;
-      return res;
+      MonteCarlo::CompExpand CE(OList);
+      CB->addIntersection(CE.complement(*CV));
+      return 1;
     }
   return CB->addSurfString(CV->cellCompStr());
 }
@@ -972,11 +991,8 @@ Simulation::removeComplement(MonteCarlo::Qhull& OB) const
 {
   ELog::RegMethod RegA("Simulation","removeComplement");
 
-  MonteCarlo::Algebra AX;
-
-  AX.setFunctionObjStr(OB.cellStr(OList));
-
-  return OB.procString(AX.writeMCNPX());
+  MonteCarlo::CompExpand CE(OList);
+  return OB.procHeadRule(CE.expand(OB));
 }
 
 
@@ -991,7 +1007,10 @@ Simulation::removeComplements()
   ELog::RegMethod RegA("Simulation","removeComplements");
 
   populateCells();
+  BVHPtr->setInvalid();
   int retVal(0);
+  // expanded cells are shared over the pass
+  MonteCarlo::CompExpand CE(OList);
   OTYPE::iterator vc;
   for(vc=OList.begin();vc!=OList.end();vc++)
     {
@@ -1001,11 +1020,9 @@ Simulation::removeComplements()
         {  
 	  if (workObj.isPopulated())
 	    {
-	      MonteCarlo::Algebra AX;
-	      AX.setFunctionObjStr(workObj.cellStr(OList));
-	      if (!workObj.procString(AX.writeMCNPX()))
+	      if (!workObj.procHeadRule(CE.expand(workObj)))
 		{
-		  ELog::EM<<"Error processing Algebra Complement : "
+		  ELog::EM<<"Error processing Complement : "
 			  <<ELog::endErr;
 		  throw ColErr::ExitAbort(RegA.getFull());
 		}
@@ -1032,7 +1049,7 @@ Simulation::removeNullSurfaces()
     \returns Number of surface removed (will do)
   */
 {
-  
+  BVHPtr->setInvalid();
   ModelSupport::surfIndex& SI=ModelSupport::surfIndex::Instance();
   const ModelSupport::surfIndex::STYPE& SurMap=SI.surMap();
   std::map<int,Geometry::Surface*>::const_iterator sf;
@@ -1069,6 +1086,7 @@ Simulation::populateCells()
 {
   ELog::RegMethod RegA("Simulation","populateCells");
   
+  BVHPtr->setInvalid();
   OTYPE::iterator oc;
 
   int retVal(0);
@@ -1102,6 +1120,7 @@ Simulation::populateCells(const std::vector<int>& cellVec)
 {
   ELog::RegMethod RegA("Simulation","populateCells");
   
+  BVHPtr->setInvalid();
   OTYPE::iterator oc;
 
   for(const int CN : cellVec)
@@ -1155,8 +1174,10 @@ Simulation::applyTransforms()
 {
   
   ELog::RegMethod RegA("Simulation","applyTransforms");
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
+  ModelSupport::surfIndex& SI=ModelSupport::surfIndex::Instance();
+  const ModelSupport::surfIndex::STYPE& SurMap=SI.surMap();
+  // surfaces are changed in place
+  SI.invalidateHash();
   std::map<int,Geometry::Surface*>::const_iterator sm;
   for(sm=SurMap.begin();sm!=SurMap.end();sm++)
     {
@@ -1217,23 +1238,29 @@ Simulation::calcVertex(const int CellN)
 }
 
 void
-Simulation::calcAllVertex()
+Simulation::calcAllVertex(const size_t nThread)
   /*! 
      Calculates the vertexes in the Cell and stores
-     in the Qhull. The number of vertexes found are returned. 
+     in the Qhull. The surface triple intersections are
+     shared between the cells. The cells are taken 
+     in turn by nThread threads.
+     \param nThread :: Number of threads [0/1 serial]
   */
 {
   ELog::RegMethod RegA("Simulation","calcAllVertex");
 
-
-  OTYPE::iterator mc;
-
-  for(mc=OList.begin();mc!=OList.end();mc++)
-    {
-      // This point may be outside of the point
-      if (!mc->second->calcVertex())   
-	mc->second->calcMidVertex();
-    }
+  std::vector<MonteCarlo::Qhull*> QVec;
+  for(const OTYPE::value_type& mc : OList)
+    QVec.push_back(mc.second);
+
+  Geometry::TripleCache TCache;
+  threadSupport::parallelQueue
+    (nThread,QVec.size(),[&](const size_t i)
+     {
+       // This point may be outside of the point
+       if (!QVec[i]->calcVertex(TCache))
+	 QVec[i]->calcMidVertex();
+     });
   return;
 }
 
@@ -1278,6 +1305,40 @@ Simulation::validateObjSurfMap()
   return;
 } 
 
+Simulation::OTYPE&
+Simulation::getCells()
+  /*!
+    Get the cells [non-const]. Rule changes of the cells are
+    picked up by the bounding box tree [ObjBVH::update]
+    \return Cell map
+  */
+{
+  return OList;
+}
+
+void
+Simulation::invalidateCellIndex()
+  /*!
+    Mark the cell bounding box tree as out of date.
+    Required if surfaces are changed without going
+    through the Simulation [cell rule changes are tracked].
+  */
+{
+  BVHPtr->setInvalid();
+  return;
+}
+
+const ModelSupport::ObjBVH&
+Simulation::getCellIndex() const
+  /*!
+    Access the cell bounding box tree [built if required]
+    \return bounding box tree
+  */
+{
+  BVHPtr->update(OList);
+  return *BVHPtr;
+}
+
 void
 Simulation::createObjSurfMap()
   /*! 
@@ -1466,6 +1527,14 @@ Simulation::isValidCell(const int cellNumber,const Geometry::Vec3D& Pt) const
   if (!QH)
     return 0;
 
+  // quick reject on the cell bounding box
+  if (BVHPtr->isValid())
+    {
+      BVHPtr->update(OList);
+      if (!BVHPtr->inBox(cellNumber,Pt))
+	return 0;
+    }
+  
   return QH->isValid(Pt);
 }
 
@@ -1495,6 +1564,10 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
 		     MonteCarlo::Object* testCell) const
   /*! 
     Object that a given the point is in.
+    Cells within a universe are not found [only their
+    filled cell is].
+    Safe for concurrent readers once the cell index has
+    been built [getCellIndex] as the last cell is per thread.
     \param Pt :: Point to find
     \param testCell :: Last Cell (since points often are close together 
     \retval Object ptr
@@ -1513,12 +1586,22 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
   if (curObjPtr && curObjPtr!=testCell 
       && curObjPtr->isValid(Pt))
     return curObjPtr;
-      
-  // now we need to search everthing
+
+  // search the cells whose bounding box contains the point
+  BVHPtr->update(OList);
+  MonteCarlo::Object* OPtr=BVHPtr->findCell(Pt);
+  if (OPtr)
+    {
+      ST.setCell(this,OPtr);
+      return OPtr;
+    }
+  
+  // now we need to search everthing [in case of an out-of-date box]
   OTYPE::const_iterator mpc;
   for(mpc=OList.begin();mpc!=OList.end();mpc++)
     {
       if (!mpc->second->isPlaceHold() &&
+	  !mpc->second->getUniverse() &&
 	  mpc->second->isValid(Pt))
         {
 	  ST.setCell(this,mpc->second);
@@ -1530,6 +1613,37 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
   return 0;
 }
 
+std::vector<const MonteCarlo::Qhull*>
+Simulation::cellVector() const
+  /*!
+    Get the cells in output order [for an indexed write]
+    \return cell pointers
+  */
+{
+  std::vector<const MonteCarlo::Qhull*> OVec;
+  OVec.reserve(OList.size());
+  for(const OTYPE::value_type& OV : OList)
+    OVec.push_back(OV.second);
+  return OVec;
+}
+
+std::vector<const Geometry::Surface*>
+Simulation::surfaceVector() const
+  /*!
+    Get the surfaces in output order [for an indexed write]
+    \return surface pointers
+  */
+{
+  const ModelSupport::surfIndex::STYPE& SurMap =
+    ModelSupport::surfIndex::Instance().surMap();
+
+  std::vector<const Geometry::Surface*> SVec;
+  SVec.reserve(SurMap.size());
+  for(const ModelSupport::surfIndex::STYPE::value_type& SV : SurMap)
+    SVec.push_back(SV.second);
+  return SVec;
+}
+
 void
 Simulation::writeTally(std::ostream& OX) const
   /*!
@@ -1586,11 +1700,10 @@ Simulation::writeCells(std::ostream& OX) const
   OX<<"c -------------------------------------------------------"<<std::endl;
   OX<<"c --------------- CELL CARDS --------------------------"<<std::endl;
   OX<<"c -------------------------------------------------------"<<std::endl;
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    {
-      mp->second->write(OX);
-    }
+  const std::vector<const MonteCarlo::Qhull*> OVec=cellVector();
+  StrFunc::parallelWrite(OX,OVec.size(),writeThread,
+			 [&OVec](std::ostream& cx,const size_t i)
+			 { OVec[i]->write(cx); });
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;  // Empty line manditory for MCNPX
   return;
@@ -1610,14 +1723,10 @@ Simulation::writeSurfaces(std::ostream& OX) const
   OX<<"c --------------- SURFACE CARDS -------------------------"<<std::endl;
   OX<<"c -------------------------------------------------------"<<std::endl;
 
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
-
-  std::map<int,Geometry::Surface*>::const_iterator mp;
-  for(mp=SurMap.begin();mp!=SurMap.end();mp++)
-    {
-      (mp->second)->write(OX);
-    }
+  const std::vector<const Geometry::Surface*> SVec=surfaceVector();
+  StrFunc::parallelWrite(OX,SVec.size(),writeThread,
+			 [&SVec](std::ostream& cx,const size_t i)
+			 { SVec[i]->write(cx); });
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;
   return;
@@ -1803,14 +1912,12 @@ Simulation::writeCinder() const
 
 
 void
-Simulation::write(const std::string& Fname) const
+Simulation::writeDeck(std::ostream& OX) const
   /*!
     Write out all the system (in MCNPX output format)
-    \param Fname :: Output file 
+    \param OX :: Output stream
   */
 {
-  std::ofstream OX(Fname.c_str());
-  
   OX<<"Input File:"<<inputFile<<std::endl;
   StrFunc::writeMCNPXcomment("RunCmd:"+cmdLine,OX);
   writeVariables(OX);
@@ -1821,10 +1928,91 @@ Simulation::write(const std::string& Fname) const
   writeWeights(OX);
   writeTally(OX);
   writePhysics(OX);
+  return;
+}
+
+void
+Simulation::write(const std::string& Fname) const
+  /*!
+    Write out all the system 
+    \param Fname :: Output file 
+  */
+{
+  StrFunc::CardWriter OX(Fname);
+  writeDeck(OX);
   OX.close();
   return;
 }
 
+void
+Simulation::writeMulti(const std::vector<std::string>& Fnames,
+		       const std::vector<long int>& RNDseed) 
+  /*!
+    Write out a set of decks that differ only in the random
+    number seed. The deck is written once to an image and 
+    the position of the seed card is found in it. Each 
+    file is then the image with that card replaced. The 
+    files are written over writeThread threads [set from
+    -nThread, once -writeThread].
+    If the seed card is not in the deck [e.g. POV-Ray] each
+    file is a copy of the image.
+    \param Fnames :: Output files
+    \param RNDseed :: Random number seed of each file
+  */
+{
+  ELog::RegMethod RegA("Simulation","writeMulti");
+
+  if (Fnames.size()!=RNDseed.size())
+    throw ColErr::MisMatch<size_t>(Fnames.size(),RNDseed.size(),
+				   "Fnames/RNDseed");
+  const size_t NFile(Fnames.size());
+  if (!NFile) return;
+
+  PhysPtr->setRND(RNDseed[0]);
+  std::ostringstream cx;
+  writeDeck(cx);
+  const std::string Image=cx.str();
+
+  // seed card : the physics cards are at the end of the deck
+  std::vector<std::string> Cards(NFile);
+  cx.str("");
+  PhysPtr->writeRND(cx);
+  Cards[0]=cx.str();
+  size_t offset=(Cards[0].empty()) ? 
+    std::string::npos : Image.rfind(Cards[0]);
+  size_t cardLen(Cards[0].size());
+  if (offset==std::string::npos)
+    {
+      offset=Image.size();
+      cardLen=0;
+      Cards[0].clear();
+      PhysPtr->setRND(RNDseed.back());
+    }
+  else
+    {
+      for(size_t i=1;i<NFile;i++)
+	{
+	  cx.str("");
+	  PhysPtr->setRND(RNDseed[i]);
+	  PhysPtr->writeRND(cx);
+	  Cards[i]=cx.str();
+	}
+    }
+
+  const char* tailPtr=Image.data()+offset+cardLen;
+  const size_t tailLen=Image.size()-offset-cardLen;
+  threadSupport::parallelQueue
+    (writeThread,NFile,[&](const size_t i)
+     {
+       StrFunc::CardWriter OX(Fnames[i]);
+       OX.write(Image.data(),static_cast<std::streamsize>(offset));
+       OX<<Cards[i];
+       OX.write(tailPtr,static_cast<std::streamsize>(tailLen));
+       OX.close();
+     });
+  return;
+}
+
 void
 Simulation::writeHTape() const
   /*!
@@ -2086,20 +2274,30 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
 
   //Offset index  
   const int cIndex(10000);
+  BVHPtr->setInvalid();
 
   OTYPE newMap;           // New map with correct numbering
+  MapSupport::NumberMap CAll;    // all cells [weights]
+  MapSupport::NumberMap CReal;   // non-placeholder cells
   int nNum(0);
   int index(1);
 
+  std::vector<int> CellN;
+  CellN.reserve(OList.size());
+  for(const OTYPE::value_type& OV : OList)
+    CellN.push_back(OV.second->getName());
+  const std::vector<std::string> KeyVec=OR.inRange(CellN);
+
   std::string oldUnit,keyUnit;
   int startNum(0);
+  size_t cIndexPt(0);
   const attachSystem::CellMap* CMapPtr(0);
   // This is ordered:
   OTYPE::const_iterator vc;  
   for(vc=OList.begin();vc!=OList.end();vc++)
     {
       const int cNum=vc->second->getName();
-      keyUnit=OR.inRange(cNum);
+      keyUnit=KeyVec[cIndexPt++];
       // Determine inf the cell is within cRange:
       size_t j=0;
       while(j<cOffset.size())
@@ -2121,15 +2319,11 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
 	}
       // Do renumber:
       vc->second->setName(nNum);      
-      newMap.insert(OTYPE::value_type(nNum,vc->second));
-      WM.renumberCell(cNum,nNum);
-
+      newMap.insert(newMap.end(),OTYPE::value_type(nNum,vc->second));
+      CAll.addItem(cNum,nNum);
       if (!vc->second->isPlaceHold())
-	{
-	  PhysPtr->substituteCell(cNum,nNum);
-	  for(TallyTYPE::value_type& TI : TItem)
-	    TI.second->renumberCell(cNum,nNum);
-	}
+	CReal.addItem(cNum,nNum);
+
       if (keyUnit!=oldUnit)
 	{
 	  if (startNum)
@@ -2157,7 +2351,15 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
 
   // Last item
   OR.setRenumber(keyUnit,startNum,nNum);
-  OList=newMap;
+  OList.swap(newMap);
+
+  // Apply all the changes at once
+  CAll.sortItems();
+  CReal.sortItems();
+  WM.renumberCells(CAll);
+  PhysPtr->substituteCells(CReal);
+  for(TallyTYPE::value_type& TI : TItem)
+    TI.second->renumberCells(CReal);
   return;
 }
 
@@ -2192,13 +2394,23 @@ Simulation::renumberSurfaces(const std::vector<int>& rLow,
   
   if (SI.calcRenumber(rLow,rHigh,10000,ChangeList))
     {
+      MapSupport::NumberMap SMap;
       std::vector< std::pair<int,int> >::const_iterator dc;
       for(dc=ChangeList.begin();dc!=ChangeList.end();dc++)
 	{
 	  ELog::RN<<"Surf Change:"<<dc->first<<" "<<dc->second<<ELog::endDiag;
 	  SI.renumber(dc->first,dc->second);
-	  substituteAllSurface(dc->first,dc->second);		    
+	  SMap.addItem(dc->first,dc->second);
 	}
+      SMap.sortItems();
+
+      // single pass over each cell/tally/card
+      BVHPtr->setInvalid();
+      for(OTYPE::value_type& OV : OList)
+	OV.second->renumberSurfaces(SMap);
+      for(TallyTYPE::value_type& TI : TItem)
+	TI.second->renumberSurfaces(SMap);
+      PhysPtr->substituteSurfaces(SMap);
     }
   return;
 }
@@ -2268,9 +2480,11 @@ Simulation::masterRotation()
 
   masterRotate& MR = masterRotate::Instance();
   
-  const ModelSupport::surfIndex::STYPE& SurMap=
-    ModelSupport::surfIndex::Instance().surMap();
+  ModelSupport::surfIndex& SI=ModelSupport::surfIndex::Instance();
+  const ModelSupport::surfIndex::STYPE& SurMap=SI.surMap();
 
+  BVHPtr->setInvalid();
+  SI.invalidateHash();
   std::map<int,Geometry::Surface*>::const_iterator sc;
   for(sc=SurMap.begin();sc!=SurMap.end();sc++)
     MR.applyFull(sc->second);
@@ -42,6 +42,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "MapSupport.h"
+#include "NumberMap.h"
 #include "mathSupport.h"
 #include "support.h"
 #include "stringCombine.h"
@@ -296,14 +297,13 @@ Source::cutEnergy(const double Ecut)
 }
 
 void
-Source::substituteCell(const int originalCell,const int newCell)
+Source::substituteCells(const MapSupport::NumberMap& CMap)
   /*!
-    Substitute Cell
-    \param originalCell :: original cell number
-    \param newCell :: new cell number
+    Substitute Cells
+    \param CMap :: Map of old : new cell numbers
   */
 {
-  ELog::RegMethod RegA("Source","substituteCell");
+  ELog::RegMethod RegA("Source","substituteCells");
 
   const char* keyName[2]={"cel","ccc"};
   for(int i=0;i<2;i++)
@@ -312,8 +312,12 @@ Source::substituteCell(const int originalCell,const int newCell)
       if (mc!=sdMap.end()) 
 	{
 	  SrcItem<int>* SI=dynamic_cast< SrcItem<int>* >(mc->second.get());
-	  if (SI && SI->isData() && SI->getData()==originalCell)
-	    SI->setValue(newCell);
+	  if (SI && SI->isData())
+	    {
+	      const int newCell=CMap.convert(SI->getData());
+	      if (newCell!=SI->getData())
+		SI->setValue(newCell);
+	    }
 	}
     }
   return;
@@ -337,6 +341,27 @@ Source::substituteSurface(const int originalSurface,const int newSurface)
   return;
 }
 
+void
+Source::substituteSurfaces(const MapSupport::NumberMap& SMap)
+  /*!
+    Substitute Surfaces
+    \param SMap :: Map of old : new surface numbers
+  */
+{
+  sdMapTYPE::iterator mc=sdMap.find("sur");
+  if (mc!=sdMap.end()) 
+    {
+      SrcItem<int>* SI=dynamic_cast< SrcItem<int>* >(mc->second.get());
+      if (SI && SI->isData())
+	{
+	  const int newSurface=SMap.convert(SI->getData());
+	  if (newSurface!=SI->getData())
+	    SI->setValue(newSurface);
+	}
+    }
+  return;
+}
+
 int
 Source::rotateMaster()
   /*!
@@ -3,7 +3,7 @@
  
  * File:   src/mainJobs.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -71,7 +71,7 @@
 
 int
 createVTK(const mainSystem::inputParam& IParam,
-	  const Simulation* SimPtr,
+	  Simulation* SimPtr,
 	  const std::string& Oname)
   /*!
     Run the VTK box
@@ -99,6 +99,13 @@ createVTK(const mainSystem::inputParam& IParam,
 	  return -1;
 	}
 
+      // scanline tracking needs the surface/object map
+      SimPtr->populateCells();
+      SimPtr->createObjSurfMap();
+      // mesh threads [-nThread : the old -vThread option]
+      const size_t nThread=(IParam.flag("nThread")) ?
+	IParam.getValue<size_t>("nThread") : 0;
+
       const Triple<size_t>& MPts=MPtr->getNPt();
       const Geometry::Vec3D& MeshA=MPtr->getMinPt();
       const Geometry::Vec3D& MeshB=MPtr->getMaxPt();
@@ -108,6 +115,7 @@ createVTK(const mainSystem::inputParam& IParam,
 	  MD5sum MM(60);
 	  MM.setBox(MeshA,MeshB);
 	  MM.setIndex(MPts[0],MPts[1],MPts[2]);
+	  MM.setThreads(nThread);
 	  MM.populate(SimPtr);
 	  return 1;
 	}
@@ -133,6 +141,7 @@ createVTK(const mainSystem::inputParam& IParam,
 	  // PROCESS VTK:
 	  VTK.setBox(MeshA,MeshB);
 	  VTK.setIndex(MPts[0],MPts[1],MPts[2]);
+	  VTK.setThreads(nThread);
 	  VTK.populate(SimPtr,Active);
 	  
 	  VTK.writeVTK(Oname);
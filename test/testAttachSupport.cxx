@@ -3,7 +3,7 @@
  
  * File:   test/testAttachSupport.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,6 +33,7 @@
 #include <sstream>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <tuple>
 
 #include "Exception.h"
@@ -47,6 +48,8 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "Triple.h"
+#include "BoundBox.h"
 #include "Transform.h"
 #include "Surface.h"
 #include "Rules.h"
@@ -60,10 +63,14 @@
 #include "FItem.h"
 #include "FuncDataBase.h"
 #include "ContainedComp.h"
+#include "TripleCache.h"
+#include "InsertCheck.h"
+#include "AttachSupport.h"
 #include "LinkUnit.h"
 #include "FixedComp.h"
 #include "simpleObj.h"
 #include "Simulation.h"
+#include "SurInter.h"
 #include "World.h"
 
 #include "Debug.h"
@@ -73,6 +80,60 @@
 
 using namespace attachSystem;
 
+namespace
+{
+  bool
+  bruteIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
+		 const std::vector<const Geometry::Surface*>& CellSVec)
+    /*!
+      Reference insert test : every surface triple without
+      any box pruning [the original checkIntersect]
+      \param CC :: Contained Component
+      \param CellObj :: Cell Object
+      \param CellSVec :: Cell surfaces
+      \return true if the object needs to be inserted
+    */
+  {
+    const std::vector<Geometry::Surface*> SVec=CC.getSurfaces(); 
+
+    for(size_t iA=0;iA<SVec.size();iA++)
+      for(size_t iB=0;iB<CellSVec.size();iB++)
+	for(size_t iC=iB+1;iC<CellSVec.size();iC++)
+	  for(const Geometry::Vec3D& Pt : SurInter::processPoint
+		(SVec[iA],CellSVec[iB],CellSVec[iC]))
+	    {
+	      std::set<int> boundarySet;
+	      boundarySet.insert(CellSVec[iB]->getName());
+	      boundarySet.insert(CellSVec[iC]->getName());
+	      if (CellObj.isValid(Pt,boundarySet) &&
+		  !CC.isOuterValid(Pt,SVec[iA]->getName()))
+		return 1;
+	    }
+    for(size_t iA=0;iA<SVec.size();iA++)
+      for(size_t iB=iA+1;iB<SVec.size();iB++)
+	for(size_t iC=iB+1;iC<SVec.size();iC++)
+	  for(const Geometry::Vec3D& Pt : SurInter::processPoint
+		(SVec[iA],SVec[iB],SVec[iC]))
+	    if (CellObj.isValid(Pt))
+	      return 1;
+
+    for(size_t iA=0;iA<SVec.size();iA++)
+      for(size_t iB=iA+1;iB<SVec.size();iB++)
+	for(size_t iC=0;iC<CellSVec.size();iC++)
+	  for(const Geometry::Vec3D& Pt : SurInter::processPoint
+		(SVec[iA],SVec[iB],CellSVec[iC]))
+	    {
+	      std::set<int> boundarySet;
+	      boundarySet.insert(SVec[iA]->getName());
+	      boundarySet.insert(SVec[iB]->getName());
+	      if (CellObj.isValid(Pt,CellSVec[iC]->getName()) &&
+		  !CC.isOuterValid(Pt,boundarySet))
+		return 1;
+	    }
+    return 0;
+  }
+}
+
 testAttachSupport::testAttachSupport() 
   /*!
     Constructor
@@ -121,11 +182,13 @@ testAttachSupport::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testAttachSupport::testBoundaryValid,
+      &testAttachSupport::testInsertCheck,
       &testAttachSupport::testInsertComponent
     };
   const std::string TestName[]=
     {
       "BoundaryValid",
+      "InsertCheck",
       "InsertComponent"
     };
   
@@ -198,6 +261,128 @@ testAttachSupport::testBoundaryValid()
   return 0;
 }
 
+int
+testAttachSupport::testInsertCheck()
+  /*!
+    Test the surface intersect of a contained component
+    with a set of cells [direct and over a cell range]
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testAttachSupport","testInsertCheck");
+
+  initSim();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  // Object to insert : 20cm cube
+  SurI.createSurface(1,"px -10");
+  SurI.createSurface(2,"px 10");
+  SurI.createSurface(3,"py -10");
+  SurI.createSurface(4,"py 10");
+  SurI.createSurface(5,"pz -10");
+  SurI.createSurface(6,"pz 10");
+  // Cell cutting the +x face
+  SurI.createSurface(11,"px 0");
+  SurI.createSurface(12,"px 20");
+  SurI.createSurface(13,"py -5");
+  SurI.createSurface(14,"py 5");
+  SurI.createSurface(15,"pz -5");
+  SurI.createSurface(16,"pz 5");
+  // Cell remote in x
+  SurI.createSurface(21,"px 50");
+  SurI.createSurface(22,"px 60");
+  // Cell round the object
+  SurI.createSurface(31,"so 100");
+  // Cell inside the object [no surface cut]
+  SurI.createSurface(41,"s 2 2 2 1");
+  // Cells on the +x face [shares surface 2]
+  SurI.createSurface(54,"py 15");
+  // Cell above the object : holds the triple point [-10,-10,30]
+  // of the redundant object plane 7 [x+z<20] with 1 and 3
+  SurI.createSurface(7,"p 1 0 1 20");
+  SurI.createSurface(61,"px -20");
+  SurI.createSurface(62,"py -20");
+  SurI.createSurface(65,"pz 25");
+  SurI.createSurface(66,"pz 35");
+
+  ASim.addCell(MonteCarlo::Qhull(6001,0,0.0,"11 -12 13 -14 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(6002,0,0.0,"21 -22 13 -14 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(6004,0,0.0,"-31"));
+  ASim.addCell(MonteCarlo::Qhull(6005,0,0.0,"-41"));
+  // face touching : out through +y / outside the face only
+  ASim.addCell(MonteCarlo::Qhull(6011,0,0.0,"11 -2 13 -54 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(6012,0,0.0,"2 -12 13 -14 15 -16"));
+  ASim.addCell(MonteCarlo::Qhull(6013,0,0.0,"61 -11 62 -4 65 -66"));
+
+  ContainedComp CC;
+  CC.addOuterSurf("1 -2 3 -4 5 -6 -7");
+
+  // cell : InsertCheck : reference [all triples]
+  // 6013 is a reference false positive : the triple point is
+  // outside the object box and the object does not reach the cell
+  typedef std::tuple<int,bool,bool> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(6001,1,1),
+      TTYPE(6002,0,0),
+      TTYPE(6004,1,1),
+      TTYPE(6005,0,0),
+      TTYPE(6011,1,1),
+      TTYPE(6012,1,1),
+      TTYPE(6013,0,1)
+    };
+
+  InsertCheck ICheck(CC);
+  for(const TTYPE& tc : Tests)
+    {
+      MonteCarlo::Qhull* QPtr=ASim.findQhull(std::get<0>(tc));
+      QPtr->populate();
+      QPtr->createSurfaceList();
+      const bool flag=ICheck.check(*QPtr,QPtr->getSurList());
+      const bool refFlag=bruteIntersect(CC,*QPtr,QPtr->getSurList());
+      if (flag!=std::get<1>(tc) || refFlag!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Cell "<<std::get<0>(tc)<<" == "<<flag
+		  <<" : "<<refFlag<<ELog::endDiag;
+	  ELog::EM<<"Expected "<<std::get<1>(tc)<<" : "
+		  <<std::get<2>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  // object triples only found once
+  const size_t NCache=ICheck.cacheSize();
+  ICheck.check(*ASim.findQhull(6004),ASim.findQhull(6004)->getSurList());
+  if (!NCache || NCache!=ICheck.cacheSize())
+    {
+      ELog::EM<<"Cache size "<<NCache<<" "<<ICheck.cacheSize()<<ELog::endDiag;
+      return -1;
+    }
+
+  // range form [missing cell 6003] : object excluded from 6001/6004
+  addToInsertSurfCtrl(ASim,6000,6005,CC);
+  typedef std::tuple<int,Geometry::Vec3D,int> VTYPE;
+  const std::vector<VTYPE> VTests=
+    {
+      VTYPE(6001,Geometry::Vec3D(5,0,0),0),
+      VTYPE(6001,Geometry::Vec3D(15,0,0),1),
+      VTYPE(6002,Geometry::Vec3D(55,0,0),1),
+      VTYPE(6004,Geometry::Vec3D(0,0,0),0),
+      VTYPE(6004,Geometry::Vec3D(50,0,0),1)
+    };
+  for(const VTYPE& tc : VTests)
+    {
+      MonteCarlo::Qhull* QPtr=ASim.findQhull(std::get<0>(tc));
+      QPtr->populate();
+      if (QPtr->isValid(std::get<1>(tc))!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Cell "<<*QPtr<<ELog::endDiag;
+	  ELog::EM<<"Point "<<std::get<1>(tc)<<" expected "
+		  <<std::get<2>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testAttachSupport::testInsertComponent()
   /*!
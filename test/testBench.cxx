@@ -0,0 +1,605 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   test/testBench.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <chrono>
+#include <cstdio>
+#include <boost/format.hpp>
+
+#include "Exception.h"
+#include "MersenneTwister.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "stringCombine.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "neutron.h"
+#include "ObjSurfMap.h"
+#include "surfRegister.h"
+#include "objectRegister.h"
+#include "ModelSupport.h"
+#include "Simulation.h"
+#include "LinkUnit.h"
+#include "FixedComp.h"
+#include "ContainedComp.h"
+#include "World.h"
+
+#include "testFunc.h"
+#include "simpleObj.h"
+#include "testBench.h"
+
+testBench::testBench(const std::string& CSV) :
+  csvFile(CSV),ModelName({"cylinder","lattice","simpleObj"}),
+  ModelSize({{4,16,64},{4,8,16},{2,8,32}})
+  /*!
+    Constructor
+    \param CSV :: Results file [empty for none]
+  */
+{}
+
+testBench::~testBench()
+  /*!
+    Destructor
+  */
+{
+  ASim.resetAll();
+  ModelSupport::objectRegister::Instance().reset();
+}
+
+double
+testBench::clockTime()
+  /*!
+    Steady clock time for the timing
+    \return time [ns]
+  */
+{
+  return std::chrono::duration<double,std::nano>
+    (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void
+testBench::initSim()
+  /*!
+    Clear the simulation and create the outer world cells
+    [1 : outside / 74123 : world void]
+  */
+{
+  ASim.resetAll();
+  ModelSupport::objectRegister::Instance().reset();
+  World::createOuterObjects(ASim);
+  return;
+}
+
+size_t
+testBench::buildCylinder(const size_t NCyl)
+  /*!
+    Build nested cylinders. The world cell excludes
+    each cylinder by a cell complement [left unexpanded]
+    \param NCyl :: Number of cylinders
+    \return number of cells
+  */
+{
+  ELog::RegMethod RegA("testBench","buildCylinder");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+
+  std::ostringstream excludeCX;
+  int cellIndex(2);
+  for(size_t i=0;i<NCyl;i++)
+    {
+      const int index(static_cast<int>(i));
+      const double R(2.0*static_cast<double>(i+1));
+      SurI.createSurface(1001+index,"cz "+StrFunc::makeString(R));
+      SurI.createSurface(2001+index,"pz "+StrFunc::makeString(-R));
+      SurI.createSurface(3001+index,"pz "+StrFunc::makeString(R));
+
+      const std::string Out=(i) ?
+	ModelSupport::getComposite(index,"-1001 2001 -3001 "
+				   "(1000 : -2000 : 3000)") :
+	ModelSupport::getComposite(index,"-1001 2001 -3001");
+      ASim.addCell(MonteCarlo::Qhull(cellIndex,(i % 2) ? 3 : 5,0.0,Out));
+      excludeCX<<" #"<<cellIndex++;
+    }
+  ASim.findQhull(74123)->addSurfString(excludeCX.str());
+
+  const double R(2.0*static_cast<double>(NCyl));
+  halfExtent=Geometry::Vec3D(R,R,R)*1.1;
+  return NCyl+2;
+}
+
+size_t
+testBench::buildLattice(const size_t NSide)
+  /*!
+    Build a cube of boxes
+    \param NSide :: Number of boxes on each side
+    \return number of cells
+  */
+{
+  ELog::RegMethod RegA("testBench","buildLattice");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  const ModelSupport::surfRegister SMap;
+
+  const double pitch(10.0);
+  const double halfSide(pitch*static_cast<double>(NSide)/2.0);
+  for(size_t i=0;i<=NSide;i++)
+    {
+      const int index(static_cast<int>(i));
+      const std::string D=
+	StrFunc::makeString(pitch*static_cast<double>(i)-halfSide);
+      SurI.createSurface(1001+index,"px "+D);
+      SurI.createSurface(2001+index,"py "+D);
+      SurI.createSurface(3001+index,"pz "+D);
+    }
+
+  int cellIndex(2);
+  for(size_t i=0;i<NSide;i++)
+    for(size_t j=0;j<NSide;j++)
+      for(size_t k=0;k<NSide;k++)
+	{
+	  const std::string Out=ModelSupport::getComposite
+	    (SMap,static_cast<int>(i),static_cast<int>(j),
+	     static_cast<int>(k),"1001 -1002 2001M -2002M 3001N -3002N");
+	  ASim.addCell(MonteCarlo::Qhull(cellIndex++,((i+j+k) % 2) ? 3 : 5,
+					 0.0,Out));
+	}
+  const int N(static_cast<int>(NSide));
+  ASim.findQhull(74123)->addSurfString
+    (ModelSupport::getComposite(SMap,0,N,
+       " (-1001 : 1001M : -2001 : 2001M : -3001 : 3001M) "));
+
+  halfExtent=Geometry::Vec3D(halfSide,halfSide,halfSide)*1.1;
+  return NSide*NSide*NSide+2;
+}
+
+size_t
+testBench::buildSimpleObj(const size_t NObj)
+  /*!
+    Build a row of simpleObj boxes
+    \param NObj :: Number of objects
+    \return number of cells
+  */
+{
+  ELog::RegMethod RegA("testBench","buildSimpleObj");
+
+  const double step(20.0);
+  const double halfRow(step*static_cast<double>(NObj)/2.0);
+  for(size_t i=0;i<NObj;i++)
+    {
+      testSystem::simpleObj A("benchObj"+StrFunc::makeString(i));
+      A.addInsertCell(74123);
+      A.setMat((i % 2) ? 3 : 5);
+      A.setOffset(Geometry::Vec3D(step*static_cast<double>(i)+
+				  step/2.0-halfRow,0,0));
+      A.createAll(ASim,World::masterOrigin());
+    }
+
+  halfExtent=Geometry::Vec3D(halfRow,10.0,10.0)*1.1;
+  return NObj+2;
+}
+
+size_t
+testBench::buildModel(const size_t modelIndex,const size_t NSize)
+  /*!
+    Reset the simulation and build a model
+    \param modelIndex :: Model type [ModelName]
+    \param NSize :: Model size
+    \return number of cells
+  */
+{
+  ELog::RegMethod RegA("testBench","buildModel");
+
+  initSim();
+  switch (modelIndex)
+    {
+    case 0:
+      return buildCylinder(NSize);
+    case 1:
+      return buildLattice(NSize);
+    case 2:
+      return buildSimpleObj(NSize);
+    default:
+      throw ColErr::IndexError<size_t>(modelIndex,ModelName.size(),
+				       "modelIndex");
+    }
+}
+
+std::vector<Geometry::Vec3D>
+testBench::randomPoints(const size_t NPts) const
+  /*!
+    Points within the model extent [fixed seed]
+    \param NPts :: Number of points
+    \return points
+  */
+{
+  MTRand Rand(12345UL);
+  std::vector<Geometry::Vec3D> Pts;
+  Pts.reserve(NPts);
+  for(size_t i=0;i<NPts;i++)
+    Pts.push_back(Geometry::Vec3D
+		  (halfExtent[0]*(2.0*Rand.randExc()-1.0),
+		   halfExtent[1]*(2.0*Rand.randExc()-1.0),
+		   halfExtent[2]*(2.0*Rand.randExc()-1.0)));
+  return Pts;
+}
+
+void
+testBench::addResult(const std::string& kernel,const std::string& model,
+		     const size_t NSize,const size_t NCells,
+		     const size_t NOps,const double nanoSec,
+		     const double checkSum)
+  /*!
+    Store and report a timing
+    \param kernel :: Kernel name
+    \param model :: Model name
+    \param NSize :: Model size
+    \param NCells :: Number of cells
+    \param NOps :: Number of operations timed
+    \param nanoSec :: Total time [ns]
+    \param checkSum :: Value derived from the results
+  */
+{
+  Results.push_back(BTYPE(kernel,model,NSize,NCells,NOps,nanoSec,checkSum));
+
+  const double nsOp(nanoSec/static_cast<double>(NOps));
+  boost::format FMT("%1$-18s %2$-10s %3$5d %4$7d %5$9d "
+		    "%6$12.1f ns/op %7$12.4g op/s  [%8$.8g]");
+  std::cout<<FMT % kernel % model % NSize % NCells % NOps
+    % nsOp % (1e9/nsOp) % checkSum<<std::endl;
+  return;
+}
+
+void
+testBench::writeResults(const std::string& FName) const
+  /*!
+    Write the results as csv
+    \param FName :: File name
+  */
+{
+  ELog::RegMethod RegA("testBench","writeResults");
+
+  std::ofstream OX(FName.c_str());
+  OX<<"kernel,model,size,cells,ops,ns,nsPerOp,opsPerSec,check"<<std::endl;
+  OX.precision(10);
+  for(const BTYPE& BR : Results)
+    {
+      const double nsOp(std::get<5>(BR)/static_cast<double>(std::get<4>(BR)));
+      OX<<std::get<0>(BR)<<","<<std::get<1>(BR)<<","
+	<<std::get<2>(BR)<<","<<std::get<3>(BR)<<","
+	<<std::get<4>(BR)<<","<<std::get<5>(BR)<<","
+	<<nsOp<<","<<1e9/nsOp<<","<<std::get<6>(BR)<<std::endl;
+    }
+  ELog::EM<<"Benchmark results in "<<FName<<ELog::endDiag;
+  return;
+}
+
+int
+testBench::applyTest(const int extra)
+  /*!
+    Applies all the benchmarks and writes the results
+    [if a results file is set]
+    \param extra :: Benchmark number to run
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testBench","applyTest");
+  TestFunc::regSector("testBench");
+
+  typedef int (testBench::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testBench::benchComposite,
+      &testBench::benchFindCell,
+      &testBench::benchIsValid,
+      &testBench::benchRemoveComplements,
+      &testBench::benchTrackCell,
+      &testBench::benchWrite
+    };
+  const std::string TestName[]=
+    {
+      "Composite",
+      "FindCell",
+      "IsValid",
+      "RemoveComplements",
+      "TrackCell",
+      "Write"
+    };
+
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  Results.clear();
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue)
+	    return retValue;
+	}
+    }
+  if (!csvFile.empty())
+    writeResults(csvFile);
+  return 0;
+}
+
+int
+testBench::benchComposite()
+  /*!
+    Time getComposite on templates of increasing length
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBench","benchComposite");
+
+  const ModelSupport::surfRegister SMap;
+  const std::vector<std::string> Templates=
+    {
+      "1 -2 3 -4 5 -6",
+      "1 -2 3M -4M 5N -6N (-11:12:-13:14) #(21 -22 23M -24M)",
+      "1 -2 3M -4M 5N -6N (-11:12:-13:14) #(21 -22 23M -24M) "
+      "(-31 : 32 : -33M : 34M : -35N : 36N) 41 -42 43 -44 #101 "
+      "(51 -52 : 53M -54M : 55N -56N) 61T -62T 63 -64 65M -66M"
+    };
+  const size_t NOps(100000);
+
+  for(const std::string& TStr : Templates)
+    {
+      size_t NToken(0);
+      std::istringstream cx(ModelSupport::spcDelimString(TStr));
+      std::string Unit;
+      while(cx>>Unit)
+	NToken++;
+
+      double checkSum(0.0);
+      const double startTime=clockTime();
+      for(size_t i=0;i<NOps;i++)
+	{
+	  const int index(static_cast<int>(i % 1000));
+	  checkSum+=static_cast<double>
+	    (ModelSupport::getComposite(SMap,index*10,index*20,
+					index*30,TStr).size());
+	}
+      addResult("getComposite","template",NToken,0,NOps,
+		clockTime()-startTime,checkSum);
+    }
+  return 0;
+}
+
+int
+testBench::benchFindCell()
+  /*!
+    Time Simulation::findCell on random points
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBench","benchFindCell");
+
+  const size_t NPts(20000);
+  for(size_t mIndex=0;mIndex<ModelName.size();mIndex++)
+    for(const size_t NSize : ModelSize[mIndex])
+      {
+	const size_t NCells=buildModel(mIndex,NSize);
+	ASim.removeComplements();
+	const std::vector<Geometry::Vec3D> Pts=randomPoints(NPts);
+	// first call builds the cell index
+	ASim.findCell(Pts.front(),0);
+
+	double checkSum(0.0);
+	const double startTime=clockTime();
+	for(const Geometry::Vec3D& Pt : Pts)
+	  {
+	    const MonteCarlo::Object* OPtr=ASim.findCell(Pt,0);
+	    if (OPtr)
+	      checkSum+=OPtr->getName();
+	  }
+	addResult("findCell",ModelName[mIndex],NSize,NCells,NPts,
+		  clockTime()-startTime,checkSum);
+      }
+  return 0;
+}
+
+int
+testBench::benchIsValid()
+  /*!
+    Time HeadRule::isValid of every cell on random points
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBench","benchIsValid");
+
+  const size_t NPts(1000);
+  for(size_t mIndex=0;mIndex<ModelName.size();mIndex++)
+    for(const size_t NSize : ModelSize[mIndex])
+      {
+	const size_t NCells=buildModel(mIndex,NSize);
+	ASim.removeComplements();
+	const std::vector<Geometry::Vec3D> Pts=randomPoints(NPts);
+
+	std::vector<const HeadRule*> HRVec;
+	for(const Simulation::OTYPE::value_type& OV : ASim.getCells())
+	  HRVec.push_back(&OV.second->getHeadRule());
+
+	double checkSum(0.0);
+	const double startTime=clockTime();
+	for(const Geometry::Vec3D& Pt : Pts)
+	  for(const HeadRule* HR : HRVec)
+	    if (HR->isValid(Pt))
+	      checkSum++;
+	addResult("HeadRule::isValid",ModelName[mIndex],NSize,NCells,
+		  NPts*HRVec.size(),clockTime()-startTime,checkSum);
+      }
+  return 0;
+}
+
+int
+testBench::benchRemoveComplements()
+  /*!
+    Time Simulation::removeComplements over the model
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBench","benchRemoveComplements");
+
+  for(size_t mIndex=0;mIndex<ModelName.size();mIndex++)
+    for(const size_t NSize : ModelSize[mIndex])
+      {
+	const size_t NCells=buildModel(mIndex,NSize);
+
+	const double startTime=clockTime();
+	ASim.removeComplements();
+	const double nanoSec=clockTime()-startTime;
+
+	double checkSum(0.0);
+	for(const Simulation::OTYPE::value_type& OV : ASim.getCells())
+	  checkSum+=static_cast<double>(OV.second->getSurfSet().size());
+	addResult("removeComplements",ModelName[mIndex],NSize,NCells,
+		  NCells,nanoSec,checkSum);
+      }
+  return 0;
+}
+
+int
+testBench::benchTrackCell()
+  /*!
+    Time Object::trackOutCell from random points in
+    random directions
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBench","benchTrackCell");
+
+  const size_t NPts(20000);
+  for(size_t mIndex=0;mIndex<ModelName.size();mIndex++)
+    for(const size_t NSize : ModelSize[mIndex])
+      {
+	const size_t NCells=buildModel(mIndex,NSize);
+	ASim.removeComplements();
+	const std::vector<Geometry::Vec3D> Pts=randomPoints(2*NPts);
+
+	std::vector<const MonteCarlo::Object*> OVec;
+	std::vector<MonteCarlo::neutron> NVec;
+	for(size_t i=0;i<NPts;i++)
+	  {
+	    const MonteCarlo::Object* OPtr=ASim.findCell(Pts[i],0);
+	    const Geometry::Vec3D& uVec=Pts[NPts+i];
+	    if (OPtr && uVec.abs()>Geometry::zeroTol)
+	      {
+		OVec.push_back(OPtr);
+		NVec.push_back(MonteCarlo::neutron(1.0,Pts[i],uVec.unit()));
+	      }
+	  }
+
+	double checkSum(0.0);
+	double aDist;
+	const Geometry::Surface* SPtr;
+	const double startTime=clockTime();
+	for(size_t i=0;i<OVec.size();i++)
+	  {
+	    aDist=0.0;
+	    SPtr=0;
+	    OVec[i]->trackOutCell(NVec[i],aDist,SPtr,0);
+	    if (SPtr)
+	      checkSum+=aDist;
+	  }
+	addResult("Object::trackOutCell",ModelName[mIndex],NSize,NCells,
+		  OVec.size(),clockTime()-startTime,checkSum);
+      }
+  return 0;
+}
+
+int
+testBench::benchWrite()
+  /*!
+    Time Simulation::write of the model. The output
+    is a scratch file removed after each model.
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testBench","benchWrite");
+
+  const std::string scratchFile("Bench.x");
+  const size_t NCellMin(20000);
+  for(size_t mIndex=0;mIndex<ModelName.size();mIndex++)
+    for(const size_t NSize : ModelSize[mIndex])
+      {
+	const size_t NCells=buildModel(mIndex,NSize);
+	ASim.removeComplements();
+	ASim.prepareWrite();
+
+	const size_t NRepeat(std::max<size_t>(1,NCellMin/NCells));
+	const double startTime=clockTime();
+	for(size_t i=0;i<NRepeat;i++)
+	  ASim.write(scratchFile);
+	const double nanoSec=clockTime()-startTime;
+
+	std::ifstream IX(scratchFile.c_str());
+	IX.seekg(0,std::ios::end);
+	const double fileSize(static_cast<double>(IX.tellg()));
+	IX.close();
+	std::remove(scratchFile.c_str());
+	addResult("Simulation::write",ModelName[mIndex],NSize,NCells,
+		  NRepeat*NCells,nanoSec,fileSize);
+      }
+  return 0;
+}
@@ -81,6 +81,7 @@ testFunction::applyTest(const int extra)
       &testFunction::testAnalyse,
       &testFunction::testBuiltIn,
       &testFunction::testCopyVarSet,
+      &testFunction::testDepend,
       &testFunction::testEval,
       &testFunction::testString, 
       &testFunction::testVariable,
@@ -93,6 +94,7 @@ testFunction::applyTest(const int extra)
       "Analyse",
       "BuiltIn",
       "CopyVarSet",
+      "Depend",
       "Eval",
       "String",
       "Variable",
@@ -232,6 +234,69 @@ testFunction::testCopyVarSet()
   return 0;
 }
 
+int
+testFunction::testDepend()
+  /*!
+    Test that a change in a variable is seen by
+    the [cached] functions that depend on it
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testFunction","testDepend");
+
+  FuncDataBase XX;
+
+  XX.addVariable("alpha",2.0);
+  XX.addVariable("beta",10.0);
+  XX.Parse("alpha*3");
+  XX.addVariable("Bval");
+  XX.Parse("Bval+1");
+  XX.addVariable("Cval");
+  XX.Parse("beta-1");
+  XX.addVariable("Dval");
+
+  // Variable set : value : C : D
+  typedef std::tuple<std::string,double,double,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("",0.0,7.0,9.0),
+      TTYPE("alpha",4.0,13.0,9.0),
+      TTYPE("beta",1.0,13.0,0.0),
+      TTYPE("alpha",-1.0,-2.0,0.0)
+    };
+  
+  for(const TTYPE& tc : Tests)
+    {
+      if (!std::get<0>(tc).empty())
+	XX.setVariable(std::get<0>(tc),std::get<1>(tc));
+      // read twice : second from cache
+      for(size_t i=0;i<2;i++)
+	{
+	  const double C=XX.EvalVar<double>("Cval");
+	  const double D=XX.EvalVar<double>("Dval");
+	  if (std::abs(C-std::get<2>(tc))>Geometry::zeroTol ||
+	      std::abs(D-std::get<3>(tc))>Geometry::zeroTol)
+	    {
+	      ELog::EM<<"Set "<<std::get<0>(tc)<<" = "
+		      <<std::get<1>(tc)<<ELog::endDiag;
+	      ELog::EM<<"C/D == "<<C<<" "<<D<<" != "<<std::get<2>(tc)
+		      <<" "<<std::get<3>(tc)<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+    }
+  
+  // replace a mid-level function
+  XX.Parse("alpha*alpha");
+  XX.setVariable("Bval");
+  const double C=XX.EvalVar<double>("Cval");
+  if (std::abs(C-2.0)>Geometry::zeroTol)
+    {
+      ELog::EM<<"C == "<<C<<" != 2.0"<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
 
 int
 testFunction::testEval()
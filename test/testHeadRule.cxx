@@ -48,6 +48,7 @@
 #include "Matrix.h"
 #include "Vec3D.h"
 #include "support.h"
+#include "NumberMap.h"
 #include "Surface.h"
 #include "Rules.h"
 #include "RuleBinary.h"
@@ -127,6 +128,7 @@ testHeadRule::applyTest(const int extra)
       &testHeadRule::testLevel,
       &testHeadRule::testPartEqual,
       &testHeadRule::testRemoveSurf,
+      &testHeadRule::testRenumberSurfaces,
       &testHeadRule::testReplacePart,
       &testHeadRule::testSurfSet
     };
@@ -143,6 +145,7 @@ testHeadRule::applyTest(const int extra)
       "Level",
       "PartEqual",
       "RemoveSurf",      
+      "RenumberSurfaces",
       "ReplacePart",      
       "SurfSet"
     };
@@ -736,6 +739,46 @@ testHeadRule::testRemoveSurf()
   return 0;
 }
 
+int
+testHeadRule::testRenumberSurfaces()
+  /*!
+    Check that all the surfaces are renumbered at once
+    [including a swap of two surfaces]
+    \return 0 :: success / -ve on error
+   */
+{
+  ELog::RegMethod RegA("testHeadRule","testRenumberSurfaces");
+
+  MapSupport::NumberMap SMap;
+  SMap.addItem(6,2);
+  SMap.addItem(1,11);
+  SMap.addItem(2,6);
+  SMap.addItem(4,14);
+  SMap.sortItems();
+
+  typedef std::tuple<std::string,std::string,int> TTYPE;
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE("1 -2 ","11 -6",2));
+  Tests.push_back(TTYPE("1 -2 (3:-4) #(5 6)","11 -6 (3:-14) #(5 2)",4));
+  Tests.push_back(TTYPE("3 5 ","3 5",0));
+
+  for(const TTYPE& tc : Tests)
+    {
+      HeadRule A(std::get<0>(tc));
+      const HeadRule B(std::get<1>(tc));
+      const int cnt=A.renumberSurfaces(SMap);
+      if (cnt!=std::get<2>(tc) || A.display()!=B.display())
+	{
+	  ELog::EM<<"Failed on test "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"A   == "<<A.display()<<ELog::endDiag;
+	  ELog::EM<<"B   == "<<B.display()<<ELog::endDiag;
+	  ELog::EM<<"cnt == "<<cnt<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testHeadRule::testSurfSet()
   /*!
@@ -0,0 +1,385 @@
+ /********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testLayerDivide3D.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "Rules.h"
+#include "surfIndex.h"
+#include "surfRegister.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "Simulation.h"
+#include "ModelSupport.h"
+#include "LinkUnit.h"
+#include "FixedComp.h"
+#include "BaseMap.h"
+#include "CellMap.h"
+#include "SurfMap.h"
+#include "LayerDivide3D.h"
+
+#include "testFunc.h"
+#include "testLayerDivide3D.h"
+
+using namespace ModelSupport;
+
+testLayerDivide3D::testLayerDivide3D() 
+  /*!
+    Constructor
+  */
+{}
+
+testLayerDivide3D::~testLayerDivide3D() 
+  /*!
+    Destructor
+  */
+{}
+
+void
+testLayerDivide3D::initSim()
+  /*!
+    Set all the objects in the simulation:
+  */
+{
+  ELog::RegMethod RegA("testLayerDivide3D","initSim");
+
+  ASim.resetAll();
+  createSurfaces();
+  createObjects();
+  return;
+}
+
+void 
+testLayerDivide3D::createSurfaces()
+  /*!
+    Create the surface list
+   */
+{
+  ELog::RegMethod RegA("testLayerDivide3D","createSurfaces");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  
+  // Box to divide : 6x4x2
+  SurI.createSurface(1,"px 0");
+  SurI.createSurface(2,"px 6");
+  SurI.createSurface(3,"py 0");
+  SurI.createSurface(4,"py 4");
+  SurI.createSurface(5,"pz 0");
+  SurI.createSurface(6,"pz 2");
+
+  // Sphere :
+  SurI.createSurface(100,"so 25");
+  
+  return;
+}
+  
+void
+testLayerDivide3D::createObjects()
+  /*!
+    Create Object for test
+  */
+{
+  std::string Out;
+  const int surIndex(0);
+  Out=ModelSupport::getComposite(surIndex,"100");
+  ASim.addCell(MonteCarlo::Qhull(1,0,0.0,Out));      // Outside void
+
+  Out=ModelSupport::getComposite(surIndex,"1 -2 3 -4 5 -6");
+  ASim.addCell(MonteCarlo::Qhull(2,5,0.0,Out));      // Al box
+
+  Out=ModelSupport::getComposite(surIndex,"-100 (-1:2:-3:4:-5:6)");
+  ASim.addCell(MonteCarlo::Qhull(3,0,0.0,Out));      // Void
+  
+  return;
+}
+
+int 
+testLayerDivide3D::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \retval -1 : SetObject 
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testLayerDivide3D","applyTest");
+  TestFunc::regSector("testLayerDivide3D");
+
+  typedef int (testLayerDivide3D::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testLayerDivide3D::testExplicit,
+      &testLayerDivide3D::testLattice
+    };
+  const std::string TestName[]=
+    {
+      "Explicit",
+      "Lattice"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+	std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+      std::cout.flags(flagIO);
+      return 0;
+    }
+
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testLayerDivide3D::testExplicit()
+  /*!
+    Test that uneven layers in lattice mode fall back
+    to a cell for each element
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testLayerDivide3D","testExplicit");
+
+  initSim();
+
+  LayerDivide3D LD3("testLD3Explicit");
+  LD3.setSurfPair(0,1,2);
+  LD3.setSurfPair(1,3,4);
+  LD3.setSurfPair(2,5,6);
+  LD3.setFractions(0,std::vector<double>({0.2,0.7}));
+  LD3.setFractions(1,std::vector<double>({0.5}));
+  LD3.setFractions(2,std::vector<double>());
+  LD3.setMaterials(0,{"Void","Aluminium","H2O"});
+  LD3.setLattice(1);
+  LD3.divideCell(ASim,2);
+
+  // element : mid point
+  typedef std::tuple<size_t,size_t,Geometry::Vec3D> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(0,0,Geometry::Vec3D(0.6,1,1)),
+      TTYPE(1,0,Geometry::Vec3D(2.7,1,1)),
+      TTYPE(2,1,Geometry::Vec3D(5.1,3,1))
+    };
+  
+  if (ASim.findQhull(2))
+    {
+      ELog::EM<<"Divided cell not removed"<<ELog::endDiag;
+      return -1;
+    }
+  for(const TTYPE& tc : Tests)
+    {
+      const size_t i(std::get<0>(tc));
+      const size_t j(std::get<1>(tc));
+      const std::string CRef=LD3.getCellRef(i,j,0);
+      int CN(0);
+      MonteCarlo::Qhull* QPtr=(StrFunc::convert(CRef,CN)) ?
+	ASim.findQhull(CN) : 0;
+      if (!QPtr)
+	{
+	  ELog::EM<<"Cell ref["<<i<<" "<<j<<"] == "<<CRef<<ELog::endDiag;
+	  return -2;
+	}
+      QPtr->populate();
+      if (!QPtr->isValid(std::get<2>(tc)) || QPtr->getMat()!=
+	  ((i==0) ? 0 : (i==1) ? 5 : 11))
+	{
+	  ELog::EM<<"Cell "<<*QPtr<<ELog::endDiag;
+	  ELog::EM<<"Point "<<std::get<2>(tc)<<ELog::endDiag;
+	  return -3;
+	}
+    }
+  // layer names : [B x C] cells each
+  if (LD3.getCells("LD3:1").size()!=2)
+    {
+      ELog::EM<<"Layer cells LD3:1 == "<<LD3.getCells("LD3:1").size()
+	      <<ELog::endDiag;
+      return -4;
+    }
+  return 0;
+}
+
+int
+testLayerDivide3D::testLattice()
+  /*!
+    Test the division of a box as a lattice. The faces of
+    element [0,0,0] must be in index order [+i,-i,+j,-j,+k,-k].
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testLayerDivide3D","testLattice");
+
+  initSim();
+
+  LayerDivide3D LD3("testLD3Lattice");
+  LD3.setSurfPair(0,1,2);
+  LD3.setSurfPair(1,3,4);
+  LD3.setSurfPair(2,5,6);
+  LD3.setFractions(0,std::vector<double>({1.0/3.0,2.0/3.0}));
+  LD3.setFractions(1,std::vector<double>({0.5}));
+  LD3.setFractions(2,std::vector<double>());
+  LD3.setMaterials(0,{"Void","Aluminium","H2O"});
+  LD3.setLattice(1);
+  LD3.divideCell(ASim,2);
+
+  const int LCN=LD3.getCell("LD3Lattice");
+  MonteCarlo::Qhull* LPtr=ASim.findQhull(LCN);
+  const MonteCarlo::Qhull* FPtr=ASim.findQhull(2);
+  if (!LPtr || !FPtr || FPtr->getFill()!=LCN || FPtr->getMat())
+    {
+      ELog::EM<<"Lattice cell "<<LCN<<" not filled into cell 2"
+	      <<ELog::endDiag;
+      return -1;
+    }
+
+  // universe [cell] of each layer material
+  std::vector<int> UCell;
+  for(size_t i=0;i<3;i++)
+    {
+      const std::string CRef=LD3.getCellRef(i,1,0);
+      std::istringstream cx(CRef);
+      std::string bracket;
+      int CN(0);
+      cx>>bracket>>CN;
+      std::ostringstream ex;
+      ex<<"( "<<CN<<" < "<<LCN<<"["<<i<<" 1 0] < 2 )";
+      const MonteCarlo::Qhull* UPtr=ASim.findQhull(CN);
+      if (CRef!=ex.str() || !UPtr || UPtr->getUniverse()!=CN ||
+	  UPtr->getMat()!=((i==0) ? 0 : (i==1) ? 5 : 11))
+	{
+	  ELog::EM<<"Cell ref["<<i<<" 1 0] == "<<CRef<<ELog::endDiag;
+	  ELog::EM<<"Expect        == "<<ex.str()<<ELog::endDiag;
+	  return -2;
+	}
+      UCell.push_back(CN);
+    }
+
+  // universes are shared between layers : no layer names
+  if (!LD3.getCells("LD3:0").empty() ||
+      LD3.getCells("LD3Universe").size()!=3)
+    {
+      ELog::EM<<"Layer cells in lattice mode"<<ELog::endDiag;
+      return -6;
+    }
+
+  LPtr->populate();
+  std::ostringstream cx;
+  LPtr->write(cx);
+  const std::string Card=StrFunc::singleLine(cx.str());
+  const size_t uPos=Card.find(" u=");
+
+  std::ostringstream ex;
+  ex<<" u="<<LCN<<" lat=1 fill=0:2 0:1 0:0";
+  for(size_t j=0;j<2;j++)
+    for(const int U : UCell)
+      ex<<" "<<U;
+  if (uPos==std::string::npos || Card.substr(uPos)!=ex.str())
+    {
+      ELog::EM<<"Card   == "<<Card<<ELog::endDiag;
+      ELog::EM<<"Expect == ... "<<ex.str()<<ELog::endDiag;
+      return -3;
+    }
+
+  // faces of element [0,0,0] : outward normal / plane position
+  typedef std::tuple<Geometry::Vec3D,double> FTYPE;
+  const std::vector<FTYPE> Faces=
+    {
+      FTYPE(Geometry::Vec3D(1,0,0),2.0),
+      FTYPE(Geometry::Vec3D(-1,0,0),0.0),
+      FTYPE(Geometry::Vec3D(0,1,0),2.0),
+      FTYPE(Geometry::Vec3D(0,-1,0),0.0),
+      FTYPE(Geometry::Vec3D(0,0,1),2.0),
+      FTYPE(Geometry::Vec3D(0,0,-1),0.0)
+    };
+  
+  const ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  std::istringstream fx(Card.substr(0,uPos));
+  int CN,Mat,SN;
+  fx>>CN>>Mat;
+  for(const FTYPE& tc : Faces)
+    {
+      const Geometry::Plane* PPtr=(fx>>SN) ? 
+	dynamic_cast<const Geometry::Plane*>(SurI.getSurf(std::abs(SN))) : 0;
+      if (!PPtr)
+	{
+	  ELog::EM<<"Card == "<<Card<<ELog::endDiag;
+	  return -4;
+	}
+      const int sign((SN>0) ? 1 : -1);
+      const Geometry::Vec3D OutNorm=PPtr->getNormal()*(-sign);
+      const double D=PPtr->getDistance()*std::get<0>(tc).dotProd
+	(PPtr->getNormal());
+      if (OutNorm!=std::get<0>(tc) || 
+	  std::abs(D-std::get<1>(tc))>Geometry::zeroTol)
+	{
+	  ELog::EM<<"Card == "<<Card<<ELog::endDiag;
+	  ELog::EM<<"Face "<<SN<<" == "<<OutNorm<<" : "<<D<<ELog::endDiag;
+	  ELog::EM<<"Expect "<<std::get<0>(tc)<<" : "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  return -5;
+	}
+    }
+  return 0;
+}
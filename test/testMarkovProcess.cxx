@@ -0,0 +1,397 @@
+ /********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testMarkovProcess.cxx
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <boost/multi_array.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "Rules.h"
+#include "surfIndex.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ObjSurfMap.h"
+#include "Simulation.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "Mesh3D.h"
+#include "WWG.h"
+#include "MarkovProcess.h"
+
+#include "testFunc.h"
+#include "testMarkovProcess.h"
+
+using namespace WeightSystem;
+
+namespace
+{
+  const double r2Length(1.5);    ///< Length scale of the test
+  const double r2Power(2.0);     ///< Power of the test
+  const double cutValue(-1.9);   ///< Drops pairs beyond ~3.9cm
+
+  typedef std::vector<std::vector<double>> DENSE;
+
+  DENSE
+  denseMatrix(const std::vector<Geometry::Vec3D>& Pts)
+    /*!
+      Build the expected matrix for a void system
+      \param Pts :: Mesh mid points
+      \return full matrix [unit diagonal]
+     */
+  {
+    DENSE M(Pts.size(),std::vector<double>(Pts.size(),0.0));
+    for(size_t i=0;i<Pts.size();i++)
+      {
+	M[i][i]=1.0;
+	for(size_t j=0;j<Pts.size();j++)
+	  if (i!=j)
+	    {
+	      const double D=std::max(1.0,Pts[i].Distance(Pts[j])/r2Length);
+	      const double R= -r2Power*log(D);
+	      if (R>cutValue)
+		M[i][j]=exp(R);
+	    }
+      }
+    return M;
+  }
+
+  void
+  denseIterate(const DENSE& M,std::vector<double>& V,const size_t N)
+    /*!
+      Apply M to V, N times [max scaled to unity]
+      \param M :: Matrix
+      \param V :: Vector / result
+      \param N :: Number of steps
+     */
+  {
+    for(size_t n=0;n<N;n++)
+      {
+	std::vector<double> Out(V.size(),0.0);
+	for(size_t i=0;i<V.size();i++)
+	  for(size_t j=0;j<V.size();j++)
+	    Out[i]+=M[i][j]*V[j];
+	const double maxV= *std::max_element(Out.begin(),Out.end());
+	for(size_t i=0;i<V.size();i++)
+	  V[i]=Out[i]/maxV;
+      }
+    return;
+  }
+}
+
+testMarkovProcess::testMarkovProcess() 
+  /*!
+    Constructor
+  */
+{
+  initSim();
+}
+
+testMarkovProcess::~testMarkovProcess() 
+  /*!
+    Destructor
+  */
+{}
+
+void
+testMarkovProcess::initSim()
+  /*!
+    Set all the objects in the simulation:
+  */
+{
+  ASim.resetAll();
+  createSurfaces();
+  createObjects();
+  ASim.createObjSurfMap();
+  return;
+}
+
+void 
+testMarkovProcess::createSurfaces()
+  /*!
+    Create the surface list
+   */
+{
+  ELog::RegMethod RegA("testMarkovProcess","createSurfaces");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  
+  // Sphere :
+  SurI.createSurface(100,"so 25");
+  
+  return;
+}
+  
+void
+testMarkovProcess::createObjects()
+  /*!
+    Create Object for test
+  */
+{
+  std::string Out;
+  int cellIndex(1);
+  const int surIndex(0);
+  Out=ModelSupport::getComposite(surIndex,"100");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Outside void
+
+  Out=ModelSupport::getComposite(surIndex,"-100");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Void
+  
+  ASim.removeComplements();
+
+  return;
+}
+
+void
+testMarkovProcess::createMesh(WWG& wSet) const
+  /*!
+    Set a 3x2x2 mesh of 2cm cells on the WWG
+    \param wSet :: WWG to set
+  */
+{
+  wSet.getGrid().setMesh({0.0,6.0},{3},{0.0,4.0},{2},{0.0,4.0},{2});
+  wSet.calcGridMidPoints();
+  wSet.setEnergyBin({1.0,10.0,100.0},{1.0,1.0,1.0});
+  return;
+}
+
+int 
+testMarkovProcess::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \retval -1 : SetObject 
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","applyTest");
+  TestFunc::regSector("testMarkovProcess");
+
+  typedef int (testMarkovProcess::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testMarkovProcess::testComputeMatrix,
+      &testMarkovProcess::testMultiplyOut,
+      &testMarkovProcess::testPowerIterate
+    };
+  const std::string TestName[]=
+    {
+      "ComputeMatrix",
+      "MultiplyOut",
+      "PowerIterate"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+	std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+      std::cout.flags(flagIO);
+      return 0;
+    }
+
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testMarkovProcess::testComputeMatrix()
+  /*!
+    Test the compressed matrix [threaded and not] 
+    against the dense matrix of a void system
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","testComputeMatrix");
+
+  WWG wSet;
+  createMesh(wSet);
+  const DENSE M=denseMatrix(wSet.getMidPoints());
+  const long int NPts(static_cast<long int>(M.size()));
+
+  size_t nDense(0);
+  for(const std::vector<double>& Row : M)
+    nDense+=static_cast<size_t>
+      (std::count_if(Row.begin(),Row.end(),
+		     [](const double V) { return V>0.0; }));
+  
+  const std::vector<size_t> Threads({1,3});
+  for(const size_t nT : Threads)
+    {
+      MarkovProcess MP;
+      MP.setThreads(nT);
+      MP.setCut(cutValue);
+      MP.initializeData(wSet);
+      MP.computeMatrix(ASim,wSet,0.0,r2Length,r2Power);
+
+      if (MP.nonZero()!=nDense || nDense==M.size()*M.size())
+	{
+	  ELog::EM<<"Threads == "<<nT<<ELog::endDiag;
+	  ELog::EM<<"NonZero == "<<MP.nonZero()<<" ["<<nDense<<"]"
+		  <<ELog::endDiag;
+	  return -1;
+	}
+      for(long int i=0;i<NPts;i++)
+	for(long int j=0;j<NPts;j++)
+	  {
+	    const double V=M[static_cast<size_t>(i)][static_cast<size_t>(j)];
+	    if (std::abs(MP.getItem(i,j)-V)>1e-10 ||
+		std::abs(MP.getItem(i,j)-MP.getItem(j,i))>1e-10)
+	      {
+		ELog::EM<<"Threads == "<<nT<<ELog::endDiag;
+		ELog::EM<<"M["<<i<<"]["<<j<<"] == "<<MP.getItem(i,j)
+			<<" : "<<MP.getItem(j,i)<<" ["<<V<<"]"<<ELog::endDiag;
+		return -2;
+	      }
+	  }
+    }
+  return 0;
+}
+
+int
+testMarkovProcess::testPowerIterate()
+  /*!
+    Test the power iteration for a fixed number of 
+    steps and to convergence against the dense matrix
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","testPowerIterate");
+
+  WWG wSet;
+  createMesh(wSet);
+  const DENSE M=denseMatrix(wSet.getMidPoints());
+
+  MarkovProcess MP;
+  MP.setCut(cutValue);
+  MP.initializeData(wSet);
+  MP.computeMatrix(ASim,wSet,0.0,r2Length,r2Power);
+
+  // Fixed steps : no early stop with zero tolerance
+  std::vector<double> V(M.size()),DV(M.size());
+  for(size_t i=0;i<V.size();i++)
+    V[i]=DV[i]=1.0+static_cast<double>(i % 5);
+  MP.setIterations(3);
+  const size_t nA=MP.powerIterate(V,0.0);
+  denseIterate(M,DV,3);
+  for(size_t i=0;i<V.size();i++)
+    if (nA!=3 || std::abs(V[i]-DV[i])>1e-10)
+      {
+	ELog::EM<<"Steps == "<<nA<<ELog::endDiag;
+	ELog::EM<<"V["<<i<<"] == "<<V[i]<<" ["<<DV[i]<<"]"<<ELog::endDiag;
+	return -1;
+      }
+
+  // Converged : principle eigenvector
+  MP.setIterations(1000);
+  const std::vector<double> IV=MP.importance(1e-10);
+  DV=std::vector<double>(M.size(),1.0);
+  denseIterate(M,DV,1000);
+  for(size_t i=0;i<IV.size();i++)
+    if (std::abs(IV[i]-DV[i])>1e-8)
+      {
+	ELog::EM<<"I["<<i<<"] == "<<IV[i]<<" ["<<DV[i]<<"]"<<ELog::endDiag;
+	return -2;
+      }
+  return 0;
+}
+
+int
+testMarkovProcess::testMultiplyOut()
+  /*!
+    Test that each energy bin is scaled by the importance
+    and the energy dependence of the mesh is kept
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","testMultiplyOut");
+
+  WWG wSet;
+  createMesh(wSet);
+
+  MarkovProcess MP;
+  MP.setCut(cutValue);
+  MP.setIterations(1000);
+  MP.initializeData(wSet);
+  MP.computeMatrix(ASim,wSet,0.0,r2Length,r2Power);
+  const std::vector<double> IV=MP.importance(1e-6);
+
+  boost::multi_array<double,4>& WMesh=wSet.getMesh();
+  const size_t NE(WMesh.shape()[3]);
+  double* WData=WMesh.data();
+  std::vector<double> Init(WMesh.num_elements());
+  for(size_t i=0;i<Init.size();i++)
+    Init[i]=WData[i]=static_cast<double>((i/NE) % 7 + 1)*
+      static_cast<double>(1+(i % NE)*10);
+
+  MP.multiplyOut(wSet);
+
+  for(size_t i=0;i<Init.size();i++)
+    if (std::abs(WData[i]-Init[i]*IV[i/NE])>1e-10)
+      {
+	ELog::EM<<"W["<<i/NE<<"]["<<i%NE<<"] == "<<WData[i]
+		<<" ["<<Init[i]*IV[i/NE]<<"]"<<ELog::endDiag;
+	return -1;
+      }
+  return 0;
+}
@@ -3,7 +3,7 @@
  
  * File:   test/testModelSupport.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -57,6 +57,7 @@
 #include "Object.h"
 #include "Qhull.h"
 #include "ModelSupport.h"
+#include "CompTemplate.h"
 
 #include "testFunc.h"
 #include "testModelSupport.h"
@@ -91,10 +92,12 @@ testModelSupport::applyTest(const int extra)
   typedef int (testModelSupport::*testPtr)();
   testPtr TPtr[]=
     {
+      &testModelSupport::testCompTemplate,
       &testModelSupport::testRemoveOpenPair
     };
   const std::string TestName[]=
     {
+      "CompTemplate",
       "RemoveOpenPair",
     };
   
@@ -122,6 +125,67 @@ testModelSupport::applyTest(const int extra)
   return 0;
 }
 
+int
+testModelSupport::testCompTemplate()
+  /*!
+    Test that the template rule matches the processed
+    getComposite string
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testModelSupport","testCompTemplate");
+
+  ModelSupport::surfRegister SMap;
+  SMap.addMatch(103,7);
+  SMap.addMatch(1004,12);
+
+  typedef std::tuple<std::string,int,int,int,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("1 -2 3 -4",100,0,0," 101 -102 7 -104 "),
+      TTYPE("1 -2 (3:-4M) 5T",100,1000,0," 101 -102 ( 7 : -12 ) 5 "),
+      TTYPE("1 #(3 -4N) : 6",100,0,1000," 101 # ( 7 -12 ) : 106 "),
+      TTYPE("-1 #12 3N",-100,0,2000," 101 #12 2003 "),
+      TTYPE("1 (2:3",100,0,0," 101 ( 102 : 7 ")
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const ModelSupport::CompTemplate& CT=
+	ModelSupport::CompTemplate::getTemplate(std::get<0>(tc));
+      const std::string Res=CT.makeString(SMap,std::get<1>(tc),
+					  std::get<2>(tc),std::get<3>(tc));
+      HeadRule AR;
+      AR.procString(Res);
+      const HeadRule BR=CT.makeRule(SMap,std::get<1>(tc),
+				    std::get<2>(tc),std::get<3>(tc));
+      if (Res!=std::get<4>(tc) || AR.display()!=BR.display())
+	{
+	  ELog::EM<<"Template == "<<std::get<0>(tc)<<ELog::endTrace;
+	  ELog::EM<<"Result   == :"<<Res<<":"<<ELog::endTrace;
+	  ELog::EM<<"Expect   == :"<<std::get<4>(tc)<<":"<<ELog::endTrace;
+	  ELog::EM<<"String   == "<<AR.display()<<ELog::endTrace;
+	  ELog::EM<<"Rule     == "<<BR.display()<<ELog::endTrace;
+	  return -1;
+	}
+    }
+  // cache : same template same object
+  if (&ModelSupport::CompTemplate::getTemplate("1 -2 3 -4")!=
+      &ModelSupport::CompTemplate::getTemplate("1 -2 3 -4"))
+    {
+      ELog::EM<<"Template not cached"<<ELog::endDiag;
+      return -2;
+    }
+  // run time template : not cached but the same string
+  if (ModelSupport::getDynamicComposite(SMap,100,"1 -2 (3:-4) 5T")!=
+      ModelSupport::getComposite(SMap,100,"1 -2 (3:-4) 5T"))
+    {
+      ELog::EM<<"Dynamic template == "<<ModelSupport::getDynamicComposite
+	(SMap,100,"1 -2 (3:-4) 5T")<<ELog::endDiag;
+      return -3;
+    }
+  return 0;
+}
 
 int
 testModelSupport::testRemoveOpenPair()
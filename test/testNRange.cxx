@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <tuple>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -78,14 +79,16 @@ testNRange::applyTest(const int extra)
       &testNRange::testCondense,
       &testNRange::testOperator,
       &testNRange::testOutput,
-      &testNRange::testRange
+      &testNRange::testRange,
+      &testNRange::testSetCondensed
     };
   const std::string TestName[]=
     {
       "Condense",
       "Operator",
       "Output",
-      "Range"
+      "Range",
+      "SetCondensed"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -293,3 +296,38 @@ testNRange::testRange()
   return 0;
 }
 
+int
+testNRange::testSetCondensed()
+  /*!
+    Test the one pass condense of a vector
+    \retval -1 :: failed to condense
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testNRange","testSetCondensed");
+
+  typedef std::tuple<std::vector<double>,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE({5.0},"5"),
+      TTYPE({1.0,1.0,1.0,1.0},"1 3r"),
+      TTYPE({1.0,2.0,4.0,8.0,16.0},"1 3log 16"),
+      TTYPE({0.001,0.001,0.0,0.0,0.0,0.0,1.0},"0.001 0.001 0 3r 1"),
+      TTYPE({0.5,1.0,1.0,0.0,0.0},"0.5 1 1 0 0")
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      NRange NE;
+      NE.setCondensed(std::get<0>(tc));
+      std::ostringstream cx;
+      cx<<NE;
+      if (StrFunc::fullBlock(cx.str())!=std::get<1>(tc))
+	{
+	  ELog::EM<<"Expected == "<<std::get<1>(tc)<<ELog::endDiag;
+	  ELog::EM<<"NE       == "<<NE<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
@@ -3,7 +3,7 @@
  
  * File:   test/testObject.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,6 +33,7 @@
 #include <sstream>
 #include <algorithm>
 #include <tuple>
+#include <mutex>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -46,6 +47,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "Triple.h"
 #include "Transform.h"
 #include "Surface.h"
 #include "Rules.h"
@@ -57,6 +59,9 @@
 #include "HeadRule.h"
 #include "Object.h"
 #include "Qhull.h"
+#include "SurInter.h"
+#include "TripleCache.h"
+#include "CompExpand.h"
 #include "neutron.h"
 
 #include "Debug.h"
@@ -179,10 +184,15 @@ testObject::applyTest(const int extra)
   typedef int (testObject::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObject::testAddIntersection,
+      &testObject::testCalcVertex,
       &testObject::testCellStr,
+      &testObject::testCompExpand,
       &testObject::testComplement,
+      &testObject::testCompiledRule,
       &testObject::testIsValid,
       &testObject::testIsOnSide,
+      &testObject::testLattice,
       &testObject::testMakeComplement,
       &testObject::testRemoveComplement,
       &testObject::testSetObject,
@@ -191,10 +201,15 @@ testObject::applyTest(const int extra)
     };
   const std::string TestName[]=
     {
+      "AddIntersection",
+      "CalcVertex",
       "CellStr",
+      "CompExpand",
       "Complement",
+      "CompiledRule",
       "IsValid",
       "IsOnSide",
+      "Lattice",
       "MakeComplement",
       "RemoveComplement",
       "SetObject",
@@ -227,6 +242,145 @@ testObject::applyTest(const int extra)
 }
 
 
+int
+testObject::testAddIntersection()
+  /*!
+    Test that the structural insertion of a rule gives 
+    the same cell as the string insertion
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testAddIntersection");
+
+  createSurfaces();
+  Qhull A;
+  Qhull B;
+
+  typedef std::tuple<std::string,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05524655  1 -2 3 -4 5 -6","-11 : 12"),
+      TTYPE("4 10 0.05524655  -1 : 2 : -3 : 4 : -5 : 6",
+	    "#(11 -12 13 -14 15 -16)"),
+      TTYPE("4 10 0.05524655  -100 (-1 : 2 : (-3 -4))","-21 : 22 : -5")
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const std::string& cellStr=std::get<0>(tc);
+      const std::string& excludeStr=std::get<1>(tc);
+      A.setObject(cellStr);
+      B.setObject(cellStr);
+      // string form needs the bracket to keep the union inside
+      A.addSurfString(" ("+excludeStr+") ");
+      B.addIntersection(HeadRule(excludeStr));
+      A.populate();
+      B.populate();
+      if (A.isPopulated()!=B.isPopulated() ||
+	  A.getTemp()!=B.getTemp())
+	{
+	  ELog::EM<<"Failed state "<<cellStr<<ELog::endDiag;
+	  return -1;
+	}
+      for(int i=-14;i<=14;i++)
+	for(int j=-7;j<=7;j++)
+	  for(int k=-7;k<=7;k++)
+	    {
+	      const Geometry::Vec3D Pt(1.9*i,0.5*j,0.51*k);
+	      if (A.isValid(Pt)!=B.isValid(Pt))
+		{
+		  ELog::EM<<"Failed "<<cellStr<<" : "<<Pt<<ELog::endDiag;
+		  ELog::EM<<"A == "<<A.cellCompStr()<<ELog::endDiag;
+		  ELog::EM<<"B == "<<B.cellCompStr()<<ELog::endDiag;
+		  return -1;
+		}
+	    }
+    }
+  return 0;
+}
+
+int
+testObject::testCalcVertex()
+  /*!
+    Test the pruned vertex calculation against all the
+    surface triples, and the sharing of the triple points
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testCalcVertex");
+
+  createSurfaces();
+
+  // cell : number of vertex
+  typedef std::tuple<std::string,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05524655  1 -2 3 -4 5 -6",8),
+      TTYPE("5 10 0.05524655  11 -1 3 -4 5 -6",8),
+      TTYPE("6 10 0.05524655  1 -2 3 -4 5 -6 -22",8),
+      TTYPE("7 10 0.05524655  -100 (-11:12:-13:14:-15:16)",32)
+    };
+
+  Geometry::TripleCache TCache;
+  size_t sumTriple(0);
+  for(const TTYPE& tc : Tests)
+    {
+      Qhull A;
+      A.setObject(std::get<0>(tc));
+      Qhull B(A);
+      A.calcVertex();
+      B.calcVertex(TCache);
+
+      // all the triples :
+      const std::vector<const Geometry::Surface*>& SL=A.getSurList();
+      size_t NTriple(0);
+      std::vector<Geometry::Vec3D> Pts;
+      for(size_t i=0;i<SL.size();i++)
+	for(size_t j=i+1;j<SL.size();j++)
+	  for(size_t k=j+1;k<SL.size();k++)
+	    {
+	      NTriple++;
+	      const std::set<int> ExSN=
+		{SL[i]->getName(),SL[j]->getName(),SL[k]->getName()};
+	      for(const Geometry::Vec3D& Pt :
+		    SurInter::processPoint(SL[i],SL[j],SL[k]))
+		if (A.isValid(Pt,ExSN))
+		  Pts.push_back(Pt);
+	    }
+      sumTriple+=NTriple;
+
+      const std::vector<Geometry::Vec3D> AVec=A.getVertex();
+      const std::vector<Geometry::Vec3D> BVec=B.getVertex();
+      if (AVec.size()!=std::get<1>(tc) || Pts.size()!=AVec.size() ||
+	  BVec.size()!=AVec.size() ||
+	  A.getCofM().Distance(B.getCofM())>1e-6)
+	{
+	  ELog::EM<<"Cell   == "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Vertex == "<<AVec.size()<<" "<<BVec.size()
+		  <<" ("<<Pts.size()<<")"<<ELog::endDiag;
+	  ELog::EM<<"CofM   == "<<A.getCofM()<<" : "
+		  <<B.getCofM()<<ELog::endDiag;
+	  return -1;
+	}
+      for(const Geometry::Vec3D& Pt : Pts)
+	if (std::find(AVec.begin(),AVec.end(),Pt)==AVec.end())
+	  {
+	    ELog::EM<<"Missing point "<<Pt<<ELog::endDiag;
+	    return -2;
+	  }
+    }
+  // shared surfaces and pruned triples
+  if (TCache.size()>=sumTriple)
+    {
+      ELog::EM<<"Triple cache == "<<TCache.size()<<" "
+	      <<sumTriple<<ELog::endDiag;
+      return -3;
+    }
+  return 0;
+}
+
 int
 testObject::testCellStr()
   /*!
@@ -352,6 +506,81 @@ testObject::testSetObjectExtra()
   return 0;
 }
 
+int
+testObject::testCompExpand()
+  /*!
+    Test the tree expansion of complements against the
+    Algebra string expansion over all the surface states
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testCompExpand");
+
+  populateMObj();
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -6  #12",
+      "5 10 0.05524655  #(1 2 3 4)",
+      "5 10 0.05524655  #(-8 (-9 : 19) 3 -4)",
+      "6 10 0.05524655  #2 #10",
+      "7 10 0.05524655  -61 #(#12 : 1)"
+    };
+
+  MonteCarlo::CompExpand CE(MObj);
+  for(const std::string& tc : Tests)
+    {
+      Qhull A;
+      A.setObject(tc);
+      Qhull B(A);
+
+      Algebra AX;
+      AX.setFunctionObjStr(A.cellStr(MObj));
+      A.procString(AX.writeMCNPX());
+      B.procHeadRule(CE.expand(B));
+      if (B.hasComplement())
+	{
+	  ELog::EM<<"Complement left :"<<B<<ELog::endDiag;
+	  return -1;
+	}
+
+      std::set<int> SSet;
+      for(const int SN : A.getHeadRule().getSurfSet())
+	SSet.insert(std::abs(SN));
+      for(const int SN : B.getHeadRule().getSurfSet())
+	SSet.insert(std::abs(SN));
+      const std::vector<int> SVec(SSet.begin(),SSet.end());
+
+      std::map<int,int> SMap;
+      for(size_t flag=0;flag < (1UL << SVec.size());flag++)
+	{
+	  for(size_t i=0;i<SVec.size();i++)
+	    SMap[SVec[i]]=((flag >> i) & 1) ? 1 : -1;
+	  if (A.isValid(SMap)!=B.isValid(SMap))
+	    {
+	      ELog::EM<<"Cell    == "<<tc<<ELog::endDiag;
+	      ELog::EM<<"Algebra == "<<A<<ELog::endDiag;
+	      ELog::EM<<"Tree    == "<<B<<ELog::endDiag;
+	      return -2;
+	    }
+	}
+    }
+
+  // unknown cell
+  Qhull C;
+  C.setObject("8 0  1 #99");
+  try
+    {
+      CE.expand(C);
+      ELog::EM<<"Failed to find unknown cell"<<ELog::endDiag;
+      return -3;
+    }
+  catch(ColErr::InContainerError<int>&)
+    { }
+  return 0;
+}
+
 int
 testObject::testComplement() 
   /*!
@@ -409,6 +638,63 @@ testObject::testComplement()
   return 0;
 }
 
+int
+testObject::testCompiledRule()
+  /*!
+    Test that the compiled rule gives the same
+    results as the rule tree
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testCompiledRule");
+
+  createSurfaces();
+  Qhull A;
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -6",
+      "4 10 0.05524655  -1 : 2 : -3 : 4 : -5 : 6",
+      "4 10 0.05524655  11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",
+      "4 10 0.05524655  -100 #(11 -12 13 -14 15 -16) ",
+      "4 10 0.05524655  -100 #(21 -22 3 -4 5 -6) (-1 : 2 : (-3 -4))"
+    };
+  // surfaces to exclude/alternate
+  const std::vector<int> SNVec({1,-2,4,-16,100});
+
+  for(const std::string& cellStr : Tests)
+    {
+      A.setObject(cellStr);
+      A.populate();
+      const HeadRule& HR=A.getHeadRule();
+      for(int i=-14;i<=14;i++)
+	for(int j=-7;j<=7;j++)
+	  for(int k=-7;k<=7;k++)
+	    {
+	      const Geometry::Vec3D Pt(1.9*i,0.5*j,0.51*k);
+	      if (A.isValid(Pt)!=static_cast<int>(HR.isValid(Pt)))
+		{
+		  ELog::EM<<"Failed "<<cellStr<<" : "<<Pt<<ELog::endDiag;
+		  return -1;
+		}
+	      for(const int SN : SNVec)
+		{
+		  if (A.isValid(Pt,SN)!=static_cast<int>(HR.isValid(Pt,SN)) ||
+		      A.isDirectionValid(Pt,SN)!=
+		      static_cast<int>(HR.isDirectionValid(Pt,SN)) ||
+		      A.pairValid(SN,Pt)!=HR.pairValid(SN,Pt))
+		    {
+		      ELog::EM<<"Failed "<<cellStr<<" : "<<Pt
+			      <<" : "<<SN<<ELog::endDiag;
+		      return -1;
+		    }
+		}
+	    }
+    }
+  return 0;
+}
+
 int
 testObject::testIsValid() 
   /*!
@@ -529,6 +815,80 @@ testObject::testIsOnSide()
   return 0;
 }
 
+int
+testObject::testLattice()
+  /*!
+    Test the output of universe / fill / lattice cells
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testLattice");
+
+  std::vector<std::string> Result;
+  
+  // element [0,0,0] : surface order sets the lattice index
+  Qhull LCell(10,0,0.0," 5 -6 3 -4 1 -2 ");
+  LCell.setUniverse(10);
+  LCell.setLattice(1,2,1,3,{20,21,20,21,21,20});
+  Result.push_back("10 0 -2 1 -4 3 -6 5 u=10 lat=1 "
+		   "fill=0:1 0:0 0:2 20 21 20 21 21 20");
+
+  Qhull UCell(20,0,0.0," 1 : -1 ");
+  UCell.setUniverse(20);
+  Result.push_back("20 0 (1 : -1) u=20");
+
+  Qhull FCell(30,0,0.0," -11 ");
+  FCell.setFill(10);
+  Result.push_back("30 0 -11 fill=10");
+
+  const std::vector<const Qhull*> CVec({&LCell,&UCell,&FCell});
+  for(size_t i=0;i<CVec.size();i++)
+    {
+      std::ostringstream cx;
+      CVec[i]->write(cx);
+      if (StrFunc::singleLine(cx.str())!=Result[i])
+	{
+	  ELog::EM<<"Failed on test "<<i+1<<ELog::endTrace;
+	  ELog::EM<<"Expect == "<<Result[i]<<ELog::endTrace;
+	  ELog::EM<<"Result == "<<cx.str()<<ELog::endTrace;
+	  return -1;
+	}
+    }
+
+  // lattice axes set : faces in index order [+i,-i,+j,-j,+k,-k]
+  createSurfaces();
+  Qhull ACell(11,0,0.0," 1 -2 3 -4 5 -6 ");
+  ACell.setUniverse(11);
+  ACell.setLattice(1,1,1,1,{20});
+  ACell.setLatticeAxis(Geometry::Vec3D(0,1,0),Geometry::Vec3D(0,0,1),
+		       Geometry::Vec3D(1,0,0));
+  ACell.populate();
+  std::ostringstream cx;
+  ACell.write(cx);
+  const std::string AResult("11 0 -4 3 -6 5 -2 1 u=11 lat=1 "
+			    "fill=0:0 0:0 0:0 20");
+  if (StrFunc::singleLine(cx.str())!=AResult)
+    {
+      ELog::EM<<"Failed on lattice axis"<<ELog::endTrace;
+      ELog::EM<<"Expect == "<<AResult<<ELog::endTrace;
+      ELog::EM<<"Result == "<<cx.str()<<ELog::endTrace;
+      return -1;
+    }
+
+  // fill array must match the lattice size
+  try
+    {
+      LCell.setLattice(1,2,2,2,{20,21});
+      ELog::EM<<"Failed to reject a short fill array"<<ELog::endTrace;
+      return -1;
+    }
+  catch (ColErr::MisMatch<size_t>&)
+    { }
+  
+  return 0;
+}
+
 int
 testObject::testTrackCell() 
   /*!
@@ -3,7 +3,7 @@
  
  * File:   test/testObjectRegister.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -89,12 +89,14 @@ testObjectRegister::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testObjectRegister::testExcludeItem,
-      &testObjectRegister::testGetObject
+      &testObjectRegister::testGetObject,
+      &testObjectRegister::testInRange
     };
   const std::string TestName[]=
     {
       "ExcludeItem",
-      "GetObject"
+      "GetObject",
+      "InRange"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -160,5 +162,61 @@ testObjectRegister::testGetObject()
   return 0;
 }
 
+int
+testObjectRegister::testInRange()
+  /*!
+    Test the finding of the object of a cell 
+    [normal and renumbered]
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObjectRegister","testInRange");
+
+  ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
 
+  const int AN=OR.cell("RangeA",100);
+  const int BN=OR.cell("RangeB",0);     // zero cell : masked by C
+  const int CN=OR.cell("RangeC",50);
 
+  const std::vector<int> CellN({AN,AN+20,AN+100,BN,CN+50,CN+51,5});
+  const std::vector<std::string> ResultN=
+    {"RangeA","RangeA","RangeC","RangeC","RangeC","",""};
+  if (OR.inRange(CellN)!=ResultN)
+    {
+      ELog::EM<<"Failed on bulk inRange"<<ELog::endDiag;
+      return -1;
+    }
+  for(size_t i=0;i<CellN.size();i++)
+    if (OR.inRange(CellN[i])!=ResultN[i])
+      {
+	ELog::EM<<"Cell "<<CellN[i]<<" == "<<OR.inRange(CellN[i])<<ELog::endDiag;
+	ELog::EM<<"Expected "<<ResultN[i]<<ELog::endDiag;
+	return -1;
+      }
+
+  // renumber [A moved after C]
+  OR.setRenumber("RangeA",900001,900010);
+  OR.setRenumber("RangeC",900011,900020);
+  OR.setRenumber("RangeUnknown",900031,900040);
+  OR.setRenumber("RangeA",900021,900030);
+
+  const std::vector<int> RCellN({900025,900011,900021,900005,900035,900020});
+  const std::vector<std::string> RResultN=
+    {"RangeA","RangeC","RangeA","","","RangeC"};
+  const std::vector<std::string> Out=OR.inRenumberRange(RCellN);
+  for(size_t i=0;i<RCellN.size();i++)
+    if (Out[i]!=RResultN[i] ||
+	OR.inRenumberRange(RCellN[i])!=RResultN[i])
+      {
+	ELog::EM<<"Renumber "<<RCellN[i]<<" == "<<Out[i]<<ELog::endDiag;
+	ELog::EM<<"Expected "<<RResultN[i]<<ELog::endDiag;
+	return -1;
+      }
+  if (OR.calcRenumber(AN+5)!=900026 || OR.calcRenumber(5)!=5)
+    {
+      ELog::EM<<"Failed on calcRenumber "<<OR.calcRenumber(AN+5)<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
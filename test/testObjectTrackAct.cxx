@@ -48,6 +48,9 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
 #include "varList.h"
 #include "Code.h"
 #include "FItem.h"
@@ -64,8 +67,15 @@
 #include "surfRegister.h"
 #include "ModelSupport.h"
 #include "LineTrack.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "AttnTable.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
+#include "ObjectTrackPlane.h"
+#include "TrackFan.h"
 
 #include "testFunc.h"
 #include "testObjectTrackAct.h"
@@ -183,11 +193,15 @@ testObjectTrackAct::applyTest(const int extra)
   typedef int (testObjectTrackAct::*testPtr)();
   testPtr TPtr[]=
     {
-      &testObjectTrackAct::testPointDet
+      &testObjectTrackAct::testAttnSum,
+      &testObjectTrackAct::testPointDet,
+      &testObjectTrackAct::testTrackFan
     };
   const std::string TestName[]=
     {
-      "PointDet"
+      "AttnSum",
+      "PointDet",
+      "TrackFan"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -215,6 +229,57 @@ testObjectTrackAct::applyTest(const int extra)
   return 0;
 }
 
+int
+testObjectTrackAct::testAttnSum()
+  /*!
+    Tests the energy dependent attenuation sum
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testAttnSum");
+
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+
+  ObjectTrackPoint OA(Geometry::Vec3D(20,0,0));
+  OA.addUnit(ASim,1,Geometry::Vec3D(0,0,0));
+
+  // High energy limit : rho A^0.66 per segment
+  // track from centre : 1cm steel / 2cm Al / 5cm Gd 
+  double expect(0.0);
+  const int matN[]={3,5,8};
+  const double dist[]={1.0,2.0,5.0};
+  for(size_t i=0;i<3;i++)
+    {
+      const MonteCarlo::Material& MI=DB.getMaterial(matN[i]);
+      expect+=dist[i]*MI.getAtomDensity()*std::pow(MI.getMeanA(),0.66);
+    }
+  
+  std::vector<double> AT;
+  OA.getAttnSum(1,AttnTable(),AT);
+  if (AT.size()!=1 || std::abs(AT[0]-expect)>1e-6*expect)
+    {
+      ELog::EM<<"AT["<<AT.size()<<"] == "<<AT[0]<<ELog::endDiag;
+      ELog::EM<<"Expect == "<<expect<<ELog::endDiag;
+      return -1;
+    }
+
+  // Attenuation falls with energy to the high energy limit
+  const std::vector<double> EBin({0.001,1.0,20.0,1e3,1e7});
+  OA.getAttnSum(1,AttnTable(EBin),AT);
+  if (AT.size()!=EBin.size() ||
+      std::abs(AT[0]-AT[1])>1e-6*AT[1] ||
+      AT[1]<=AT[2] || AT[2]<=AT[3] || AT[3]<=AT[4] ||
+      std::abs(AT[4]-expect)>1e-3*expect)
+    {
+      for(size_t i=0;i<AT.size();i++)
+	ELog::EM<<"AT["<<EBin[i]<<"] == "<<AT[i]<<ELog::endDiag;
+      ELog::EM<<"Expect == "<<expect<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
 int
 testObjectTrackAct::testPointDet()
   /*!
@@ -258,3 +323,76 @@ testObjectTrackAct::testPointDet()
   return 0;
 }
 
+
+int
+testObjectTrackAct::testTrackFan()
+  /*!
+    Tests the ray fan against single tracks
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testTrackFan");
+
+  const Geometry::Vec3D Origin(20,0,0);
+  const Geometry::Plane TPlane(1,0,Geometry::Vec3D(20,0,0),
+			       Geometry::Vec3D(1,0,0));
+
+  std::vector<Geometry::Vec3D> Pts;
+  for(double x=-2.5;x<16.0;x+=1.5)
+    for(double y=-2.5;y<3.0;y+=1.25)
+      Pts.push_back(Geometry::Vec3D(x,y,0.3*y));
+
+  const AttnTable ATable(std::vector<double>({0.1,20.0,1e3}));
+  const size_t NE(ATable.getNE());
+
+  for(size_t planeFlag=0;planeFlag<2;planeFlag++)
+    for(size_t nThread=1;nThread<4;nThread+=2)
+      {
+	std::vector<double> Dist(Pts.size(),-1.0);
+	std::vector<double> Attn(Pts.size()*NE,-1.0);
+	TrackFan TFan(ASim,ATable);
+	TFan.setThreads(nThread);
+	TrackFan::RayFunc outFunc=
+	  [&](const size_t index,const double D,const double* AT)
+	  {
+	    Dist[index]=D;
+	    std::copy(AT,AT+NE,Attn.begin()+
+		      static_cast<long int>(index*NE));
+	  };
+	if (planeFlag)
+	  TFan.trace(TPlane,Pts,outFunc);
+	else
+	  TFan.trace(Origin,Pts,outFunc);
+
+	std::vector<double> AT;
+	for(size_t i=0;i<Pts.size();i++)
+	  {
+	    ObjectTrackPoint OA(Origin);
+	    ObjectTrackPlane OB(TPlane);
+	    ObjectTrackAct& OT=(planeFlag) ?
+	      static_cast<ObjectTrackAct&>(OB) :
+	      static_cast<ObjectTrackAct&>(OA);
+	    if (planeFlag)
+	      OB.addUnit(ASim,1,Pts[i]);
+	    else
+	      OA.addUnit(ASim,1,Pts[i]);
+	    OT.getAttnSum(1,ATable,AT);
+	    bool failFlag(std::abs(OT.getDistance(1)-Dist[i])>1e-6);
+	    for(size_t e=0;e<NE;e++)
+	      if (std::abs(AT[e]-Attn[i*NE+e])>1e-6*(1.0+AT[e]))
+		failFlag=1;
+	    if (failFlag)
+	      {
+		ELog::EM<<"Plane/Thread "<<planeFlag<<" "
+			<<nThread<<" Pt "<<Pts[i]<<ELog::endDiag;
+		ELog::EM<<"Dist == "<<Dist[i]<<" : "
+			<<OT.getDistance(1)<<ELog::endDiag;
+		for(size_t e=0;e<NE;e++)
+		  ELog::EM<<"AT["<<e<<"] == "<<Attn[i*NE+e]
+			  <<" : "<<AT[e]<<ELog::endDiag;
+		return -1;
+	      }
+	  }
+      }
+  return 0;
+}
@@ -50,6 +50,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Quaternion.h"
 #include "Transform.h"
 #include "Surface.h"
@@ -69,6 +70,7 @@
 #include "Object.h"
 #include "Qhull.h"
 #include "ObjSurfMap.h"
+#include "ObjBVH.h"
 #include "ReadFunctions.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
@@ -187,12 +189,14 @@ testSimulation::applyTest(const int extra)
   typedef int (testSimulation::*testPtr)();
   testPtr TPtr[]=
     {
+      &testSimulation::testCellIndex,
       &testSimulation::testCreateObjSurfMap,
       &testSimulation::testInCell,
       &testSimulation::testTrackNeutron
     };
   const std::string TestName[]=
     {
+      "CellIndex",
       "CreateObjSurfMap",
       "InCell",
       "TrackNeutron"
@@ -280,6 +284,93 @@ testSimulation::testTrackNeutron()
             
 }
 
+int
+testSimulation::testCellIndex()
+  /*!
+    Test the bounding box tree of the cells
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testCellIndex");
+
+  ASim.populateCells();
+  const Simulation& CSim(ASim);
+  const Simulation::OTYPE& OMap=CSim.getCells();
+  const ModelSupport::ObjBVH& BVH=CSim.getCellIndex();
+
+  // cell : bounded : low : high
+  typedef std::tuple<int,bool,Geometry::Vec3D,Geometry::Vec3D> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(1,0,Geometry::Vec3D(0,0,0),Geometry::Vec3D(0,0,0)),
+      TTYPE(2,1,Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(1,1,1)),
+      TTYPE(3,1,Geometry::Vec3D(-3,-3,-3),Geometry::Vec3D(3,3,3)),
+      TTYPE(4,1,Geometry::Vec3D(10,-1,-1),Geometry::Vec3D(15,1,1)),
+      TTYPE(5,1,Geometry::Vec3D(-25,-25,-25),Geometry::Vec3D(25,25,25))
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::BoundBox& BB=BVH.getBox(std::get<0>(tc));
+      if (BB.isFinite()!=std::get<1>(tc) ||
+	  (std::get<1>(tc) &&
+	   (BB.getLow().Distance(std::get<2>(tc))>1e-3 ||
+	    BB.getHigh().Distance(std::get<3>(tc))>1e-3)))
+	{
+	  ELog::EM<<"Cell "<<std::get<0>(tc)<<" Box == "<<BB<<ELog::endDiag;
+	  ELog::EM<<"Expect :"<<std::get<2>(tc)<<" : "
+		  <<std::get<3>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // Compare to a linear search on a grid
+  auto gridCheck=[&OMap,&BVH]() -> bool
+    {
+      for(int i=-15;i<=15;i++)
+	for(int j=-15;j<=15;j++)
+	  for(int k=-15;k<=15;k++)
+	    {
+	      const Geometry::Vec3D Pt(2.0*i+0.1,1.7*j+0.1,1.9*k+0.1);
+	      int linearCell(0);
+	      for(const Simulation::OTYPE::value_type& MC : OMap)
+		if (!MC.second->isPlaceHold() && MC.second->isValid(Pt))
+		  {
+		    linearCell=MC.first;
+		    break;
+		  }
+	      const MonteCarlo::Object* OPtr=BVH.findCell(Pt);
+	      const int bvhCell=(OPtr) ? OPtr->getName() : 0;
+	      if (bvhCell!=linearCell)
+		{
+		  ELog::EM<<"Point "<<Pt<<" : "<<bvhCell<<" "
+			  <<linearCell<<ELog::endDiag;
+		  return 0;
+		}
+	    }
+      return 1;
+    };
+  if (!gridCheck())
+    return -2;
+
+  // Cut a cell through the simulation : only it is refitted
+  MonteCarlo::Qhull* QH=ASim.findQhull(3);
+  QH->addIntersection(HeadRule("-2"));
+  QH->populate();
+  CSim.getCellIndex();
+  const Geometry::BoundBox& BB=BVH.getBox(3);
+  if (BB.getHigh().Distance(Geometry::Vec3D(1,3,3))>1e-3 ||
+      BVH.findCell(Geometry::Vec3D(2,0,0)))
+    {
+      ELog::EM<<"Cell 3 Box == "<<BB<<ELog::endDiag;
+      initSim();
+      return -3;
+    }
+  const int flag=(gridCheck()) ? 0 : -4;
+  initSim();
+  return flag;
+}
+
 int
 testSimulation::testCreateObjSurfMap()
   /*!
@@ -23,6 +23,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex>
 #include <vector>
@@ -92,7 +93,8 @@ testSupport::applyTest(const int extra)
       &testSupport::testStrFullCut,
       &testSupport::testStrParts,
       &testSupport::testStrRemove,
-      &testSupport::testStrSplit
+      &testSupport::testStrSplit,
+      &testSupport::testWriteControl
     };
 
   const std::string TestName[]=
@@ -111,7 +113,8 @@ testSupport::applyTest(const int extra)
       "StrFullCut",
       "StrParts",
       "StrRemove",
-      "StrSplit"
+      "StrSplit",
+      "WriteControl"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -898,3 +901,51 @@ testSupport::testStrSplit()
 
   return 0;
 }
+
+int
+testSupport::testWriteControl()
+  /*!
+    Test the line wrap of writeControl
+    \retval -1 on failure
+  */
+{
+  ELog::RegMethod RegA("testSupport","testWriteControl");
+
+  const std::string LineA("1 0 -1 2 -3 4 -5 6 -7 8 -9 10 -11 12 -13 "
+			  "14 -15 16 -17 18 -19 20 -21 22 -23 24");
+  const std::string LineB("imp:n 1 1 1,1,1,1,1,1,1 1 1 1 1,1,1,1 1 "
+			  "1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1");
+  
+  // Line : max length : insert depth : result
+  typedef std::tuple<std::string,size_t,int,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(LineA,72,8,
+	    "1 0 -1 2 -3 4 -5 6 -7 8 -9 10 -11 12 -13 14 -15 16 "
+	    "-17 18 -19 20 -21 22\n        -23 24\n"),
+      TTYPE(LineA,30,-4,
+	    "    1 0 -1 2 -3 4 -5 6 -7 8\n    -9 10 -11 12 -13 14 -15\n"
+	    "    16 -17 18 -19 20 -21 22\n    -23 24\n"),
+      TTYPE(LineB,40,6,
+	    "imp:n 1 1 1,1,1,1,1,1,1 1 1 1 1,1,1,1 1\n"
+	    "      1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1\n"
+	    "      1 1 1 1 1 1 1 1 1\n"),
+      TTYPE("  short  ",72,8,"short\n"),
+      TTYPE("    ",72,8,"")
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      std::ostringstream cx;
+      StrFunc::writeControl(std::get<0>(tc),cx,
+			    std::get<1>(tc),std::get<2>(tc));
+      if (cx.str()!=std::get<3>(tc))
+	{
+	  ELog::EM<<"Line == "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Out ==\n"<<cx.str()<<ELog::endDiag;
+	  ELog::EM<<"Expect ==\n"<<std::get<3>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
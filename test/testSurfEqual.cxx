@@ -112,13 +112,15 @@ testSurfEqual::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testSurfEqual::testBasicPair,
-      &testSurfEqual::testEqualSurfNum
+      &testSurfEqual::testEqualSurfNum,
+      &testSurfEqual::testHashEqual
     };
 
   const std::string TestName[]=
     {
       "BasicPair",
-      "EqualSurfNum"
+      "EqualSurfNum",
+      "HashEqual"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -208,3 +210,71 @@ testSurfEqual::testEqualSurfNum()
   return 0;
 }
 
+int
+testSurfEqual::testHashEqual()
+  /*!
+    Test the hashed equal/opposite surface search including
+    surfaces either side of a bucket edge
+    \return -ve on error 
+  */
+{
+  ELog::RegMethod RegA("testSurfEqual","testHashEqual");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+
+  SurI.createSurface(21,"px 1.000000001");
+  SurI.createSurface(22,"px -1");
+  SurI.createSurface(23,"px 0.0002");
+  SurI.createSurface(24,"px 0.000199999999");
+  SurI.createSurface(25,"p -1 0 0 -1");
+
+  // surface : equal : opposite
+  typedef std::tuple<int,int,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(21,2,0),
+      TTYPE(22,1,0),
+      TTYPE(24,23,0),
+      TTYPE(25,25,2),
+      TTYPE(11,11,1)
+    };
+
+  int retFlag(0);
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Surface* SA=SurI.getSurf(std::get<0>(tc));
+      const int eqN=ModelSupport::equalSurfNum(SA);
+      const int oppN=SurI.findOpposite(SA);
+      if (eqN!=std::get<1>(tc) || oppN!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Failed :  "<<std::get<0>(tc)<<" "
+		  <<std::get<1>(tc)<<" "<<std::get<2>(tc)<<ELog::endCrit;
+	  ELog::EM<<"Surface :  "<<*SA<<ELog::endCrit;
+	  ELog::EM<<"Equal/Opp :  "<<eqN<<" "<<oppN<<ELog::endCrit;
+	  retFlag=-1;
+	  break;
+	}
+    }
+
+  if (!retFlag)
+    {
+      std::map<int,Geometry::Surface*> EQMap;
+      SurI.findEqualSurf(21,26,EQMap);
+      const std::map<int,int> Expect({{21,2},{22,1},{23,24}});
+      std::map<int,int> Result;
+      for(const std::map<int,Geometry::Surface*>::value_type& EQ : EQMap)
+	Result.emplace(EQ.first,EQ.second->getName());
+      if (Result!=Expect)
+	{
+	  ELog::EM<<"Failed findEqualSurf"<<ELog::endCrit;
+	  for(const std::map<int,int>::value_type& RItem : Result)
+	    ELog::EM<<"Result :  "<<RItem.first<<" "
+		    <<RItem.second<<ELog::endCrit;
+	  retFlag=-1;
+	}
+    }
+  
+  for(int i=21;i<26;i++)
+    SurI.deleteSurface(i);
+  return retFlag;
+}
@@ -3,7 +3,7 @@
  
  * File:   test/testVolumes.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -34,6 +34,7 @@
 #include <numeric>
 #include <iterator>
 #include <memory>
+#include <tuple>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -133,6 +134,10 @@ testVolumes::createSurfaces()
   SurI.createSurface(21,"px 10");
   SurI.createSurface(22,"px 15");
 
+  // Outer box [outside sphere 100] :
+  SurI.createSurface(31,"px 40");
+  SurI.createSurface(32,"px 45");
+
   // Sphere :
   SurI.createSurface(100,"so 25");
   // Sphere :
@@ -152,7 +157,7 @@ testVolumes::createObjects()
   int cellIndex(1);
   const int surIndex(0);
 
-  Out=ModelSupport::getComposite(surIndex,"100");
+  Out=ModelSupport::getComposite(surIndex,"100 (-31:32:-3:4:-5:6)");
   ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Outside void Void
 
   // Out=ModelSupport::getComposite(surIndex,"-102");
@@ -182,6 +187,9 @@ testVolumes::createObjects()
   Out=ModelSupport::getComposite(surIndex,"-100 (-11:12:-13:14:-15:16)"
 				 " #4");
   ASim.addCell(MonteCarlo::Qhull(cellIndex++,0,0.0,Out));      // Void
+
+  Out=ModelSupport::getComposite(surIndex,"31 -32 3 -4 5 -6");
+  ASim.addCell(MonteCarlo::Qhull(cellIndex++,8,0.0,Out));      // Outer Gd box 
   
   ASim.removeComplements();
 
@@ -207,11 +215,15 @@ testVolumes::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testVolumes::testPointVolume,
+      &testVolumes::testSampledVolume,
+      &testVolumes::testStratifiedVolume,
       &testVolumes::testVolume
     };
   const std::string TestName[]=
     {
       "PointVolume",
+      "SampledVolume",
+      "StratifiedVolume",
       "Volume"
     };
   
@@ -302,3 +314,97 @@ testVolumes::testPointVolume()
   return 0;
 }
 
+int
+testVolumes::testSampledVolume()
+  /*!
+    Test the threaded/stratified/quasi-random volume
+    of the sphere [cell 2 : r=6]
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testVolumes","testSampledVolume");
+
+  const double VExpect(4.0*M_PI*216.0/3.0);
+  
+  // sample type : threads
+  typedef std::tuple<std::string,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("random",1),
+      TTYPE("random",3),
+      TTYPE("stratified",2),
+      TTYPE("halton",4)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      VolSum VTally(Geometry::Vec3D(0,0,0),Geometry::Vec3D(14.0,14.0,14.0));
+      VTally.addTallyCell(4,2);
+      VTally.setSampling(std::get<0>(tc));
+      VTally.setThreads(std::get<1>(tc));
+      VTally.setTargetError(0.005);
+      VTally.pointRun(ASim,400000);
+
+      const double V=VTally.calcVolume(4);
+      const double RE=VTally.calcRelError(4);
+      if (std::abs(V-VExpect)>0.03*VExpect || RE>0.005)
+	{
+	  ELog::EM<<"Sample "<<std::get<0>(tc)<<" : "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Volume == "<<V<<" ["<<VExpect<<"] : "
+		  <<RE<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testVolumes::testStratifiedVolume()
+  /*!
+    Test the stratified/halton volume of a small cell
+    [cell 7 : outer Gd box, 20cm3] in the low-z end of the box.
+    The number of points is not a cube of an integer, so 
+    left over points must not go into the low-z strata.
+    The error must also describe the spread of the result.
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testVolumes","testStratifiedVolume");
+
+  const double VExpect(20.0);
+  
+  // sample type : threads : target error : N
+  typedef std::tuple<std::string,size_t,double,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("stratified",1,0.0,100000),
+      TTYPE("stratified",3,0.004,200000),
+      TTYPE("halton",2,0.004,200000)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      // box : x 40-45 / y -1-1 / z -1-19
+      VolSum VTally(Geometry::Vec3D(42.5,0,9),Geometry::Vec3D(5.0,2.0,20.0));
+      VTally.addTallyCell(4,7);
+      VTally.setSampling(std::get<0>(tc));
+      VTally.setThreads(std::get<1>(tc));
+      VTally.setTargetError(std::get<2>(tc));
+      VTally.pointRun(ASim,std::get<3>(tc));
+
+      const double V=VTally.calcVolume(4);
+      const double RE=VTally.calcRelError(4);
+      const double diff=std::abs(V-VExpect);
+      if (diff>0.02*VExpect || RE<=0.0 || diff>5.0*RE*VExpect ||
+	  (std::get<2>(tc)>0.0 && RE>std::get<2>(tc)))
+	{
+	  ELog::EM<<"Sample "<<std::get<0>(tc)<<" : "
+		  <<std::get<1>(tc)<<" : "<<std::get<3>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Volume == "<<V<<" ["<<VExpect<<"] : "
+		  <<RE<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
@@ -58,6 +58,7 @@
 #include "XMLnamespace.h" 
 #include "XMLiterator.h"
 #include "XMLgridSupport.h"
+#include "XMLpull.h"
 
 #include "testFunc.h"
 #include "testUnitSupport.h"
@@ -246,7 +247,8 @@ testXML::applyTest(const int extra)
       &testXML::testDataBlock,	    
       &testXML::testGroupContent,   
       &testXML::testXMLiterator,     
-      &testXML::testProcString    
+      &testXML::testProcString,
+      &testXML::testPullParse
     };
 
   std::string TestName[] = 
@@ -269,7 +271,8 @@ testXML::applyTest(const int extra)
       "testDataBlock",
       "testGroupContent",
       "testXMLiterator",
-      "testProcString"
+      "testProcString",
+      "testPullParse"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -1127,3 +1130,101 @@ testXML::testDataBlock()
   
   return 0;
 }
+
+int
+testXML::testPullParse()
+  /*!
+    Test the XMLpull stream parser
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testXML","testPullParse");
+
+  std::ofstream TX("testXMLpull.xml");
+  TX<<"<?xml version=\"1.0\" encoding=\"ISO-8859-1\" ?>\n"
+    "<metadata_entry>\n"
+    " <!-- comment <variable> -->\n"
+    " <variable name=\"A\" type = 'int'> 3 </variable>\n"
+    " <grid>\n"
+    "   <variable name=\"B\">\n"
+    "     <value>\n  1.0   2.0\n 3.0 </value>\n"
+    "     <value>7.0</value>\n"
+    "   </variable>\n"
+    "   <variable name=\"C\"/>\n"
+    " </grid>\n"
+    "</metadata_entry>\n";
+  TX.close();
+
+  XMLpull XP;
+  if (XP.openFile("testXMLpull.xml"))
+    {
+      ELog::EM<<"Failed to open testXMLpull.xml"<<ELog::endDiag;
+      return -1;
+    }
+
+  // Name : Type : Value : in grid
+  typedef std::tuple<std::string,std::string,std::string,bool> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("A","int","3",0),
+      TTYPE("B","double","1.0 2.0 3.0",1),
+      TTYPE("C","double","",1)
+    };
+
+  size_t index(0);
+  XMLpull::EventType ET;
+  while( (ET=XP.next())!=XMLpull::endFile )
+    {
+      if ((ET!=XMLpull::startElm && ET!=XMLpull::emptyElm) ||
+	  XP.getKey()!="variable")
+	continue;
+      if (index>=Tests.size())
+	{
+	  ELog::EM<<"Extra variable found"<<ELog::endDiag;
+	  return -2;
+	}
+      const TTYPE& tc(Tests[index++]);
+      const std::string Name=XP.getAttribute("name");
+      const std::string Type=XP.getAttribute("type","double");
+      const bool gridFlag=XP.matchPath("grid/variable");
+      std::string Value;
+      try
+        {
+	  Value=XP.getValue("value");
+	}
+      catch (ColErr::InContainerError<std::string>&)
+        {
+	  Value="";
+	}
+      if (Name!=std::get<0>(tc) || Type!=std::get<1>(tc) ||
+	  Value!=std::get<2>(tc) || gridFlag!=std::get<3>(tc))
+	{
+	  ELog::EM<<"Test "<<index<<ELog::endDiag;
+	  ELog::EM<<"Name  == "<<Name<<" "<<gridFlag<<ELog::endDiag;
+	  ELog::EM<<"Type  == "<<Type<<ELog::endDiag;
+	  ELog::EM<<"Value == :"<<Value<<":"<<ELog::endDiag;
+	  return -3;
+	}
+    }
+  if (index!=Tests.size())
+    {
+      ELog::EM<<"Variables found == "<<index<<ELog::endDiag;
+      return -4;
+    }
+  
+  // Bad close
+  TX.open("testXMLpull.xml");
+  TX<<"<metadata_entry><a></b></metadata_entry>";
+  TX.close();
+  XP.openFile("testXMLpull.xml");
+  try
+    {
+      while(XP.next()!=XMLpull::endFile) ;
+      ELog::EM<<"Failed to find bad close"<<ELog::endDiag;
+      return -5;
+    }
+  catch (ColErr::InvalidLine&)
+    { }
+  
+  return 0;
+}
@@ -46,6 +46,7 @@ private:
 
   //Tests 
   int testBoundaryValid();
+  int testInsertCheck();
   int testInsertComponent();
 
 public:
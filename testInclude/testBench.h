@@ -0,0 +1,86 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   testInclude/testBench.h
+ *
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef testBench_h
+#define testBench_h
+
+class Simulation;
+
+/*!
+  \class testBench
+  \brief Timing of the geometry kernels
+  \author S. Ansell
+  \date November 2017
+  \version 1.0
+
+  Builds synthetic models [nested cylinders / box lattice /
+  simpleObj row] at several sizes and times the kernels
+  on fixed-seed points. Each result is written as a line
+  and [if named] to a csv file for comparison between builds.
+*/
+
+class testBench
+{
+private:
+
+  /// Result : kernel : model : size : cells : ops : time [ns] : checksum
+  typedef std::tuple<std::string,std::string,size_t,size_t,
+		     size_t,double,double> BTYPE;
+
+  const std::string csvFile;     ///< Results file [empty for none]
+  Simulation ASim;               ///< Simulation
+  /// Model names [buildModel index]
+  const std::vector<std::string> ModelName;
+  /// Model sizes [cylinders / cells per side / objects]
+  const std::vector<std::vector<size_t>> ModelSize;
+  Geometry::Vec3D halfExtent;    ///< Half size of the model
+  std::vector<BTYPE> Results;    ///< Timing results
+
+  static double clockTime();
+
+  void initSim();
+  size_t buildCylinder(const size_t);
+  size_t buildLattice(const size_t);
+  size_t buildSimpleObj(const size_t);
+  size_t buildModel(const size_t,const size_t);
+  std::vector<Geometry::Vec3D> randomPoints(const size_t) const;
+
+  void addResult(const std::string&,const std::string&,const size_t,
+		 const size_t,const size_t,const double,const double);
+  void writeResults(const std::string&) const;
+
+  //Tests
+  int benchComposite();
+  int benchFindCell();
+  int benchIsValid();
+  int benchRemoveComplements();
+  int benchTrackCell();
+  int benchWrite();
+
+public:
+
+  explicit testBench(const std::string&);
+  ~testBench();
+
+  int applyTest(const int);
+};
+
+#endif
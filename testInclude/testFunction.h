@@ -39,6 +39,7 @@ private:
   int testAnalyse();
   int testBuiltIn();
   int testCopyVarSet();
+  int testDepend();
   int testEval();
   int testString();
   int testVariable();
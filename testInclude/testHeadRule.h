@@ -49,6 +49,7 @@ private:
   int testLevel();
   int testPartEqual();
   int testRemoveSurf();
+  int testRenumberSurfaces();
   int testReplacePart();
   int testSurfSet();
  
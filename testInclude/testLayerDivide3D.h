@@ -0,0 +1,59 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   testInclude/testLayerDivide3D.h
+*
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testLayerDivide3D_h
+#define testLayerDivide3D_h 
+
+/*!
+  \class testLayerDivide3D
+  \brief Tests the class LayerDivide3D
+  \author S. Ansell
+  \date November 2017
+  \version 1.0
+
+  Test the division of a box cell into explicit 
+  cells and into a lattice
+*/
+
+class testLayerDivide3D
+{
+private:
+  
+  Simulation ASim;       ///< Simulation object to build
+
+  void initSim();
+  void createSurfaces();
+  void createObjects();
+
+  //Tests 
+  int testExplicit();
+  int testLattice();
+
+public:
+  
+  testLayerDivide3D();
+  ~testLayerDivide3D();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
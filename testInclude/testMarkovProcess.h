@@ -0,0 +1,65 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   testInclude/testMarkovProcess.h
+*
+ * Copyright (c) 2004-2017 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testMarkovProcess_h
+#define testMarkovProcess_h 
+
+namespace WeightSystem
+{
+  class WWG;
+}
+
+/*!
+  \class testMarkovProcess
+  \brief Tests the class MarkovProcess
+  \author S. Ansell
+  \date November 2017
+  \version 1.0
+
+  Test the Markov transfer matrix against a dense matrix
+*/
+
+class testMarkovProcess
+{
+private:
+  
+  Simulation ASim;       ///< Simulation object to build
+
+  void initSim();
+  void createSurfaces();
+  void createObjects();
+  void createMesh(WeightSystem::WWG&) const;
+
+  //Tests 
+  int testComputeMatrix();
+  int testMultiplyOut();
+  int testPowerIterate();
+
+public:
+  
+  testMarkovProcess();
+  ~testMarkovProcess();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
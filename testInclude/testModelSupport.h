@@ -3,7 +3,7 @@
  
  * File:   testInclude/testModelSupport.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -39,6 +39,7 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testCompTemplate();
   int testRemoveOpenPair();
 
 public:
@@ -41,6 +41,7 @@ private:
   int testOperator();
   int testOutput();
   int testRange();
+  int testSetCondensed();
 
 public:
   
@@ -3,7 +3,7 @@
  
  * File:   testInclude/testObject.h
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -46,11 +46,16 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testAddIntersection();
+  int testCalcVertex();
   int testCellStr();
+  int testCompExpand();
   int testComplement();
+  int testCompiledRule();
   int testIntersect();
   int testIsValid();
   int testIsOnSide();
+  int testLattice();
   int testMakeComplement();
   int testRemoveComplement();
   int testSetObject();
@@ -43,7 +43,9 @@ private:
   void createObjects();
 
   //Tests 
+  int testAttnSum();
   int testPointDet();
+  int testTrackFan();
 
 public:
   
@@ -43,6 +43,7 @@ private:
   void createObjects();
 
   //Tests 
+  int testCellIndex();
   int testCreateObjSurfMap();
   int testInCell();
   int testTrackNeutron();
@@ -54,6 +54,7 @@ private:
   int testStrParts();   
   int testStrRemove();  
   int testStrSplit();   
+  int testWriteControl();
 
 public:
 
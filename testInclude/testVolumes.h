@@ -3,7 +3,7 @@
  
  * File:   testInclude/testVolumes.h
 *
- * Copyright (c) 2004-2013 by Stuart Ansell
+ * Copyright (c) 2004-2017 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -44,6 +44,8 @@ private:
 
   //Tests 
   int testPointVolume();
+  int testSampledVolume();
+  int testStratifiedVolume();
   int testVolume();
 
 public:
@@ -67,6 +67,7 @@ private:
   int testDeleteObj();
   int testDataBlock();
   int testProcString();
+  int testPullParse();
   
 public:
 